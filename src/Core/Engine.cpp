@@ -1,12 +1,12 @@
 #include "Core/Engine.h"
+#include "Core/ThreadPool.h"
 #include "Platform/Win32/Win32Window.h"
 #include "RHI/RHIDevice.h"
 #include "RHI/RHIContext.h"
 #include "RHI/D3D12/D3D12Device.h"
-#include "RHI/D3D12/D3D12Buffer.h"
-#include "RHI/D3D12/D3D12Context.h"
 #include "Renderer/Mesh.h"
 #include "Renderer/MeshFactory.h"
+#include "Renderer/MeshLibrary.h"
 #include "Renderer/Renderer.h"
 #include "Renderer/DebugHUD.h"
 #include "Lighting/PointLight.h"
@@ -21,6 +21,26 @@ using namespace DirectX;
 namespace RRE
 {
 
+namespace
+{
+
+MeshDesc GetMeshDesc(MeshType type)
+{
+    switch (type)
+    {
+    case MeshType::Sphere:      return MeshDesc::Sphere();
+    case MeshType::Tetrahedron: return MeshDesc::Tetrahedron();
+    case MeshType::Cube:        return MeshDesc::Cube();
+    case MeshType::Cylinder:    return MeshDesc::Cylinder();
+    }
+    return MeshDesc::Cube();
+}
+
+// Low-poly light indicator (uploaded separately from scene meshes)
+const MeshDesc LIGHT_SPHERE_DESC = MeshDesc::Sphere(8, 8);
+
+} // anonymous namespace
+
 Engine::Engine() = default;
 
 Engine::~Engine()
@@ -53,38 +73,44 @@ bool Engine::Initialize(const EngineInitParams& params)
         return false;
     }
 
-    // Create all 4 mesh types
-    m_sphereMesh = std::make_unique<Mesh>(MeshFactory::CreateSphere());
-    m_tetrahedronMesh = std::make_unique<Mesh>(MeshFactory::CreateTetrahedron());
-    m_cubeMesh = std::make_unique<Mesh>(MeshFactory::CreateCube());
-    m_cylinderMesh = std::make_unique<Mesh>(MeshFactory::CreateCylinder());
-    m_currentMesh = m_cubeMesh.get();
+    // Create worker pool (mesh generation; large flat hierarchies update
+    // world matrices in parallel)
+    m_threadPool = std::make_unique<ThreadPool>();
+
+    // Generate all 4 mesh types and the light sphere on the pool; startup
+    // only waits for the meshes the first frame draws
+    m_meshLibrary = std::make_unique<MeshLibrary>(m_threadPool.get());
+    for (MeshType type : { MeshType::Cube, MeshType::Sphere, MeshType::Tetrahedron, MeshType::Cylinder })
+    {
+        m_meshLibrary->Request(GetMeshDesc(type));
+    }
+    m_meshLibrary->Request(LIGHT_SPHERE_DESC);
+    m_currentMesh = m_meshLibrary->Get(GetMeshDesc(MeshType::Cube));
 
     // Build scene graph:
     //   Root -> Parent (self-rotation)
     //   Root -> OrbitPivot (orbital rotation, no mesh) -> Child (offset + self-rotation)
     m_sceneGraph = std::make_unique<SceneGraph>();
+    m_sceneGraph->SetStorage(SceneStorage::Flat);
+    m_sceneGraph->SetThreadPool(m_threadPool.get());
     {
         auto parentNode = std::make_unique<SceneNode>();
-        parentNode->SetMesh(m_currentMesh);
+        parentNode->SetMesh(m_currentMesh.get());
         m_parentNode = m_sceneGraph->GetRoot()->AddChild(std::move(parentNode));
 
         auto orbitPivot = std::make_unique<SceneNode>();  // no mesh, controls orbit speed
         m_orbitPivotNode = m_sceneGraph->GetRoot()->AddChild(std::move(orbitPivot));
 
         auto childNode = std::make_unique<SceneNode>();
-        childNode->SetMesh(m_currentMesh);
+        childNode->SetMesh(m_currentMesh.get());
         childNode->GetTransform().SetPosition({ 3.0f, 0.0f, 0.0f });
         m_childNode = m_orbitPivotNode->AddChild(std::move(childNode));
     }
 
     // Create renderer
     m_renderer = std::make_unique<Renderer>();
-    {
-        auto* d3dDevice = static_cast<D3D12Device*>(m_rhiDevice.get());
-        auto* context = static_cast<D3D12Context*>(m_rhiDevice->GetContext());
-        m_renderer->SetContext(context, d3dDevice->GetD3DDevice());
-    }
+    m_renderer->SetDevice(m_rhiDevice.get());
+    m_renderer->SetVertexFormat(VertexFormat::Compact);
 
     // Create menu
     m_menu = std::make_unique<Win32Menu>();
@@ -109,19 +135,20 @@ bool Engine::Initialize(const EngineInitParams& params)
     // Create point light
     m_pointLight = std::make_unique<PointLight>();
 
-    // Create light indicator sphere (low-poly, uploaded separately from scene meshes)
-    m_lightSphereMesh = std::make_unique<Mesh>(MeshFactory::CreateSphere(8, 8));
+    // Create light indicator sphere buffers
+    m_lightSphereMesh = m_meshLibrary->Get(LIGHT_SPHERE_DESC);
     {
-        auto* d3dDevice = static_cast<D3D12Device*>(m_rhiDevice.get());
-        auto vb = std::make_unique<D3D12Buffer>();
         uint32 vbSize = static_cast<uint32>(m_lightSphereMesh->vertices.size() * sizeof(Vertex));
-        vb->Initialize(d3dDevice->GetD3DDevice(), m_lightSphereMesh->vertices.data(), vbSize, sizeof(Vertex));
-        m_lightSphereVB = std::move(vb);
+        m_lightSphereVB = m_rhiDevice->CreateBuffer(m_lightSphereMesh->vertices.data(), vbSize, sizeof(Vertex));
 
-        auto ib = std::make_unique<D3D12Buffer>();
-        uint32 ibSize = static_cast<uint32>(m_lightSphereMesh->indices.size() * sizeof(uint32));
-        ib->Initialize(d3dDevice->GetD3DDevice(), m_lightSphereMesh->indices.data(), ibSize, sizeof(uint32));
-        m_lightSphereIB = std::move(ib);
+        // A low-poly sphere: 16-bit indices
+        std::vector<uint16> indices(m_lightSphereMesh->indices.size());
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            indices[i] = static_cast<uint16>(m_lightSphereMesh->indices[i]);
+        }
+        uint32 ibSize = static_cast<uint32>(indices.size() * sizeof(uint16));
+        m_lightSphereIB = m_rhiDevice->CreateBuffer(indices.data(), ibSize, sizeof(uint16));
     }
 
     // Set light menu callbacks
@@ -204,11 +231,10 @@ void Engine::Shutdown()
     m_orbitPivotNode = nullptr;
     m_childNode = nullptr;
     m_sceneGraph.reset();
-    m_currentMesh = nullptr;
-    m_sphereMesh.reset();
-    m_tetrahedronMesh.reset();
-    m_cubeMesh.reset();
-    m_cylinderMesh.reset();
+    m_currentMesh.reset();
+    m_meshChangePending = false;
+    m_meshLibrary.reset();      // waits for its jobs, so before the pool
+    m_threadPool.reset();
     m_lightSphereVB.reset();
     m_lightSphereIB.reset();
     m_lightSphereMesh.reset();
@@ -222,6 +248,8 @@ void Engine::Shutdown()
 
 void Engine::Update(float deltaTime)
 {
+    ApplyPendingMesh();
+
     // Animate: parent self-rotation, orbit pivot, child self-rotation (all independent speeds)
     if (m_isAnimating)
     {
@@ -278,6 +306,14 @@ void Engine::Update(float deltaTime)
         stats.aspectRatio = static_cast<float>(stats.width) / static_cast<float>(stats.height);
         stats.totalPolygons = m_sceneGraph ? m_sceneGraph->GetTotalPolygonCount() : 0;
         stats.polygonsPerSec = stats.totalPolygons * (1.0f / deltaTime);
+        if (m_renderer)
+        {
+            const CullingStats& culling = m_renderer->GetCullingStats();
+            stats.nodesTested = culling.tested;
+            stats.nodesCulled = culling.culled;
+            stats.nodesDrawn = culling.drawn;
+            stats.drawCalls = culling.drawCalls;
+        }
         stats.showLightInfo = m_showLightInfo;
         if (m_pointLight)
         {
@@ -301,7 +337,7 @@ void Engine::Render()
     if (!m_rhiDevice || !m_renderer || !m_sceneGraph)
         return;
 
-    auto* context = static_cast<D3D12Context*>(m_rhiDevice->GetContext());
+    IRHIContext* context = m_rhiDevice->GetContext();
 
     float aspectRatio = static_cast<float>(m_window->GetWidth())
         / static_cast<float>(m_window->GetHeight());
@@ -353,19 +389,32 @@ void Engine::OnViewModeChanged(uint32 width, uint32 height, bool fullscreen)
 
 void Engine::OnMeshTypeChanged(MeshType type)
 {
-    switch (type)
-    {
-    case MeshType::Sphere:      m_currentMesh = m_sphereMesh.get(); break;
-    case MeshType::Tetrahedron: m_currentMesh = m_tetrahedronMesh.get(); break;
-    case MeshType::Cube:        m_currentMesh = m_cubeMesh.get(); break;
-    case MeshType::Cylinder:    m_currentMesh = m_cylinderMesh.get(); break;
-    }
+    m_pendingMeshType = type;
+    m_meshChangePending = true;
+    ApplyPendingMesh();
+}
+
+void Engine::ApplyPendingMesh()
+{
+    if (!m_meshChangePending || !m_meshLibrary)
+        return;
+
+    // Keep drawing the current mesh until the requested one is generated
+    std::shared_ptr<const Mesh> mesh = m_meshLibrary->TryGet(GetMeshDesc(m_pendingMeshType));
+    if (!mesh)
+        return;
+    m_meshChangePending = false;
+    if (mesh == m_currentMesh)
+        return;
+    m_currentMesh = std::move(mesh);
 
     // Update both parent and child scene nodes
-    if (m_parentNode) m_parentNode->SetMesh(m_currentMesh);
-    if (m_childNode)  m_childNode->SetMesh(m_currentMesh);
+    if (m_parentNode) m_parentNode->SetMesh(m_currentMesh.get());
+    if (m_childNode)  m_childNode->SetMesh(m_currentMesh.get());
 
     // Clear Renderer mesh cache so new mesh gets uploaded on next frame
+    // (frames still in flight may reference the cached buffers)
+    if (m_rhiDevice) m_rhiDevice->GetContext()->WaitForGPU();
     if (m_renderer) m_renderer->ClearMeshCache();
 }
 
@@ -17,6 +17,8 @@ class Camera;
 class Renderer;
 class SceneGraph;
 class SceneNode;
+class ThreadPool;
+class MeshLibrary;
 enum class MeshType;
 
 struct EngineInitParams
@@ -42,12 +44,16 @@ private:
 
     void OnViewModeChanged(uint32 width, uint32 height, bool fullscreen);
     void OnMeshTypeChanged(MeshType type);
+    void ApplyPendingMesh();
     void OnAnimationToggle();
 
     std::unique_ptr<Win32Window> m_window;
     std::unique_ptr<Win32Menu> m_menu;
     std::unique_ptr<IRHIDevice> m_rhiDevice;
 
+    // Worker pool shared by CPU-heavy systems (scene update, ...)
+    std::unique_ptr<ThreadPool> m_threadPool;
+
     // Renderer & Scene Graph
     std::unique_ptr<Renderer> m_renderer;
     std::unique_ptr<SceneGraph> m_sceneGraph;
@@ -55,12 +61,11 @@ private:
     SceneNode* m_orbitPivotNode = nullptr;  // non-owning (controls child orbit speed)
     SceneNode* m_childNode = nullptr;       // non-owning
 
-    // Meshes (all 4 types pre-created)
-    std::unique_ptr<Mesh> m_sphereMesh;
-    std::unique_ptr<Mesh> m_tetrahedronMesh;
-    std::unique_ptr<Mesh> m_cubeMesh;
-    std::unique_ptr<Mesh> m_cylinderMesh;
-    Mesh* m_currentMesh = nullptr;
+    // Meshes (all 4 types requested at startup, generated on the pool)
+    std::unique_ptr<MeshLibrary> m_meshLibrary;
+    std::shared_ptr<const Mesh> m_currentMesh;
+    MeshType m_pendingMeshType{};
+    bool m_meshChangePending = false;      // shown once generated
 
     // Debug HUD
     std::unique_ptr<DebugHUD> m_debugHUD;
@@ -70,7 +75,7 @@ private:
     bool m_showLightInfo = true;
 
     // Light indicator sphere
-    std::unique_ptr<Mesh> m_lightSphereMesh;
+    std::shared_ptr<const Mesh> m_lightSphereMesh;
     std::unique_ptr<IRHIBuffer> m_lightSphereVB;
     std::unique_ptr<IRHIBuffer> m_lightSphereIB;
 
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Core/Types.h"
+#include <cstring>
+
+namespace RRE
+{
+
+// FNV-1a over 32-bit words, with the high bits folded down because the hash
+// tables index with the low bits
+inline uint64 HashWords(const uint32* words, size_t count)
+{
+    uint64 hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < count; ++i)
+    {
+        hash = (hash ^ words[i]) * 0x100000001B3ull;
+    }
+    return hash ^ (hash >> 29);
+}
+
+// Bits of WORDS consecutive floats with -0.0f folded into +0.0f, so values
+// that compare equal as floats also hash and compare equal as keys
+template <uint32 WORDS>
+struct FloatBitsKey
+{
+    uint32 words[WORDS];
+
+    explicit FloatBitsKey(const void* floats)
+    {
+        memcpy(words, floats, sizeof(words));
+        for (uint32& word : words)
+        {
+            if (word == 0x80000000u)
+                word = 0;
+        }
+    }
+
+    bool operator==(const FloatBitsKey& other) const
+    {
+        return memcmp(words, other.words, sizeof(words)) == 0;
+    }
+
+    uint64 Hash() const { return HashWords(words, WORDS); }
+};
+
+} // namespace RRE
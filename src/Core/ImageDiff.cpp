@@ -0,0 +1,133 @@
+#include "Core/ImageDiff.h"
+#include <algorithm>
+#include <cmath>
+#include <emmintrin.h>
+
+namespace RRE
+{
+
+namespace
+{
+
+// RGB -> YIQ rows and the per-component weights of the squared distance
+constexpr float Y_R = 0.29889531f, Y_G = 0.58662247f, Y_B = 0.11448223f;
+constexpr float I_R = 0.59597799f, I_G = -0.27417610f, I_B = -0.32180189f;
+constexpr float Q_R = 0.21147017f, Q_G = -0.52261711f, Q_B = 0.31114694f;
+constexpr float W_Y = 0.5053f, W_I = 0.299f, W_Q = 0.1957f;
+
+// Squared distance of black vs white (pure luma), the unit of the result
+constexpr float UNIT_DELTA_SQ = W_Y * 255.0f * 255.0f;
+
+float DeltaSq(uint32 a, uint32 b)
+{
+    float dr = static_cast<float>(a & 0xFF) - static_cast<float>(b & 0xFF);
+    float dg = static_cast<float>((a >> 8) & 0xFF) - static_cast<float>((b >> 8) & 0xFF);
+    float db = static_cast<float>((a >> 16) & 0xFF) - static_cast<float>((b >> 16) & 0xFF);
+    float y = Y_R * dr + Y_G * dg + Y_B * db;
+    float i = I_R * dr + I_G * dg + I_B * db;
+    float q = Q_R * dr + Q_G * dg + Q_B * db;
+    return W_Y * y * y + W_I * i * i + W_Q * q * q;
+}
+
+__m128 Channel(__m128i pixels, int shift)
+{
+    __m128i value = _mm_and_si128(_mm_srli_epi32(pixels, shift), _mm_set1_epi32(0xFF));
+    return _mm_cvtepi32_ps(value);
+}
+
+__m128 DeltaSq4(__m128i a, __m128i b)
+{
+    __m128 dr = _mm_sub_ps(Channel(a, 0), Channel(b, 0));
+    __m128 dg = _mm_sub_ps(Channel(a, 8), Channel(b, 8));
+    __m128 db = _mm_sub_ps(Channel(a, 16), Channel(b, 16));
+
+    auto dot = [&](float r, float g, float b) {
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(dr, _mm_set1_ps(r)), _mm_mul_ps(dg, _mm_set1_ps(g))),
+            _mm_mul_ps(db, _mm_set1_ps(b)));
+    };
+    __m128 y = dot(Y_R, Y_G, Y_B);
+    __m128 i = dot(I_R, I_G, I_B);
+    __m128 q = dot(Q_R, Q_G, Q_B);
+    return _mm_add_ps(_mm_add_ps(
+        _mm_mul_ps(_mm_mul_ps(y, y), _mm_set1_ps(W_Y)),
+        _mm_mul_ps(_mm_mul_ps(i, i), _mm_set1_ps(W_I))),
+        _mm_mul_ps(_mm_mul_ps(q, q), _mm_set1_ps(W_Q)));
+}
+
+// Reference luma blended 90% towards white, or opaque red
+uint32 DiffPixel(uint32 reference, bool different)
+{
+    if (different)
+        return 0xFF0000FFu;
+
+    float luma = Y_R * static_cast<float>(reference & 0xFF) +
+        Y_G * static_cast<float>((reference >> 8) & 0xFF) +
+        Y_B * static_cast<float>((reference >> 16) & 0xFF);
+    uint32 gray = static_cast<uint32>(255.0f + (luma - 255.0f) * 0.1f + 0.5f);
+    return gray | (gray << 8) | (gray << 16) | 0xFF000000u;
+}
+
+} // anonymous namespace
+
+ImageDiffResult ImageDiff::Compare(const uint32* a, uint32 pitchA,
+    const uint32* b, uint32 pitchB, uint32 width, uint32 height,
+    float threshold, uint32* diffImage)
+{
+    ImageDiffResult result;
+    if (!a || !b)
+        return result;
+
+    const float limit = UNIT_DELTA_SQ * threshold * threshold;
+    const __m128 limit4 = _mm_set1_ps(limit);
+    __m128 max4 = _mm_setzero_ps();
+    float maxDeltaSq = 0.0f;
+
+    for (uint32 y = 0; y < height; ++y)
+    {
+        const uint32* rowA = a + static_cast<size_t>(y) * pitchA;
+        const uint32* rowB = b + static_cast<size_t>(y) * pitchB;
+        uint32* rowDiff = diffImage ? diffImage + static_cast<size_t>(y) * width : nullptr;
+
+        uint32 x = 0;
+        for (; x + 4 <= width; x += 4)
+        {
+            __m128i pa = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rowA + x));
+            __m128i pb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rowB + x));
+            __m128 deltaSq = DeltaSq4(pa, pb);
+            max4 = _mm_max_ps(max4, deltaSq);
+
+            int mask = _mm_movemask_ps(_mm_cmpgt_ps(deltaSq, limit4));
+            result.differentPixels += (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1);
+            if (rowDiff)
+            {
+                for (uint32 k = 0; k < 4; ++k)
+                {
+                    rowDiff[x + k] = DiffPixel(rowA[x + k], (mask >> k) & 1);
+                }
+            }
+        }
+
+        for (; x < width; ++x)
+        {
+            float deltaSq = DeltaSq(rowA[x], rowB[x]);
+            maxDeltaSq = std::max(maxDeltaSq, deltaSq);
+            bool different = deltaSq > limit;
+            result.differentPixels += different ? 1 : 0;
+            if (rowDiff)
+            {
+                rowDiff[x] = DiffPixel(rowA[x], different);
+            }
+        }
+    }
+
+    float lanes[4];
+    _mm_storeu_ps(lanes, max4);
+    for (float lane : lanes)
+    {
+        maxDeltaSq = std::max(maxDeltaSq, lane);
+    }
+    result.maxDelta = std::sqrt(maxDeltaSq / UNIT_DELTA_SQ);
+    return result;
+}
+
+} // namespace RRE
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Core/Types.h"
+
+namespace RRE
+{
+
+struct ImageDiffResult
+{
+    uint32 differentPixels = 0;     // delta above the threshold
+    float maxDelta = 0.0f;          // largest per-pixel delta (1 = black vs white)
+};
+
+// Perceptual comparison of RGBA8 images (alpha ignored). The per-pixel delta
+// is the YIQ-weighted color distance used by pixelmatch, normalized so black
+// against white is 1: luma differences weigh far more than chroma, so shading
+// regressions are caught while tiny hue shifts are tolerated. Four pixels are
+// compared per SSE2 step.
+class ImageDiff
+{
+public:
+    // threshold is on the delta scale (0.1 is strict but practical).
+    // diffImage (optional, width x height tightly packed) receives a faded
+    // grayscale copy of a with differing pixels in red. Pitches are in pixels.
+    static ImageDiffResult Compare(const uint32* a, uint32 pitchA,
+        const uint32* b, uint32 pitchB, uint32 width, uint32 height,
+        float threshold, uint32* diffImage = nullptr);
+};
+
+} // namespace RRE
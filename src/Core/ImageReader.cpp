@@ -0,0 +1,84 @@
+#include "Core/ImageReader.h"
+#include <cctype>
+#include <cstdio>
+
+namespace RRE
+{
+
+namespace
+{
+
+// Next whitespace-separated header number, skipping # comments
+bool ReadHeaderValue(FILE* file, uint32& value)
+{
+    int c = std::fgetc(file);
+    while (c != EOF && (std::isspace(c) || c == '#'))
+    {
+        if (c == '#')
+        {
+            while (c != EOF && c != '\n')
+            {
+                c = std::fgetc(file);
+            }
+        }
+        c = std::fgetc(file);
+    }
+
+    if (c == EOF || !std::isdigit(c))
+        return false;
+
+    uint64 result = 0;
+    while (c != EOF && std::isdigit(c))
+    {
+        result = result * 10 + static_cast<uint64>(c - '0');
+        if (result > 0xFFFFFFFFu)
+            return false;
+        c = std::fgetc(file);
+    }
+
+    // Exactly one whitespace byte ends the header's last value
+    if (c != EOF && !std::isspace(c))
+        return false;
+
+    value = static_cast<uint32>(result);
+    return true;
+}
+
+} // anonymous namespace
+
+bool ImageReader::ReadPPM(const char* path, std::vector<uint32>& pixels,
+    uint32& width, uint32& height)
+{
+    if (!path)
+        return false;
+
+    FILE* file = std::fopen(path, "rb");
+    if (!file)
+        return false;
+
+    uint32 maxValue = 0;
+    bool ok = std::fgetc(file) == 'P' && std::fgetc(file) == '6' &&
+        ReadHeaderValue(file, width) && ReadHeaderValue(file, height) &&
+        ReadHeaderValue(file, maxValue) && maxValue == 255 &&
+        width > 0 && height > 0 && width <= 65536 && height <= 65536;
+
+    if (ok)
+    {
+        std::vector<uint8> row(static_cast<size_t>(width) * 3);
+        pixels.resize(static_cast<size_t>(width) * height);
+        for (uint32 y = 0; y < height && ok; ++y)
+        {
+            ok = std::fread(row.data(), 1, row.size(), file) == row.size();
+            uint32* dst = pixels.data() + static_cast<size_t>(y) * width;
+            for (uint32 x = 0; x < width && ok; ++x)
+            {
+                dst[x] = row[x * 3] | (row[x * 3 + 1] << 8) | (row[x * 3 + 2] << 16) | 0xFF000000u;
+            }
+        }
+    }
+
+    std::fclose(file);
+    return ok;
+}
+
+} // namespace RRE
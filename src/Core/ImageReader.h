@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Core/Types.h"
+#include <vector>
+
+namespace RRE
+{
+
+// Loads images written by ImageWriter. Pixels come back tightly packed as
+// R | G << 8 | B << 16 | A << 24.
+class ImageReader
+{
+public:
+    // Binary PPM (P6, maxval 255); alpha is set to 255
+    static bool ReadPPM(const char* path, std::vector<uint32>& pixels,
+        uint32& width, uint32& height);
+};
+
+} // namespace RRE
@@ -0,0 +1,178 @@
+#include "Core/ImageWriter.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace RRE
+{
+
+namespace
+{
+
+struct CrcTable
+{
+    uint32 values[256];
+
+    CrcTable()
+    {
+        for (uint32 n = 0; n < 256; ++n)
+        {
+            uint32 c = n;
+            for (int k = 0; k < 8; ++k)
+            {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            values[n] = c;
+        }
+    }
+};
+
+uint32 Crc32(const uint8* data, size_t size, uint32 crc = 0)
+{
+    static const CrcTable table;
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i)
+    {
+        crc = table.values[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void AppendBigEndian(std::vector<uint8>& out, uint32 value)
+{
+    out.push_back(static_cast<uint8>(value >> 24));
+    out.push_back(static_cast<uint8>(value >> 16));
+    out.push_back(static_cast<uint8>(value >> 8));
+    out.push_back(static_cast<uint8>(value));
+}
+
+// Length, type, data, CRC of type + data
+bool WriteChunk(FILE* file, const char* type, const std::vector<uint8>& data)
+{
+    std::vector<uint8> header;
+    AppendBigEndian(header, static_cast<uint32>(data.size()));
+    header.insert(header.end(), type, type + 4);
+
+    uint32 crc = Crc32(header.data() + 4, 4);
+    crc = Crc32(data.data(), data.size(), crc);
+    std::vector<uint8> footer;
+    AppendBigEndian(footer, crc);
+
+    return std::fwrite(header.data(), 1, header.size(), file) == header.size() &&
+        std::fwrite(data.data(), 1, data.size(), file) == data.size() &&
+        std::fwrite(footer.data(), 1, footer.size(), file) == footer.size();
+}
+
+} // anonymous namespace
+
+bool ImageWriter::WritePPM(const char* path, const uint32* pixels,
+    uint32 width, uint32 height, uint32 pitch)
+{
+    if (!path || !pixels || width == 0 || height == 0)
+        return false;
+
+    FILE* file = std::fopen(path, "wb");
+    if (!file)
+        return false;
+
+    std::fprintf(file, "P6\n%u %u\n255\n", width, height);
+
+    std::vector<uint8> row(width * 3);
+    bool ok = true;
+    for (uint32 y = 0; y < height && ok; ++y)
+    {
+        const uint32* src = pixels + static_cast<size_t>(y) * pitch;
+        for (uint32 x = 0; x < width; ++x)
+        {
+            row[x * 3 + 0] = static_cast<uint8>(src[x]);
+            row[x * 3 + 1] = static_cast<uint8>(src[x] >> 8);
+            row[x * 3 + 2] = static_cast<uint8>(src[x] >> 16);
+        }
+        ok = std::fwrite(row.data(), 1, row.size(), file) == row.size();
+    }
+
+    ok = std::fclose(file) == 0 && ok;
+    return ok;
+}
+
+bool ImageWriter::WritePNG(const char* path, const uint32* pixels,
+    uint32 width, uint32 height, uint32 pitch)
+{
+    if (!path || !pixels || width == 0 || height == 0)
+        return false;
+
+    // Raw scanlines: filter type 0 followed by RGBA bytes
+    size_t rowBytes = static_cast<size_t>(width) * 4 + 1;
+    std::vector<uint8> raw(rowBytes * height);
+    for (uint32 y = 0; y < height; ++y)
+    {
+        const uint32* src = pixels + static_cast<size_t>(y) * pitch;
+        uint8* dst = raw.data() + y * rowBytes;
+        dst[0] = 0;
+        for (uint32 x = 0; x < width; ++x)
+        {
+            dst[1 + x * 4 + 0] = static_cast<uint8>(src[x]);
+            dst[1 + x * 4 + 1] = static_cast<uint8>(src[x] >> 8);
+            dst[1 + x * 4 + 2] = static_cast<uint8>(src[x] >> 16);
+            dst[1 + x * 4 + 3] = static_cast<uint8>(src[x] >> 24);
+        }
+    }
+
+    // zlib stream of stored deflate blocks (at most 65535 bytes each)
+    const size_t MAX_BLOCK = 65535;
+    std::vector<uint8> idat;
+    idat.reserve(raw.size() + (raw.size() / MAX_BLOCK + 1) * 5 + 6);
+    idat.push_back(0x78);
+    idat.push_back(0x01);
+    for (size_t offset = 0; offset < raw.size(); offset += MAX_BLOCK)
+    {
+        size_t length = std::min(MAX_BLOCK, raw.size() - offset);
+        idat.push_back(offset + length == raw.size() ? 1 : 0);
+        idat.push_back(static_cast<uint8>(length));
+        idat.push_back(static_cast<uint8>(length >> 8));
+        idat.push_back(static_cast<uint8>(~length));
+        idat.push_back(static_cast<uint8>(~length >> 8));
+        idat.insert(idat.end(), raw.begin() + offset, raw.begin() + offset + length);
+    }
+
+    // Adler-32 of the uncompressed data
+    uint32 a = 1;
+    uint32 b = 0;
+    for (size_t offset = 0; offset < raw.size(); offset += 5552)
+    {
+        size_t end = std::min(raw.size(), offset + 5552);
+        for (size_t i = offset; i < end; ++i)
+        {
+            a += raw[i];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    AppendBigEndian(idat, (b << 16) | a);
+
+    std::vector<uint8> ihdr;
+    AppendBigEndian(ihdr, width);
+    AppendBigEndian(ihdr, height);
+    ihdr.push_back(8);  // bit depth
+    ihdr.push_back(6);  // color type RGBA
+    ihdr.push_back(0);  // deflate
+    ihdr.push_back(0);  // adaptive filtering
+    ihdr.push_back(0);  // no interlace
+
+    FILE* file = std::fopen(path, "wb");
+    if (!file)
+        return false;
+
+    static const uint8 signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    bool ok = std::fwrite(signature, 1, sizeof(signature), file) == sizeof(signature) &&
+        WriteChunk(file, "IHDR", ihdr) &&
+        WriteChunk(file, "IDAT", idat) &&
+        WriteChunk(file, "IEND", std::vector<uint8>());
+
+    ok = std::fclose(file) == 0 && ok;
+    return ok;
+}
+
+} // namespace RRE
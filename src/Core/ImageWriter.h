@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Core/Types.h"
+
+namespace RRE
+{
+
+// Writes CPU images to disk. Pixels are RGBA8 packed as
+// R | G << 8 | B << 16 | A << 24; pitch is in pixels.
+class ImageWriter
+{
+public:
+    // Binary PPM (P6); alpha is dropped
+    static bool WritePPM(const char* path, const uint32* pixels,
+        uint32 width, uint32 height, uint32 pitch);
+
+    // 8-bit RGBA PNG. Scanlines are stored unfiltered in uncompressed
+    // deflate blocks: no zlib dependency, fast to write, about raw size.
+    static bool WritePNG(const char* path, const uint32* pixels,
+        uint32 width, uint32 height, uint32 pitch);
+};
+
+} // namespace RRE
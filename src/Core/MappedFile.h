@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Core/Types.h"
+
+namespace RRE
+{
+
+// Read-only memory mapping of a whole file. Pages are faulted in on first
+// touch, so opening costs no reads; the view stays valid until Close.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Maps path, closing any previous mapping. Empty files fail.
+    bool Open(const char* path);
+    void Close();
+
+    bool IsOpen() const { return m_data != nullptr; }
+    const uint8* GetData() const { return m_data; }    // page aligned
+    uint64 GetSize() const { return m_size; }
+
+private:
+    const uint8* m_data = nullptr;
+    uint64 m_size = 0;
+};
+
+} // namespace RRE
@@ -0,0 +1,126 @@
+#include "Core/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace RRE
+{
+
+ThreadPool::ThreadPool(uint32 threadCount)
+{
+    if (threadCount == 0)
+    {
+        uint32 hardwareThreads = std::thread::hardware_concurrency();
+        threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    m_workers.reserve(threadCount);
+    for (uint32 i = 0; i < threadCount; ++i)
+    {
+        m_workers.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_jobAvailable.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::Submit(std::function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(std::move(job));
+    }
+    m_jobAvailable.notify_one();
+}
+
+void ThreadPool::ParallelFor(uint32 count, uint32 grain,
+    const std::function<void(uint32 begin, uint32 end)>& fn)
+{
+    if (count == 0)
+        return;
+
+    grain = std::max(grain, 1u);
+    uint32 chunkCount = (count + grain - 1) / grain;
+
+    if (chunkCount == 1 || m_workers.empty())
+    {
+        fn(0, count);
+        return;
+    }
+
+    // Shared so helpers that start after the loop finished never touch a dead frame
+    struct SharedState
+    {
+        std::atomic<uint32> nextChunk{ 0 };
+        std::atomic<uint32> doneChunks{ 0 };
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto state = std::make_shared<SharedState>();
+    const auto* body = &fn;
+
+    auto runChunks = [state, body, count, grain, chunkCount]()
+    {
+        for (;;)
+        {
+            uint32 chunk = state->nextChunk.fetch_add(1);
+            if (chunk >= chunkCount)
+                return;
+
+            uint32 begin = chunk * grain;
+            uint32 end = std::min(begin + grain, count);
+            (*body)(begin, end);
+
+            if (state->doneChunks.fetch_add(1) + 1 == chunkCount)
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->finished.notify_all();
+            }
+        }
+    };
+
+    uint32 helperCount = std::min(chunkCount - 1, GetWorkerCount());
+    for (uint32 i = 0; i < helperCount; ++i)
+    {
+        Submit(runChunks);
+    }
+
+    // The caller works too, so nested ParallelFor calls cannot starve
+    runChunks();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&state, chunkCount]() {
+        return state->doneChunks.load() == chunkCount;
+    });
+}
+
+void ThreadPool::WorkerLoop()
+{
+    for (;;)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobAvailable.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+            if (m_stopping && m_jobs.empty())
+                return;
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        job();
+    }
+}
+
+} // namespace RRE
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Core/Types.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RRE
+{
+
+// Fixed-size worker pool shared by CPU-heavy engine systems
+class ThreadPool
+{
+public:
+    // threadCount == 0 uses (hardware threads - 1) workers; the calling
+    // thread also participates in ParallelFor
+    explicit ThreadPool(uint32 threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    uint32 GetWorkerCount() const { return static_cast<uint32>(m_workers.size()); }
+
+    // Queue a fire-and-forget job
+    void Submit(std::function<void()> job);
+
+    // Split [0, count) into chunks of at most `grain` items and run
+    // fn(begin, end) on the workers and the calling thread. Blocks until done.
+    void ParallelFor(uint32 count, uint32 grain,
+        const std::function<void(uint32 begin, uint32 end)>& fn);
+
+private:
+    void WorkerLoop();
+
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_jobs;
+    std::mutex m_mutex;
+    std::condition_variable m_jobAvailable;
+    bool m_stopping = false;
+};
+
+} // namespace RRE
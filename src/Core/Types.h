@@ -9,6 +9,7 @@ namespace RRE
     using uint16 = std::uint16_t;
     using uint32 = std::uint32_t;
     using uint64 = std::uint64_t;
+    using int16  = std::int16_t;
     using int32  = std::int32_t;
     using int64  = std::int64_t;
 
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <cmath>
+#include <cfloat>
+
+namespace RRE
+{
+namespace Math
+{
+
+using namespace DirectX;
+
+// Axis-aligned bounding box (min/max corners)
+struct AABB
+{
+    XMFLOAT3 min = { FLT_MAX, FLT_MAX, FLT_MAX };
+    XMFLOAT3 max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    bool IsValid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+
+    XMFLOAT3 GetCenter() const
+    {
+        return { (min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f };
+    }
+
+    XMFLOAT3 GetExtents() const
+    {
+        return { (max.x - min.x) * 0.5f, (max.y - min.y) * 0.5f, (max.z - min.z) * 0.5f };
+    }
+
+    void Expand(const XMFLOAT3& p)
+    {
+        min = { std::fminf(min.x, p.x), std::fminf(min.y, p.y), std::fminf(min.z, p.z) };
+        max = { std::fmaxf(max.x, p.x), std::fmaxf(max.y, p.y), std::fmaxf(max.z, p.z) };
+    }
+};
+
+struct BoundingSphere
+{
+    XMFLOAT3 center = { 0.0f, 0.0f, 0.0f };
+    float radius = -1.0f;   // negative = empty
+
+    bool IsValid() const { return radius >= 0.0f; }
+};
+
+inline AABB Union(const AABB& a, const AABB& b)
+{
+    AABB result;
+    result.min = { std::fminf(a.min.x, b.min.x), std::fminf(a.min.y, b.min.y), std::fminf(a.min.z, b.min.z) };
+    result.max = { std::fmaxf(a.max.x, b.max.x), std::fmaxf(a.max.y, b.max.y), std::fmaxf(a.max.z, b.max.z) };
+    return result;
+}
+
+// Half the surface area; used as the insertion cost for BVH building
+inline float HalfSurfaceArea(const AABB& box)
+{
+    float dx = box.max.x - box.min.x;
+    float dy = box.max.y - box.min.y;
+    float dz = box.max.z - box.min.z;
+    return dx * dy + dy * dz + dz * dx;
+}
+
+inline bool Contains(const AABB& outer, const AABB& inner)
+{
+    return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z
+        && outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+}
+
+inline bool Overlaps(const AABB& a, const AABB& b)
+{
+    return a.min.x <= b.max.x && a.max.x >= b.min.x
+        && a.min.y <= b.max.y && a.max.y >= b.min.y
+        && a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+inline bool SphereOverlapsAABB(const XMFLOAT3& center, float radius, const AABB& box)
+{
+    float dx = std::fmaxf(std::fmaxf(box.min.x - center.x, 0.0f), center.x - box.max.x);
+    float dy = std::fmaxf(std::fmaxf(box.min.y - center.y, 0.0f), center.y - box.max.y);
+    float dz = std::fmaxf(std::fmaxf(box.min.z - center.z, 0.0f), center.z - box.max.z);
+    return dx * dx + dy * dy + dz * dz <= radius * radius;
+}
+
+// Slab test. invDir is 1/direction per axis (infinities are fine).
+// On hit, tEnter is the entry distance clamped to 0 (origin inside = 0).
+inline bool RayIntersectsAABB(const XMFLOAT3& origin, const XMFLOAT3& invDir, float maxT,
+    const AABB& box, float& tEnter)
+{
+    float tx1 = (box.min.x - origin.x) * invDir.x;
+    float tx2 = (box.max.x - origin.x) * invDir.x;
+    float ty1 = (box.min.y - origin.y) * invDir.y;
+    float ty2 = (box.max.y - origin.y) * invDir.y;
+    float tz1 = (box.min.z - origin.z) * invDir.z;
+    float tz2 = (box.max.z - origin.z) * invDir.z;
+
+    float tmin = std::fmaxf(std::fmaxf(std::fminf(tx1, tx2), std::fminf(ty1, ty2)), std::fminf(tz1, tz2));
+    float tmax = std::fminf(std::fminf(std::fmaxf(tx1, tx2), std::fmaxf(ty1, ty2)), std::fmaxf(tz1, tz2));
+
+    tmin = std::fmaxf(tmin, 0.0f);
+    if (tmax < tmin || tmin > maxT)
+        return false;
+
+    tEnter = tmin;
+    return true;
+}
+
+// World-space AABB of a transformed box (Arvo): center moves with the
+// matrix, extents are projected onto the absolute basis vectors
+inline AABB TransformAABB(const AABB& box, FXMMATRIX m)
+{
+    XMFLOAT3 c = box.GetCenter();
+    XMFLOAT3 e = box.GetExtents();
+
+    XMVECTOR center = XMVector3TransformCoord(XMLoadFloat3(&c), m);
+    XMVECTOR extents = XMVectorMultiply(XMVectorAbs(m.r[0]), XMVectorReplicate(e.x));
+    extents = XMVectorMultiplyAdd(XMVectorAbs(m.r[1]), XMVectorReplicate(e.y), extents);
+    extents = XMVectorMultiplyAdd(XMVectorAbs(m.r[2]), XMVectorReplicate(e.z), extents);
+
+    AABB result;
+    XMStoreFloat3(&result.min, XMVectorSubtract(center, extents));
+    XMStoreFloat3(&result.max, XMVectorAdd(center, extents));
+    return result;
+}
+
+// World-space sphere: radius grows by the largest axis scale
+inline BoundingSphere TransformSphere(const BoundingSphere& sphere, FXMMATRIX m)
+{
+    float sx = XMVectorGetX(XMVector3LengthSq(m.r[0]));
+    float sy = XMVectorGetX(XMVector3LengthSq(m.r[1]));
+    float sz = XMVectorGetX(XMVector3LengthSq(m.r[2]));
+    float maxScale = std::sqrt(std::fmaxf(sx, std::fmaxf(sy, sz)));
+
+    BoundingSphere result;
+    XMStoreFloat3(&result.center, XMVector3TransformCoord(XMLoadFloat3(&sphere.center), m));
+    result.radius = sphere.radius * maxScale;
+    return result;
+}
+
+} // namespace Math
+} // namespace RRE
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "Math/Bounds.h"
+#include <DirectXMath.h>
+
+namespace RRE
+{
+namespace Math
+{
+
+using namespace DirectX;
+
+// Six clip planes in SoA layout (two 4-wide groups, the last two lanes
+// duplicate the far plane) so one sphere/box is tested against all planes
+// with a handful of vector ops. Plane normals point inward.
+class Frustum
+{
+public:
+    Frustum() = default;
+
+    // Extract planes from a row-vector view * projection matrix
+    // (Gribb/Hartmann, D3D clip space with 0 <= z <= w)
+    static Frustum FromViewProjection(FXMMATRIX viewProj)
+    {
+        XMFLOAT4X4 m;
+        XMStoreFloat4x4(&m, viewProj);
+
+        XMVECTOR col0 = XMVectorSet(m._11, m._21, m._31, m._41);
+        XMVECTOR col1 = XMVectorSet(m._12, m._22, m._32, m._42);
+        XMVECTOR col2 = XMVectorSet(m._13, m._23, m._33, m._43);
+        XMVECTOR col3 = XMVectorSet(m._14, m._24, m._34, m._44);
+
+        XMVECTOR planes[PLANE_COUNT] =
+        {
+            XMVectorAdd(col3, col0),        // left
+            XMVectorSubtract(col3, col0),   // right
+            XMVectorAdd(col3, col1),        // bottom
+            XMVectorSubtract(col3, col1),   // top
+            col2,                           // near
+            XMVectorSubtract(col3, col2),   // far
+        };
+
+        Frustum frustum;
+        float* dst[4] = { frustum.m_x, frustum.m_y, frustum.m_z, frustum.m_w };
+        for (int i = 0; i < LANE_COUNT; ++i)
+        {
+            XMFLOAT4 p;
+            XMStoreFloat4(&p, XMPlaneNormalize(planes[i < PLANE_COUNT ? i : PLANE_COUNT - 1]));
+            dst[0][i] = p.x;
+            dst[1][i] = p.y;
+            dst[2][i] = p.z;
+            dst[3][i] = p.w;
+        }
+        return frustum;
+    }
+
+    // Normalized plane i (xyz = inward normal, w = offset)
+    XMFLOAT4 GetPlane(int i) const { return { m_x[i], m_y[i], m_z[i], m_w[i] }; }
+
+    // True unless the sphere lies fully outside some plane
+    bool IntersectsSphere(const BoundingSphere& sphere) const
+    {
+        XMVECTOR cx = XMVectorReplicate(sphere.center.x);
+        XMVECTOR cy = XMVectorReplicate(sphere.center.y);
+        XMVECTOR cz = XMVectorReplicate(sphere.center.z);
+        XMVECTOR negRadius = XMVectorReplicate(-sphere.radius);
+
+        for (int g = 0; g < LANE_COUNT; g += 4)
+        {
+            XMVECTOR dist = XMVectorMultiplyAdd(XMLoadFloat4A(Lanes(m_x, g)), cx, XMLoadFloat4A(Lanes(m_w, g)));
+            dist = XMVectorMultiplyAdd(XMLoadFloat4A(Lanes(m_y, g)), cy, dist);
+            dist = XMVectorMultiplyAdd(XMLoadFloat4A(Lanes(m_z, g)), cz, dist);
+            if (!XMVector4GreaterOrEqual(dist, negRadius))
+                return false;
+        }
+        return true;
+    }
+
+    // True unless the box lies fully outside some plane
+    // (tests the corner furthest along each plane normal)
+    bool IntersectsAABB(const AABB& box) const
+    {
+        XMFLOAT3 c = box.GetCenter();
+        XMFLOAT3 e = box.GetExtents();
+        XMVECTOR cx = XMVectorReplicate(c.x);
+        XMVECTOR cy = XMVectorReplicate(c.y);
+        XMVECTOR cz = XMVectorReplicate(c.z);
+        XMVECTOR ex = XMVectorReplicate(e.x);
+        XMVECTOR ey = XMVectorReplicate(e.y);
+        XMVECTOR ez = XMVectorReplicate(e.z);
+
+        for (int g = 0; g < LANE_COUNT; g += 4)
+        {
+            XMVECTOR nx = XMLoadFloat4A(Lanes(m_x, g));
+            XMVECTOR ny = XMLoadFloat4A(Lanes(m_y, g));
+            XMVECTOR nz = XMLoadFloat4A(Lanes(m_z, g));
+
+            XMVECTOR dist = XMVectorMultiplyAdd(nx, cx, XMLoadFloat4A(Lanes(m_w, g)));
+            dist = XMVectorMultiplyAdd(ny, cy, dist);
+            dist = XMVectorMultiplyAdd(nz, cz, dist);
+
+            XMVECTOR radius = XMVectorMultiply(XMVectorAbs(nx), ex);
+            radius = XMVectorMultiplyAdd(XMVectorAbs(ny), ey, radius);
+            radius = XMVectorMultiplyAdd(XMVectorAbs(nz), ez, radius);
+
+            if (!XMVector4GreaterOrEqual(XMVectorAdd(dist, radius), XMVectorZero()))
+                return false;
+        }
+        return true;
+    }
+
+    static constexpr int PLANE_COUNT = 6;
+
+private:
+    static constexpr int LANE_COUNT = 8;
+
+    static const XMFLOAT4A* Lanes(const float* stream, int group)
+    {
+        return reinterpret_cast<const XMFLOAT4A*>(stream + group);
+    }
+
+    alignas(16) float m_x[LANE_COUNT] = {};
+    alignas(16) float m_y[LANE_COUNT] = {};
+    alignas(16) float m_z[LANE_COUNT] = {};
+    alignas(16) float m_w[LANE_COUNT] = {};
+};
+
+} // namespace Math
+} // namespace RRE
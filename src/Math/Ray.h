@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Math/Bounds.h"
+#include "Core/Types.h"
+#include <DirectXMath.h>
+
+namespace RRE
+{
+namespace Math
+{
+
+using namespace DirectX;
+
+// Up to four rays in SoA layout (one lane per ray) for SIMD box and
+// triangle tests. Unused lanes should be given a negative tMax.
+struct RayPacket4
+{
+    XMVECTOR ox, oy, oz;        // origins
+    XMVECTOR dx, dy, dz;        // directions
+    XMVECTOR idx, idy, idz;     // 1 / direction
+
+    static RayPacket4 Load(const XMFLOAT3* origins, const XMFLOAT3* directions, uint32 count)
+    {
+        alignas(16) float o[3][4];
+        alignas(16) float d[3][4];
+        for (uint32 i = 0; i < 4; ++i)
+        {
+            // Unused lanes repeat the first ray (their tMax masks them out)
+            uint32 src = i < count ? i : 0;
+            o[0][i] = origins[src].x;
+            o[1][i] = origins[src].y;
+            o[2][i] = origins[src].z;
+            d[0][i] = directions[src].x;
+            d[1][i] = directions[src].y;
+            d[2][i] = directions[src].z;
+        }
+
+        RayPacket4 packet;
+        packet.ox = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(o[0]));
+        packet.oy = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(o[1]));
+        packet.oz = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(o[2]));
+        packet.dx = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(d[0]));
+        packet.dy = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(d[1]));
+        packet.dz = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(d[2]));
+        packet.idx = XMVectorReciprocal(packet.dx);
+        packet.idy = XMVectorReciprocal(packet.dy);
+        packet.idz = XMVectorReciprocal(packet.dz);
+        return packet;
+    }
+
+    // Lane mask of rays that enter the box before their tMax
+    XMVECTOR IntersectAABB(const AABB& box, FXMVECTOR tMax) const
+    {
+        XMVECTOR tx1 = XMVectorMultiply(XMVectorSubtract(XMVectorReplicate(box.min.x), ox), idx);
+        XMVECTOR tx2 = XMVectorMultiply(XMVectorSubtract(XMVectorReplicate(box.max.x), ox), idx);
+        XMVECTOR ty1 = XMVectorMultiply(XMVectorSubtract(XMVectorReplicate(box.min.y), oy), idy);
+        XMVECTOR ty2 = XMVectorMultiply(XMVectorSubtract(XMVectorReplicate(box.max.y), oy), idy);
+        XMVECTOR tz1 = XMVectorMultiply(XMVectorSubtract(XMVectorReplicate(box.min.z), oz), idz);
+        XMVECTOR tz2 = XMVectorMultiply(XMVectorSubtract(XMVectorReplicate(box.max.z), oz), idz);
+
+        XMVECTOR tmin = XMVectorMax(XMVectorMax(XMVectorMin(tx1, tx2), XMVectorMin(ty1, ty2)), XMVectorMin(tz1, tz2));
+        XMVECTOR tmax = XMVectorMin(XMVectorMin(XMVectorMax(tx1, tx2), XMVectorMax(ty1, ty2)), XMVectorMax(tz1, tz2));
+        tmin = XMVectorMax(tmin, XMVectorZero());
+
+        return XMVectorAndInt(XMVectorLessOrEqual(tmin, tmax), XMVectorLessOrEqual(tmin, tMax));
+    }
+};
+
+inline bool AnyLane(FXMVECTOR mask)
+{
+    return !XMVector4EqualInt(mask, XMVectorFalseInt());
+}
+
+} // namespace Math
+} // namespace RRE
@@ -83,7 +83,7 @@ D3D12_INDEX_BUFFER_VIEW D3D12Buffer::GetIndexBufferView() const
     D3D12_INDEX_BUFFER_VIEW view = {};
     view.BufferLocation = m_resource->GetGPUVirtualAddress();
     view.SizeInBytes = m_size;
-    view.Format = DXGI_FORMAT_R32_UINT;
+    view.Format = GetIndexFormat() == IndexFormat::UInt16 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
     return view;
 }
 
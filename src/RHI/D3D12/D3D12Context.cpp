@@ -1,6 +1,7 @@
 #include "RHI/D3D12/D3D12Context.h"
 #include "RHI/D3D12/D3D12SwapChain.h"
 #include "RHI/D3D12/D3D12Buffer.h"
+#include "RHI/D3D12/D3D12Texture.h"
 #include <cstring>
 
 #pragma comment(lib, "d3d11.lib")
@@ -10,7 +11,7 @@
 namespace RRE
 {
 
-bool D3D12Context::Initialize(ID3D12Device* device)
+bool D3D12Context::Initialize(ID3D12Device* device, uint32 framesInFlight)
 {
     m_device = device;
 
@@ -23,15 +24,18 @@ bool D3D12Context::Initialize(ID3D12Device* device)
     if (FAILED(hr))
         return false;
 
-    // Create command allocator
-    hr = device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT,
-        IID_PPV_ARGS(&m_commandAllocator));
-    if (FAILED(hr))
-        return false;
+    // Create one command allocator per frame slot
+    for (auto& allocator : m_commandAllocators)
+    {
+        hr = device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT,
+            IID_PPV_ARGS(&allocator));
+        if (FAILED(hr))
+            return false;
+    }
 
     // Create command list
     hr = device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT,
-        m_commandAllocator.Get(), nullptr, IID_PPV_ARGS(&m_commandList));
+        m_commandAllocators[0].Get(), nullptr, IID_PPV_ARGS(&m_commandList));
     if (FAILED(hr))
         return false;
 
@@ -43,7 +47,7 @@ bool D3D12Context::Initialize(ID3D12Device* device)
     if (FAILED(hr))
         return false;
 
-    m_fenceValue = 0;
+    m_frameRing.Reset(framesInFlight);
     m_fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
     if (!m_fenceEvent)
         return false;
@@ -57,9 +61,9 @@ bool D3D12Context::Initialize(ID3D12Device* device)
     // Initialize DSV heap
     m_dsvHeap.Initialize(device, D3D12_DESCRIPTOR_HEAP_TYPE_DSV, 1);
 
-    // Initialize CBV heap and constant buffer
-    if (!CreateConstantBuffer())
-        return false;
+    // Upload pages for per-draw constants and instance data
+    m_uploadPages.Initialize(device);
+    m_frameAllocator.SetPageSource(&m_uploadPages);
 
     // Initialize view-projection to identity
     DirectX::XMStoreFloat4x4(&m_viewProjection, DirectX::XMMatrixIdentity());
@@ -67,61 +71,6 @@ bool D3D12Context::Initialize(ID3D12Device* device)
     return true;
 }
 
-bool D3D12Context::CreateConstantBuffer()
-{
-    // Create CBV_SRV_UAV descriptor heap (shader-visible, one descriptor per draw call)
-    if (!m_cbvHeap.Initialize(m_device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, MAX_DRAW_CALLS, true))
-        return false;
-
-    // Constant buffer size must be 256-byte aligned (per slot)
-    m_cbAlignedSize = (sizeof(PerObjectConstants) + 255) & ~255;
-    UINT totalSize = m_cbAlignedSize * MAX_DRAW_CALLS;
-
-    // Create upload heap buffer
-    D3D12_HEAP_PROPERTIES heapProps = {};
-    heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
-
-    D3D12_RESOURCE_DESC bufferDesc = {};
-    bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-    bufferDesc.Width = totalSize;
-    bufferDesc.Height = 1;
-    bufferDesc.DepthOrArraySize = 1;
-    bufferDesc.MipLevels = 1;
-    bufferDesc.SampleDesc.Count = 1;
-    bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-
-    HRESULT hr = m_device->CreateCommittedResource(
-        &heapProps,
-        D3D12_HEAP_FLAG_NONE,
-        &bufferDesc,
-        D3D12_RESOURCE_STATE_GENERIC_READ,
-        nullptr,
-        IID_PPV_ARGS(&m_constantBuffer));
-    if (FAILED(hr))
-        return false;
-
-    // Create one CBV descriptor per draw call slot
-    D3D12_GPU_VIRTUAL_ADDRESS gpuBase = m_constantBuffer->GetGPUVirtualAddress();
-    for (uint32 i = 0; i < MAX_DRAW_CALLS; ++i)
-    {
-        D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
-        cbvDesc.BufferLocation = gpuBase + i * m_cbAlignedSize;
-        cbvDesc.SizeInBytes = m_cbAlignedSize;
-        D3D12_CPU_DESCRIPTOR_HANDLE cbvHandle = m_cbvHeap.Allocate();
-        m_device->CreateConstantBufferView(&cbvDesc, cbvHandle);
-    }
-
-    // Cache CBV descriptor increment size for DrawPrimitives
-    m_cbvDescriptorSize = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-
-    // Keep the buffer persistently mapped
-    hr = m_constantBuffer->Map(0, nullptr, reinterpret_cast<void**>(&m_cbData));
-    if (FAILED(hr))
-        return false;
-
-    return true;
-}
-
 bool D3D12Context::InitializeD2D(ID3D12Device* device, ID3D12CommandQueue* commandQueue,
     D3D12SwapChain* swapChain)
 {
@@ -325,15 +274,12 @@ void D3D12Context::Shutdown()
 
     ShutdownD2D();
 
-    // Unmap constant buffer
-    if (m_constantBuffer && m_cbData)
-    {
-        m_constantBuffer->Unmap(0, nullptr);
-        m_cbData = nullptr;
-    }
+    // Release upload pages and readback buffers (GPU is idle after WaitForGPU)
+    m_frameAllocator.Release();
+    m_readbacks.clear();
+    m_renderTarget = nullptr;
 
     m_pipelineState.Shutdown();
-    m_constantBuffer.Reset();
     m_depthBuffer.Reset();
 
     if (m_fenceEvent)
@@ -343,26 +289,44 @@ void D3D12Context::Shutdown()
     }
 
     m_commandList.Reset();
-    m_commandAllocator.Reset();
+    for (auto& allocator : m_commandAllocators)
+    {
+        allocator.Reset();
+    }
     m_fence.Reset();
     m_commandQueue.Reset();
 }
 
 void D3D12Context::BeginFrame()
 {
-    m_commandAllocator->Reset();
-    m_commandList->Reset(m_commandAllocator.Get(), nullptr);
-    m_drawCallIndex = 0;
+    // Wait only for the frame that last used this slot, not the previous one
+    WaitForFenceValue(m_frameRing.GetWaitValue());
+
+    ID3D12CommandAllocator* allocator = m_commandAllocators[m_frameRing.GetFrameIndex()].Get();
+    allocator->Reset();
+    m_commandList->Reset(allocator, nullptr);
+
+    // Pages from frames the GPU has finished become reusable
+    m_frameAllocator.Recycle(m_fence->GetCompletedValue());
+
+    m_renderTarget = nullptr;
+    m_backBufferBound = false;
 }
 
 void D3D12Context::EndFrame()
 {
+    // Text is drawn over the back buffer only; a frame that rendered purely
+    // offscreen leaves the back buffer alone and is not presented
+    if (!m_backBufferBound)
+    {
+        m_textCommands.clear();
+    }
     bool hasTextCommands = m_d2dInitialized && !m_textCommands.empty();
 
     if (!hasTextCommands)
     {
         // No text: use standard barrier path
-        if (m_swapChain)
+        if (m_swapChain && m_backBufferBound)
         {
             ID3D12Resource* backBuffer = m_swapChain->GetCurrentBackBuffer();
             D3D12_RESOURCE_BARRIER barrier = {};
@@ -390,41 +354,76 @@ void D3D12Context::EndFrame()
     }
 
     // Present
-    if (m_swapChain)
+    if (m_swapChain && m_backBufferBound)
     {
         m_swapChain->Present(1);
     }
 
-    // Wait for GPU
-    WaitForGPU();
+    // Signal the end of this frame and move on without waiting; the slot's
+    // allocator and upload pages are reused once the fence passes this value
+    uint64 fenceValue = m_frameRing.NextFenceValue();
+    m_commandQueue->Signal(m_fence.Get(), fenceValue);
+    m_frameAllocator.FinishFrame(fenceValue);
+    m_frameRing.EndFrame(fenceValue);
+
+    // Readbacks recorded this frame land when the fence passes the same value
+    for (Readback& readback : m_readbacks)
+    {
+        if (readback.ticket != 0 && readback.fenceValue == 0)
+        {
+            readback.fenceValue = fenceValue;
+        }
+    }
 }
 
 void D3D12Context::Clear(const DirectX::XMFLOAT4& color)
 {
-    if (!m_swapChain)
+    const float clearColor[] = { color.x, color.y, color.z, color.w };
+
+    // Offscreen target: its views were bound by SetRenderTarget
+    if (m_renderTarget)
+    {
+        m_commandList->ClearRenderTargetView(m_renderTarget->GetRTV(), clearColor, 0, nullptr);
+        m_commandList->ClearDepthStencilView(m_renderTarget->GetDSV(), D3D12_CLEAR_FLAG_DEPTH,
+            1.0f, 0, 0, nullptr);
         return;
+    }
 
-    ID3D12Resource* backBuffer = m_swapChain->GetCurrentBackBuffer();
-    D3D12_CPU_DESCRIPTOR_HANDLE rtv = m_swapChain->GetCurrentRTV();
+    if (!m_swapChain)
+        return;
 
-    // Transition back buffer: PRESENT -> RENDER_TARGET
-    D3D12_RESOURCE_BARRIER barrier = {};
-    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Transition.pResource = backBuffer;
-    barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_PRESENT;
-    barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    m_commandList->ResourceBarrier(1, &barrier);
+    BindBackBuffer();
 
     // Clear render target
-    const float clearColor[] = { color.x, color.y, color.z, color.w };
-    m_commandList->ClearRenderTargetView(rtv, clearColor, 0, nullptr);
+    m_commandList->ClearRenderTargetView(m_swapChain->GetCurrentRTV(), clearColor, 0, nullptr);
 
     // Clear depth buffer if it exists
     if (m_depthBuffer)
+    {
+        m_commandList->ClearDepthStencilView(m_dsvHeap.GetCPUStart(), D3D12_CLEAR_FLAG_DEPTH,
+            1.0f, 0, 0, nullptr);
+    }
+}
+
+void D3D12Context::BindBackBuffer()
+{
+    // Transition back buffer: PRESENT -> RENDER_TARGET
+    if (!m_backBufferBound)
+    {
+        D3D12_RESOURCE_BARRIER barrier = {};
+        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        barrier.Transition.pResource = m_swapChain->GetCurrentBackBuffer();
+        barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_PRESENT;
+        barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
+        barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+        m_commandList->ResourceBarrier(1, &barrier);
+        m_backBufferBound = true;
+    }
+
+    D3D12_CPU_DESCRIPTOR_HANDLE rtv = m_swapChain->GetCurrentRTV();
+    if (m_depthBuffer)
     {
         D3D12_CPU_DESCRIPTOR_HANDLE dsv = m_dsvHeap.GetCPUStart();
-        m_commandList->ClearDepthStencilView(dsv, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr);
         m_commandList->OMSetRenderTargets(1, &rtv, FALSE, &dsv);
     }
     else
@@ -432,12 +431,17 @@ void D3D12Context::Clear(const DirectX::XMFLOAT4& color)
         m_commandList->OMSetRenderTargets(1, &rtv, FALSE, nullptr);
     }
 
+    SetViewport(m_swapChain->GetWidth(), m_swapChain->GetHeight());
+}
+
+void D3D12Context::SetViewport(uint32 width, uint32 height)
+{
     // Set viewport and scissor rect
     D3D12_VIEWPORT viewport = {};
     viewport.TopLeftX = 0.0f;
     viewport.TopLeftY = 0.0f;
-    viewport.Width = static_cast<float>(m_swapChain->GetWidth());
-    viewport.Height = static_cast<float>(m_swapChain->GetHeight());
+    viewport.Width = static_cast<float>(width);
+    viewport.Height = static_cast<float>(height);
     viewport.MinDepth = 0.0f;
     viewport.MaxDepth = 1.0f;
     m_commandList->RSSetViewports(1, &viewport);
@@ -445,21 +449,198 @@ void D3D12Context::Clear(const DirectX::XMFLOAT4& color)
     D3D12_RECT scissorRect = {};
     scissorRect.left = 0;
     scissorRect.top = 0;
-    scissorRect.right = static_cast<LONG>(m_swapChain->GetWidth());
-    scissorRect.bottom = static_cast<LONG>(m_swapChain->GetHeight());
+    scissorRect.right = static_cast<LONG>(width);
+    scissorRect.bottom = static_cast<LONG>(height);
     m_commandList->RSSetScissorRects(1, &scissorRect);
 }
 
+void D3D12Context::SetRenderTarget(IRHITexture* target)
+{
+    m_renderTarget = static_cast<D3D12Texture*>(target);
+    if (!m_renderTarget)
+    {
+        if (m_swapChain)
+        {
+            BindBackBuffer();
+        }
+        return;
+    }
+
+    m_renderTarget->Transition(m_commandList.Get(), D3D12_RESOURCE_STATE_RENDER_TARGET);
+    D3D12_CPU_DESCRIPTOR_HANDLE rtv = m_renderTarget->GetRTV();
+    D3D12_CPU_DESCRIPTOR_HANDLE dsv = m_renderTarget->GetDSV();
+    m_commandList->OMSetRenderTargets(1, &rtv, FALSE, &dsv);
+    SetViewport(m_renderTarget->GetWidth(), m_renderTarget->GetHeight());
+}
+
+D3D12Context::Readback* D3D12Context::AcquireReadback(uint64 size)
+{
+    // Reuse the smallest free buffer that fits
+    Readback* best = nullptr;
+    for (Readback& readback : m_readbacks)
+    {
+        if (readback.ticket == 0 && readback.size >= size && (!best || readback.size < best->size))
+        {
+            best = &readback;
+        }
+    }
+    if (best)
+        return best;
+
+    D3D12_HEAP_PROPERTIES heapProps = {};
+    heapProps.Type = D3D12_HEAP_TYPE_READBACK;
+
+    D3D12_RESOURCE_DESC bufferDesc = {};
+    bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    bufferDesc.Width = size;
+    bufferDesc.Height = 1;
+    bufferDesc.DepthOrArraySize = 1;
+    bufferDesc.MipLevels = 1;
+    bufferDesc.Format = DXGI_FORMAT_UNKNOWN;
+    bufferDesc.SampleDesc.Count = 1;
+    bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+    Readback readback;
+    HRESULT hr = m_device->CreateCommittedResource(
+        &heapProps,
+        D3D12_HEAP_FLAG_NONE,
+        &bufferDesc,
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        nullptr,
+        IID_PPV_ARGS(&readback.buffer));
+    if (FAILED(hr))
+        return nullptr;
+
+    readback.size = size;
+    m_readbacks.push_back(std::move(readback));
+    return &m_readbacks.back();
+}
+
+uint64 D3D12Context::ReadPixels(IRHITexture* target)
+{
+    auto* texture = static_cast<D3D12Texture*>(target);
+    if (!texture)
+        return 0;
+
+    // Rows of the copy are padded to D3D12_TEXTURE_DATA_PITCH_ALIGNMENT
+    D3D12_RESOURCE_DESC desc = texture->GetResource()->GetDesc();
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint = {};
+    UINT64 totalBytes = 0;
+    m_device->GetCopyableFootprints(&desc, 0, 1, 0, &footprint, nullptr, nullptr, &totalBytes);
+
+    Readback* readback = AcquireReadback(totalBytes);
+    if (!readback)
+        return 0;
+
+    texture->Transition(m_commandList.Get(), D3D12_RESOURCE_STATE_COPY_SOURCE);
+
+    D3D12_TEXTURE_COPY_LOCATION dst = {};
+    dst.pResource = readback->buffer.Get();
+    dst.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+    dst.PlacedFootprint = footprint;
+
+    D3D12_TEXTURE_COPY_LOCATION src = {};
+    src.pResource = texture->GetResource();
+    src.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+    src.SubresourceIndex = 0;
+
+    m_commandList->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
+
+    // Drawing into it again later in the frame needs it back as a target
+    if (texture == m_renderTarget)
+    {
+        texture->Transition(m_commandList.Get(), D3D12_RESOURCE_STATE_RENDER_TARGET);
+    }
+
+    readback->ticket = m_nextReadbackTicket++;
+    readback->fenceValue = 0;
+    readback->footprint = footprint;
+    return readback->ticket;
+}
+
+ReadbackStatus D3D12Context::ResolveReadback(uint64 ticket, uint32* pixels)
+{
+    if (ticket == 0)
+        return ReadbackStatus::Invalid;
+
+    for (Readback& readback : m_readbacks)
+    {
+        if (readback.ticket != ticket)
+            continue;
+
+        if (readback.fenceValue == 0 || m_fence->GetCompletedValue() < readback.fenceValue)
+            return ReadbackStatus::Pending;
+
+        if (pixels)
+        {
+            const D3D12_SUBRESOURCE_FOOTPRINT& layout = readback.footprint.Footprint;
+            D3D12_RANGE readRange = { 0, static_cast<SIZE_T>(readback.size) };
+            void* mapped = nullptr;
+            if (SUCCEEDED(readback.buffer->Map(0, &readRange, &mapped)))
+            {
+                const uint8* src = static_cast<const uint8*>(mapped) + readback.footprint.Offset;
+                for (uint32 y = 0; y < layout.Height; ++y)
+                {
+                    memcpy(pixels + static_cast<size_t>(y) * layout.Width,
+                        src + static_cast<size_t>(y) * layout.RowPitch, layout.Width * sizeof(uint32));
+                }
+                D3D12_RANGE writeRange = { 0, 0 };
+                readback.buffer->Unmap(0, &writeRange);
+            }
+        }
+
+        readback.ticket = 0;
+        readback.fenceValue = 0;
+        return ReadbackStatus::Ready;
+    }
+    return ReadbackStatus::Invalid;
+}
+
 void D3D12Context::DrawPrimitives(IRHIBuffer* vb, IRHIBuffer* ib,
     const DirectX::XMFLOAT4X4& worldMatrix)
 {
-    if (!m_hasPSO || !vb || !ib || !m_cbData || m_drawCallIndex >= MAX_DRAW_CALLS)
+    SubmitDraw(vb, ib, worldMatrix, 1, 0);
+}
+
+void D3D12Context::DrawPrimitivesInstanced(IRHIBuffer* vb, IRHIBuffer* ib,
+    const DirectX::XMFLOAT4X4* worldMatrices, uint32 instanceCount)
+{
+    if (!m_hasPSO || !vb || !ib || !worldMatrices || instanceCount == 0)
+        return;
+
+    // Copy this draw's matrices; the root SRV points at the first one
+    uint64 size = static_cast<uint64>(instanceCount) * sizeof(DirectX::XMFLOAT4X4);
+    LinearAllocation instances;
+    if (!m_frameAllocator.Allocate(size, 16, instances))
+        return;
+    memcpy(instances.cpuAddress, worldMatrices, size);
+
+    DirectX::XMFLOAT4X4 identity;
+    DirectX::XMStoreFloat4x4(&identity, DirectX::XMMatrixIdentity());
+    SubmitDraw(vb, ib, identity, instanceCount, instances.gpuAddress);
+}
+
+void D3D12Context::DrawPrimitivesRange(IRHIBuffer* vb, IRHIBuffer* ib,
+    uint32 firstIndex, uint32 indexCount, const DirectX::XMFLOAT4X4& worldMatrix)
+{
+    SubmitDraw(vb, ib, worldMatrix, 1, 0, firstIndex, indexCount);
+}
+
+void D3D12Context::SubmitDraw(IRHIBuffer* vb, IRHIBuffer* ib, const DirectX::XMFLOAT4X4& worldMatrix,
+    uint32 instanceCount, D3D12_GPU_VIRTUAL_ADDRESS instanceData,
+    uint32 firstIndex, uint32 indexCount)
+{
+    if (!m_hasPSO || !vb || !ib)
+        return;
+
+    LinearAllocation cb;
+    if (!m_frameAllocator.Allocate(sizeof(PerObjectConstants), CONSTANT_BUFFER_ALIGNMENT, cb))
         return;
 
     auto* d3dVB = static_cast<D3D12Buffer*>(vb);
     auto* d3dIB = static_cast<D3D12Buffer*>(ib);
 
-    // Write constant buffer to the current slot (zero-init pads all padding fields)
+    // Write this draw's constants (zero-init pads all padding fields)
     PerObjectConstants constants = {};
     constants.world = worldMatrix;
     constants.viewProj = m_viewProjection;
@@ -472,18 +653,20 @@ void D3D12Context::DrawPrimitives(IRHIBuffer* vb, IRHIBuffer* ib,
     constants.Kq = m_Kq;
     constants.unlit = m_unlit;
     constants.colorOverride = m_colorOverride;
-    memcpy(m_cbData + m_drawCallIndex * m_cbAlignedSize, &constants, sizeof(PerObjectConstants));
-
-    // Set PSO and root signature
-    m_commandList->SetPipelineState(m_pipelineState.GetPSO());
+    constants.instanced = instanceData != 0 ? 1.0f : 0.0f;
+    constants.positionOffset = m_positionOffset;
+    constants.compactVertices = m_vertexFormat == VertexFormat::Compact ? 1.0f : 0.0f;
+    constants.positionScale = m_positionScale;
+    memcpy(cb.cpuAddress, &constants, sizeof(PerObjectConstants));
+
+    // Set PSO (per vertex layout) and root signature
+    m_commandList->SetPipelineState(m_pipelineState.GetPSO(m_vertexFormat));
     m_commandList->SetGraphicsRootSignature(m_pipelineState.GetRootSignature());
 
-    // Set CBV descriptor heap and bind the descriptor for this draw call's slot
-    ID3D12DescriptorHeap* heaps[] = { m_cbvHeap.GetHeap() };
-    m_commandList->SetDescriptorHeaps(1, heaps);
-    D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle = m_cbvHeap.GetGPUStart();
-    gpuHandle.ptr += m_drawCallIndex * m_cbvDescriptorSize;
-    m_commandList->SetGraphicsRootDescriptorTable(0, gpuHandle);
+    // Bind constants as a root CBV. Non-instanced draws never read t0 but the
+    // root SRV still needs a valid address, so it aliases the constants.
+    m_commandList->SetGraphicsRootConstantBufferView(0, cb.gpuAddress);
+    m_commandList->SetGraphicsRootShaderResourceView(1, instanceData != 0 ? instanceData : cb.gpuAddress);
 
     // Set primitive topology
     m_commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -495,11 +678,14 @@ void D3D12Context::DrawPrimitives(IRHIBuffer* vb, IRHIBuffer* ib,
     D3D12_INDEX_BUFFER_VIEW ibView = d3dIB->GetIndexBufferView();
     m_commandList->IASetIndexBuffer(&ibView);
 
-    // Draw
-    uint32 indexCount = d3dIB->GetSize() / sizeof(uint32);
-    m_commandList->DrawIndexedInstanced(indexCount, 1, 0, 0, 0);
-
-    m_drawCallIndex++;
+    // Draw (range clamped to the index buffer)
+    uint32 bufferIndices = d3dIB->GetIndexCount();
+    if (firstIndex > bufferIndices)
+        firstIndex = bufferIndices;
+    if (indexCount > bufferIndices - firstIndex)
+        indexCount = bufferIndices - firstIndex;
+    if (indexCount > 0)
+        m_commandList->DrawIndexedInstanced(indexCount, instanceCount, firstIndex, 0, 0);
 }
 
 void D3D12Context::DrawText(int x, int y, const char* text,
@@ -518,16 +704,27 @@ void D3D12Context::DrawText(int x, int y, const char* text,
 
 void D3D12Context::WaitForGPU()
 {
-    m_fenceValue++;
-    m_commandQueue->Signal(m_fence.Get(), m_fenceValue);
+    uint64 fenceValue = m_frameRing.NextFenceValue();
+    m_commandQueue->Signal(m_fence.Get(), fenceValue);
+    WaitForFenceValue(fenceValue);
+}
 
-    if (m_fence->GetCompletedValue() < m_fenceValue)
+void D3D12Context::WaitForFenceValue(uint64 fenceValue)
+{
+    if (m_fence->GetCompletedValue() < fenceValue)
     {
-        m_fence->SetEventOnCompletion(m_fenceValue, m_fenceEvent);
+        m_fence->SetEventOnCompletion(fenceValue, m_fenceEvent);
         WaitForSingleObject(m_fenceEvent, INFINITE);
     }
 }
 
+void D3D12Context::SetFramesInFlight(uint32 framesInFlight)
+{
+    // Slots are renumbered, so drain the queue first
+    WaitForGPU();
+    m_frameRing.Reset(framesInFlight);
+}
+
 void D3D12Context::CreateDepthBuffer(uint32 width, uint32 height)
 {
     if (width == 0 || height == 0)
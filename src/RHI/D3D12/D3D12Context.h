@@ -9,35 +9,18 @@
 #include <string>
 #include "Core/Types.h"
 #include "RHI/RHIContext.h"
+#include "RHI/PerObjectConstants.h"
 #include "RHI/D3D12/D3D12PipelineState.h"
 #include "RHI/D3D12/D3D12DescriptorHeap.h"
+#include "RHI/D3D12/D3D12UploadPageSource.h"
+#include "RHI/LinearAllocator.h"
+#include "RHI/FrameRing.h"
 
 namespace RRE
 {
 
-// Constant buffer data passed to the GPU per draw call
-struct PerObjectConstants
-{
-    DirectX::XMFLOAT4X4 world;          // 64
-    DirectX::XMFLOAT4X4 viewProj;       // 64
-    DirectX::XMFLOAT3 lightPosition;    // 12
-    float _pad1;                         // 4
-    DirectX::XMFLOAT3 lightColor;       // 12
-    float _pad2;                         // 4
-    DirectX::XMFLOAT3 cameraPosition;   // 12
-    float _pad3;                         // 4
-    DirectX::XMFLOAT3 ambientColor;     // 12
-    float _pad4;                         // 4
-    float Kc;                            // 4
-    float Kl;                            // 4
-    float Kq;                            // 4
-    float unlit;                         // 4
-    DirectX::XMFLOAT3 colorOverride;    // 12
-    float _pad6;                         // 4
-};  // Total: 224 bytes → 256 aligned
-static_assert(sizeof(PerObjectConstants) <= 256, "PerObjectConstants exceeds 256-byte CB slot");
-
 class D3D12SwapChain;
+class D3D12Texture;
 
 struct TextCommand
 {
@@ -53,7 +36,7 @@ public:
     D3D12Context() = default;
     ~D3D12Context() override = default;
 
-    bool Initialize(ID3D12Device* device);
+    bool Initialize(ID3D12Device* device, uint32 framesInFlight = 2);
     void Shutdown();
 
     void SetSwapChain(D3D12SwapChain* swapChain) { m_swapChain = swapChain; }
@@ -66,12 +49,12 @@ public:
     void ShutdownD2D();
 
     // Set View-Projection matrix for current frame
-    void SetViewProjection(const DirectX::XMFLOAT4X4& viewProj) { m_viewProjection = viewProj; }
+    void SetViewProjection(const DirectX::XMFLOAT4X4& viewProj) override { m_viewProjection = viewProj; }
 
     // Set lighting data for current frame
     void SetLightData(const DirectX::XMFLOAT3& lightPos, const DirectX::XMFLOAT3& lightColor,
         const DirectX::XMFLOAT3& cameraPos, const DirectX::XMFLOAT3& ambient,
-        float Kc, float Kl, float Kq)
+        float Kc, float Kl, float Kq) override
     {
         m_lightPosition = lightPos;
         m_lightColor = lightColor;
@@ -81,42 +64,86 @@ public:
     }
 
     // Set unlit mode for next draw call (solid color, no lighting)
-    void SetUnlitMode(bool unlit, const DirectX::XMFLOAT3& color)
+    void SetUnlitMode(bool unlit, const DirectX::XMFLOAT3& color) override
     {
         m_unlit = unlit ? 1.0f : 0.0f;
         m_colorOverride = color;
     }
 
+    // Vertex layout (selects the PSO) and compact position decoding for next draw calls
+    void SetVertexFormat(VertexFormat format, const DirectX::XMFLOAT3& positionOffset,
+        const DirectX::XMFLOAT3& positionScale) override
+    {
+        m_vertexFormat = format;
+        m_positionOffset = positionOffset;
+        m_positionScale = positionScale;
+    }
+
     // IRHIContext interface
     void BeginFrame() override;
     void EndFrame() override;
     void Clear(const DirectX::XMFLOAT4& color) override;
     void DrawPrimitives(IRHIBuffer* vb, IRHIBuffer* ib,
         const DirectX::XMFLOAT4X4& worldMatrix) override;
+    void DrawPrimitivesInstanced(IRHIBuffer* vb, IRHIBuffer* ib,
+        const DirectX::XMFLOAT4X4* worldMatrices, uint32 instanceCount) override;
+    void DrawPrimitivesRange(IRHIBuffer* vb, IRHIBuffer* ib,
+        uint32 firstIndex, uint32 indexCount, const DirectX::XMFLOAT4X4& worldMatrix) override;
     void DrawText(int x, int y, const char* text,
         const DirectX::XMFLOAT4& color) override;
 
+    // Offscreen rendering and pipelined readback; a readback's buffer is
+    // recycled once it has been resolved
+    void SetRenderTarget(IRHITexture* target) override;
+    uint64 ReadPixels(IRHITexture* target) override;
+    ReadbackStatus ResolveReadback(uint64 ticket, uint32* pixels) override;
+
     ID3D12CommandQueue* GetCommandQueue() const { return m_commandQueue.Get(); }
     ID3D12GraphicsCommandList* GetCommandList() const { return m_commandList.Get(); }
 
-    void WaitForGPU();
+    // Block until all submitted work has finished
+    void WaitForGPU() override;
+
+    // Frames the CPU may record ahead of the GPU (1 = fully serialized)
+    void SetFramesInFlight(uint32 framesInFlight);
+    uint32 GetFramesInFlight() const { return m_frameRing.GetFramesInFlight(); }
     void CreateDepthBuffer(uint32 width, uint32 height);
 
 private:
-    bool CreateConstantBuffer();
+    // Copy of a render target in a READBACK heap buffer
+    struct Readback
+    {
+        Microsoft::WRL::ComPtr<ID3D12Resource> buffer;
+        uint64 size = 0;
+        uint64 ticket = 0;          // 0 = free for reuse
+        uint64 fenceValue = 0;      // 0 = recorded in the frame still being built
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint = {};
+    };
+
     void FlushTextCommands();
+    void WaitForFenceValue(uint64 fenceValue);
+
+    // Transition the back buffer to RENDER_TARGET once per frame and bind it
+    void BindBackBuffer();
+    void SetViewport(uint32 width, uint32 height);
+    Readback* AcquireReadback(uint64 size);
+
+    // Shared path for all draw entry points (instanceData = 0 reads world from the CB)
+    void SubmitDraw(IRHIBuffer* vb, IRHIBuffer* ib, const DirectX::XMFLOAT4X4& worldMatrix,
+        uint32 instanceCount, D3D12_GPU_VIRTUAL_ADDRESS instanceData,
+        uint32 firstIndex = 0, uint32 indexCount = UINT32_MAX);
 
     ID3D12Device* m_device = nullptr;
     D3D12SwapChain* m_swapChain = nullptr;
 
     Microsoft::WRL::ComPtr<ID3D12CommandQueue> m_commandQueue;
-    Microsoft::WRL::ComPtr<ID3D12CommandAllocator> m_commandAllocator;
+    Microsoft::WRL::ComPtr<ID3D12CommandAllocator> m_commandAllocators[FrameRing::MAX_FRAMES_IN_FLIGHT];
     Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> m_commandList;
 
-    // Fence for GPU synchronization
+    // Fence for GPU synchronization; values come from the frame ring
     Microsoft::WRL::ComPtr<ID3D12Fence> m_fence;
-    uint64 m_fenceValue = 0;
     HANDLE m_fenceEvent = nullptr;
+    FrameRing m_frameRing;
 
     // Pipeline state
     D3D12PipelineState m_pipelineState;
@@ -126,14 +153,17 @@ private:
     Microsoft::WRL::ComPtr<ID3D12Resource> m_depthBuffer;
     D3D12DescriptorHeap m_dsvHeap;
 
-    // Constant buffer (CBV) — supports multiple draw calls per frame
-    static constexpr uint32 MAX_DRAW_CALLS = 16;
-    Microsoft::WRL::ComPtr<ID3D12Resource> m_constantBuffer;
-    D3D12DescriptorHeap m_cbvHeap;
-    uint8* m_cbData = nullptr;
-    uint32 m_drawCallIndex = 0;
-    UINT m_cbAlignedSize = 0;
-    UINT m_cbvDescriptorSize = 0;
+    // Offscreen target bound by SetRenderTarget (nullptr = back buffer)
+    D3D12Texture* m_renderTarget = nullptr;
+    bool m_backBufferBound = false;
+
+    std::vector<Readback> m_readbacks;
+    uint64 m_nextReadbackTicket = 1;
+
+    // Per-frame constants (root CBV b0) and instance matrices (root SRV t0)
+    // are bump-allocated from upload pages recycled by fence value
+    D3D12UploadPageSource m_uploadPages;
+    LinearAllocator m_frameAllocator;
 
     // Current frame's view-projection matrix
     DirectX::XMFLOAT4X4 m_viewProjection;
@@ -149,6 +179,11 @@ private:
     float m_unlit = 0.0f;
     DirectX::XMFLOAT3 m_colorOverride = { 1.0f, 1.0f, 1.0f };
 
+    // Vertex buffer layout of the next draws
+    VertexFormat m_vertexFormat = VertexFormat::Full;
+    DirectX::XMFLOAT3 m_positionOffset = { 0.0f, 0.0f, 0.0f };
+    DirectX::XMFLOAT3 m_positionScale = { 1.0f, 1.0f, 1.0f };
+
     // D3D11On12 / D2D / DirectWrite
     Microsoft::WRL::ComPtr<ID3D11On12Device> m_d3d11On12Device;
     Microsoft::WRL::ComPtr<ID3D11Device> m_d3d11Device;
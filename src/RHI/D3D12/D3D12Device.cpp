@@ -1,4 +1,6 @@
 #include "RHI/D3D12/D3D12Device.h"
+#include "RHI/D3D12/D3D12Buffer.h"
+#include "RHI/D3D12/D3D12Texture.h"
 
 namespace RRE
 {
@@ -153,6 +155,28 @@ void D3D12Device::OnResize(uint32 width, uint32 height)
     m_context.CreateD2DRenderTargets(&m_swapChain);
 }
 
+std::unique_ptr<IRHIBuffer> D3D12Device::CreateBuffer(const void* data, uint32 size, uint32 stride)
+{
+    if (!m_device)
+        return nullptr;
+
+    auto buffer = std::make_unique<D3D12Buffer>();
+    if (!buffer->Initialize(m_device.Get(), data, size, stride))
+        return nullptr;
+    return buffer;
+}
+
+std::unique_ptr<IRHITexture> D3D12Device::CreateRenderTarget(uint32 width, uint32 height)
+{
+    if (!m_device)
+        return nullptr;
+
+    auto texture = std::make_unique<D3D12Texture>();
+    if (!texture->Initialize(m_device.Get(), width, height))
+        return nullptr;
+    return texture;
+}
+
 bool D3D12Device::CreateDevice(IDXGIAdapter1* adapter)
 {
     HRESULT hr = D3D12CreateDevice(adapter, D3D_FEATURE_LEVEL_11_0,
@@ -22,6 +22,8 @@ public:
     void Shutdown() override;
     void OnResize(uint32 width, uint32 height) override;
     IRHIContext* GetContext() override { return &m_context; }
+    std::unique_ptr<IRHIBuffer> CreateBuffer(const void* data, uint32 size, uint32 stride) override;
+    std::unique_ptr<IRHITexture> CreateRenderTarget(uint32 width, uint32 height) override;
 
     // Initialize with WARP adapter for testing
     bool InitializeWARP(void* windowHandle, uint32 width, uint32 height);
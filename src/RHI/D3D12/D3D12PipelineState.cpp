@@ -6,20 +6,50 @@
 namespace RRE
 {
 
+namespace
+{
+
+// Input layout for RRE::Vertex
+const D3D12_INPUT_ELEMENT_DESC VERTEX_INPUT_LAYOUT[] =
+{
+    { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0,  0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+    { "COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT,  0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+    { "NORMAL",   0, DXGI_FORMAT_R32G32B32_FLOAT,     0, 28, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+};
+
+// Input layout for RRE::CompactVertex; the shader decodes position and
+// normal when CompactVertices is set
+const D3D12_INPUT_ELEMENT_DESC COMPACT_VERTEX_INPUT_LAYOUT[] =
+{
+    { "POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0,  0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+    { "NORMAL",   0, DXGI_FORMAT_R16G16_SNORM,       0,  8, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+    { "COLOR",    0, DXGI_FORMAT_R8G8B8A8_UNORM,     0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+};
+
+constexpr UINT VERTEX_INPUT_LAYOUT_COUNT = _countof(VERTEX_INPUT_LAYOUT);
+constexpr UINT COMPACT_VERTEX_INPUT_LAYOUT_COUNT = _countof(COMPACT_VERTEX_INPUT_LAYOUT);
+
+} // anonymous namespace
+
 bool D3D12PipelineState::Initialize(ID3D12Device* device)
 {
     if (!CreateRootSignature(device))
         return false;
     if (!LoadShaders())
         return false;
-    if (!CreatePipelineState(device))
+    if (!CreatePipelineState(device, VertexFormat::Full))
+        return false;
+    if (!CreatePipelineState(device, VertexFormat::Compact))
         return false;
     return true;
 }
 
 void D3D12PipelineState::Shutdown()
 {
-    m_pipelineState.Reset();
+    for (auto& pipelineState : m_pipelineStates)
+    {
+        pipelineState.Reset();
+    }
     m_rootSignature.Reset();
     m_vertexShader.Reset();
     m_pixelShader.Reset();
@@ -27,23 +57,22 @@ void D3D12PipelineState::Shutdown()
 
 bool D3D12PipelineState::CreateRootSignature(ID3D12Device* device)
 {
-    // Descriptor table with one CBV at register b0
-    D3D12_DESCRIPTOR_RANGE cbvRange = {};
-    cbvRange.RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_CBV;
-    cbvRange.NumDescriptors = 1;
-    cbvRange.BaseShaderRegister = 0;
-    cbvRange.RegisterSpace = 0;
-    cbvRange.OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
-
-    D3D12_ROOT_PARAMETER rootParam = {};
-    rootParam.ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
-    rootParam.DescriptorTable.NumDescriptorRanges = 1;
-    rootParam.DescriptorTable.pDescriptorRanges = &cbvRange;
-    rootParam.ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+    // Root CBV at b0: per-draw constants (bound by GPU address, no descriptor heap)
+    D3D12_ROOT_PARAMETER rootParams[2] = {};
+    rootParams[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+    rootParams[0].Descriptor.ShaderRegister = 0;
+    rootParams[0].Descriptor.RegisterSpace = 0;
+    rootParams[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+
+    // Root SRV at t0: per-instance world matrices for instanced draws
+    rootParams[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+    rootParams[1].Descriptor.ShaderRegister = 0;
+    rootParams[1].Descriptor.RegisterSpace = 0;
+    rootParams[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
 
     D3D12_ROOT_SIGNATURE_DESC rsDesc = {};
-    rsDesc.NumParameters = 1;
-    rsDesc.pParameters = &rootParam;
+    rsDesc.NumParameters = 2;
+    rsDesc.pParameters = rootParams;
     rsDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
 
     Microsoft::WRL::ComPtr<ID3DBlob> serialized;
@@ -80,7 +109,7 @@ bool D3D12PipelineState::LoadShaders()
     return true;
 }
 
-bool D3D12PipelineState::CreatePipelineState(ID3D12Device* device)
+bool D3D12PipelineState::CreatePipelineState(ID3D12Device* device, VertexFormat format)
 {
     D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc = {};
     psoDesc.pRootSignature = m_rootSignature.Get();
@@ -90,8 +119,16 @@ bool D3D12PipelineState::CreatePipelineState(ID3D12Device* device)
     psoDesc.PS.pShaderBytecode = m_pixelShader->GetBufferPointer();
     psoDesc.PS.BytecodeLength = m_pixelShader->GetBufferSize();
 
-    psoDesc.InputLayout.pInputElementDescs = VERTEX_INPUT_LAYOUT;
-    psoDesc.InputLayout.NumElements = VERTEX_INPUT_LAYOUT_COUNT;
+    if (format == VertexFormat::Compact)
+    {
+        psoDesc.InputLayout.pInputElementDescs = COMPACT_VERTEX_INPUT_LAYOUT;
+        psoDesc.InputLayout.NumElements = COMPACT_VERTEX_INPUT_LAYOUT_COUNT;
+    }
+    else
+    {
+        psoDesc.InputLayout.pInputElementDescs = VERTEX_INPUT_LAYOUT;
+        psoDesc.InputLayout.NumElements = VERTEX_INPUT_LAYOUT_COUNT;
+    }
 
     // Rasterizer state
     psoDesc.RasterizerState.FillMode = D3D12_FILL_MODE_SOLID;
@@ -115,7 +152,8 @@ bool D3D12PipelineState::CreatePipelineState(ID3D12Device* device)
     psoDesc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM;
     psoDesc.SampleDesc.Count = 1;
 
-    HRESULT hr = device->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&m_pipelineState));
+    HRESULT hr = device->CreateGraphicsPipelineState(&psoDesc,
+        IID_PPV_ARGS(&m_pipelineStates[static_cast<uint32>(format)]));
     return SUCCEEDED(hr);
 }
 
@@ -2,10 +2,13 @@
 
 #include <d3d12.h>
 #include <wrl/client.h>
+#include "Renderer/Vertex.h"
 
 namespace RRE
 {
 
+// Root signature and one PSO per VertexFormat; the PSOs share the shaders
+// and differ only in their input layout
 class D3D12PipelineState
 {
 public:
@@ -16,15 +19,19 @@ public:
     void Shutdown();
 
     ID3D12RootSignature* GetRootSignature() const { return m_rootSignature.Get(); }
-    ID3D12PipelineState* GetPSO() const { return m_pipelineState.Get(); }
+    ID3D12PipelineState* GetPSO(VertexFormat format = VertexFormat::Full) const
+    {
+        return m_pipelineStates[static_cast<uint32>(format)].Get();
+    }
 
 private:
     bool CreateRootSignature(ID3D12Device* device);
     bool LoadShaders();
-    bool CreatePipelineState(ID3D12Device* device);
+    bool CreatePipelineState(ID3D12Device* device, VertexFormat format);
 
     Microsoft::WRL::ComPtr<ID3D12RootSignature> m_rootSignature;
-    Microsoft::WRL::ComPtr<ID3D12PipelineState> m_pipelineState;
+    static constexpr uint32 VERTEX_FORMAT_COUNT = 2;
+    Microsoft::WRL::ComPtr<ID3D12PipelineState> m_pipelineStates[VERTEX_FORMAT_COUNT];
     Microsoft::WRL::ComPtr<ID3DBlob> m_vertexShader;
     Microsoft::WRL::ComPtr<ID3DBlob> m_pixelShader;
 };
@@ -0,0 +1,88 @@
+#include "RHI/D3D12/D3D12Texture.h"
+
+namespace RRE
+{
+
+bool D3D12Texture::Initialize(ID3D12Device* device, uint32 width, uint32 height)
+{
+    if (!device || width == 0 || height == 0)
+        return false;
+
+    m_width = width;
+    m_height = height;
+
+    D3D12_HEAP_PROPERTIES heapProps = {};
+    heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+    // Color target
+    D3D12_RESOURCE_DESC colorDesc = {};
+    colorDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+    colorDesc.Width = width;
+    colorDesc.Height = height;
+    colorDesc.DepthOrArraySize = 1;
+    colorDesc.MipLevels = 1;
+    colorDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    colorDesc.SampleDesc.Count = 1;
+    colorDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+
+    HRESULT hr = device->CreateCommittedResource(
+        &heapProps,
+        D3D12_HEAP_FLAG_NONE,
+        &colorDesc,
+        D3D12_RESOURCE_STATE_RENDER_TARGET,
+        nullptr,
+        IID_PPV_ARGS(&m_color));
+    if (FAILED(hr))
+        return false;
+    m_state = D3D12_RESOURCE_STATE_RENDER_TARGET;
+
+    // Depth buffer
+    D3D12_RESOURCE_DESC depthDesc = colorDesc;
+    depthDesc.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
+    depthDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+
+    D3D12_CLEAR_VALUE clearValue = {};
+    clearValue.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
+    clearValue.DepthStencil.Depth = 1.0f;
+
+    hr = device->CreateCommittedResource(
+        &heapProps,
+        D3D12_HEAP_FLAG_NONE,
+        &depthDesc,
+        D3D12_RESOURCE_STATE_DEPTH_WRITE,
+        &clearValue,
+        IID_PPV_ARGS(&m_depth));
+    if (FAILED(hr))
+        return false;
+
+    // Views
+    if (!m_rtvHeap.Initialize(device, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, 1) ||
+        !m_dsvHeap.Initialize(device, D3D12_DESCRIPTOR_HEAP_TYPE_DSV, 1))
+        return false;
+
+    device->CreateRenderTargetView(m_color.Get(), nullptr, m_rtvHeap.Allocate());
+
+    D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc = {};
+    dsvDesc.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
+    dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
+    device->CreateDepthStencilView(m_depth.Get(), &dsvDesc, m_dsvHeap.Allocate());
+
+    return true;
+}
+
+void D3D12Texture::Transition(ID3D12GraphicsCommandList* commandList, D3D12_RESOURCE_STATES state)
+{
+    if (m_state == state)
+        return;
+
+    D3D12_RESOURCE_BARRIER barrier = {};
+    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    barrier.Transition.pResource = m_color.Get();
+    barrier.Transition.StateBefore = m_state;
+    barrier.Transition.StateAfter = state;
+    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+    commandList->ResourceBarrier(1, &barrier);
+    m_state = state;
+}
+
+} // namespace RRE
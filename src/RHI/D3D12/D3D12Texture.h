@@ -0,0 +1,44 @@
+#pragma once
+
+#include <d3d12.h>
+#include <wrl/client.h>
+#include "Core/Types.h"
+#include "RHI/RHITexture.h"
+#include "RHI/D3D12/D3D12DescriptorHeap.h"
+
+namespace RRE
+{
+
+// RGBA8 color texture with a D24S8 depth buffer, both matching the formats
+// the pipeline state was built for. Tracks the color resource's state so the
+// context can switch it between rendering and copy source.
+class D3D12Texture : public IRHITexture
+{
+public:
+    D3D12Texture() = default;
+    ~D3D12Texture() override = default;
+
+    bool Initialize(ID3D12Device* device, uint32 width, uint32 height);
+
+    // IRHITexture interface
+    uint32 GetWidth() const override { return m_width; }
+    uint32 GetHeight() const override { return m_height; }
+
+    // Records a barrier if the color resource is not already in state
+    void Transition(ID3D12GraphicsCommandList* commandList, D3D12_RESOURCE_STATES state);
+
+    ID3D12Resource* GetResource() const { return m_color.Get(); }
+    D3D12_CPU_DESCRIPTOR_HANDLE GetRTV() const { return m_rtvHeap.GetCPUStart(); }
+    D3D12_CPU_DESCRIPTOR_HANDLE GetDSV() const { return m_dsvHeap.GetCPUStart(); }
+
+private:
+    Microsoft::WRL::ComPtr<ID3D12Resource> m_color;
+    Microsoft::WRL::ComPtr<ID3D12Resource> m_depth;
+    D3D12DescriptorHeap m_rtvHeap;
+    D3D12DescriptorHeap m_dsvHeap;
+    D3D12_RESOURCE_STATES m_state = D3D12_RESOURCE_STATE_RENDER_TARGET;
+    uint32 m_width = 0;
+    uint32 m_height = 0;
+};
+
+} // namespace RRE
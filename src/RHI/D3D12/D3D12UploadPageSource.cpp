@@ -0,0 +1,62 @@
+#include "RHI/D3D12/D3D12UploadPageSource.h"
+
+namespace RRE
+{
+
+bool D3D12UploadPageSource::CreatePage(uint64 size, LinearPage& page)
+{
+    if (!m_device)
+        return false;
+
+    D3D12_HEAP_PROPERTIES heapProps = {};
+    heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+    D3D12_RESOURCE_DESC bufferDesc = {};
+    bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    bufferDesc.Width = size;
+    bufferDesc.Height = 1;
+    bufferDesc.DepthOrArraySize = 1;
+    bufferDesc.MipLevels = 1;
+    bufferDesc.SampleDesc.Count = 1;
+    bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+    // Buffer placements are 64 KB aligned, which covers the 256-byte CBV rule
+    ID3D12Resource* resource = nullptr;
+    HRESULT hr = m_device->CreateCommittedResource(
+        &heapProps,
+        D3D12_HEAP_FLAG_NONE,
+        &bufferDesc,
+        D3D12_RESOURCE_STATE_GENERIC_READ,
+        nullptr,
+        IID_PPV_ARGS(&resource));
+    if (FAILED(hr))
+        return false;
+
+    // Keep the page persistently mapped
+    void* mapped = nullptr;
+    hr = resource->Map(0, nullptr, &mapped);
+    if (FAILED(hr))
+    {
+        resource->Release();
+        return false;
+    }
+
+    page.cpuAddress = static_cast<uint8*>(mapped);
+    page.gpuAddress = resource->GetGPUVirtualAddress();
+    page.size = size;
+    page.handle = resource;
+    return true;
+}
+
+void D3D12UploadPageSource::DestroyPage(LinearPage& page)
+{
+    auto* resource = static_cast<ID3D12Resource*>(page.handle);
+    if (resource)
+    {
+        resource->Unmap(0, nullptr);
+        resource->Release();
+    }
+    page = LinearPage();
+}
+
+} // namespace RRE
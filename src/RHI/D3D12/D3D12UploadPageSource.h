@@ -0,0 +1,27 @@
+#pragma once
+
+#include <d3d12.h>
+#include "Core/Types.h"
+#include "RHI/LinearAllocator.h"
+
+namespace RRE
+{
+
+// Persistently mapped upload-heap buffers as LinearAllocator pages
+class D3D12UploadPageSource : public ILinearPageSource
+{
+public:
+    D3D12UploadPageSource() = default;
+    ~D3D12UploadPageSource() override = default;
+
+    void Initialize(ID3D12Device* device) { m_device = device; }
+
+    // ILinearPageSource interface
+    bool CreatePage(uint64 size, LinearPage& page) override;
+    void DestroyPage(LinearPage& page) override;
+
+private:
+    ID3D12Device* m_device = nullptr;
+};
+
+} // namespace RRE
@@ -0,0 +1,31 @@
+#include "RHI/FrameRing.h"
+#include <algorithm>
+
+namespace RRE
+{
+
+FrameRing::FrameRing(uint32 framesInFlight)
+{
+    Reset(framesInFlight);
+}
+
+void FrameRing::Reset(uint32 framesInFlight)
+{
+    m_framesInFlight = std::clamp<uint32>(framesInFlight, 1, MAX_FRAMES_IN_FLIGHT);
+    m_frameIndex = 0;
+
+    // Keep m_lastFenceValue: the fence object itself is never reset
+    for (uint64& value : m_slotFenceValues)
+    {
+        value = 0;
+    }
+}
+
+void FrameRing::EndFrame(uint64 signaledFenceValue)
+{
+    m_slotFenceValues[m_frameIndex] = signaledFenceValue;
+    m_frameIndex = (m_frameIndex + 1) % m_framesInFlight;
+    m_frameNumber++;
+}
+
+} // namespace RRE
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Core/Types.h"
+
+namespace RRE
+{
+
+// Frame-slot bookkeeping for N frames in flight. Each slot owns per-frame
+// resources (command allocator, transient memory); before a slot is reused
+// the CPU waits until the GPU has passed the fence value signaled at the end
+// of the frame that last used it. Fence values are handed out in increasing
+// order, so one fence can serve both frame ends and full flushes.
+class FrameRing
+{
+public:
+    static constexpr uint32 MAX_FRAMES_IN_FLIGHT = 3;
+
+    explicit FrameRing(uint32 framesInFlight = 2);
+
+    // Change the ring size; only valid while the GPU is idle
+    void Reset(uint32 framesInFlight);
+
+    uint32 GetFramesInFlight() const { return m_framesInFlight; }
+    uint32 GetFrameIndex() const { return m_frameIndex; }
+    uint64 GetFrameNumber() const { return m_frameNumber; }
+
+    // Fence value the current slot must wait for before recording (0 = none)
+    uint64 GetWaitValue() const { return m_slotFenceValues[m_frameIndex]; }
+    bool IsSlotReady(uint64 completedFenceValue) const { return completedFenceValue >= GetWaitValue(); }
+
+    // Next fence value to signal (monotonic across frames and flushes)
+    uint64 NextFenceValue() { return ++m_lastFenceValue; }
+    uint64 GetLastFenceValue() const { return m_lastFenceValue; }
+
+    // Tag the current slot with the value signaled after its commands and
+    // move on to the next slot
+    void EndFrame(uint64 signaledFenceValue);
+
+private:
+    uint32 m_framesInFlight = 0;
+    uint32 m_frameIndex = 0;
+    uint64 m_frameNumber = 0;
+    uint64 m_lastFenceValue = 0;
+    uint64 m_slotFenceValues[MAX_FRAMES_IN_FLIGHT] = {};
+};
+
+} // namespace RRE
@@ -0,0 +1,114 @@
+#include "RHI/LinearAllocator.h"
+#include <algorithm>
+
+namespace RRE
+{
+
+namespace
+{
+
+uint64 AlignUp(uint64 value, uint64 alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // anonymous namespace
+
+LinearAllocator::LinearAllocator(uint64 pageSize)
+    : m_pageSize(pageSize)
+{
+}
+
+LinearAllocator::~LinearAllocator()
+{
+    Release();
+}
+
+bool LinearAllocator::Allocate(uint64 size, uint64 alignment, LinearAllocation& out)
+{
+    // Offsets are aligned relative to the page start; backends hand out page
+    // bases that satisfy any alignment requested here
+    uint64 offset = AlignUp(m_offset, alignment);
+    if (m_usedPages.empty() || offset + size > m_usedPages.back().size)
+    {
+        if (!AcquirePage(size))
+            return false;
+        offset = 0;
+    }
+
+    const LinearPage& page = m_usedPages.back();
+    out.cpuAddress = page.cpuAddress + offset;
+    out.gpuAddress = page.gpuAddress + offset;
+    out.size = size;
+
+    m_offset = offset + size;
+    m_frameBytes += size;
+    return true;
+}
+
+bool LinearAllocator::AcquirePage(uint64 minSize)
+{
+    // Reuse the first free page that is large enough
+    auto it = std::find_if(m_freePages.begin(), m_freePages.end(),
+        [minSize](const LinearPage& page) { return page.size >= minSize; });
+    if (it != m_freePages.end())
+    {
+        m_usedPages.push_back(*it);
+        m_freePages.erase(it);
+        m_offset = 0;
+        return true;
+    }
+
+    if (!m_source)
+        return false;
+
+    LinearPage page;
+    if (!m_source->CreatePage(std::max(minSize, m_pageSize), page))
+        return false;
+
+    m_usedPages.push_back(page);
+    m_pageCount++;
+    m_offset = 0;
+    return true;
+}
+
+void LinearAllocator::FinishFrame(uint64 fenceValue)
+{
+    for (const LinearPage& page : m_usedPages)
+    {
+        m_retiredPages.push_back({ page, fenceValue });
+    }
+    m_usedPages.clear();
+    m_offset = 0;
+    m_frameBytes = 0;
+}
+
+void LinearAllocator::Recycle(uint64 completedFenceValue)
+{
+    // Retired pages are in fence order, so stop at the first pending one
+    size_t done = 0;
+    while (done < m_retiredPages.size() && m_retiredPages[done].fenceValue <= completedFenceValue)
+    {
+        m_freePages.push_back(m_retiredPages[done].page);
+        done++;
+    }
+    m_retiredPages.erase(m_retiredPages.begin(), m_retiredPages.begin() + done);
+}
+
+void LinearAllocator::Release()
+{
+    FinishFrame(0);
+    Recycle(UINT64_MAX);
+
+    if (m_source)
+    {
+        for (LinearPage& page : m_freePages)
+        {
+            m_source->DestroyPage(page);
+        }
+    }
+    m_freePages.clear();
+    m_pageCount = 0;
+}
+
+} // namespace RRE
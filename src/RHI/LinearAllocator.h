@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Core/Types.h"
+#include <vector>
+
+namespace RRE
+{
+
+// One persistently mapped block of GPU-visible memory
+struct LinearPage
+{
+    uint8* cpuAddress = nullptr;
+    uint64 gpuAddress = 0;
+    uint64 size = 0;
+    void* handle = nullptr;     // backend resource
+};
+
+// Backend hook that creates and destroys pages for LinearAllocator
+class ILinearPageSource
+{
+public:
+    virtual ~ILinearPageSource() = default;
+
+    virtual bool CreatePage(uint64 size, LinearPage& page) = 0;
+    virtual void DestroyPage(LinearPage& page) = 0;
+};
+
+struct LinearAllocation
+{
+    uint8* cpuAddress = nullptr;
+    uint64 gpuAddress = 0;
+    uint64 size = 0;
+};
+
+// Per-frame bump allocator for transient GPU data (constants, instance data).
+// Allocations are carved out of the current page; a new page is paged in on
+// demand. At the end of a frame the used pages are retired with the frame's
+// fence value and recycled once the GPU has passed that value.
+class LinearAllocator
+{
+public:
+    explicit LinearAllocator(uint64 pageSize = 256 * 1024);
+    ~LinearAllocator();
+
+    LinearAllocator(const LinearAllocator&) = delete;
+    LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+    // Must be set before the first Allocate; the source outlives the allocator
+    void SetPageSource(ILinearPageSource* source) { m_source = source; }
+
+    // alignment must be a power of two. Requests larger than the page size
+    // get a dedicated page. Returns false if no page could be created.
+    bool Allocate(uint64 size, uint64 alignment, LinearAllocation& out);
+
+    // Retire every page used since the last call; they stay untouched until
+    // Recycle sees completedFenceValue >= fenceValue
+    void FinishFrame(uint64 fenceValue);
+    void Recycle(uint64 completedFenceValue);
+
+    // Destroy all pages (the GPU must be idle)
+    void Release();
+
+    uint64 GetPageSize() const { return m_pageSize; }
+    uint32 GetPageCount() const { return m_pageCount; }
+    uint32 GetFreePageCount() const { return static_cast<uint32>(m_freePages.size()); }
+    uint32 GetRetiredPageCount() const { return static_cast<uint32>(m_retiredPages.size()); }
+    uint64 GetFrameBytes() const { return m_frameBytes; }
+
+private:
+    struct RetiredPage
+    {
+        LinearPage page;
+        uint64 fenceValue;
+    };
+
+    bool AcquirePage(uint64 minSize);
+
+    ILinearPageSource* m_source = nullptr;
+    uint64 m_pageSize;
+    uint32 m_pageCount = 0;
+
+    std::vector<LinearPage> m_usedPages;       // this frame; back() is current
+    std::vector<RetiredPage> m_retiredPages;   // in fence order
+    std::vector<LinearPage> m_freePages;
+    uint64 m_offset = 0;                       // into m_usedPages.back()
+    uint64 m_frameBytes = 0;
+};
+
+} // namespace RRE
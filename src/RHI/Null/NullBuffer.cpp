@@ -0,0 +1,24 @@
+#include "RHI/Null/NullBuffer.h"
+#include "RHI/Null/NullContext.h"
+
+namespace RRE
+{
+
+NullBuffer::NullBuffer(NullRHIStats* stats, uint32 size, uint32 stride)
+    : m_stats(stats)
+    , m_size(size)
+    , m_stride(stride)
+{
+}
+
+void NullBuffer::SetData(const void* data, uint32 size, uint32 stride)
+{
+    m_size = size;
+    m_stride = stride;
+    if (data)
+    {
+        m_stats->bytesUploaded += size;
+    }
+}
+
+} // namespace RRE
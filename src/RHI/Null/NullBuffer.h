@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Core/Types.h"
+#include "RHI/RHIBuffer.h"
+
+namespace RRE
+{
+
+struct NullRHIStats;
+
+// Size/stride only; the data is counted, not stored
+class NullBuffer : public IRHIBuffer
+{
+public:
+    NullBuffer(NullRHIStats* stats, uint32 size, uint32 stride);
+    ~NullBuffer() override = default;
+
+    // IRHIBuffer interface
+    void SetData(const void* data, uint32 size, uint32 stride) override;
+    uint32 GetSize() const override { return m_size; }
+    uint32 GetStride() const override { return m_stride; }
+
+private:
+    NullRHIStats* m_stats;
+    uint32 m_size;
+    uint32 m_stride;
+};
+
+} // namespace RRE
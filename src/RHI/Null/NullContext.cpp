@@ -0,0 +1,208 @@
+#include "RHI/Null/NullContext.h"
+#include "RHI/RHIBuffer.h"
+#include "RHI/RHITexture.h"
+#include "Renderer/Vertex.h"
+#include <algorithm>
+#include <cstring>
+
+namespace RRE
+{
+
+bool NullPageSource::CreatePage(uint64 size, LinearPage& page)
+{
+    m_pages.push_back(std::make_unique<uint8[]>(size));
+    page.cpuAddress = m_pages.back().get();
+    page.gpuAddress = reinterpret_cast<uint64>(page.cpuAddress);
+    page.size = size;
+    page.handle = page.cpuAddress;
+    return true;
+}
+
+void NullPageSource::DestroyPage(LinearPage& page)
+{
+    for (auto it = m_pages.begin(); it != m_pages.end(); ++it)
+    {
+        if (it->get() == page.handle)
+        {
+            m_pages.erase(it);
+            break;
+        }
+    }
+    page = LinearPage();
+}
+
+NullContext::NullContext(NullRHIStats* stats)
+    : m_stats(stats)
+{
+    m_frameAllocator.SetPageSource(&m_pages);
+    DirectX::XMStoreFloat4x4(&m_frameConstants.viewProj, DirectX::XMMatrixIdentity());
+}
+
+void NullContext::BeginFrame()
+{
+    // The "GPU" finishes each frame immediately
+    m_frameAllocator.Recycle(m_frameNumber);
+}
+
+void NullContext::EndFrame()
+{
+    m_frameNumber++;
+    m_frameAllocator.FinishFrame(m_frameNumber);
+    m_stats->frames++;
+}
+
+void NullContext::Clear(const DirectX::XMFLOAT4& color)
+{
+    (void)color;
+}
+
+void NullContext::SetViewProjection(const DirectX::XMFLOAT4X4& viewProj)
+{
+    m_frameConstants.viewProj = viewProj;
+}
+
+void NullContext::SetLightData(const DirectX::XMFLOAT3& lightPos, const DirectX::XMFLOAT3& lightColor,
+    const DirectX::XMFLOAT3& cameraPos, const DirectX::XMFLOAT3& ambient,
+    float Kc, float Kl, float Kq)
+{
+    m_frameConstants.lightPosition = lightPos;
+    m_frameConstants.lightColor = lightColor;
+    m_frameConstants.cameraPosition = cameraPos;
+    m_frameConstants.ambientColor = ambient;
+    m_frameConstants.Kc = Kc;
+    m_frameConstants.Kl = Kl;
+    m_frameConstants.Kq = Kq;
+}
+
+void NullContext::SetUnlitMode(bool unlit, const DirectX::XMFLOAT3& color)
+{
+    m_frameConstants.unlit = unlit ? 1.0f : 0.0f;
+    m_frameConstants.colorOverride = color;
+}
+
+void NullContext::SetVertexFormat(VertexFormat format, const DirectX::XMFLOAT3& positionOffset,
+    const DirectX::XMFLOAT3& positionScale)
+{
+    m_frameConstants.compactVertices = format == VertexFormat::Compact ? 1.0f : 0.0f;
+    m_frameConstants.positionOffset = positionOffset;
+    m_frameConstants.positionScale = positionScale;
+}
+
+bool NullContext::WriteConstants(const DirectX::XMFLOAT4X4& worldMatrix, bool instanced)
+{
+    LinearAllocation cb;
+    if (!m_frameAllocator.Allocate(sizeof(PerObjectConstants), CONSTANT_BUFFER_ALIGNMENT, cb))
+        return false;
+
+    PerObjectConstants constants = m_frameConstants;
+    constants.world = worldMatrix;
+    constants.instanced = instanced ? 1.0f : 0.0f;
+    memcpy(cb.cpuAddress, &constants, sizeof(PerObjectConstants));
+
+    m_stats->constantWrites++;
+    m_stats->constantBytes += sizeof(PerObjectConstants);
+    return true;
+}
+
+void NullContext::DrawPrimitives(IRHIBuffer* vb, IRHIBuffer* ib,
+    const DirectX::XMFLOAT4X4& worldMatrix)
+{
+    if (!vb || !ib || !WriteConstants(worldMatrix, false))
+        return;
+
+    m_stats->drawCalls++;
+    m_stats->instances++;
+    m_stats->indices += ib->GetIndexCount();
+}
+
+void NullContext::DrawPrimitivesInstanced(IRHIBuffer* vb, IRHIBuffer* ib,
+    const DirectX::XMFLOAT4X4* worldMatrices, uint32 instanceCount)
+{
+    if (!vb || !ib || !worldMatrices || instanceCount == 0)
+        return;
+
+    uint64 size = static_cast<uint64>(instanceCount) * sizeof(DirectX::XMFLOAT4X4);
+    LinearAllocation instances;
+    if (!m_frameAllocator.Allocate(size, 16, instances))
+        return;
+    memcpy(instances.cpuAddress, worldMatrices, size);
+    m_stats->constantBytes += size;
+
+    DirectX::XMFLOAT4X4 identity;
+    DirectX::XMStoreFloat4x4(&identity, DirectX::XMMatrixIdentity());
+    if (!WriteConstants(identity, true))
+        return;
+
+    m_stats->drawCalls++;
+    m_stats->instancedDrawCalls++;
+    m_stats->instances += instanceCount;
+    m_stats->indices += static_cast<uint64>(ib->GetIndexCount()) * instanceCount;
+}
+
+void NullContext::DrawPrimitivesRange(IRHIBuffer* vb, IRHIBuffer* ib,
+    uint32 firstIndex, uint32 indexCount, const DirectX::XMFLOAT4X4& worldMatrix)
+{
+    if (!vb || !ib || !WriteConstants(worldMatrix, false))
+        return;
+
+    uint32 bufferIndices = ib->GetIndexCount();
+    firstIndex = std::min(firstIndex, bufferIndices);
+    m_stats->drawCalls++;
+    m_stats->instances++;
+    m_stats->indices += std::min(indexCount, bufferIndices - firstIndex);
+}
+
+void NullContext::DrawText(int x, int y, const char* text,
+    const DirectX::XMFLOAT4& color)
+{
+    (void)x;
+    (void)y;
+    (void)color;
+    if (text)
+    {
+        m_stats->textCommands++;
+    }
+}
+
+void NullContext::SetRenderTarget(IRHITexture* target)
+{
+    (void)target;
+    m_stats->renderTargetSwitches++;
+}
+
+uint64 NullContext::ReadPixels(IRHITexture* target)
+{
+    if (!target)
+        return 0;
+
+    Readback readback;
+    readback.ticket = m_nextTicket++;
+    readback.frame = m_frameNumber;
+    readback.pixelCount = target->GetWidth() * target->GetHeight();
+    m_readbacks.push_back(readback);
+
+    m_stats->readbacks++;
+    m_stats->readbackBytes += static_cast<uint64>(readback.pixelCount) * sizeof(uint32);
+    return readback.ticket;
+}
+
+ReadbackStatus NullContext::ResolveReadback(uint64 ticket, uint32* pixels)
+{
+    for (auto it = m_readbacks.begin(); it != m_readbacks.end(); ++it)
+    {
+        if (it->ticket != ticket)
+            continue;
+        if (it->frame >= m_frameNumber)
+            return ReadbackStatus::Pending;
+
+        if (pixels)
+        {
+            std::fill(pixels, pixels + it->pixelCount, 0u);
+        }
+        m_readbacks.erase(it);
+        return ReadbackStatus::Ready;
+    }
+    return ReadbackStatus::Invalid;
+}
+
+} // namespace RRE
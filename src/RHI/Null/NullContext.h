@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Core/Types.h"
+#include "RHI/RHIContext.h"
+#include "RHI/PerObjectConstants.h"
+#include "RHI/LinearAllocator.h"
+#include <memory>
+#include <vector>
+
+namespace RRE
+{
+
+// Counters recorded by the null backend since the last ResetStats
+struct NullRHIStats
+{
+    uint64 frames = 0;
+    uint64 drawCalls = 0;           // all DrawPrimitives* calls
+    uint64 instancedDrawCalls = 0;
+    uint64 instances = 0;           // summed over all draws
+    uint64 indices = 0;             // index count x instances
+    uint64 buffersCreated = 0;
+    uint64 bytesUploaded = 0;       // buffer creation and SetData
+    uint64 constantWrites = 0;      // per-draw constant blocks written
+    uint64 constantBytes = 0;       // constant blocks + instance matrices
+    uint64 textCommands = 0;
+    uint64 renderTargetsCreated = 0;
+    uint64 renderTargetSwitches = 0;
+    uint64 readbacks = 0;           // ReadPixels calls that returned a ticket
+    uint64 readbackBytes = 0;
+};
+
+// System-memory pages for the null context's frame allocator
+class NullPageSource : public ILinearPageSource
+{
+public:
+    bool CreatePage(uint64 size, LinearPage& page) override;
+    void DestroyPage(LinearPage& page) override;
+
+private:
+    std::vector<std::unique_ptr<uint8[]>> m_pages;
+};
+
+// Executes the CPU side of every call (constant packing, instance copies,
+// per-frame transient memory) and records it in NullRHIStats; draws nothing.
+// Readbacks complete (as black pixels) when their frame ends.
+class NullContext : public IRHIContext
+{
+public:
+    explicit NullContext(NullRHIStats* stats);
+    ~NullContext() override = default;
+
+    // IRHIContext interface
+    void BeginFrame() override;
+    void EndFrame() override;
+    void Clear(const DirectX::XMFLOAT4& color) override;
+    void SetViewProjection(const DirectX::XMFLOAT4X4& viewProj) override;
+    void SetLightData(const DirectX::XMFLOAT3& lightPos, const DirectX::XMFLOAT3& lightColor,
+        const DirectX::XMFLOAT3& cameraPos, const DirectX::XMFLOAT3& ambient,
+        float Kc, float Kl, float Kq) override;
+    void SetUnlitMode(bool unlit, const DirectX::XMFLOAT3& color) override;
+    void SetVertexFormat(VertexFormat format, const DirectX::XMFLOAT3& positionOffset,
+        const DirectX::XMFLOAT3& positionScale) override;
+    void DrawPrimitives(IRHIBuffer* vb, IRHIBuffer* ib,
+        const DirectX::XMFLOAT4X4& worldMatrix) override;
+    void DrawPrimitivesInstanced(IRHIBuffer* vb, IRHIBuffer* ib,
+        const DirectX::XMFLOAT4X4* worldMatrices, uint32 instanceCount) override;
+    void DrawPrimitivesRange(IRHIBuffer* vb, IRHIBuffer* ib,
+        uint32 firstIndex, uint32 indexCount, const DirectX::XMFLOAT4X4& worldMatrix) override;
+    void DrawText(int x, int y, const char* text,
+        const DirectX::XMFLOAT4& color) override;
+    void SetRenderTarget(IRHITexture* target) override;
+    uint64 ReadPixels(IRHITexture* target) override;
+    ReadbackStatus ResolveReadback(uint64 ticket, uint32* pixels) override;
+    void WaitForGPU() override {}
+
+    const LinearAllocator& GetFrameAllocator() const { return m_frameAllocator; }
+
+private:
+    struct Readback
+    {
+        uint64 ticket;
+        uint64 frame;       // completes once m_frameNumber passes this
+        uint32 pixelCount;
+    };
+
+    bool WriteConstants(const DirectX::XMFLOAT4X4& worldMatrix, bool instanced);
+
+    NullRHIStats* m_stats;
+    PerObjectConstants m_frameConstants = {};   // everything but world/instanced
+    NullPageSource m_pages;
+    LinearAllocator m_frameAllocator;
+    uint64 m_frameNumber = 0;
+    std::vector<Readback> m_readbacks;
+    uint64 m_nextTicket = 1;
+};
+
+} // namespace RRE
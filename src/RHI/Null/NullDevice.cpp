@@ -0,0 +1,46 @@
+#include "RHI/Null/NullDevice.h"
+#include "RHI/Null/NullBuffer.h"
+#include "RHI/Null/NullTexture.h"
+
+namespace RRE
+{
+
+NullDevice::NullDevice()
+    : m_context(&m_stats)
+{
+}
+
+bool NullDevice::Initialize(void* windowHandle, uint32 width, uint32 height)
+{
+    (void)windowHandle;
+    m_width = width;
+    m_height = height;
+    return true;
+}
+
+void NullDevice::OnResize(uint32 width, uint32 height)
+{
+    m_width = width;
+    m_height = height;
+}
+
+std::unique_ptr<IRHIBuffer> NullDevice::CreateBuffer(const void* data, uint32 size, uint32 stride)
+{
+    m_stats.buffersCreated++;
+    if (data)
+    {
+        m_stats.bytesUploaded += size;
+    }
+    return std::make_unique<NullBuffer>(&m_stats, size, stride);
+}
+
+std::unique_ptr<IRHITexture> NullDevice::CreateRenderTarget(uint32 width, uint32 height)
+{
+    if (width == 0 || height == 0)
+        return nullptr;
+
+    m_stats.renderTargetsCreated++;
+    return std::make_unique<NullTexture>(width, height);
+}
+
+} // namespace RRE
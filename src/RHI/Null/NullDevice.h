@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Core/Types.h"
+#include "RHI/RHIDevice.h"
+#include "RHI/Null/NullContext.h"
+
+namespace RRE
+{
+
+// Headless backend for CPU-only benchmarks and CI (no window, no GPU)
+class NullDevice : public IRHIDevice
+{
+public:
+    NullDevice();
+    ~NullDevice() override = default;
+
+    // IRHIDevice interface
+    bool Initialize(void* windowHandle, uint32 width, uint32 height) override;
+    void Shutdown() override {}
+    void OnResize(uint32 width, uint32 height) override;
+    IRHIContext* GetContext() override { return &m_context; }
+    std::unique_ptr<IRHIBuffer> CreateBuffer(const void* data, uint32 size, uint32 stride) override;
+    std::unique_ptr<IRHITexture> CreateRenderTarget(uint32 width, uint32 height) override;
+
+    const NullRHIStats& GetStats() const { return m_stats; }
+    void ResetStats() { m_stats = {}; }
+
+    uint32 GetWidth() const { return m_width; }
+    uint32 GetHeight() const { return m_height; }
+
+private:
+    NullRHIStats m_stats;
+    NullContext m_context;
+    uint32 m_width = 0;
+    uint32 m_height = 0;
+};
+
+} // namespace RRE
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Core/Types.h"
+#include "RHI/RHITexture.h"
+
+namespace RRE
+{
+
+// Dimensions only; nothing is rendered into it
+class NullTexture : public IRHITexture
+{
+public:
+    NullTexture(uint32 width, uint32 height) : m_width(width), m_height(height) {}
+    ~NullTexture() override = default;
+
+    // IRHITexture interface
+    uint32 GetWidth() const override { return m_width; }
+    uint32 GetHeight() const override { return m_height; }
+
+private:
+    uint32 m_width;
+    uint32 m_height;
+};
+
+} // namespace RRE
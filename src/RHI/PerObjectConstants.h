@@ -0,0 +1,38 @@
+#pragma once
+
+#include <DirectXMath.h>
+
+namespace RRE
+{
+
+// Constant buffer data passed to the GPU per draw call (matches PerObjectCB
+// in BasicColor.hlsl)
+struct PerObjectConstants
+{
+    DirectX::XMFLOAT4X4 world;          // 64
+    DirectX::XMFLOAT4X4 viewProj;       // 64
+    DirectX::XMFLOAT3 lightPosition;    // 12
+    float _pad1;                         // 4
+    DirectX::XMFLOAT3 lightColor;       // 12
+    float _pad2;                         // 4
+    DirectX::XMFLOAT3 cameraPosition;   // 12
+    float _pad3;                         // 4
+    DirectX::XMFLOAT3 ambientColor;     // 12
+    float _pad4;                         // 4
+    float Kc;                            // 4
+    float Kl;                            // 4
+    float Kq;                            // 4
+    float unlit;                         // 4
+    DirectX::XMFLOAT3 colorOverride;    // 12
+    float instanced;                     // 4 (1 = world from instance buffer)
+    DirectX::XMFLOAT3 positionOffset;   // 12 (compact vertices: offset + unorm * scale)
+    float compactVertices;               // 4 (1 = CompactVertex layout)
+    DirectX::XMFLOAT3 positionScale;    // 12
+    float _pad5;                         // 4
+};  // Total: 256 bytes
+static_assert(sizeof(PerObjectConstants) <= 256, "PerObjectConstants exceeds 256-byte CB slot");
+
+// Constant buffer placement alignment shared by all backends
+inline constexpr unsigned int CONSTANT_BUFFER_ALIGNMENT = 256;
+
+} // namespace RRE
@@ -5,6 +5,23 @@
 namespace RRE
 {
 
+enum class IndexFormat : uint32
+{
+    UInt16,
+    UInt32,
+};
+
+// 16-bit indices when every vertex is addressable (fewer than 65536)
+inline IndexFormat SelectIndexFormat(uint64 vertexCount)
+{
+    return vertexCount < 65536 ? IndexFormat::UInt16 : IndexFormat::UInt32;
+}
+
+inline uint32 GetIndexSize(IndexFormat format)
+{
+    return format == IndexFormat::UInt16 ? sizeof(uint16) : sizeof(uint32);
+}
+
 class IRHIBuffer
 {
 public:
@@ -13,6 +30,13 @@ public:
     virtual void SetData(const void* data, uint32 size, uint32 stride) = 0;
     virtual uint32 GetSize() const = 0;
     virtual uint32 GetStride() const = 0;
+
+    // Index buffers carry their format as the stride (2 = 16-bit, else 32-bit)
+    IndexFormat GetIndexFormat() const
+    {
+        return GetStride() == sizeof(uint16) ? IndexFormat::UInt16 : IndexFormat::UInt32;
+    }
+    uint32 GetIndexCount() const { return GetSize() / GetIndexSize(GetIndexFormat()); }
 };
 
 } // namespace RRE
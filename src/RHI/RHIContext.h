@@ -7,6 +7,15 @@ namespace RRE
 {
 
 class IRHIBuffer;
+class IRHITexture;
+enum class VertexFormat : uint32;
+
+enum class ReadbackStatus
+{
+    Pending,    // the frame that copies the pixels has not finished yet
+    Ready,      // pixels were copied out and the ticket released
+    Invalid     // unknown or already resolved ticket
+};
 
 class IRHIContext
 {
@@ -16,10 +25,44 @@ public:
     virtual void BeginFrame() = 0;
     virtual void EndFrame() = 0;
     virtual void Clear(const DirectX::XMFLOAT4& color) = 0;
+
+    // Frame state picked up by subsequent draws
+    virtual void SetViewProjection(const DirectX::XMFLOAT4X4& viewProj) = 0;
+    virtual void SetLightData(const DirectX::XMFLOAT3& lightPos, const DirectX::XMFLOAT3& lightColor,
+        const DirectX::XMFLOAT3& cameraPos, const DirectX::XMFLOAT3& ambient,
+        float Kc, float Kl, float Kq) = 0;
+    virtual void SetUnlitMode(bool unlit, const DirectX::XMFLOAT3& color) = 0;
+    // Layout of the vertex buffers of subsequent draws (Full until set).
+    // Compact positions decode as positionOffset + unorm * positionScale.
+    virtual void SetVertexFormat(VertexFormat format, const DirectX::XMFLOAT3& positionOffset,
+        const DirectX::XMFLOAT3& positionScale) = 0;
+
     virtual void DrawPrimitives(IRHIBuffer* vb, IRHIBuffer* ib,
         const DirectX::XMFLOAT4X4& worldMatrix) = 0;
+    // One draw of the same buffers per world matrix (same layout as DrawPrimitives)
+    virtual void DrawPrimitivesInstanced(IRHIBuffer* vb, IRHIBuffer* ib,
+        const DirectX::XMFLOAT4X4* worldMatrices, uint32 instanceCount) = 0;
+    // Draw indexCount indices starting at firstIndex (clamped to the buffer),
+    // e.g. a run of visible meshlets
+    virtual void DrawPrimitivesRange(IRHIBuffer* vb, IRHIBuffer* ib,
+        uint32 firstIndex, uint32 indexCount, const DirectX::XMFLOAT4X4& worldMatrix) = 0;
     virtual void DrawText(int x, int y, const char* text,
         const DirectX::XMFLOAT4& color) = 0;
+
+    // Redirect Clear and draws to an offscreen target (nullptr = back buffer).
+    // Binding lasts until the end of the frame; BeginFrame restores the back buffer.
+    virtual void SetRenderTarget(IRHITexture* target) = 0;
+
+    // Queue a copy of the target's pixels after the work recorded so far and
+    // return a ticket (0 on failure). Never waits: the copy completes with
+    // the frame it was recorded in, so poll ResolveReadback on later frames.
+    virtual uint64 ReadPixels(IRHITexture* target) = 0;
+    // On Ready, writes width x height tightly packed RGBA8 pixels
+    // (R | G << 8 | B << 16 | A << 24) and releases the ticket
+    virtual ReadbackStatus ResolveReadback(uint64 ticket, uint32* pixels) = 0;
+
+    // Block until all submitted work has finished
+    virtual void WaitForGPU() = 0;
 };
 
 } // namespace RRE
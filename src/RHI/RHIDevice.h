@@ -1,6 +1,9 @@
 #pragma once
 
 #include "Core/Types.h"
+#include "RHI/RHIBuffer.h"
+#include "RHI/RHITexture.h"
+#include <memory>
 
 namespace RRE
 {
@@ -16,6 +19,12 @@ public:
     virtual void Shutdown() = 0;
     virtual void OnResize(uint32 width, uint32 height) = 0;
     virtual IRHIContext* GetContext() = 0;
+
+    // Vertex/index buffer filled with data (nullptr on failure)
+    virtual std::unique_ptr<IRHIBuffer> CreateBuffer(const void* data, uint32 size, uint32 stride) = 0;
+
+    // Offscreen color + depth target (nullptr on failure)
+    virtual std::unique_ptr<IRHITexture> CreateRenderTarget(uint32 width, uint32 height) = 0;
 };
 
 } // namespace RRE
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Core/Types.h"
+
+namespace RRE
+{
+
+// Offscreen color target (RGBA8 UNORM) with its own depth buffer, created by
+// IRHIDevice::CreateRenderTarget and bound with IRHIContext::SetRenderTarget.
+// Destroy it only once the frames that used it have finished (WaitForGPU or
+// after its readbacks resolved).
+class IRHITexture
+{
+public:
+    virtual ~IRHITexture() = default;
+
+    virtual uint32 GetWidth() const = 0;
+    virtual uint32 GetHeight() const = 0;
+};
+
+} // namespace RRE
@@ -0,0 +1,22 @@
+#include "RHI/Software/SoftwareBuffer.h"
+#include <cstring>
+
+namespace RRE
+{
+
+SoftwareBuffer::SoftwareBuffer(const void* data, uint32 size, uint32 stride)
+{
+    SetData(data, size, stride);
+}
+
+void SoftwareBuffer::SetData(const void* data, uint32 size, uint32 stride)
+{
+    m_data.resize(size);
+    m_stride = stride;
+    if (data && size > 0)
+    {
+        memcpy(m_data.data(), data, size);
+    }
+}
+
+} // namespace RRE
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Core/Types.h"
+#include "RHI/RHIBuffer.h"
+#include <vector>
+
+namespace RRE
+{
+
+// System-memory copy of vertex or index data read by the software rasterizer
+class SoftwareBuffer : public IRHIBuffer
+{
+public:
+    SoftwareBuffer(const void* data, uint32 size, uint32 stride);
+    ~SoftwareBuffer() override = default;
+
+    // IRHIBuffer interface
+    void SetData(const void* data, uint32 size, uint32 stride) override;
+    uint32 GetSize() const override { return static_cast<uint32>(m_data.size()); }
+    uint32 GetStride() const override { return m_stride; }
+
+    const uint8* GetData() const { return m_data.data(); }
+    uint32 GetElementCount() const { return m_stride > 0 ? GetSize() / m_stride : 0; }
+
+private:
+    std::vector<uint8> m_data;
+    uint32 m_stride = 0;
+};
+
+} // namespace RRE
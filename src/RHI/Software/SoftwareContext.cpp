@@ -0,0 +1,204 @@
+#include "RHI/Software/SoftwareContext.h"
+#include "RHI/Software/SoftwareBuffer.h"
+#include "Renderer/Vertex.h"
+#include <algorithm>
+
+namespace RRE
+{
+
+SoftwareContext::SoftwareContext(ThreadPool* pool)
+    : m_pool(pool)
+{
+    DirectX::XMStoreFloat4x4(&m_frameConstants.viewProj, DirectX::XMMatrixIdentity());
+    DirectX::XMStoreFloat4x4(&m_frameConstants.world, DirectX::XMMatrixIdentity());
+}
+
+void SoftwareContext::BeginFrame()
+{
+    m_frame.Reset();
+    m_constantsDirty = true;
+    m_target = &m_backBuffer;
+}
+
+void SoftwareContext::EndFrame()
+{
+    Flush();
+}
+
+void SoftwareContext::Flush()
+{
+    if (m_frame.clear || !m_frame.draws.empty())
+    {
+        m_rasterizer.Render(m_frame, *m_target, m_pool);
+    }
+    m_frame.Reset();
+}
+
+void SoftwareContext::Clear(const DirectX::XMFLOAT4& color)
+{
+    // Clearing is done per tile during rasterization; draws recorded before
+    // the clear are dropped, as they would be overwritten
+    m_frame.Reset();
+    m_frame.clear = true;
+    m_frame.clearColor = color;
+    m_constantsDirty = true;
+}
+
+void SoftwareContext::SetViewProjection(const DirectX::XMFLOAT4X4& viewProj)
+{
+    m_frameConstants.viewProj = viewProj;
+    m_constantsDirty = true;
+}
+
+void SoftwareContext::SetLightData(const DirectX::XMFLOAT3& lightPos, const DirectX::XMFLOAT3& lightColor,
+    const DirectX::XMFLOAT3& cameraPos, const DirectX::XMFLOAT3& ambient,
+    float Kc, float Kl, float Kq)
+{
+    m_frameConstants.lightPosition = lightPos;
+    m_frameConstants.lightColor = lightColor;
+    m_frameConstants.cameraPosition = cameraPos;
+    m_frameConstants.ambientColor = ambient;
+    m_frameConstants.Kc = Kc;
+    m_frameConstants.Kl = Kl;
+    m_frameConstants.Kq = Kq;
+    m_constantsDirty = true;
+}
+
+void SoftwareContext::SetUnlitMode(bool unlit, const DirectX::XMFLOAT3& color)
+{
+    m_frameConstants.unlit = unlit ? 1.0f : 0.0f;
+    m_frameConstants.colorOverride = color;
+    m_constantsDirty = true;
+}
+
+void SoftwareContext::SetVertexFormat(VertexFormat format, const DirectX::XMFLOAT3& positionOffset,
+    const DirectX::XMFLOAT3& positionScale)
+{
+    m_frameConstants.compactVertices = format == VertexFormat::Compact ? 1.0f : 0.0f;
+    m_frameConstants.positionOffset = positionOffset;
+    m_frameConstants.positionScale = positionScale;
+    m_constantsDirty = true;
+}
+
+uint32 SoftwareContext::PushConstants()
+{
+    if (m_constantsDirty || m_frame.constants.empty())
+    {
+        m_frame.constants.push_back(m_frameConstants);
+        m_constantsDirty = false;
+    }
+    return static_cast<uint32>(m_frame.constants.size() - 1);
+}
+
+void SoftwareContext::DrawPrimitives(IRHIBuffer* vb, IRHIBuffer* ib,
+    const DirectX::XMFLOAT4X4& worldMatrix)
+{
+    DrawPrimitivesInstanced(vb, ib, &worldMatrix, 1);
+}
+
+void SoftwareContext::DrawPrimitivesInstanced(IRHIBuffer* vb, IRHIBuffer* ib,
+    const DirectX::XMFLOAT4X4* worldMatrices, uint32 instanceCount)
+{
+    RecordDraw(vb, ib, 0, UINT32_MAX, worldMatrices, instanceCount);
+}
+
+void SoftwareContext::DrawPrimitivesRange(IRHIBuffer* vb, IRHIBuffer* ib,
+    uint32 firstIndex, uint32 indexCount, const DirectX::XMFLOAT4X4& worldMatrix)
+{
+    RecordDraw(vb, ib, firstIndex, indexCount, &worldMatrix, 1);
+}
+
+void SoftwareContext::RecordDraw(IRHIBuffer* vb, IRHIBuffer* ib, uint32 firstIndex, uint32 indexCount,
+    const DirectX::XMFLOAT4X4* worldMatrices, uint32 instanceCount)
+{
+    if (!vb || !ib || !worldMatrices || instanceCount == 0)
+        return;
+
+    // Whole triangles inside the buffer
+    uint32 bufferTriangles = ib->GetIndexCount() / 3;
+    uint32 firstTriangle = std::min(firstIndex / 3, bufferTriangles);
+    uint32 triangleCount = std::min(indexCount / 3, bufferTriangles - firstTriangle);
+    if (triangleCount == 0)
+        return;
+
+    SoftwareDraw draw;
+    draw.vb = static_cast<SoftwareBuffer*>(vb);
+    draw.ib = static_cast<SoftwareBuffer*>(ib);
+    draw.firstTriangle = firstTriangle;
+    draw.triangleCount = triangleCount;
+    draw.constantsIndex = PushConstants();
+    draw.firstWorld = static_cast<uint32>(m_frame.worlds.size());
+    draw.instanceCount = instanceCount;
+
+    m_frame.worlds.insert(m_frame.worlds.end(), worldMatrices, worldMatrices + instanceCount);
+    m_frame.draws.push_back(draw);
+}
+
+void SoftwareContext::SetRenderTarget(IRHITexture* target)
+{
+    Flush();
+    m_target = target ? static_cast<SoftwareTexture*>(target) : &m_backBuffer;
+}
+
+uint64 SoftwareContext::ReadPixels(IRHITexture* target)
+{
+    auto* texture = static_cast<SoftwareTexture*>(target);
+    if (!texture || texture->GetWidth() == 0 || texture->GetHeight() == 0)
+        return 0;
+
+    if (texture == m_target)
+    {
+        Flush();
+    }
+
+    Readback* slot = nullptr;
+    for (Readback& readback : m_readbacks)
+    {
+        if (readback.ticket == 0)
+        {
+            slot = &readback;
+            break;
+        }
+    }
+    if (!slot)
+    {
+        m_readbacks.emplace_back();
+        slot = &m_readbacks.back();
+    }
+
+    slot->ticket = m_nextTicket++;
+    slot->pixels.resize(static_cast<size_t>(texture->GetWidth()) * texture->GetHeight());
+    texture->ReadPixels(slot->pixels.data());
+    return slot->ticket;
+}
+
+ReadbackStatus SoftwareContext::ResolveReadback(uint64 ticket, uint32* pixels)
+{
+    if (ticket == 0)
+        return ReadbackStatus::Invalid;
+
+    for (Readback& readback : m_readbacks)
+    {
+        if (readback.ticket == ticket)
+        {
+            if (pixels)
+            {
+                std::copy(readback.pixels.begin(), readback.pixels.end(), pixels);
+            }
+            readback.ticket = 0;
+            return ReadbackStatus::Ready;
+        }
+    }
+    return ReadbackStatus::Invalid;
+}
+
+void SoftwareContext::DrawText(int x, int y, const char* text,
+    const DirectX::XMFLOAT4& color)
+{
+    (void)x;
+    (void)y;
+    (void)text;
+    (void)color;
+}
+
+} // namespace RRE
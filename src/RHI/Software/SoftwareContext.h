@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Core/Types.h"
+#include "RHI/RHIContext.h"
+#include "RHI/PerObjectConstants.h"
+#include "RHI/Software/SoftwareRasterizer.h"
+#include "RHI/Software/SoftwareTexture.h"
+#include <vector>
+
+namespace RRE
+{
+
+class ThreadPool;
+
+// Records draws between BeginFrame and EndFrame; EndFrame rasterizes the
+// whole frame on the CPU, so the color buffer is complete when it returns.
+// Switching targets or reading pixels mid-frame rasterizes what was recorded
+// so far, which makes every readback ready as soon as ReadPixels returns.
+class SoftwareContext : public IRHIContext
+{
+public:
+    explicit SoftwareContext(ThreadPool* pool);
+    ~SoftwareContext() override = default;
+
+    void Resize(uint32 width, uint32 height) { m_backBuffer.Resize(width, height); }
+
+    // IRHIContext interface
+    void BeginFrame() override;
+    void EndFrame() override;
+    void Clear(const DirectX::XMFLOAT4& color) override;
+    void SetViewProjection(const DirectX::XMFLOAT4X4& viewProj) override;
+    void SetLightData(const DirectX::XMFLOAT3& lightPos, const DirectX::XMFLOAT3& lightColor,
+        const DirectX::XMFLOAT3& cameraPos, const DirectX::XMFLOAT3& ambient,
+        float Kc, float Kl, float Kq) override;
+    void SetUnlitMode(bool unlit, const DirectX::XMFLOAT3& color) override;
+    void SetVertexFormat(VertexFormat format, const DirectX::XMFLOAT3& positionOffset,
+        const DirectX::XMFLOAT3& positionScale) override;
+    void DrawPrimitives(IRHIBuffer* vb, IRHIBuffer* ib,
+        const DirectX::XMFLOAT4X4& worldMatrix) override;
+    void DrawPrimitivesInstanced(IRHIBuffer* vb, IRHIBuffer* ib,
+        const DirectX::XMFLOAT4X4* worldMatrices, uint32 instanceCount) override;
+    void DrawPrimitivesRange(IRHIBuffer* vb, IRHIBuffer* ib,
+        uint32 firstIndex, uint32 indexCount, const DirectX::XMFLOAT4X4& worldMatrix) override;
+    // Text is not rasterized by this backend
+    void DrawText(int x, int y, const char* text,
+        const DirectX::XMFLOAT4& color) override;
+    void SetRenderTarget(IRHITexture* target) override;
+    uint64 ReadPixels(IRHITexture* target) override;
+    ReadbackStatus ResolveReadback(uint64 ticket, uint32* pixels) override;
+    void WaitForGPU() override {}
+
+    const SoftwareRasterizer& GetRasterizer() const { return m_rasterizer; }
+    const SoftwareTexture& GetBackBuffer() const { return m_backBuffer; }
+
+private:
+    struct Readback
+    {
+        uint64 ticket = 0;      // 0 = free slot (pixel storage kept for reuse)
+        std::vector<uint32> pixels;
+    };
+
+    // Snapshot of the current frame state for the next draw
+    uint32 PushConstants();
+    // Shared path for all draw entry points
+    void RecordDraw(IRHIBuffer* vb, IRHIBuffer* ib, uint32 firstIndex, uint32 indexCount,
+        const DirectX::XMFLOAT4X4* worldMatrices, uint32 instanceCount);
+    // Rasterize everything recorded so far into the current target
+    void Flush();
+
+    ThreadPool* m_pool;
+    SoftwareTexture m_backBuffer;
+    SoftwareTexture* m_target = &m_backBuffer;
+    std::vector<Readback> m_readbacks;
+    uint64 m_nextTicket = 1;
+    PerObjectConstants m_frameConstants = {};
+    bool m_constantsDirty = true;
+    SoftwareFrame m_frame;
+    SoftwareRasterizer m_rasterizer;
+};
+
+} // namespace RRE
@@ -0,0 +1,48 @@
+#include "RHI/Software/SoftwareDevice.h"
+#include "RHI/Software/SoftwareBuffer.h"
+#include "Core/ImageWriter.h"
+
+namespace RRE
+{
+
+SoftwareDevice::SoftwareDevice(uint32 threadCount)
+    : m_pool(threadCount)
+    , m_context(&m_pool)
+{
+}
+
+bool SoftwareDevice::Initialize(void* windowHandle, uint32 width, uint32 height)
+{
+    (void)windowHandle;
+    if (width == 0 || height == 0)
+        return false;
+
+    m_context.Resize(width, height);
+    return true;
+}
+
+void SoftwareDevice::OnResize(uint32 width, uint32 height)
+{
+    m_context.Resize(width, height);
+}
+
+std::unique_ptr<IRHIBuffer> SoftwareDevice::CreateBuffer(const void* data, uint32 size, uint32 stride)
+{
+    return std::make_unique<SoftwareBuffer>(data, size, stride);
+}
+
+std::unique_ptr<IRHITexture> SoftwareDevice::CreateRenderTarget(uint32 width, uint32 height)
+{
+    if (width == 0 || height == 0)
+        return nullptr;
+    return std::make_unique<SoftwareTexture>(width, height);
+}
+
+bool SoftwareDevice::SaveFramebuffer(const char* path) const
+{
+    const SoftwareTexture& backBuffer = m_context.GetBackBuffer();
+    return ImageWriter::WritePPM(path, backBuffer.GetColorBuffer(),
+        backBuffer.GetWidth(), backBuffer.GetHeight(), backBuffer.GetPitch());
+}
+
+} // namespace RRE
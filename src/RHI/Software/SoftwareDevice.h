@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Core/Types.h"
+#include "Core/ThreadPool.h"
+#include "RHI/RHIDevice.h"
+#include "RHI/Software/SoftwareContext.h"
+
+namespace RRE
+{
+
+// CPU rendering backend for machines without a GPU. Renders off-screen (the
+// window handle is ignored) into a system-memory back buffer; read the result
+// back or save it to disk.
+class SoftwareDevice : public IRHIDevice
+{
+public:
+    // threadCount = worker threads besides the caller (0 = hardware threads - 1)
+    explicit SoftwareDevice(uint32 threadCount = 0);
+    ~SoftwareDevice() override = default;
+
+    // IRHIDevice interface
+    bool Initialize(void* windowHandle, uint32 width, uint32 height) override;
+    void Shutdown() override {}
+    void OnResize(uint32 width, uint32 height) override;
+    IRHIContext* GetContext() override { return &m_context; }
+    std::unique_ptr<IRHIBuffer> CreateBuffer(const void* data, uint32 size, uint32 stride) override;
+    std::unique_ptr<IRHITexture> CreateRenderTarget(uint32 width, uint32 height) override;
+
+    const SoftwareRasterizer& GetRasterizer() const { return m_context.GetRasterizer(); }
+    const SoftwareTexture& GetBackBuffer() const { return m_context.GetBackBuffer(); }
+
+    // Last completed frame as a binary PPM
+    bool SaveFramebuffer(const char* path) const;
+
+private:
+    ThreadPool m_pool;
+    SoftwareContext m_context;
+};
+
+} // namespace RRE
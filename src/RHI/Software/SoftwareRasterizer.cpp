@@ -0,0 +1,787 @@
+#include "RHI/Software/SoftwareRasterizer.h"
+#include "RHI/Software/SoftwareBuffer.h"
+#include "RHI/Software/SoftwareTexture.h"
+#include "Renderer/Vertex.h"
+#include "Renderer/VertexQuantizer.h"
+#include "Core/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <emmintrin.h>
+
+using namespace DirectX;
+
+namespace RRE
+{
+
+namespace
+{
+
+constexpr uint32 ATTRIBUTE_COUNT = 10;      // world position, normal, color
+constexpr uint32 CLIP_PLANE_COUNT = 6;      // near, far, 4 guard-band planes
+constexpr uint32 MAX_CLIP_VERTICES = 3 + CLIP_PLANE_COUNT;
+constexpr uint32 JOB_TRIANGLES = 4096;      // geometry work item size
+constexpr double SUBPIXEL_SCALE = 16.0;     // vertices snap to 1/16 pixel
+constexpr float GUARD_BAND = 32.0f;         // |x|, |y| <= GUARD_BAND * w after clipping
+
+} // anonymous namespace
+
+struct SoftwareClipVertex
+{
+    XMFLOAT4 position;                      // clip space
+    float attributes[ATTRIBUTE_COUNT];      // world xyz, normal xyz, color rgba
+};
+
+// Screen-space triangle ready for rasterization. Edge i runs from vertex i to
+// vertex i + 1; E(x, y) = A * x + B * y + C is positive inside. A and B are
+// multiples of 1/16 and C is exact in double, so an edge shared by two
+// triangles evaluates to exactly opposite values in both.
+struct SoftwareTriangle
+{
+    // a(x, y) = value + dx * (x - originX) + dy * (y - originY)
+    struct Plane
+    {
+        float dx;
+        float dy;
+        float value;
+    };
+
+    double edgeA[3];
+    double edgeB[3];
+    double edgeC[3];
+    uint32 topLeftMask;                 // bit i: edge i owns pixels exactly on it
+    int32 minX, minY, maxX, maxY;       // inclusive, clamped to the target
+    double originX, originY;            // vertex 0
+    Plane depth;
+    Plane invW;
+    Plane attributes[ATTRIBUTE_COUNT];  // attribute / w
+    uint32 draw;
+};
+
+struct SoftwareGeometryJob
+{
+    struct TileRef
+    {
+        uint32 tile;
+        uint32 triangle;
+    };
+
+    uint32 draw = 0;
+    uint32 instance = 0;
+    uint32 firstTriangle = 0;
+    uint32 triangleCount = 0;
+
+    std::vector<SoftwareTriangle> triangles;
+    std::vector<TileRef> bins;          // in triangle order
+    uint64 culled = 0;
+    uint64 clipped = 0;
+};
+
+namespace
+{
+
+// Target dimensions shared by the geometry jobs
+struct Viewport
+{
+    uint32 width;
+    uint32 height;
+    uint32 tilesX;
+};
+
+// Signed distance to clip plane `plane`; inside when >= 0
+float ClipDistance(const XMFLOAT4& p, uint32 plane)
+{
+    switch (plane)
+    {
+    case 0:  return p.z;                        // near (D3D depth range 0..w)
+    case 1:  return p.w - p.z;                  // far
+    case 2:  return p.x + GUARD_BAND * p.w;
+    case 3:  return GUARD_BAND * p.w - p.x;
+    case 4:  return p.y + GUARD_BAND * p.w;
+    default: return GUARD_BAND * p.w - p.y;
+    }
+}
+
+// Bit per clip plane the vertex is outside of
+uint32 ClipCode(const XMFLOAT4& p)
+{
+    uint32 code = 0;
+    for (uint32 plane = 0; plane < CLIP_PLANE_COUNT; ++plane)
+    {
+        if (ClipDistance(p, plane) < 0.0f)
+            code |= 1u << plane;
+    }
+    return code;
+}
+
+// Bit per view frustum plane the vertex is outside of
+uint32 FrustumCode(const XMFLOAT4& p)
+{
+    uint32 code = 0;
+    if (p.z < 0.0f)   code |= 1;
+    if (p.z > p.w)    code |= 2;
+    if (p.x < -p.w)   code |= 4;
+    if (p.x > p.w)    code |= 8;
+    if (p.y < -p.w)   code |= 16;
+    if (p.y > p.w)    code |= 32;
+    return code;
+}
+
+void LerpVertex(const SoftwareClipVertex& a, const SoftwareClipVertex& b, float t, SoftwareClipVertex& out)
+{
+    out.position.x = a.position.x + (b.position.x - a.position.x) * t;
+    out.position.y = a.position.y + (b.position.y - a.position.y) * t;
+    out.position.z = a.position.z + (b.position.z - a.position.z) * t;
+    out.position.w = a.position.w + (b.position.w - a.position.w) * t;
+    for (uint32 i = 0; i < ATTRIBUTE_COUNT; ++i)
+    {
+        out.attributes[i] = a.attributes[i] + (b.attributes[i] - a.attributes[i]) * t;
+    }
+}
+
+// Sutherland-Hodgman against the planes in planeMask; returns the vertex count
+uint32 ClipPolygon(SoftwareClipVertex* polygon, uint32 count, uint32 planeMask)
+{
+    SoftwareClipVertex clipped[MAX_CLIP_VERTICES];
+    for (uint32 plane = 0; plane < CLIP_PLANE_COUNT && count >= 3; ++plane)
+    {
+        if (!(planeMask & (1u << plane)))
+            continue;
+
+        uint32 outCount = 0;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            const SoftwareClipVertex& a = polygon[i];
+            const SoftwareClipVertex& b = polygon[(i + 1) % count];
+            float da = ClipDistance(a.position, plane);
+            float db = ClipDistance(b.position, plane);
+
+            if (da >= 0.0f)
+                clipped[outCount++] = a;
+            if ((da >= 0.0f) != (db >= 0.0f))
+                LerpVertex(a, b, da / (da - db), clipped[outCount++]);
+        }
+        std::copy(clipped, clipped + outCount, polygon);
+        count = outCount;
+    }
+    return count >= 3 ? count : 0;
+}
+
+// Project, snap, cull and compute edge/plane equations. Returns false for
+// back-facing, degenerate and off-screen triangles.
+bool SetupTriangle(const SoftwareClipVertex* v[3], uint32 draw, bool unlit,
+    const Viewport& viewport, SoftwareTriangle& out)
+{
+    double x[3];
+    double y[3];
+    float z[3];
+    float invW[3];
+    for (uint32 i = 0; i < 3; ++i)
+    {
+        const XMFLOAT4& p = v[i]->position;
+        invW[i] = 1.0f / p.w;
+        double sx = (p.x * invW[i] * 0.5 + 0.5) * viewport.width;
+        double sy = (0.5 - p.y * invW[i] * 0.5) * viewport.height;
+        x[i] = std::floor(sx * SUBPIXEL_SCALE + 0.5) / SUBPIXEL_SCALE;
+        y[i] = std::floor(sy * SUBPIXEL_SCALE + 0.5) / SUBPIXEL_SCALE;
+        z[i] = p.z * invW[i];
+    }
+
+    // Clockwise on screen (y down) is front-facing
+    double area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+    if (area <= 0.0)
+        return false;
+
+    double minX = std::max(std::floor(std::min({ x[0], x[1], x[2] })), 0.0);
+    double minY = std::max(std::floor(std::min({ y[0], y[1], y[2] })), 0.0);
+    double maxX = std::min(std::ceil(std::max({ x[0], x[1], x[2] })), viewport.width - 1.0);
+    double maxY = std::min(std::ceil(std::max({ y[0], y[1], y[2] })), viewport.height - 1.0);
+    if (minX > maxX || minY > maxY)
+        return false;
+
+    out.minX = static_cast<int32>(minX);
+    out.minY = static_cast<int32>(minY);
+    out.maxX = static_cast<int32>(maxX);
+    out.maxY = static_cast<int32>(maxY);
+
+    out.topLeftMask = 0;
+    for (uint32 i = 0; i < 3; ++i)
+    {
+        uint32 j = (i + 1) % 3;
+        double a = y[i] - y[j];
+        double b = x[j] - x[i];
+        out.edgeA[i] = a;
+        out.edgeB[i] = b;
+        out.edgeC[i] = -(a * x[i] + b * y[i]);
+
+        // Left edges run up the screen, top edges run right along it
+        if (a > 0.0 || (a == 0.0 && b > 0.0))
+            out.topLeftMask |= 1u << i;
+    }
+
+    out.originX = x[0];
+    out.originY = y[0];
+    double invArea = 1.0 / area;
+    auto makePlane = [&](float a0, float a1, float a2) {
+        double d1 = static_cast<double>(a1) - a0;
+        double d2 = static_cast<double>(a2) - a0;
+        SoftwareTriangle::Plane plane;
+        plane.dx = static_cast<float>((d1 * (y[2] - y[0]) - d2 * (y[1] - y[0])) * invArea);
+        plane.dy = static_cast<float>((d2 * (x[1] - x[0]) - d1 * (x[2] - x[0])) * invArea);
+        plane.value = a0;
+        return plane;
+    };
+
+    out.depth = makePlane(z[0], z[1], z[2]);
+    if (!unlit)
+    {
+        out.invW = makePlane(invW[0], invW[1], invW[2]);
+        for (uint32 k = 0; k < ATTRIBUTE_COUNT; ++k)
+        {
+            out.attributes[k] = makePlane(
+                v[0]->attributes[k] * invW[0],
+                v[1]->attributes[k] * invW[1],
+                v[2]->attributes[k] * invW[2]);
+        }
+    }
+    out.draw = draw;
+    return true;
+}
+
+// Append refs for every tile the triangle's edges do not exclude
+void BinTriangle(const SoftwareTriangle& tri, uint32 index, const Viewport& viewport,
+    SoftwareGeometryJob& job)
+{
+    const uint32 tileSize = SoftwareRasterizer::TILE_SIZE;
+    uint32 tx0 = tri.minX / tileSize;
+    uint32 ty0 = tri.minY / tileSize;
+    uint32 tx1 = tri.maxX / tileSize;
+    uint32 ty1 = tri.maxY / tileSize;
+
+    if (tx0 == tx1 && ty0 == ty1)
+    {
+        job.bins.push_back({ ty0 * viewport.tilesX + tx0, index });
+        return;
+    }
+
+    for (uint32 ty = ty0; ty <= ty1; ++ty)
+    {
+        double cy0 = ty * tileSize + 0.5;
+        double cy1 = std::min((ty + 1) * tileSize, viewport.height) - 0.5;
+        for (uint32 tx = tx0; tx <= tx1; ++tx)
+        {
+            double cx0 = tx * tileSize + 0.5;
+            double cx1 = std::min((tx + 1) * tileSize, viewport.width) - 0.5;
+
+            // Largest edge value over the tile's pixel centers
+            bool outside = false;
+            for (uint32 i = 0; i < 3 && !outside; ++i)
+            {
+                double e = tri.edgeA[i] * (tri.edgeA[i] > 0.0 ? cx1 : cx0)
+                    + tri.edgeB[i] * (tri.edgeB[i] > 0.0 ? cy1 : cy0) + tri.edgeC[i];
+                outside = e < 0.0;
+            }
+            if (!outside)
+                job.bins.push_back({ ty * viewport.tilesX + tx, index });
+        }
+    }
+}
+
+// BasicColor.hlsl VSMain for one vertex
+void TransformVertex(const Vertex& vertex, FXMMATRIX world, CXMMATRIX viewProj, SoftwareClipVertex& out)
+{
+    XMVECTOR worldPos = XMVector3Transform(XMLoadFloat3(&vertex.position), world);
+    XMStoreFloat4(&out.position, XMVector4Transform(worldPos, viewProj));
+
+    XMVECTOR normal = XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&vertex.normal), world));
+    XMFLOAT3 worldPos3;
+    XMFLOAT3 normal3;
+    XMStoreFloat3(&worldPos3, worldPos);
+    XMStoreFloat3(&normal3, normal);
+
+    float* a = out.attributes;
+    a[0] = worldPos3.x;
+    a[1] = worldPos3.y;
+    a[2] = worldPos3.z;
+    a[3] = normal3.x;
+    a[4] = normal3.y;
+    a[5] = normal3.z;
+    a[6] = vertex.color.x;
+    a[7] = vertex.color.y;
+    a[8] = vertex.color.z;
+    a[9] = vertex.color.w;
+}
+
+void ProcessGeometry(const SoftwareFrame& frame, SoftwareGeometryJob& job,
+    const Viewport& viewport, std::vector<SoftwareClipVertex>& transformed)
+{
+    job.triangles.clear();
+    job.bins.clear();
+    job.culled = 0;
+    job.clipped = 0;
+
+    const SoftwareDraw& draw = frame.draws[job.draw];
+    const PerObjectConstants& constants = frame.constants[draw.constantsIndex];
+    bool unlit = constants.unlit > 0.5f;
+
+    // Compact streams are decoded the way the vertex shader does it
+    bool compact = constants.compactVertices > 0.5f;
+    QuantizationRange range;
+    range.offset = constants.positionOffset;
+    range.scale = constants.positionScale;
+
+    const Vertex* vertices = reinterpret_cast<const Vertex*>(draw.vb->GetData());
+    const CompactVertex* compactVertices = reinterpret_cast<const CompactVertex*>(draw.vb->GetData());
+    uint32 vertexCount = draw.vb->GetSize() / (compact ? sizeof(CompactVertex) : sizeof(Vertex));
+    uint32 indexCount = job.triangleCount * 3;
+
+    // 16- or 32-bit indices, as the index buffer's stride says
+    bool shortIndices = draw.ib->GetIndexFormat() == IndexFormat::UInt16;
+    const uint16* indices16 = reinterpret_cast<const uint16*>(draw.ib->GetData()) + job.firstTriangle * 3;
+    const uint32* indices32 = reinterpret_cast<const uint32*>(draw.ib->GetData()) + job.firstTriangle * 3;
+    auto index = [&](uint32 i) -> uint32 { return shortIndices ? indices16[i] : indices32[i]; };
+
+    // Transform the vertex range this job references (mesh indices are local,
+    // so the range stays close to the job's own vertices)
+    uint32 firstVertex = UINT32_MAX;
+    uint32 lastVertex = 0;
+    for (uint32 i = 0; i < indexCount; ++i)
+    {
+        firstVertex = std::min(firstVertex, index(i));
+        lastVertex = std::max(lastVertex, index(i));
+    }
+    if (firstVertex > lastVertex || lastVertex >= vertexCount)
+        return;
+
+    // Constants hold transposed (HLSL column-major) matrices
+    XMMATRIX world = XMMatrixTranspose(XMLoadFloat4x4(&frame.worlds[draw.firstWorld + job.instance]));
+    XMMATRIX viewProj = XMMatrixTranspose(XMLoadFloat4x4(&constants.viewProj));
+
+    uint32 rangeSize = lastVertex - firstVertex + 1;
+    if (transformed.size() < rangeSize)
+        transformed.resize(rangeSize);
+    for (uint32 i = 0; i < rangeSize; ++i)
+    {
+        Vertex vertex = compact ? VertexQuantizer::Decode(compactVertices[firstVertex + i], range)
+                                : vertices[firstVertex + i];
+        TransformVertex(vertex, world, viewProj, transformed[i]);
+    }
+
+    for (uint32 i = 0; i < indexCount; i += 3)
+    {
+        const SoftwareClipVertex* v[3] = {
+            &transformed[index(i) - firstVertex],
+            &transformed[index(i + 1) - firstVertex],
+            &transformed[index(i + 2) - firstVertex],
+        };
+
+        if (FrustumCode(v[0]->position) & FrustumCode(v[1]->position) & FrustumCode(v[2]->position))
+        {
+            job.culled++;
+            continue;
+        }
+
+        uint32 clipCode = ClipCode(v[0]->position) | ClipCode(v[1]->position) | ClipCode(v[2]->position);
+        if (!clipCode)
+        {
+            SoftwareTriangle tri;
+            if (SetupTriangle(v, job.draw, unlit, viewport, tri))
+            {
+                BinTriangle(tri, static_cast<uint32>(job.triangles.size()), viewport, job);
+                job.triangles.push_back(tri);
+            }
+            else
+            {
+                job.culled++;
+            }
+            continue;
+        }
+
+        job.clipped++;
+        SoftwareClipVertex polygon[MAX_CLIP_VERTICES] = { *v[0], *v[1], *v[2] };
+        uint32 count = ClipPolygon(polygon, 3, clipCode);
+        for (uint32 k = 1; k + 1 < count; ++k)
+        {
+            const SoftwareClipVertex* fan[3] = { &polygon[0], &polygon[k], &polygon[k + 1] };
+            SoftwareTriangle tri;
+            if (SetupTriangle(fan, job.draw, unlit, viewport, tri))
+            {
+                BinTriangle(tri, static_cast<uint32>(job.triangles.size()), viewport, job);
+                job.triangles.push_back(tri);
+            }
+        }
+    }
+}
+
+// Saturate four RGBA float pixels and pack them to RGBA8
+__m128i PackRGBA8(__m128 r, __m128 g, __m128 b, __m128 a)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(255.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    auto toByte = [&](__m128 v) {
+        v = _mm_min_ps(_mm_max_ps(v, zero), one);
+        return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, scale), half));
+    };
+
+    __m128i packed = toByte(r);
+    packed = _mm_or_si128(packed, _mm_slli_epi32(toByte(g), 8));
+    packed = _mm_or_si128(packed, _mm_slli_epi32(toByte(b), 16));
+    packed = _mm_or_si128(packed, _mm_slli_epi32(toByte(a), 24));
+    return packed;
+}
+
+// A draw's pixel shader constants splatted across the four lanes
+struct ShadeConstants
+{
+    bool unlit;
+    __m128i unlitColor;
+    __m128 lightPos[3];
+    __m128 lightColor[3];
+    __m128 ambient[3];
+    __m128 Kc, Kl, Kq;
+};
+
+ShadeConstants MakeShadeConstants(const PerObjectConstants& c)
+{
+    ShadeConstants k;
+    k.unlit = c.unlit > 0.5f;
+    k.unlitColor = PackRGBA8(_mm_set1_ps(c.colorOverride.x), _mm_set1_ps(c.colorOverride.y),
+        _mm_set1_ps(c.colorOverride.z), _mm_set1_ps(1.0f));
+    k.lightPos[0] = _mm_set1_ps(c.lightPosition.x);
+    k.lightPos[1] = _mm_set1_ps(c.lightPosition.y);
+    k.lightPos[2] = _mm_set1_ps(c.lightPosition.z);
+    k.lightColor[0] = _mm_set1_ps(c.lightColor.x);
+    k.lightColor[1] = _mm_set1_ps(c.lightColor.y);
+    k.lightColor[2] = _mm_set1_ps(c.lightColor.z);
+    k.ambient[0] = _mm_set1_ps(c.ambientColor.x);
+    k.ambient[1] = _mm_set1_ps(c.ambientColor.y);
+    k.ambient[2] = _mm_set1_ps(c.ambientColor.z);
+    k.Kc = _mm_set1_ps(c.Kc);
+    k.Kl = _mm_set1_ps(c.Kl);
+    k.Kq = _mm_set1_ps(c.Kq);
+    return k;
+}
+
+// 1 / sqrt(x) refined with one Newton-Raphson step (~23 bits)
+__m128 ReciprocalSqrt(__m128 x)
+{
+    __m128 y = _mm_rsqrt_ps(x);
+    __m128 yyx = _mm_mul_ps(_mm_mul_ps(y, y), x);
+    return _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), y), _mm_sub_ps(_mm_set1_ps(3.0f), yyx));
+}
+
+__m128 Dot3(__m128 ax, __m128 ay, __m128 az, __m128 bx, __m128 by, __m128 bz)
+{
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+}
+
+// BasicColor.hlsl PSMain (lit path) for four pixels
+__m128i ShadeLit(const __m128* attr, const ShadeConstants& k)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    __m128 invNormalLength = ReciprocalSqrt(Dot3(attr[3], attr[4], attr[5], attr[3], attr[4], attr[5]));
+
+    __m128 lx = _mm_sub_ps(k.lightPos[0], attr[0]);
+    __m128 ly = _mm_sub_ps(k.lightPos[1], attr[1]);
+    __m128 lz = _mm_sub_ps(k.lightPos[2], attr[2]);
+    __m128 distanceSq = Dot3(lx, ly, lz, lx, ly, lz);
+    __m128 invDistance = ReciprocalSqrt(distanceSq);
+    __m128 d = _mm_mul_ps(distanceSq, invDistance);
+
+    // Distance attenuation
+    __m128 attenuation = _mm_div_ps(one,
+        _mm_add_ps(k.Kc, _mm_mul_ps(d, _mm_add_ps(k.Kl, _mm_mul_ps(k.Kq, d)))));
+
+    // Diffuse lighting: dot(normalize(n), normalize(L))
+    __m128 nDotL = _mm_mul_ps(Dot3(attr[3], attr[4], attr[5], lx, ly, lz),
+        _mm_mul_ps(invNormalLength, invDistance));
+    __m128 diffuse = _mm_mul_ps(_mm_max_ps(nDotL, zero), attenuation);
+
+    // (ambient + diffuse) * face color
+    __m128 r = _mm_mul_ps(_mm_add_ps(k.ambient[0], _mm_mul_ps(diffuse, k.lightColor[0])), attr[6]);
+    __m128 g = _mm_mul_ps(_mm_add_ps(k.ambient[1], _mm_mul_ps(diffuse, k.lightColor[1])), attr[7]);
+    __m128 b = _mm_mul_ps(_mm_add_ps(k.ambient[2], _mm_mul_ps(diffuse, k.lightColor[2])), attr[8]);
+    return PackRGBA8(r, g, b, attr[9]);
+}
+
+__m128 Select(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+constexpr uint32 BIT_COUNT4[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+// Rasterize one triangle inside [tileX0, tileX1) x [tileY0, tileY1); returns
+// the number of pixels written
+uint64 RasterizeTriangle(const SoftwareTriangle& tri, const ShadeConstants& shade,
+    int32 tileX0, int32 tileY0, int32 tileX1, int32 tileY1,
+    uint32* color, float* depth, uint32 pitch)
+{
+    // Tiles start on multiples of 4, so aligning down stays inside the tile
+    int32 startX = std::max(tri.minX, tileX0) & ~3;
+    int32 endX = std::min(tri.maxX, tileX1 - 1);
+    int32 startY = std::max(tri.minY, tileY0);
+    int32 endY = std::min(tri.maxY, tileY1 - 1);
+    if (startX > endX || startY > endY)
+        return 0;
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 laneOffsets = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    const __m128 lastX = _mm_set1_ps(static_cast<float>(endX));
+
+    __m128 edgeStep[3];
+    __m128 topLeft[3];
+    for (uint32 i = 0; i < 3; ++i)
+    {
+        edgeStep[i] = _mm_set1_ps(static_cast<float>(tri.edgeA[i]));
+        topLeft[i] = _mm_castsi128_ps(_mm_set1_epi32((tri.topLeftMask >> i) & 1 ? -1 : 0));
+    }
+
+    const bool unlit = shade.unlit;
+    const uint32 planeCount = unlit ? 1 : 2 + ATTRIBUTE_COUNT;
+    const SoftwareTriangle::Plane* planes[2 + ATTRIBUTE_COUNT] = { &tri.depth, &tri.invW };
+    for (uint32 k = 0; k < ATTRIBUTE_COUNT; ++k)
+    {
+        planes[2 + k] = &tri.attributes[k];
+    }
+    __m128 planeStep[2 + ATTRIBUTE_COUNT];
+    for (uint32 p = 0; p < planeCount; ++p)
+    {
+        planeStep[p] = _mm_set1_ps(planes[p]->dx);
+    }
+
+    uint64 pixels = 0;
+    double px = startX + 0.5;
+    for (int32 y = startY; y <= endY; ++y)
+    {
+        double py = y + 0.5;
+
+        // Row start values are rounded from exact doubles so shared edges
+        // stay exact mirrors of each other
+        __m128 rowEdge[3];
+        for (uint32 i = 0; i < 3; ++i)
+        {
+            rowEdge[i] = _mm_set1_ps(static_cast<float>(tri.edgeA[i] * px + tri.edgeB[i] * py + tri.edgeC[i]));
+        }
+        float dx = static_cast<float>(px - tri.originX);
+        float dy = static_cast<float>(py - tri.originY);
+        __m128 rowPlane[2 + ATTRIBUTE_COUNT];
+        for (uint32 p = 0; p < planeCount; ++p)
+        {
+            rowPlane[p] = _mm_set1_ps(planes[p]->value + planes[p]->dx * dx + planes[p]->dy * dy);
+        }
+
+        uint32* colorRow = color + static_cast<size_t>(y) * pitch;
+        float* depthRow = depth + static_cast<size_t>(y) * pitch;
+        for (int32 x = startX; x <= endX; x += 4)
+        {
+            __m128 offset = _mm_add_ps(_mm_set1_ps(static_cast<float>(x - startX)), laneOffsets);
+            __m128 inside = _mm_cmple_ps(_mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets), lastX);
+            for (uint32 i = 0; i < 3; ++i)
+            {
+                __m128 e = _mm_add_ps(rowEdge[i], _mm_mul_ps(edgeStep[i], offset));
+                __m128 covered = _mm_or_ps(_mm_cmpgt_ps(e, zero),
+                    _mm_and_ps(_mm_cmpeq_ps(e, zero), topLeft[i]));
+                inside = _mm_and_ps(inside, covered);
+            }
+            if (_mm_movemask_ps(inside) == 0)
+                continue;
+
+            __m128 z = _mm_add_ps(rowPlane[0], _mm_mul_ps(planeStep[0], offset));
+            __m128 storedZ = _mm_loadu_ps(depthRow + x);
+            __m128 pass = _mm_and_ps(inside, _mm_cmplt_ps(z, storedZ));
+            int mask = _mm_movemask_ps(pass);
+            if (mask == 0)
+                continue;
+
+            _mm_storeu_ps(depthRow + x, Select(pass, z, storedZ));
+            pixels += BIT_COUNT4[mask];
+
+            __m128i rgba = shade.unlitColor;
+            if (!unlit)
+            {
+                // Perspective-correct attributes: (a / w) / (1 / w)
+                __m128 w = _mm_div_ps(_mm_set1_ps(1.0f),
+                    _mm_add_ps(rowPlane[1], _mm_mul_ps(planeStep[1], offset)));
+                __m128 attr[ATTRIBUTE_COUNT];
+                for (uint32 k = 0; k < ATTRIBUTE_COUNT; ++k)
+                {
+                    attr[k] = _mm_mul_ps(_mm_add_ps(rowPlane[2 + k], _mm_mul_ps(planeStep[2 + k], offset)), w);
+                }
+                rgba = ShadeLit(attr, shade);
+            }
+
+            __m128i passMask = _mm_castps_si128(pass);
+            __m128i* target = reinterpret_cast<__m128i*>(colorRow + x);
+            __m128i old = _mm_loadu_si128(target);
+            _mm_storeu_si128(target, _mm_or_si128(_mm_and_si128(passMask, rgba), _mm_andnot_si128(passMask, old)));
+        }
+    }
+    return pixels;
+}
+
+uint32 PackColor(const XMFLOAT4& color)
+{
+    auto toByte = [](float v) {
+        return static_cast<uint32>(std::min(std::max(v, 0.0f), 1.0f) * 255.0f + 0.5f);
+    };
+    return toByte(color.x) | (toByte(color.y) << 8) | (toByte(color.z) << 16) | (toByte(color.w) << 24);
+}
+
+} // anonymous namespace
+
+void SoftwareFrame::Reset()
+{
+    clear = false;
+    draws.clear();
+    constants.clear();
+    worlds.clear();
+}
+
+SoftwareRasterizer::SoftwareRasterizer() = default;
+SoftwareRasterizer::~SoftwareRasterizer() = default;
+
+void SoftwareRasterizer::Render(const SoftwareFrame& frame, SoftwareTexture& target, ThreadPool* pool)
+{
+    m_stats = {};
+    uint32 width = target.GetWidth();
+    uint32 height = target.GetHeight();
+    if (width == 0 || height == 0)
+        return;
+
+    m_tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    uint32 tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+
+    auto parallelFor = [pool](uint32 count, uint32 grain, const std::function<void(uint32, uint32)>& fn) {
+        if (pool)
+            pool->ParallelFor(count, grain, fn);
+        else if (count > 0)
+            fn(0, count);
+    };
+
+    // Split draws into per-instance jobs of at most JOB_TRIANGLES triangles
+    uint32 jobCount = 0;
+    for (uint32 d = 0; d < static_cast<uint32>(frame.draws.size()); ++d)
+    {
+        const SoftwareDraw& draw = frame.draws[d];
+        if (!draw.vb || !draw.ib)
+            continue;
+
+        uint32 triangleCount = draw.triangleCount;
+        m_stats.triangles += static_cast<uint64>(triangleCount) * draw.instanceCount;
+        for (uint32 instance = 0; instance < draw.instanceCount; ++instance)
+        {
+            for (uint32 first = 0; first < triangleCount; first += JOB_TRIANGLES)
+            {
+                if (jobCount == m_jobs.size())
+                    m_jobs.emplace_back();
+
+                SoftwareGeometryJob& job = m_jobs[jobCount++];
+                job.draw = d;
+                job.instance = instance;
+                job.firstTriangle = draw.firstTriangle + first;
+                job.triangleCount = std::min(JOB_TRIANGLES, triangleCount - first);
+            }
+        }
+    }
+
+    // Transform, clip, set up and bin; each chunk has its own vertex scratch
+    Viewport viewport = { width, height, m_tilesX };
+    uint32 grain = jobCount / 64 + 1;
+    uint32 chunkCount = (jobCount + grain - 1) / grain;
+    if (m_vertexScratch.size() < chunkCount)
+        m_vertexScratch.resize(chunkCount);
+    parallelFor(jobCount, grain, [&](uint32 begin, uint32 end) {
+        std::vector<SoftwareClipVertex>& transformed = m_vertexScratch[begin / grain];
+        for (uint32 j = begin; j < end; ++j)
+        {
+            ProcessGeometry(frame, m_jobs[j], viewport, transformed);
+        }
+    });
+
+    // Stable counting sort of the bins by tile keeps submission order per tile
+    uint32 tileCount = m_tilesX * tilesY;
+    m_tileOffsets.assign(tileCount + 1, 0);
+    for (uint32 j = 0; j < jobCount; ++j)
+    {
+        const SoftwareGeometryJob& job = m_jobs[j];
+        for (const SoftwareGeometryJob::TileRef& ref : job.bins)
+        {
+            m_tileOffsets[ref.tile + 1]++;
+        }
+        m_stats.culled += job.culled;
+        m_stats.clipped += job.clipped;
+    }
+    for (uint32 t = 0; t < tileCount; ++t)
+    {
+        m_tileOffsets[t + 1] += m_tileOffsets[t];
+    }
+    m_stats.tileBins = m_tileOffsets[tileCount];
+
+    m_tileTriangles.resize(m_tileOffsets[tileCount]);
+    std::vector<uint32> cursor(m_tileOffsets.begin(), m_tileOffsets.end() - 1);
+    for (uint32 j = 0; j < jobCount; ++j)
+    {
+        const SoftwareGeometryJob& job = m_jobs[j];
+        for (const SoftwareGeometryJob::TileRef& ref : job.bins)
+        {
+            m_tileTriangles[cursor[ref.tile]++] = &job.triangles[ref.triangle];
+        }
+    }
+
+    // Tiles are disjoint, so each is cleared and rasterized by one worker
+    m_tilePixels.assign(tileCount, 0);
+    parallelFor(tileCount, 1, [&](uint32 begin, uint32 end) {
+        for (uint32 t = begin; t < end; ++t)
+        {
+            RasterizeTile(frame, target, t);
+        }
+    });
+    for (uint64 pixels : m_tilePixels)
+    {
+        m_stats.pixelsWritten += pixels;
+    }
+}
+
+void SoftwareRasterizer::RasterizeTile(const SoftwareFrame& frame, SoftwareTexture& target, uint32 tile)
+{
+    int32 x0 = static_cast<int32>((tile % m_tilesX) * TILE_SIZE);
+    int32 y0 = static_cast<int32>((tile / m_tilesX) * TILE_SIZE);
+    int32 x1 = std::min(x0 + static_cast<int32>(TILE_SIZE), static_cast<int32>(target.GetWidth()));
+    int32 y1 = std::min(y0 + static_cast<int32>(TILE_SIZE), static_cast<int32>(target.GetHeight()));
+    uint32 pitch = target.GetPitch();
+    uint32* color = target.GetColorBuffer();
+    float* depth = target.GetDepthBuffer();
+
+    if (frame.clear)
+    {
+        uint32 clearColor = PackColor(frame.clearColor);
+        for (int32 y = y0; y < y1; ++y)
+        {
+            size_t row = static_cast<size_t>(y) * pitch;
+            std::fill(color + row + x0, color + row + x1, clearColor);
+            std::fill(depth + row + x0, depth + row + x1, 1.0f);
+        }
+    }
+
+    uint64 pixels = 0;
+    uint32 shadeDraw = UINT32_MAX;
+    ShadeConstants shade;
+    for (uint32 i = m_tileOffsets[tile]; i < m_tileOffsets[tile + 1]; ++i)
+    {
+        const SoftwareTriangle& tri = *m_tileTriangles[i];
+        if (tri.draw != shadeDraw)
+        {
+            shade = MakeShadeConstants(frame.constants[frame.draws[tri.draw].constantsIndex]);
+            shadeDraw = tri.draw;
+        }
+        pixels += RasterizeTriangle(tri, shade, x0, y0, x1, y1, color, depth, pitch);
+    }
+    m_tilePixels[tile] = pixels;
+}
+
+} // namespace RRE
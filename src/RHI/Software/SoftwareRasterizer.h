@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Core/Types.h"
+#include "RHI/PerObjectConstants.h"
+#include <DirectXMath.h>
+#include <vector>
+
+namespace RRE
+{
+
+class SoftwareBuffer;
+class SoftwareTexture;
+class ThreadPool;
+struct SoftwareTriangle;
+struct SoftwareClipVertex;
+struct SoftwareGeometryJob;
+
+// One recorded draw: triangles [firstTriangle, +triangleCount) of ib for
+// instanceCount world matrices starting at firstWorld, shaded with
+// constants[constantsIndex] (matrices in HLSL layout)
+struct SoftwareDraw
+{
+    const SoftwareBuffer* vb = nullptr;
+    const SoftwareBuffer* ib = nullptr;
+    uint32 firstTriangle = 0;
+    uint32 triangleCount = 0;
+    uint32 constantsIndex = 0;
+    uint32 firstWorld = 0;
+    uint32 instanceCount = 0;
+};
+
+// Everything submitted between BeginFrame and EndFrame
+struct SoftwareFrame
+{
+    bool clear = false;
+    DirectX::XMFLOAT4 clearColor = { 0.0f, 0.0f, 0.0f, 1.0f };
+    std::vector<SoftwareDraw> draws;
+    std::vector<PerObjectConstants> constants;
+    std::vector<DirectX::XMFLOAT4X4> worlds;
+
+    void Reset();
+};
+
+// Counters for the last Render call
+struct SoftwareRasterStats
+{
+    uint64 triangles = 0;       // submitted (index count / 3 x instances)
+    uint64 culled = 0;          // back-facing, degenerate or off-screen
+    uint64 clipped = 0;         // needed near/far/guard-band clipping
+    uint64 tileBins = 0;        // triangle-tile pairs rasterized
+    uint64 pixelsWritten = 0;   // passed the depth test
+};
+
+// Tile-based CPU implementation of BasicColor.hlsl: vertices are transformed
+// and triangles set up and binned into TILE_SIZE screen tiles in parallel,
+// then every tile is rasterized by one worker with 4-wide SSE edge functions
+// into the target's RGBA8 color and 32-bit float depth planes. Matches the
+// D3D12 pipeline state: back-face culling (clockwise front), LESS depth test,
+// top-left fill rule, opaque output.
+class SoftwareRasterizer
+{
+public:
+    static constexpr uint32 TILE_SIZE = 64;
+
+    SoftwareRasterizer();
+    ~SoftwareRasterizer();
+
+    SoftwareRasterizer(const SoftwareRasterizer&) = delete;
+    SoftwareRasterizer& operator=(const SoftwareRasterizer&) = delete;
+
+    // pool may be null (single-threaded)
+    void Render(const SoftwareFrame& frame, SoftwareTexture& target, ThreadPool* pool);
+
+    const SoftwareRasterStats& GetStats() const { return m_stats; }
+
+private:
+    void RasterizeTile(const SoftwareFrame& frame, SoftwareTexture& target, uint32 tile);
+
+    uint32 m_tilesX = 0;
+
+    // Per-frame working storage (capacity kept across frames)
+    std::vector<SoftwareGeometryJob> m_jobs;
+    std::vector<std::vector<SoftwareClipVertex>> m_vertexScratch;   // per geometry chunk
+    std::vector<uint32> m_tileOffsets;                      // tileCount + 1
+    std::vector<const SoftwareTriangle*> m_tileTriangles;   // grouped by tile, submission order
+    std::vector<uint64> m_tilePixels;
+
+    SoftwareRasterStats m_stats;
+};
+
+} // namespace RRE
@@ -0,0 +1,25 @@
+#include "RHI/Software/SoftwareTexture.h"
+#include <cstring>
+
+namespace RRE
+{
+
+void SoftwareTexture::Resize(uint32 width, uint32 height)
+{
+    m_width = width;
+    m_height = height;
+    m_pitch = (width + 3) & ~3u;
+    m_color.assign(static_cast<size_t>(m_pitch) * height, 0);
+    m_depth.assign(static_cast<size_t>(m_pitch) * height, 1.0f);
+}
+
+void SoftwareTexture::ReadPixels(uint32* pixels) const
+{
+    for (uint32 y = 0; y < m_height; ++y)
+    {
+        memcpy(pixels + static_cast<size_t>(y) * m_width,
+            m_color.data() + static_cast<size_t>(y) * m_pitch, m_width * sizeof(uint32));
+    }
+}
+
+} // namespace RRE
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Core/Types.h"
+#include "RHI/RHITexture.h"
+#include <vector>
+
+namespace RRE
+{
+
+// System-memory color and depth planes rendered by the software rasterizer.
+// Rows are GetPitch() pixels apart so 4-wide spans never cross a row.
+class SoftwareTexture : public IRHITexture
+{
+public:
+    SoftwareTexture() = default;
+    SoftwareTexture(uint32 width, uint32 height) { Resize(width, height); }
+    ~SoftwareTexture() override = default;
+
+    // Reallocates both planes (color black, depth 1)
+    void Resize(uint32 width, uint32 height);
+
+    // IRHITexture interface
+    uint32 GetWidth() const override { return m_width; }
+    uint32 GetHeight() const override { return m_height; }
+
+    uint32 GetPitch() const { return m_pitch; }   // in pixels, multiple of 4
+
+    // Pixels are R | G << 8 | B << 16 | A << 24 (RGBA8 in memory order)
+    uint32* GetColorBuffer() { return m_color.data(); }
+    const uint32* GetColorBuffer() const { return m_color.data(); }
+    float* GetDepthBuffer() { return m_depth.data(); }
+    const float* GetDepthBuffer() const { return m_depth.data(); }
+
+    // Copy out as tightly packed rows (width x height)
+    void ReadPixels(uint32* pixels) const;
+
+private:
+    uint32 m_width = 0;
+    uint32 m_height = 0;
+    uint32 m_pitch = 0;
+    std::vector<uint32> m_color;
+    std::vector<float> m_depth;
+};
+
+} // namespace RRE
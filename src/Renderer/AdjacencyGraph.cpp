@@ -0,0 +1,179 @@
+#include "Renderer/AdjacencyGraph.h"
+#include <algorithm>
+
+namespace RRE
+{
+
+namespace
+{
+
+// Half-edges (face * 3 + corner, from corner to the next one) bucketed by
+// their smaller position: a counting sort over positions, so matching an
+// edge only scans the few edges that start at the same position
+struct EdgeBuckets
+{
+    std::vector<uint32> offsets;    // position count + 1
+    std::vector<uint32> halfEdges;
+
+    explicit EdgeBuckets(const std::vector<std::array<uint32, 3>>& faces)
+    {
+        uint32 faceCount = static_cast<uint32>(faces.size());
+        uint32 positionCount = 0;
+        for (const auto& face : faces)
+        {
+            positionCount = std::max(positionCount, std::max(face[0], std::max(face[1], face[2])) + 1);
+        }
+
+        offsets.assign(positionCount + 1, 0);
+        for (const auto& face : faces)
+        {
+            for (uint32 c = 0; c < 3; ++c)
+            {
+                ++offsets[std::min(face[c], face[(c + 1) % 3]) + 1];
+            }
+        }
+        for (uint32 p = 0; p < positionCount; ++p)
+        {
+            offsets[p + 1] += offsets[p];
+        }
+
+        halfEdges.resize(static_cast<size_t>(faceCount) * 3);
+        std::vector<uint32> fill(offsets.begin(), offsets.end() - 1);
+        for (uint32 f = 0; f < faceCount; ++f)
+        {
+            for (uint32 c = 0; c < 3; ++c)
+            {
+                halfEdges[fill[std::min(faces[f][c], faces[f][(c + 1) % 3])]++] = f * 3 + c;
+            }
+        }
+    }
+};
+
+uint32 UpperEnd(const std::vector<std::array<uint32, 3>>& faces, uint32 halfEdge)
+{
+    const auto& face = faces[halfEdge / 3];
+    uint32 c = halfEdge % 3;
+    return std::max(face[c], face[(c + 1) % 3]);
+}
+
+bool IsDegenerate(const std::vector<std::array<uint32, 3>>& faces, uint32 halfEdge)
+{
+    const auto& face = faces[halfEdge / 3];
+    uint32 c = halfEdge % 3;
+    return face[c] == face[(c + 1) % 3];
+}
+
+} // anonymous namespace
+
+AdjacencyGraph AdjacencyGraph::FromFaceEdges(const std::vector<std::array<uint32, 3>>& faces)
+{
+    uint32 faceCount = static_cast<uint32>(faces.size());
+    EdgeBuckets buckets(faces);
+    uint32 positionCount = static_cast<uint32>(buckets.offsets.size() - 1);
+
+    // Every pair of half-edges with the same endpoints joins their faces:
+    // count the pairs per face, then fill the rows
+    AdjacencyGraph graph;
+    graph.offsets.assign(faceCount + 1, 0);
+    auto forEachPair = [&](auto&& visit) {
+        for (uint32 p = 0; p < positionCount; ++p)
+        {
+            for (uint32 i = buckets.offsets[p]; i < buckets.offsets[p + 1]; ++i)
+            {
+                uint32 a = buckets.halfEdges[i];
+                if (IsDegenerate(faces, a))
+                    continue;
+                uint32 upper = UpperEnd(faces, a);
+                for (uint32 j = i + 1; j < buckets.offsets[p + 1]; ++j)
+                {
+                    uint32 b = buckets.halfEdges[j];
+                    if (UpperEnd(faces, b) == upper && a / 3 != b / 3)
+                        visit(a / 3, b / 3);
+                }
+            }
+        }
+    };
+
+    forEachPair([&](uint32 f, uint32 g) {
+        ++graph.offsets[f + 1];
+        ++graph.offsets[g + 1];
+    });
+    for (uint32 f = 0; f < faceCount; ++f)
+    {
+        graph.offsets[f + 1] += graph.offsets[f];
+    }
+    graph.neighbors.resize(graph.offsets[faceCount]);
+    std::vector<uint32> fill(graph.offsets.begin(), graph.offsets.end() - 1);
+    forEachPair([&](uint32 f, uint32 g) {
+        graph.neighbors[fill[f]++] = g;
+        graph.neighbors[fill[g]++] = f;
+    });
+
+    graph.SortRows();
+    return graph;
+}
+
+AdjacencyGraph AdjacencyGraph::FromPositionEdges(const std::vector<std::array<uint32, 3>>& faces,
+    uint32 positionCount)
+{
+    AdjacencyGraph graph;
+    graph.offsets.assign(positionCount + 1, 0);
+    for (const auto& face : faces)
+    {
+        for (uint32 c = 0; c < 3; ++c)
+        {
+            if (face[c] == face[(c + 1) % 3])
+                continue;
+            ++graph.offsets[face[c] + 1];
+            ++graph.offsets[face[(c + 1) % 3] + 1];
+        }
+    }
+    for (uint32 p = 0; p < positionCount; ++p)
+    {
+        graph.offsets[p + 1] += graph.offsets[p];
+    }
+
+    // Each edge lists both ends; shared edges repeat until SortRows
+    graph.neighbors.resize(graph.offsets[positionCount]);
+    std::vector<uint32> fill(graph.offsets.begin(), graph.offsets.end() - 1);
+    for (const auto& face : faces)
+    {
+        for (uint32 c = 0; c < 3; ++c)
+        {
+            uint32 a = face[c];
+            uint32 b = face[(c + 1) % 3];
+            if (a == b)
+                continue;
+            graph.neighbors[fill[a]++] = b;
+            graph.neighbors[fill[b]++] = a;
+        }
+    }
+
+    graph.SortRows();
+    return graph;
+}
+
+void AdjacencyGraph::SortRows()
+{
+    uint32 nodeCount = size();
+    uint32 write = 0;
+    for (uint32 n = 0; n < nodeCount; ++n)
+    {
+        auto first = neighbors.begin() + offsets[n];
+        auto last = neighbors.begin() + offsets[n + 1];
+        std::sort(first, last);
+        last = std::unique(first, last);
+
+        // Rows only move toward the front
+        uint32 count = static_cast<uint32>(last - first);
+        if (neighbors.begin() + write != first)
+            std::copy(first, last, neighbors.begin() + write);
+        offsets[n] = write;
+        write += count;
+    }
+    if (nodeCount > 0)
+        offsets[nodeCount] = write;
+    neighbors.resize(write);
+}
+
+} // namespace RRE
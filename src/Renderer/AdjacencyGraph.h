@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Core/Types.h"
+#include <array>
+#include <vector>
+
+namespace RRE
+{
+
+// Node adjacency in compressed sparse rows: the neighbors of node n are
+// neighbors[offsets[n] .. offsets[n + 1]), sorted ascending without
+// duplicates. Both builders bucket edges by their smaller position with a
+// counting sort, so they run in linear time for bounded vertex valence and
+// allocate three flat arrays instead of one list per node.
+class AdjacencyGraph
+{
+public:
+    // Neighbors of one node
+    class Range
+    {
+    public:
+        Range(const uint32* first, const uint32* last) : m_first(first), m_last(last) {}
+
+        const uint32* begin() const { return m_first; }
+        const uint32* end() const { return m_last; }
+        uint32 size() const { return static_cast<uint32>(m_last - m_first); }
+        bool empty() const { return m_first == m_last; }
+        uint32 operator[](uint32 i) const { return m_first[i]; }
+
+    private:
+        const uint32* m_first;
+        const uint32* m_last;
+    };
+
+    // Faces sharing an edge (two positions, either winding) with each face.
+    // Edges whose endpoints are equal are never shared.
+    static AdjacencyGraph FromFaceEdges(const std::vector<std::array<uint32, 3>>& faces);
+
+    // Positions joined by an edge of some face (never to themselves)
+    static AdjacencyGraph FromPositionEdges(const std::vector<std::array<uint32, 3>>& faces,
+        uint32 positionCount);
+
+    // Container-style access, so adjacency[n] iterates like a vector
+    uint32 size() const { return offsets.empty() ? 0 : static_cast<uint32>(offsets.size() - 1); }
+    bool empty() const { return size() == 0; }
+    void clear()
+    {
+        offsets.clear();
+        neighbors.clear();
+    }
+    Range operator[](uint32 node) const
+    {
+        return Range(neighbors.data() + offsets[node], neighbors.data() + offsets[node + 1]);
+    }
+
+    // Sorts each row and drops repeated entries, compacting the arrays
+    void SortRows();
+
+    std::vector<uint32> offsets;    // node count + 1
+    std::vector<uint32> neighbors;
+};
+
+} // namespace RRE
@@ -57,6 +57,11 @@ void DebugHUD::Render(IRHIContext& context)
     context.DrawText(x, y, buf, green);
     y += lineHeight;
 
+    snprintf(buf, sizeof(buf), "Culling: %u drawn (%u draws), %u culled / %u tested",
+        m_lastStats.nodesDrawn, m_lastStats.drawCalls, m_lastStats.nodesCulled, m_lastStats.nodesTested);
+    context.DrawText(x, y, buf, green);
+    y += lineHeight;
+
     // Light info (conditional)
     if (m_lastStats.showLightInfo)
     {
@@ -17,6 +17,12 @@ struct RenderStats
     uint32 totalPolygons;
     float polygonsPerSec;
 
+    // Frustum culling (mesh nodes tested / culled / drawn last frame)
+    uint32 nodesTested = 0;
+    uint32 nodesCulled = 0;
+    uint32 nodesDrawn = 0;
+    uint32 drawCalls = 0;
+
     // Light info (Phase 9)
     bool showLightInfo = false;
     const char* lightColorName = "White";
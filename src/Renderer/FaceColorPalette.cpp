@@ -0,0 +1,252 @@
+#include "Renderer/FaceColorPalette.h"
+#include "Core/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+
+namespace RRE
+{
+
+namespace
+{
+
+constexpr uint32 NONE = UINT32_MAX;
+
+// Parallel rounds before the remaining conflicts are fixed serially
+const uint32 MAX_PARALLEL_ROUNDS = 8;
+
+// Neighbor colors are tracked as one bit per palette entry
+static_assert(FaceColorPalette::PALETTE_SIZE <= 8, "neighbor color masks are 8 bits");
+
+uint8 ColorBit(uint32 color)
+{
+    return color < FaceColorPalette::PALETTE_SIZE ? static_cast<uint8>(1u << color) : 0;
+}
+
+// Lowest palette color not in mask, or NONE when the palette is used up
+uint32 LowestFree(uint8 mask)
+{
+    for (uint32 c = 0; c < FaceColorPalette::PALETTE_SIZE; ++c)
+    {
+        if (!(mask & (1u << c)))
+            return c;
+    }
+    return NONE;
+}
+
+uint32 CountBits(uint8 mask)
+{
+    uint32 count = 0;
+    for (; mask; mask &= mask - 1)
+    {
+        ++count;
+    }
+    return count;
+}
+
+bool AllColored(const std::vector<uint32>& colors)
+{
+    return std::find(colors.begin(), colors.end(), NONE) == colors.end();
+}
+
+} // anonymous namespace
+
+std::vector<uint32> FaceColorPalette::AssignFaceColors(const AdjacencyGraph& adjacency)
+{
+    std::vector<uint32> colors(adjacency.size(), NONE);
+    RepairFaceColors(adjacency, colors);
+    if (!AllColored(colors))
+        return AssignFaceColorsDSATUR(adjacency);
+    return colors;
+}
+
+std::vector<uint32> FaceColorPalette::AssignFaceColorsDSATUR(const AdjacencyGraph& adjacency)
+{
+    uint32 faceCount = adjacency.size();
+    std::vector<uint32> colors(faceCount, NONE);
+    std::vector<uint8> neighborColors(faceCount, 0);
+
+    // One stack per saturation level (0..PALETTE_SIZE); a face is pushed
+    // again whenever its saturation grows, so older entries go stale. Stacks
+    // keep recently touched faces on top, which grows colored regions
+    // outward much like the degree tie-break of the original.
+    std::vector<std::vector<uint32>> stacks(PALETTE_SIZE + 1);
+
+    // Level 0 in ascending degree (counting sort), highest degree on top
+    uint32 maxDegree = 0;
+    for (uint32 f = 0; f < faceCount; ++f)
+    {
+        maxDegree = std::max(maxDegree, adjacency[f].size());
+    }
+    std::vector<uint32> degreeOffsets(maxDegree + 2, 0);
+    for (uint32 f = 0; f < faceCount; ++f)
+    {
+        ++degreeOffsets[adjacency[f].size() + 1];
+    }
+    for (uint32 d = 0; d <= maxDegree; ++d)
+    {
+        degreeOffsets[d + 1] += degreeOffsets[d];
+    }
+    stacks[0].resize(faceCount);
+    for (uint32 f = faceCount; f-- > 0;)
+    {
+        stacks[0][degreeOffsets[adjacency[f].size()]++] = f;
+    }
+
+    uint32 level = 0;
+    for (;;)
+    {
+        while (level > 0 && stacks[level].empty())
+        {
+            --level;
+        }
+        if (stacks[level].empty())
+            break;
+        uint32 face = stacks[level].back();
+        stacks[level].pop_back();
+        if (colors[face] != NONE || CountBits(neighborColors[face]) != level)
+            continue;
+
+        uint32 color = LowestFree(neighborColors[face]);
+        if (color == NONE)
+        {
+            // Out of colors; mark it handled so stale entries skip it
+            colors[face] = PALETTE_SIZE;
+            continue;
+        }
+        colors[face] = color;
+
+        uint8 bit = ColorBit(color);
+        for (uint32 neighbor : adjacency[face])
+        {
+            if (colors[neighbor] != NONE || (neighborColors[neighbor] & bit))
+                continue;
+            neighborColors[neighbor] |= bit;
+            uint32 saturation = CountBits(neighborColors[neighbor]);
+            stacks[saturation].push_back(neighbor);
+            level = std::max(level, saturation);
+        }
+    }
+
+    for (uint32& color : colors)
+    {
+        if (color == PALETTE_SIZE)
+            color = NONE;
+    }
+    return colors;
+}
+
+std::vector<uint32> FaceColorPalette::AssignFaceColorsParallel(const AdjacencyGraph& adjacency,
+    ThreadPool& pool, uint32 facesPerTask)
+{
+    uint32 faceCount = adjacency.size();
+    std::vector<std::atomic<uint32>> shared(faceCount);
+    for (auto& color : shared)
+    {
+        color.store(NONE, std::memory_order_relaxed);
+    }
+
+    std::vector<uint32> pending(faceCount);
+    for (uint32 f = 0; f < faceCount; ++f)
+    {
+        pending[f] = f;
+    }
+    std::vector<uint8> conflicts;
+
+    // Faces in a round read neighbors that may be changing at the same
+    // time; the check afterwards keeps the lower-numbered face of each clash
+    for (uint32 round = 0; round < MAX_PARALLEL_ROUNDS && pending.size() > facesPerTask; ++round)
+    {
+        uint32 pendingCount = static_cast<uint32>(pending.size());
+        pool.ParallelFor(pendingCount, facesPerTask, [&](uint32 begin, uint32 end) {
+            for (uint32 i = begin; i < end; ++i)
+            {
+                uint8 used = 0;
+                for (uint32 neighbor : adjacency[pending[i]])
+                {
+                    used |= ColorBit(shared[neighbor].load(std::memory_order_relaxed));
+                }
+                shared[pending[i]].store(LowestFree(used), std::memory_order_relaxed);
+            }
+        });
+
+        conflicts.assign(pendingCount, 0);
+        pool.ParallelFor(pendingCount, facesPerTask, [&](uint32 begin, uint32 end) {
+            for (uint32 i = begin; i < end; ++i)
+            {
+                uint32 face = pending[i];
+                uint32 color = shared[face].load(std::memory_order_relaxed);
+                for (uint32 neighbor : adjacency[face])
+                {
+                    if (neighbor < face && color != NONE &&
+                        shared[neighbor].load(std::memory_order_relaxed) == color)
+                    {
+                        conflicts[i] = 1;
+                        break;
+                    }
+                }
+            }
+        });
+
+        uint32 kept = 0;
+        for (uint32 i = 0; i < pendingCount; ++i)
+        {
+            if (conflicts[i])
+                pending[kept++] = pending[i];
+        }
+        pending.resize(kept);
+    }
+
+    std::vector<uint32> colors(faceCount);
+    for (uint32 f = 0; f < faceCount; ++f)
+    {
+        colors[f] = shared[f].load(std::memory_order_relaxed);
+    }
+
+    // Every face outside pending is settled against its lower neighbors, so
+    // recoloring pending ones against all neighbors leaves no clash
+    for (uint32 face : pending)
+    {
+        uint8 used = 0;
+        for (uint32 neighbor : adjacency[face])
+        {
+            used |= ColorBit(colors[neighbor]);
+        }
+        if (colors[face] == NONE || (used & ColorBit(colors[face])))
+            colors[face] = LowestFree(used);
+    }
+
+    if (!AllColored(colors))
+        return AssignFaceColorsDSATUR(adjacency);
+    return colors;
+}
+
+void FaceColorPalette::RepairFaceColors(const AdjacencyGraph& adjacency, std::vector<uint32>& colors)
+{
+    uint32 faceCount = adjacency.size();
+    for (uint32 face = 0; face < faceCount; ++face)
+    {
+        // Colors used by earlier neighbors; later ones resolve their own
+        // conflicts when reached
+        uint8 used = 0;
+        for (uint32 neighbor : adjacency[face])
+        {
+            if (neighbor < face)
+                used |= ColorBit(colors[neighbor]);
+        }
+
+        if (colors[face] == NONE || (used & ColorBit(colors[face])))
+            colors[face] = LowestFree(used);
+    }
+}
+
+uint32 FaceColorPalette::CountColors(const std::vector<uint32>& colors)
+{
+    uint8 used = 0;
+    for (uint32 color : colors)
+    {
+        used |= ColorBit(color);
+    }
+    return CountBits(used);
+}
+
+} // namespace RRE
@@ -1,13 +1,15 @@
 #pragma once
 
 #include <DirectXMath.h>
+#include "Renderer/AdjacencyGraph.h"
 #include "Core/Types.h"
 #include <vector>
-#include <set>
 
 namespace RRE
 {
 
+class ThreadPool;
+
 class FaceColorPalette
 {
 public:
@@ -29,37 +31,31 @@ public:
         return palette[paletteIndex % PALETTE_SIZE];
     }
 
-    // Greedy graph coloring: assign colors so adjacent faces have different colors
-    static std::vector<uint32> AssignFaceColors(const std::vector<std::vector<uint32>>& adjacency)
-    {
-        uint32 faceCount = static_cast<uint32>(adjacency.size());
-        std::vector<uint32> colors(faceCount, UINT32_MAX);
-
-        for (uint32 face = 0; face < faceCount; ++face)
-        {
-            // Collect colors used by neighbors
-            std::set<uint32> usedColors;
-            for (const uint32 neighbor : adjacency[face])
-            {
-                if (colors[neighbor] != UINT32_MAX)
-                {
-                    usedColors.insert(colors[neighbor]);
-                }
-            }
-
-            // Pick the lowest available color
-            for (uint32 c = 0; c < PALETTE_SIZE; ++c)
-            {
-                if (usedColors.find(c) == usedColors.end())
-                {
-                    colors[face] = c;
-                    break;
-                }
-            }
-        }
-
-        return colors;
-    }
+    // Greedy graph coloring in face order: adjacent faces get different
+    // colors. If that runs out of palette colors, DSATUR is used instead;
+    // a face stays UINT32_MAX only if its neighbors use the whole palette.
+    static std::vector<uint32> AssignFaceColors(const AdjacencyGraph& adjacency);
+
+    // DSATUR (Brelaz 1979): always colors the face whose neighbors already
+    // use the most distinct colors next, which needs far fewer colors than a
+    // fixed order on irregular graphs. Linear time with bucketed saturation.
+    static std::vector<uint32> AssignFaceColorsDSATUR(const AdjacencyGraph& adjacency);
+
+    // Speculative coloring (Gebremedhin and Manne 2000): chunks of the
+    // pending faces are colored greedily at the same time, then faces that
+    // clash with a lower-numbered neighbor go round again. The last rounds,
+    // once few faces are pending, run serially. Falls back to DSATUR like
+    // AssignFaceColors.
+    static std::vector<uint32> AssignFaceColorsParallel(const AdjacencyGraph& adjacency,
+        ThreadPool& pool, uint32 facesPerTask = 4096);
+
+    // Keep existing colors where no earlier neighbor shares them; unassigned
+    // (UINT32_MAX) and conflicting entries take the lowest color their
+    // neighbors leave free, as in AssignFaceColors
+    static void RepairFaceColors(const AdjacencyGraph& adjacency, std::vector<uint32>& colors);
+
+    // Distinct colors used (UINT32_MAX entries not counted)
+    static uint32 CountColors(const std::vector<uint32>& colors);
 };
 
 } // namespace RRE
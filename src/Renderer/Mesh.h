@@ -1,7 +1,14 @@
 #pragma once
 
 #include "Renderer/Vertex.h"
+#include "Renderer/AdjacencyGraph.h"
+#include "Renderer/MeshBVH.h"
+#include "Renderer/Meshlet.h"
+#include "Math/Bounds.h"
+#include "RHI/RHIBuffer.h"
 #include "Core/Types.h"
+#include <cmath>
+#include <memory>
 #include <vector>
 
 namespace RRE
@@ -16,8 +23,67 @@ public:
     std::vector<Vertex> vertices;
     std::vector<uint32> indices;
 
-    // Adjacency: for each face i, adjacency[i] is a list of adjacent face indices
-    std::vector<std::vector<uint32>> faceAdjacency;
+    // Adjacency: for each face i, faceAdjacency[i] lists the faces sharing an edge
+    AdjacencyGraph faceAdjacency;
+
+    // Local-space bounds (call ComputeBounds after editing vertices)
+    Math::AABB localBounds;
+    Math::BoundingSphere localSphere;
+
+    // Triangle BVH for exact ray queries (shared between copies; rebuild
+    // with BuildTriangleBVH after editing vertices or indices)
+    std::shared_ptr<const MeshBVH> triangleBVH;
+
+    // Optional clusters for per-cluster culling (MeshletBuilder::Build; rebuild
+    // after editing vertices or indices). Empty = always drawn whole.
+    std::vector<Meshlet> meshlets;
+
+    // Coarser versions for distant draws, finest first (MeshSimplifier::
+    // BuildLODChain; shared between copies like the BVH). lodError is this
+    // mesh's deviation from the original surface in mesh units (0 = original).
+    std::vector<std::shared_ptr<Mesh>> lods;
+    float lodError = 0.0f;
+
+    void BuildTriangleBVH()
+    {
+        auto bvh = std::make_shared<MeshBVH>();
+        bvh->Build(vertices, indices);
+        triangleBVH = std::move(bvh);
+    }
+
+    void ComputeBounds()
+    {
+        localBounds = Math::AABB();
+        for (const auto& v : vertices)
+        {
+            localBounds.Expand(v.position);
+        }
+
+        if (!localBounds.IsValid())
+        {
+            localSphere = Math::BoundingSphere();
+            return;
+        }
+
+        // Sphere around the box center, tight to the furthest vertex
+        localSphere.center = localBounds.GetCenter();
+        float maxDistSq = 0.0f;
+        for (const auto& v : vertices)
+        {
+            float dx = v.position.x - localSphere.center.x;
+            float dy = v.position.y - localSphere.center.y;
+            float dz = v.position.z - localSphere.center.z;
+            maxDistSq = std::fmaxf(maxDistSq, dx * dx + dy * dy + dz * dz);
+        }
+        localSphere.radius = std::sqrt(maxDistSq);
+    }
+
+    // Width of the uploaded (and exported) index stream; indices stay
+    // 32-bit in memory for the mesh algorithms
+    IndexFormat GetIndexFormat() const
+    {
+        return SelectIndexFormat(vertices.size());
+    }
 
     uint32 GetPolygonCount() const
     {
@@ -0,0 +1,416 @@
+#include "Renderer/MeshBVH.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace DirectX;
+
+namespace RRE
+{
+
+namespace
+{
+
+constexpr uint32 BIN_COUNT = 12;
+constexpr float DET_EPSILON = 1e-12f;
+
+// Depth cap keeps traversal stacks bounded; deeper ranges become leaves
+constexpr uint32 MAX_DEPTH = 64;
+constexpr uint32 STACK_CAPACITY = MAX_DEPTH + 2;
+
+struct BuildTriangle
+{
+    Math::AABB bounds;
+    XMFLOAT3 centroid;
+};
+
+float Axis(const XMFLOAT3& v, int axis)
+{
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+} // anonymous namespace
+
+void MeshBVH::Build(const std::vector<Vertex>& vertices, const std::vector<uint32>& indices)
+{
+    m_nodes.clear();
+    m_triangles.clear();
+    m_triangleIds.clear();
+
+    uint32 triangleCount = static_cast<uint32>(indices.size() / 3);
+    if (triangleCount == 0)
+        return;
+
+    std::vector<BuildTriangle> build(triangleCount);
+    for (uint32 t = 0; t < triangleCount; ++t)
+    {
+        Math::AABB box;
+        box.Expand(vertices[indices[t * 3 + 0]].position);
+        box.Expand(vertices[indices[t * 3 + 1]].position);
+        box.Expand(vertices[indices[t * 3 + 2]].position);
+        build[t].bounds = box;
+        build[t].centroid = box.GetCenter();
+    }
+
+    m_triangleIds.resize(triangleCount);
+    for (uint32 t = 0; t < triangleCount; ++t)
+    {
+        m_triangleIds[t] = t;
+    }
+
+    // Worst case 2N - 1 nodes
+    m_nodes.reserve(triangleCount * 2);
+    m_nodes.push_back({});
+    m_nodes[0].leftFirst = 0;
+    m_nodes[0].count = triangleCount;
+
+    // Top-down split with an explicit stack (large meshes, deep trees)
+    struct BuildEntry
+    {
+        uint32 node;
+        uint32 depth;
+    };
+    std::vector<BuildEntry> stack = { { 0, 0 } };
+    while (!stack.empty())
+    {
+        uint32 nodeIndex = stack.back().node;
+        uint32 depth = stack.back().depth;
+        stack.pop_back();
+
+        uint32 first = m_nodes[nodeIndex].leftFirst;
+        uint32 count = m_nodes[nodeIndex].count;
+
+        Math::AABB bounds;
+        Math::AABB centroidBounds;
+        for (uint32 i = first; i < first + count; ++i)
+        {
+            const BuildTriangle& tri = build[m_triangleIds[i]];
+            bounds = Math::Union(bounds, tri.bounds);
+            centroidBounds.Expand(tri.centroid);
+        }
+        m_nodes[nodeIndex].min = bounds.min;
+        m_nodes[nodeIndex].max = bounds.max;
+
+        if (count <= MAX_LEAF_TRIANGLES || depth >= MAX_DEPTH)
+            continue;
+
+        // Binned SAH over the centroid bounds on each axis
+        float bestCost = FLT_MAX;
+        int bestAxis = -1;
+        uint32 bestSplit = 0;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            float lo = Axis(centroidBounds.min, axis);
+            float hi = Axis(centroidBounds.max, axis);
+            if (hi <= lo)
+                continue;
+
+            Math::AABB binBounds[BIN_COUNT];
+            uint32 binCounts[BIN_COUNT] = {};
+            float scale = BIN_COUNT / (hi - lo);
+            for (uint32 i = first; i < first + count; ++i)
+            {
+                const BuildTriangle& tri = build[m_triangleIds[i]];
+                uint32 bin = std::min(BIN_COUNT - 1, static_cast<uint32>((Axis(tri.centroid, axis) - lo) * scale));
+                binBounds[bin] = Math::Union(binBounds[bin], tri.bounds);
+                binCounts[bin]++;
+            }
+
+            // Sweep from the right to get suffix areas, then from the left
+            float rightArea[BIN_COUNT];
+            uint32 rightCount[BIN_COUNT];
+            Math::AABB accum;
+            uint32 accumCount = 0;
+            for (uint32 b = BIN_COUNT - 1; b > 0; --b)
+            {
+                accum = Math::Union(accum, binBounds[b]);
+                accumCount += binCounts[b];
+                rightArea[b] = accumCount ? Math::HalfSurfaceArea(accum) : 0.0f;
+                rightCount[b] = accumCount;
+            }
+
+            accum = Math::AABB();
+            accumCount = 0;
+            for (uint32 b = 0; b < BIN_COUNT - 1; ++b)
+            {
+                accum = Math::Union(accum, binBounds[b]);
+                accumCount += binCounts[b];
+                if (accumCount == 0 || rightCount[b + 1] == 0)
+                    continue;
+
+                float cost = accumCount * Math::HalfSurfaceArea(accum) + rightCount[b + 1] * rightArea[b + 1];
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = b + 1;
+                }
+            }
+        }
+
+        // Keep as a leaf when no split beats testing every triangle
+        float leafCost = count * Math::HalfSurfaceArea(bounds);
+        if (bestAxis < 0 || bestCost >= leafCost)
+            continue;
+
+        float lo = Axis(centroidBounds.min, bestAxis);
+        float scale = BIN_COUNT / (Axis(centroidBounds.max, bestAxis) - lo);
+        auto middle = std::partition(m_triangleIds.begin() + first, m_triangleIds.begin() + first + count,
+            [&](uint32 id) {
+                uint32 bin = std::min(BIN_COUNT - 1, static_cast<uint32>((Axis(build[id].centroid, bestAxis) - lo) * scale));
+                return bin < bestSplit;
+            });
+        uint32 leftCount = static_cast<uint32>(middle - (m_triangleIds.begin() + first));
+        if (leftCount == 0 || leftCount == count)
+            continue;
+
+        uint32 left = static_cast<uint32>(m_nodes.size());
+        m_nodes.push_back({});
+        m_nodes.push_back({});
+        m_nodes[left].leftFirst = first;
+        m_nodes[left].count = leftCount;
+        m_nodes[left + 1].leftFirst = first + leftCount;
+        m_nodes[left + 1].count = count - leftCount;
+
+        m_nodes[nodeIndex].leftFirst = left;
+        m_nodes[nodeIndex].count = 0;
+
+        stack.push_back({ left, depth + 1 });
+        stack.push_back({ left + 1, depth + 1 });
+    }
+
+    // Triangle data in leaf order for linear access during traversal
+    m_triangles.resize(triangleCount);
+    for (uint32 i = 0; i < triangleCount; ++i)
+    {
+        uint32 t = m_triangleIds[i];
+        XMVECTOR p0 = XMLoadFloat3(&vertices[indices[t * 3 + 0]].position);
+        XMVECTOR p1 = XMLoadFloat3(&vertices[indices[t * 3 + 1]].position);
+        XMVECTOR p2 = XMLoadFloat3(&vertices[indices[t * 3 + 2]].position);
+        XMStoreFloat3(&m_triangles[i].v0, p0);
+        XMStoreFloat3(&m_triangles[i].e1, XMVectorSubtract(p1, p0));
+        XMStoreFloat3(&m_triangles[i].e2, XMVectorSubtract(p2, p0));
+    }
+}
+
+Math::AABB MeshBVH::GetBounds() const
+{
+    return m_nodes.empty() ? Math::AABB() : NodeBounds(m_nodes[0]);
+}
+
+Math::AABB MeshBVH::NodeBounds(const Node& node)
+{
+    Math::AABB box;
+    box.min = node.min;
+    box.max = node.max;
+    return box;
+}
+
+bool MeshBVH::Raycast(const XMFLOAT3& origin, const XMFLOAT3& direction, Hit& hit) const
+{
+    if (m_nodes.empty())
+        return false;
+
+    XMFLOAT3 invDir = { 1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z };
+    bool found = false;
+
+    struct Entry
+    {
+        uint32 node;
+        float tEnter;
+    };
+    Entry stack[STACK_CAPACITY];
+    uint32 top = 0;
+
+    float tRoot = 0.0f;
+    if (!Math::RayIntersectsAABB(origin, invDir, hit.distance, NodeBounds(m_nodes[0]), tRoot))
+        return false;
+    stack[top++] = { 0, tRoot };
+
+    while (top > 0)
+    {
+        Entry entry = stack[--top];
+        if (entry.tEnter > hit.distance)
+            continue;
+
+        const Node& node = m_nodes[entry.node];
+        if (node.count > 0)
+        {
+            // Moller-Trumbore against each triangle in the leaf
+            for (uint32 i = node.leftFirst; i < node.leftFirst + node.count; ++i)
+            {
+                const Triangle& tri = m_triangles[i];
+                XMFLOAT3 p = {
+                    direction.y * tri.e2.z - direction.z * tri.e2.y,
+                    direction.z * tri.e2.x - direction.x * tri.e2.z,
+                    direction.x * tri.e2.y - direction.y * tri.e2.x };
+                float det = tri.e1.x * p.x + tri.e1.y * p.y + tri.e1.z * p.z;
+                if (std::fabs(det) < DET_EPSILON)
+                    continue;
+
+                float invDet = 1.0f / det;
+                XMFLOAT3 s = { origin.x - tri.v0.x, origin.y - tri.v0.y, origin.z - tri.v0.z };
+                float u = (s.x * p.x + s.y * p.y + s.z * p.z) * invDet;
+                if (u < 0.0f || u > 1.0f)
+                    continue;
+
+                XMFLOAT3 q = {
+                    s.y * tri.e1.z - s.z * tri.e1.y,
+                    s.z * tri.e1.x - s.x * tri.e1.z,
+                    s.x * tri.e1.y - s.y * tri.e1.x };
+                float v = (direction.x * q.x + direction.y * q.y + direction.z * q.z) * invDet;
+                if (v < 0.0f || u + v > 1.0f)
+                    continue;
+
+                float t = (tri.e2.x * q.x + tri.e2.y * q.y + tri.e2.z * q.z) * invDet;
+                if (t < 0.0f || t >= hit.distance)
+                    continue;
+
+                hit.triangle = m_triangleIds[i];
+                hit.distance = t;
+                hit.u = u;
+                hit.v = v;
+                found = true;
+            }
+            continue;
+        }
+
+        // Push the farther child first so the nearer one is visited next
+        uint32 left = node.leftFirst;
+        float t1 = 0.0f;
+        float t2 = 0.0f;
+        bool hit1 = Math::RayIntersectsAABB(origin, invDir, hit.distance, NodeBounds(m_nodes[left]), t1);
+        bool hit2 = Math::RayIntersectsAABB(origin, invDir, hit.distance, NodeBounds(m_nodes[left + 1]), t2);
+        if (hit1 && hit2)
+        {
+            if (t1 <= t2)
+            {
+                stack[top++] = { left + 1, t2 };
+                stack[top++] = { left, t1 };
+            }
+            else
+            {
+                stack[top++] = { left, t1 };
+                stack[top++] = { left + 1, t2 };
+            }
+        }
+        else if (hit1)
+        {
+            stack[top++] = { left, t1 };
+        }
+        else if (hit2)
+        {
+            stack[top++] = { left + 1, t2 };
+        }
+    }
+
+    return found;
+}
+
+uint32 MeshBVH::Raycast4(const Math::RayPacket4& packet, Hit hits[4]) const
+{
+    if (m_nodes.empty())
+        return 0;
+
+    XMVECTOR tBest = XMVectorSet(hits[0].distance, hits[1].distance, hits[2].distance, hits[3].distance);
+    XMVECTOR bestU = XMVectorZero();
+    XMVECTOR bestV = XMVectorZero();
+    uint32 bestTriangle[4] = { INVALID_TRIANGLE, INVALID_TRIANGLE, INVALID_TRIANGLE, INVALID_TRIANGLE };
+    uint32 improved = 0;
+
+    const XMVECTOR zero = XMVectorZero();
+    const XMVECTOR one = XMVectorSplatOne();
+    const XMVECTOR epsilon = XMVectorReplicate(DET_EPSILON);
+
+    uint32 stack[STACK_CAPACITY];
+    uint32 top = 0;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        const Node& node = m_nodes[stack[--top]];
+        if (!Math::AnyLane(packet.IntersectAABB(NodeBounds(node), tBest)))
+            continue;
+
+        if (node.count == 0)
+        {
+            stack[top++] = node.leftFirst + 1;
+            stack[top++] = node.leftFirst;
+            continue;
+        }
+
+        for (uint32 i = node.leftFirst; i < node.leftFirst + node.count; ++i)
+        {
+            const Triangle& tri = m_triangles[i];
+            XMVECTOR e1x = XMVectorReplicate(tri.e1.x);
+            XMVECTOR e1y = XMVectorReplicate(tri.e1.y);
+            XMVECTOR e1z = XMVectorReplicate(tri.e1.z);
+            XMVECTOR e2x = XMVectorReplicate(tri.e2.x);
+            XMVECTOR e2y = XMVectorReplicate(tri.e2.y);
+            XMVECTOR e2z = XMVectorReplicate(tri.e2.z);
+
+            // p = d x e2
+            XMVECTOR px = XMVectorSubtract(XMVectorMultiply(packet.dy, e2z), XMVectorMultiply(packet.dz, e2y));
+            XMVECTOR py = XMVectorSubtract(XMVectorMultiply(packet.dz, e2x), XMVectorMultiply(packet.dx, e2z));
+            XMVECTOR pz = XMVectorSubtract(XMVectorMultiply(packet.dx, e2y), XMVectorMultiply(packet.dy, e2x));
+            XMVECTOR det = XMVectorMultiplyAdd(e1x, px, XMVectorMultiplyAdd(e1y, py, XMVectorMultiply(e1z, pz)));
+            XMVECTOR invDet = XMVectorReciprocal(det);
+
+            // s = o - v0
+            XMVECTOR sx = XMVectorSubtract(packet.ox, XMVectorReplicate(tri.v0.x));
+            XMVECTOR sy = XMVectorSubtract(packet.oy, XMVectorReplicate(tri.v0.y));
+            XMVECTOR sz = XMVectorSubtract(packet.oz, XMVectorReplicate(tri.v0.z));
+            XMVECTOR u = XMVectorMultiply(XMVectorMultiplyAdd(sx, px, XMVectorMultiplyAdd(sy, py, XMVectorMultiply(sz, pz))), invDet);
+
+            // q = s x e1
+            XMVECTOR qx = XMVectorSubtract(XMVectorMultiply(sy, e1z), XMVectorMultiply(sz, e1y));
+            XMVECTOR qy = XMVectorSubtract(XMVectorMultiply(sz, e1x), XMVectorMultiply(sx, e1z));
+            XMVECTOR qz = XMVectorSubtract(XMVectorMultiply(sx, e1y), XMVectorMultiply(sy, e1x));
+            XMVECTOR v = XMVectorMultiply(XMVectorMultiplyAdd(packet.dx, qx, XMVectorMultiplyAdd(packet.dy, qy, XMVectorMultiply(packet.dz, qz))), invDet);
+            XMVECTOR t = XMVectorMultiply(XMVectorMultiplyAdd(e2x, qx, XMVectorMultiplyAdd(e2y, qy, XMVectorMultiply(e2z, qz))), invDet);
+
+            XMVECTOR mask = XMVectorGreater(XMVectorAbs(det), epsilon);
+            mask = XMVectorAndInt(mask, XMVectorGreaterOrEqual(u, zero));
+            mask = XMVectorAndInt(mask, XMVectorGreaterOrEqual(v, zero));
+            mask = XMVectorAndInt(mask, XMVectorLessOrEqual(XMVectorAdd(u, v), one));
+            mask = XMVectorAndInt(mask, XMVectorGreaterOrEqual(t, zero));
+            mask = XMVectorAndInt(mask, XMVectorLess(t, tBest));
+            if (!Math::AnyLane(mask))
+                continue;
+
+            tBest = XMVectorSelect(tBest, t, mask);
+            bestU = XMVectorSelect(bestU, u, mask);
+            bestV = XMVectorSelect(bestV, v, mask);
+
+            uint32 laneMask[4];
+            XMStoreInt4(laneMask, mask);
+            for (uint32 lane = 0; lane < 4; ++lane)
+            {
+                if (laneMask[lane])
+                {
+                    bestTriangle[lane] = m_triangleIds[i];
+                    improved |= 1u << lane;
+                }
+            }
+        }
+    }
+
+    alignas(16) float tLanes[4];
+    alignas(16) float uLanes[4];
+    alignas(16) float vLanes[4];
+    XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(tLanes), tBest);
+    XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(uLanes), bestU);
+    XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(vLanes), bestV);
+    for (uint32 lane = 0; lane < 4; ++lane)
+    {
+        if (improved & (1u << lane))
+        {
+            hits[lane].triangle = bestTriangle[lane];
+            hits[lane].distance = tLanes[lane];
+            hits[lane].u = uLanes[lane];
+            hits[lane].v = vLanes[lane];
+        }
+    }
+    return improved;
+}
+
+} // namespace RRE
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Renderer/Vertex.h"
+#include "Math/Bounds.h"
+#include "Math/Ray.h"
+#include "Core/Types.h"
+#include <DirectXMath.h>
+#include <cfloat>
+#include <vector>
+
+namespace RRE
+{
+
+// Static triangle BVH for exact ray queries against one mesh (local space).
+// Built top-down with binned SAH; leaves hold up to MAX_LEAF_TRIANGLES.
+class MeshBVH
+{
+public:
+    static constexpr uint32 INVALID_TRIANGLE = UINT32_MAX;
+    static constexpr uint32 MAX_LEAF_TRIANGLES = 4;
+
+    // Closest hit. Barycentrics are relative to the triangle's second and
+    // third vertex: P = (1 - u - v) * v0 + u * v1 + v * v2.
+    struct Hit
+    {
+        uint32 triangle = INVALID_TRIANGLE;
+        float distance = FLT_MAX;
+        float u = 0.0f;
+        float v = 0.0f;
+    };
+
+    MeshBVH() = default;
+    ~MeshBVH() = default;
+
+    void Build(const std::vector<Vertex>& vertices, const std::vector<uint32>& indices);
+
+    bool IsEmpty() const { return m_nodes.empty(); }
+    uint32 GetTriangleCount() const { return static_cast<uint32>(m_triangles.size()); }
+    uint32 GetNodeCount() const { return static_cast<uint32>(m_nodes.size()); }
+    Math::AABB GetBounds() const;
+
+    // Distances are in units of the direction's length. The hit is only
+    // updated when a triangle closer than hit.distance is found.
+    bool Raycast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, Hit& hit) const;
+
+    // Packet variant: four rays traverse together and each triangle is tested
+    // against all lanes at once. Lanes with a negative hits[i].distance are
+    // inactive. Returns a bit mask of lanes whose hit improved.
+    uint32 Raycast4(const Math::RayPacket4& packet, Hit hits[4]) const;
+
+private:
+    // 32 bytes; interior nodes have count == 0 and children at
+    // leftFirst / leftFirst + 1, leaves reference triangles [leftFirst, +count)
+    struct Node
+    {
+        DirectX::XMFLOAT3 min;
+        uint32 leftFirst;
+        DirectX::XMFLOAT3 max;
+        uint32 count;
+    };
+
+    // Precomputed vertex/edges for Moller-Trumbore, stored in leaf order
+    struct Triangle
+    {
+        DirectX::XMFLOAT3 v0;
+        DirectX::XMFLOAT3 e1;
+        DirectX::XMFLOAT3 e2;
+    };
+
+    static Math::AABB NodeBounds(const Node& node);
+
+    std::vector<Node> m_nodes;
+    std::vector<Triangle> m_triangles;
+    std::vector<uint32> m_triangleIds;   // leaf order -> original triangle index
+};
+
+} // namespace RRE
@@ -1,8 +1,9 @@
 #define NOMINMAX
 #include "Renderer/MeshFactory.h"
 #include "Renderer/FaceColorPalette.h"
+#include "Renderer/VertexWelder.h"
+#include "Renderer/MeshOptimizer.h"
 #include <DirectXMath.h>
-#include <map>
 #include <array>
 #include <algorithm>
 #include <cmath>
@@ -29,105 +30,181 @@ XMFLOAT3 ComputeFaceNormal(const XMFLOAT3& v0, const XMFLOAT3& v1, const XMFLOAT
     return result;
 }
 
-// Build edge-based adjacency from indexed triangles
-// An edge is shared if two triangles share exactly two vertex positions
-// This uses position-based edge keys for per-face (duplicated) vertices
-struct EdgeKey
+// Faces meeting at a smaller angle than this share smooth vertex normals
+const float SMOOTH_CREASE_COS = 0.5f;  // 60 degrees
+
+// Per-face vertices (duplicated for flat shading)
+void BuildFlatVertices(Mesh& mesh, const std::vector<XMFLOAT3>& positions,
+    const std::vector<std::array<uint32, 3>>& faces, const std::vector<uint32>* colors)
 {
-    // Sorted pair of position indices in the original shared-vertex positions
-    uint32 a, b;
-    bool operator<(const EdgeKey& other) const
+    uint32 faceCount = static_cast<uint32>(faces.size());
+    std::vector<uint32> faceColors;
+    if (colors)
+    {
+        faceColors = *colors;
+        FaceColorPalette::RepairFaceColors(mesh.faceAdjacency, faceColors);
+    }
+    else
+    {
+        faceColors = FaceColorPalette::AssignFaceColors(mesh.faceAdjacency);
+    }
+
+    for (uint32 f = 0; f < faceCount; ++f)
     {
-        if (a != other.a) return a < other.a;
-        return b < other.b;
+        const auto& face = faces[f];
+        XMFLOAT3 normal = ComputeFaceNormal(
+            positions[face[0]], positions[face[1]], positions[face[2]]);
+        XMFLOAT4 color = FaceColorPalette::GetColor(faceColors[f]);
+
+        uint32 baseIndex = static_cast<uint32>(mesh.vertices.size());
+
+        for (int v = 0; v < 3; ++v)
+        {
+            Vertex vert;
+            vert.position = positions[face[v]];
+            vert.color = color;
+            vert.normal = normal;
+            mesh.vertices.push_back(vert);
+        }
+
+        mesh.indices.push_back(baseIndex);
+        mesh.indices.push_back(baseIndex + 1);
+        mesh.indices.push_back(baseIndex + 2);
     }
-};
+}
 
-// Build adjacency from face list with shared position indices
-std::vector<std::vector<uint32>> BuildAdjacency(
-    const std::vector<std::array<uint32, 3>>& facePositionIndices, uint32 faceCount)
+// Shared vertices: each corner's normal is the area-weighted sum of the
+// normals of the faces around its position that lie within the crease angle
+// of the corner's own face. Faces in the same smoothing group sum the same
+// faces in the same order, so their corners weld exactly.
+void BuildSmoothVertices(Mesh& mesh, const std::vector<XMFLOAT3>& positions,
+    const std::vector<std::array<uint32, 3>>& faces, const std::vector<uint32>* colors)
 {
-    std::vector<std::vector<uint32>> adjacency(faceCount);
-    // Map from edge to list of faces using that edge
-    std::map<EdgeKey, std::vector<uint32>> edgeToFaces;
+    uint32 faceCount = static_cast<uint32>(faces.size());
+    uint32 positionCount = static_cast<uint32>(positions.size());
 
+    // Area-weighted (unnormalized) and unit face normals
+    std::vector<XMFLOAT3> areaNormals(faceCount);
+    std::vector<XMFLOAT3> unitNormals(faceCount);
     for (uint32 f = 0; f < faceCount; ++f)
     {
-        const auto& face = facePositionIndices[f];
+        XMVECTOR p0 = XMLoadFloat3(&positions[faces[f][0]]);
+        XMVECTOR p1 = XMLoadFloat3(&positions[faces[f][1]]);
+        XMVECTOR p2 = XMLoadFloat3(&positions[faces[f][2]]);
+        XMVECTOR cross = XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0));
+        XMStoreFloat3(&areaNormals[f], cross);
+
+        float length = XMVectorGetX(XMVector3Length(cross));
+        XMStoreFloat3(&unitNormals[f], length > 0.0f ? XMVectorScale(cross, 1.0f / length) : XMVectorZero());
+    }
+
+    // Faces around each position in ascending order (counting sort into
+    // flat rows, one allocation however large the mesh), and the position
+    // graph for coloring
+    std::vector<uint32> faceOffsets(positionCount + 1, 0);
+    for (const auto& face : faces)
+    {
         for (int e = 0; e < 3; ++e)
         {
-            uint32 a = face[e];
-            uint32 b = face[(e + 1) % 3];
-            EdgeKey key = { std::min(a, b), std::max(a, b) };
-            edgeToFaces[key].push_back(f);
+            ++faceOffsets[face[e] + 1];
         }
     }
-
-    for (auto& pair : edgeToFaces)
+    for (uint32 p = 0; p < positionCount; ++p)
     {
-        auto& faceList = pair.second;
-        for (size_t i = 0; i < faceList.size(); ++i)
+        faceOffsets[p + 1] += faceOffsets[p];
+    }
+    std::vector<uint32> positionFaces(faceOffsets[positionCount]);
+    {
+        std::vector<uint32> cursor(faceOffsets.begin(), faceOffsets.end() - 1);
+        for (uint32 f = 0; f < faceCount; ++f)
         {
-            for (size_t j = i + 1; j < faceList.size(); ++j)
+            for (int e = 0; e < 3; ++e)
             {
-                adjacency[faceList[i]].push_back(faceList[j]);
-                adjacency[faceList[j]].push_back(faceList[i]);
+                positionFaces[cursor[faces[f][e]]++] = f;
             }
         }
     }
+    AdjacencyGraph positionAdjacency = AdjacencyGraph::FromPositionEdges(faces, positionCount);
+    std::vector<uint32> positionColors;
+    if (colors)
+    {
+        positionColors = *colors;
+        FaceColorPalette::RepairFaceColors(positionAdjacency, positionColors);
+    }
+    else
+    {
+        positionColors = FaceColorPalette::AssignFaceColors(positionAdjacency);
+    }
 
-    // Remove duplicate adjacency entries (sort+unique for cache locality)
-    for (auto& adj : adjacency)
+    mesh.vertices.reserve(static_cast<size_t>(faceCount) * 3);
+    mesh.indices.reserve(static_cast<size_t>(faceCount) * 3);
+    for (uint32 f = 0; f < faceCount; ++f)
     {
-        std::sort(adj.begin(), adj.end());
-        adj.erase(std::unique(adj.begin(), adj.end()), adj.end());
+        XMVECTOR faceNormal = XMLoadFloat3(&unitNormals[f]);
+        for (int v = 0; v < 3; ++v)
+        {
+            uint32 p = faces[f][v];
+            XMVECTOR sum = XMVectorZero();
+            for (uint32 i = faceOffsets[p]; i < faceOffsets[p + 1]; ++i)
+            {
+                uint32 g = positionFaces[i];
+                if (XMVectorGetX(XMVector3Dot(faceNormal, XMLoadFloat3(&unitNormals[g]))) >= SMOOTH_CREASE_COS)
+                {
+                    sum = XMVectorAdd(sum, XMLoadFloat3(&areaNormals[g]));
+                }
+            }
+
+            Vertex vert;
+            vert.position = positions[p];
+            vert.color = FaceColorPalette::GetColor(positionColors[p]);
+            float length = XMVectorGetX(XMVector3Length(sum));
+            XMStoreFloat3(&vert.normal, length > 0.0f ? XMVectorScale(sum, 1.0f / length) : faceNormal);
+
+            mesh.indices.push_back(static_cast<uint32>(mesh.vertices.size()));
+            mesh.vertices.push_back(vert);
+        }
     }
 
-    return adjacency;
+    VertexWelder::Weld(mesh.vertices, mesh.indices);
 }
 
 // Create a mesh from faces with shared position indices, applying face coloring
+// (colors, if given, are palette indices per face or per position to keep)
 Mesh BuildColoredMesh(
     const std::vector<XMFLOAT3>& positions,
-    const std::vector<std::array<uint32, 3>>& faces)
+    const std::vector<std::array<uint32, 3>>& faces,
+    MeshShading shading,
+    const std::vector<uint32>* colors = nullptr)
 {
-    uint32 faceCount = static_cast<uint32>(faces.size());
-    auto adjacency = BuildAdjacency(faces, faceCount);
-    auto faceColors = FaceColorPalette::AssignFaceColors(adjacency);
-
     Mesh mesh;
-    mesh.faceAdjacency = adjacency;
+    mesh.faceAdjacency = AdjacencyGraph::FromFaceEdges(faces);
 
-    for (uint32 f = 0; f < faceCount; ++f)
+    if (shading == MeshShading::Smooth)
     {
-        const auto& face = faces[f];
-        XMFLOAT3 normal = ComputeFaceNormal(
-            positions[face[0]], positions[face[1]], positions[face[2]]);
-        XMFLOAT4 color = FaceColorPalette::GetColor(faceColors[f]);
-
-        uint32 baseIndex = static_cast<uint32>(mesh.vertices.size());
-
-        // Per-face vertices (duplicated for flat shading)
-        for (int v = 0; v < 3; ++v)
-        {
-            Vertex vert;
-            vert.position = positions[face[v]];
-            vert.color = color;
-            vert.normal = normal;
-            mesh.vertices.push_back(vert);
-        }
-
-        mesh.indices.push_back(baseIndex);
-        mesh.indices.push_back(baseIndex + 1);
-        mesh.indices.push_back(baseIndex + 2);
+        BuildSmoothVertices(mesh, positions, faces, colors);
+        // Shared vertices make triangle order matter for the vertex cache
+        MeshOptimizer::Optimize(mesh);
+    }
+    else
+    {
+        BuildFlatVertices(mesh, positions, faces, colors);
     }
 
+    mesh.ComputeBounds();
+    mesh.BuildTriangleBVH();
     return mesh;
 }
 
 } // anonymous namespace
 
-Mesh MeshFactory::CreateTetrahedron()
+Mesh MeshFactory::CreateFromFaces(const std::vector<XMFLOAT3>& positions,
+    const std::vector<std::array<uint32, 3>>& faces, MeshShading shading,
+    const std::vector<uint32>* paletteColors)
+{
+    return BuildColoredMesh(positions, faces, shading, paletteColors);
+}
+
+Mesh MeshFactory::CreateTetrahedron(MeshShading shading)
 {
     // Regular tetrahedron vertices
     const float a = 1.0f;
@@ -145,10 +222,10 @@ Mesh MeshFactory::CreateTetrahedron()
         { 1, 3, 2 },
     };
 
-    return BuildColoredMesh(positions, faces);
+    return BuildColoredMesh(positions, faces, shading);
 }
 
-Mesh MeshFactory::CreateCube()
+Mesh MeshFactory::CreateCube(MeshShading shading)
 {
     std::vector<XMFLOAT3> positions = {
         { -1.0f, -1.0f, -1.0f }, // 0: left  bottom back
@@ -177,10 +254,10 @@ Mesh MeshFactory::CreateCube()
         { 0, 4, 7 }, { 0, 7, 3 },
     };
 
-    return BuildColoredMesh(positions, faces);
+    return BuildColoredMesh(positions, faces, shading);
 }
 
-Mesh MeshFactory::CreateSphere(uint32 segments, uint32 rings)
+Mesh MeshFactory::CreateSphere(uint32 segments, uint32 rings, MeshShading shading)
 {
     const float PI = XM_PI;
     const float TWO_PI = XM_2PI;
@@ -248,10 +325,10 @@ Mesh MeshFactory::CreateSphere(uint32 segments, uint32 rings)
         faces.push_back({ bottomPole, lastRingStart + next, lastRingStart + seg });
     }
 
-    return BuildColoredMesh(positions, faces);
+    return BuildColoredMesh(positions, faces, shading);
 }
 
-Mesh MeshFactory::CreateCylinder(uint32 segments, float height)
+Mesh MeshFactory::CreateCylinder(uint32 segments, float height, MeshShading shading)
 {
     float halfH = height / 2.0f;
     const float TWO_PI = XM_2PI;
@@ -312,7 +389,7 @@ Mesh MeshFactory::CreateCylinder(uint32 segments, float height)
         faces.push_back({ tl, br, bl });
     }
 
-    return BuildColoredMesh(positions, faces);
+    return BuildColoredMesh(positions, faces, shading);
 }
 
 } // namespace RRE
@@ -2,17 +2,41 @@
 
 #include "Renderer/Mesh.h"
 #include "Core/Types.h"
+#include <DirectXMath.h>
+#include <array>
+#include <vector>
 
 namespace RRE
 {
 
+// Flat: three vertices per triangle with the face normal and a per-face
+// palette color (adjacent faces differ).
+// Smooth: normals are averaged across edges flatter than the crease angle and
+// palette colors are assigned per position, then equal vertices are welded,
+// so curved shapes need about one vertex per position.
+enum class MeshShading
+{
+    Flat,
+    Smooth
+};
+
 class MeshFactory
 {
 public:
-    static Mesh CreateSphere(uint32 segments = 16, uint32 rings = 16);
-    static Mesh CreateTetrahedron();
-    static Mesh CreateCube();
-    static Mesh CreateCylinder(uint32 segments = 16, float height = 2.0f);
+    static Mesh CreateSphere(uint32 segments = 16, uint32 rings = 16,
+        MeshShading shading = MeshShading::Flat);
+    static Mesh CreateTetrahedron(MeshShading shading = MeshShading::Flat);
+    static Mesh CreateCube(MeshShading shading = MeshShading::Flat);
+    static Mesh CreateCylinder(uint32 segments = 16, float height = 2.0f,
+        MeshShading shading = MeshShading::Flat);
+
+    // Any closed or open triangle list over shared positions. paletteColors
+    // (optional) holds FaceColorPalette indices per face (Flat) or per
+    // position (Smooth); entries that clash with a neighbor are recolored.
+    static Mesh CreateFromFaces(const std::vector<DirectX::XMFLOAT3>& positions,
+        const std::vector<std::array<uint32, 3>>& faces,
+        MeshShading shading = MeshShading::Flat,
+        const std::vector<uint32>* paletteColors = nullptr);
 };
 
 } // namespace RRE
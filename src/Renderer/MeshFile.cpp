@@ -0,0 +1,396 @@
+#include "Renderer/MeshFile.h"
+#include "Renderer/Renderer.h"
+#include <cstdio>
+
+namespace RRE
+{
+
+namespace
+{
+
+const uint64 SECTION_ALIGNMENT = 16;
+const uint8 PADDING[SECTION_ALIGNMENT] = {};
+
+uint64 AlignUp(uint64 value)
+{
+    return (value + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+}
+
+// Reserve size bytes at the next aligned offset; empty sections take no space
+MeshFileSection Place(uint64& cursor, uint64 size)
+{
+    MeshFileSection section = { 0, size };
+    if (size > 0)
+    {
+        section.offset = AlignUp(cursor);
+        cursor = section.offset + size;
+    }
+    return section;
+}
+
+// Zeros from position up to offset (less than the alignment)
+bool WritePadding(FILE* file, uint64 position, uint64 offset)
+{
+    size_t padding = static_cast<size_t>(offset - position);
+    return padding == 0 || std::fwrite(PADDING, 1, padding, file) == padding;
+}
+
+// Padding up to the section, then its bytes
+bool WriteSection(FILE* file, uint64& position, const MeshFileSection& section, const void* data)
+{
+    if (section.size == 0)
+        return true;
+
+    if (!WritePadding(file, position, section.offset))
+        return false;
+    if (std::fwrite(data, 1, static_cast<size_t>(section.size), file) != section.size)
+        return false;
+    position = section.offset + section.size;
+    return true;
+}
+
+bool SectionFits(const MeshFileSection& section, uint64 elementSize, uint64 fileSize)
+{
+    if (section.size == 0)
+        return true;
+    return section.offset % SECTION_ALIGNMENT == 0 && section.offset <= fileSize &&
+        section.size <= fileSize - section.offset && section.size % elementSize == 0 &&
+        section.size / elementSize <= UINT32_MAX;
+}
+
+template <typename T>
+const T* SectionData(const uint8* base, const MeshFileSection& section)
+{
+    return section.size > 0 ? reinterpret_cast<const T*>(base + section.offset) : nullptr;
+}
+
+uint32 SectionCount(const MeshFileSection& section, uint64 elementSize)
+{
+    return static_cast<uint32>(section.size / elementSize);
+}
+
+// Range check, then widen to the mesh's 32-bit indices
+template <typename Index>
+bool CopyIndices(const Index* indices, uint32 indexCount, uint32 vertexCount,
+    std::vector<uint32>& out)
+{
+    for (uint32 i = 0; i < indexCount; ++i)
+    {
+        if (indices[i] >= vertexCount)
+            return false;
+    }
+    out.assign(indices, indices + indexCount);
+    return true;
+}
+
+// Full CSR check (Open only checks the ends): offsets never decrease and end
+// at neighborCount, and every neighbor is a face of the level
+bool AdjacencyValid(const uint32* offsets, const uint32* neighbors, uint32 faceCount,
+    uint32 neighborCount)
+{
+    if (offsets[0] != 0 || offsets[faceCount] != neighborCount)
+        return false;
+    for (uint32 face = 0; face < faceCount; ++face)
+    {
+        if (offsets[face + 1] < offsets[face])
+            return false;
+    }
+    for (uint32 i = 0; i < neighborCount; ++i)
+    {
+        if (neighbors[i] >= faceCount)
+            return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+bool MeshFile::Write(const char* path, const Mesh& mesh)
+{
+    if (!path)
+        return false;
+
+    std::vector<const Mesh*> meshes = { &mesh };
+    for (const auto& lod : mesh.lods)
+    {
+        if (lod)
+            meshes.push_back(lod.get());
+    }
+
+    MeshFileHeader header = {};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.levelCount = static_cast<uint32>(meshes.size());
+    header.vertexStride = sizeof(Vertex);
+
+    std::vector<MeshFileLevel> levels(meshes.size());
+    std::vector<std::vector<uint16>> narrowIndices(meshes.size());
+    std::vector<std::vector<CompactVertex>> compactVertices(meshes.size());
+    uint64 cursor = sizeof(MeshFileHeader) + levels.size() * sizeof(MeshFileLevel);
+    for (size_t i = 0; i < meshes.size(); ++i)
+    {
+        const Mesh& source = *meshes[i];
+        MeshFileLevel& level = levels[i];
+        level = {};
+        IndexFormat indexFormat = source.GetIndexFormat();
+        if (indexFormat == IndexFormat::UInt16)
+        {
+            narrowIndices[i].resize(source.indices.size());
+            for (size_t j = 0; j < source.indices.size(); ++j)
+            {
+                narrowIndices[i][j] = static_cast<uint16>(source.indices[j]);
+            }
+        }
+        level.indexFormat = static_cast<uint32>(indexFormat);
+        level.compactRange = VertexQuantizer::Encode(source.vertices.data(),
+            static_cast<uint32>(source.vertices.size()), compactVertices[i]);
+        level.vertices = Place(cursor, source.vertices.size() * sizeof(Vertex));
+        level.compactVertices = Place(cursor, compactVertices[i].size() * sizeof(CompactVertex));
+        level.indices = Place(cursor, source.indices.size() * GetIndexSize(indexFormat));
+        level.adjacencyOffsets = Place(cursor, source.faceAdjacency.offsets.size() * sizeof(uint32));
+        level.adjacencyNeighbors = Place(cursor, source.faceAdjacency.neighbors.size() * sizeof(uint32));
+        level.meshlets = Place(cursor, source.meshlets.size() * sizeof(Meshlet));
+        level.localBounds = source.localBounds;
+        level.localSphere = source.localSphere;
+        level.lodError = source.lodError;
+    }
+    header.fileSize = AlignUp(cursor);
+
+    FILE* file = std::fopen(path, "wb");
+    if (!file)
+        return false;
+
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+        std::fwrite(levels.data(), sizeof(MeshFileLevel), levels.size(), file) == levels.size();
+    uint64 position = sizeof(MeshFileHeader) + levels.size() * sizeof(MeshFileLevel);
+    for (size_t i = 0; ok && i < meshes.size(); ++i)
+    {
+        const Mesh& source = *meshes[i];
+        const MeshFileLevel& level = levels[i];
+        const void* indices = level.indexFormat == static_cast<uint32>(IndexFormat::UInt16)
+            ? static_cast<const void*>(narrowIndices[i].data()) : source.indices.data();
+        ok = WriteSection(file, position, level.vertices, source.vertices.data()) &&
+            WriteSection(file, position, level.compactVertices, compactVertices[i].data()) &&
+            WriteSection(file, position, level.indices, indices) &&
+            WriteSection(file, position, level.adjacencyOffsets, source.faceAdjacency.offsets.data()) &&
+            WriteSection(file, position, level.adjacencyNeighbors, source.faceAdjacency.neighbors.data()) &&
+            WriteSection(file, position, level.meshlets, source.meshlets.data());
+    }
+
+    // The file size is aligned too, so the last section can be read in
+    // 16-byte blocks
+    ok = ok && WritePadding(file, position, header.fileSize);
+
+    ok = std::fclose(file) == 0 && ok;
+    return ok;
+}
+
+bool MeshFile::Open(const char* path)
+{
+    Close();
+    if (!m_file.Open(path))
+        return false;
+
+    const uint8* data = m_file.GetData();
+    uint64 fileSize = m_file.GetSize();
+    if (fileSize < sizeof(MeshFileHeader))
+    {
+        Close();
+        return false;
+    }
+
+    const auto* header = reinterpret_cast<const MeshFileHeader*>(data);
+    uint64 tableEnd = sizeof(MeshFileHeader) + uint64(header->levelCount) * sizeof(MeshFileLevel);
+    if (header->magic != MAGIC || header->version != VERSION ||
+        header->vertexStride != sizeof(Vertex) || header->fileSize != fileSize ||
+        header->levelCount == 0 || tableEnd > fileSize)
+    {
+        Close();
+        return false;
+    }
+
+    // Table and counts only; the streams are not touched
+    const auto* levels = reinterpret_cast<const MeshFileLevel*>(data + sizeof(MeshFileHeader));
+    for (uint32 i = 0; i < header->levelCount; ++i)
+    {
+        const MeshFileLevel& level = levels[i];
+        if (level.indexFormat > static_cast<uint32>(IndexFormat::UInt32))
+        {
+            Close();
+            return false;
+        }
+        uint32 indexSize = GetIndexSize(static_cast<IndexFormat>(level.indexFormat));
+        bool fits = SectionFits(level.vertices, sizeof(Vertex), fileSize) &&
+            SectionFits(level.compactVertices, sizeof(CompactVertex), fileSize) &&
+            SectionFits(level.indices, 3 * indexSize, fileSize) &&
+            SectionFits(level.adjacencyOffsets, sizeof(uint32), fileSize) &&
+            SectionFits(level.adjacencyNeighbors, sizeof(uint32), fileSize) &&
+            SectionFits(level.meshlets, sizeof(Meshlet), fileSize);
+        if (!fits)
+        {
+            Close();
+            return false;
+        }
+
+        // A compact stream, when stored, covers every vertex
+        uint32 vertexCount = SectionCount(level.vertices, sizeof(Vertex));
+        uint32 compactCount = SectionCount(level.compactVertices, sizeof(CompactVertex));
+        if (compactCount != 0 && compactCount != vertexCount)
+        {
+            Close();
+            return false;
+        }
+
+        uint32 indexCount = SectionCount(level.indices, indexSize);
+        uint32 neighborCount = SectionCount(level.adjacencyNeighbors, sizeof(uint32));
+        const uint32* offsets = SectionData<uint32>(data, level.adjacencyOffsets);
+        bool adjacencyOk = offsets
+            ? SectionCount(level.adjacencyOffsets, sizeof(uint32)) == indexCount / 3 + 1 &&
+                offsets[0] == 0 && offsets[indexCount / 3] == neighborCount
+            : neighborCount == 0;
+
+        // Meshlets become draw ranges, so they must stay inside the indices
+        bool meshletsOk = true;
+        const Meshlet* meshlets = SectionData<Meshlet>(data, level.meshlets);
+        uint32 meshletCount = SectionCount(level.meshlets, sizeof(Meshlet));
+        for (uint32 m = 0; m < meshletCount && meshletsOk; ++m)
+        {
+            meshletsOk = meshlets[m].firstIndex <= indexCount &&
+                meshlets[m].indexCount <= indexCount - meshlets[m].firstIndex;
+        }
+
+        if (!adjacencyOk || !meshletsOk)
+        {
+            Close();
+            return false;
+        }
+    }
+
+    m_levels = levels;
+    return true;
+}
+
+void MeshFile::Close()
+{
+    m_file.Close();
+    m_levels = nullptr;
+}
+
+uint32 MeshFile::GetLevelCount() const
+{
+    if (!m_levels)
+        return 0;
+    return reinterpret_cast<const MeshFileHeader*>(m_file.GetData())->levelCount;
+}
+
+MeshFile::LevelView MeshFile::GetLevel(uint32 level) const
+{
+    LevelView view;
+    if (level >= GetLevelCount())
+        return view;
+
+    const uint8* data = m_file.GetData();
+    const MeshFileLevel& info = m_levels[level];
+    view.vertices = SectionData<Vertex>(data, info.vertices);
+    view.vertexCount = SectionCount(info.vertices, sizeof(Vertex));
+    view.compactVertices = SectionData<CompactVertex>(data, info.compactVertices);
+    view.compactRange = info.compactRange;
+    view.indexFormat = static_cast<IndexFormat>(info.indexFormat);
+    if (view.indexFormat == IndexFormat::UInt16)
+        view.indices16 = SectionData<uint16>(data, info.indices);
+    else
+        view.indices = SectionData<uint32>(data, info.indices);
+    view.indexCount = SectionCount(info.indices, GetIndexSize(view.indexFormat));
+    view.adjacencyOffsets = SectionData<uint32>(data, info.adjacencyOffsets);
+    view.adjacencyNeighbors = SectionData<uint32>(data, info.adjacencyNeighbors);
+    view.adjacencyNeighborCount = SectionCount(info.adjacencyNeighbors, sizeof(uint32));
+    view.meshlets = SectionData<Meshlet>(data, info.meshlets);
+    view.meshletCount = SectionCount(info.meshlets, sizeof(Meshlet));
+    return view;
+}
+
+bool MeshFile::Load(Mesh& mesh, bool copyStreams) const
+{
+    uint32 levelCount = GetLevelCount();
+    if (levelCount == 0)
+        return false;
+
+    Mesh result;
+    for (uint32 level = 0; level < levelCount; ++level)
+    {
+        Mesh* target = &result;
+        if (level > 0)
+        {
+            result.lods.push_back(std::make_shared<Mesh>());
+            target = result.lods.back().get();
+        }
+
+        const MeshFileLevel& info = m_levels[level];
+        LevelView view = GetLevel(level);
+        target->localBounds = info.localBounds;
+        target->localSphere = info.localSphere;
+        target->lodError = info.lodError;
+        target->meshlets.assign(view.meshlets, view.meshlets + view.meshletCount);
+        if (!copyStreams)
+            continue;
+
+        bool indicesOk = view.indexFormat == IndexFormat::UInt16
+            ? CopyIndices(view.indices16, view.indexCount, view.vertexCount, target->indices)
+            : CopyIndices(view.indices, view.indexCount, view.vertexCount, target->indices);
+        if (!indicesOk)
+            return false;
+        target->vertices.assign(view.vertices, view.vertices + view.vertexCount);
+        if (view.adjacencyOffsets)
+        {
+            if (!AdjacencyValid(view.adjacencyOffsets, view.adjacencyNeighbors, view.indexCount / 3,
+                view.adjacencyNeighborCount))
+                return false;
+            target->faceAdjacency.offsets.assign(view.adjacencyOffsets,
+                view.adjacencyOffsets + view.indexCount / 3 + 1);
+            target->faceAdjacency.neighbors.assign(view.adjacencyNeighbors,
+                view.adjacencyNeighbors + view.adjacencyNeighborCount);
+        }
+    }
+
+    mesh = std::move(result);
+    return true;
+}
+
+bool MeshFile::Upload(Renderer& renderer, const Mesh& mesh) const
+{
+    uint32 levelCount = GetLevelCount();
+    bool uploaded = levelCount > 0;
+    for (uint32 level = 0; level < levelCount; ++level)
+    {
+        const Mesh* target = &mesh;
+        if (level > 0)
+        {
+            if (level > mesh.lods.size() || !mesh.lods[level - 1])
+                return false;
+            target = mesh.lods[level - 1].get();
+        }
+
+        LevelView view = GetLevel(level);
+        if (renderer.GetVertexFormat() == VertexFormat::Compact && view.compactVertices)
+        {
+            // Stored pre-encoded: no quantization pass, no staging copy
+            const void* indices = view.indexFormat == IndexFormat::UInt16
+                ? static_cast<const void*>(view.indices16) : view.indices;
+            uploaded &= renderer.UploadMesh(target, view.compactVertices, view.compactRange,
+                view.vertexCount, indices, view.indexCount, view.indexFormat);
+        }
+        else if (view.indexFormat == IndexFormat::UInt16)
+        {
+            uploaded &= renderer.UploadMesh(target, view.vertices, view.vertexCount,
+                view.indices16, view.indexCount);
+        }
+        else
+        {
+            uploaded &= renderer.UploadMesh(target, view.vertices, view.vertexCount,
+                view.indices, view.indexCount);
+        }
+    }
+    return uploaded;
+}
+
+} // namespace RRE
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "Renderer/Mesh.h"
+#include "Renderer/VertexQuantizer.h"
+#include "RHI/RHIBuffer.h"
+#include "Core/MappedFile.h"
+#include "Core/Types.h"
+
+namespace RRE
+{
+
+class Renderer;
+
+// On-disk layout (little-endian, version 2):
+//   MeshFileHeader, MeshFileLevel[levelCount], then the sections of every
+//   level. Level 0 is the mesh, level i its lods[i - 1]. Each section starts
+//   on a 16-byte boundary, so mapped streams can be read in place. Vertices
+//   are stored twice: full for Load, and compact for Compact-format uploads.
+struct MeshFileHeader
+{
+    uint32 magic;           // MeshFile::MAGIC
+    uint32 version;         // MeshFile::VERSION
+    uint32 levelCount;
+    uint32 vertexStride;    // sizeof(Vertex)
+    uint64 fileSize;
+    uint64 reserved;
+};
+
+// Byte range in the file; size is a whole number of elements
+struct MeshFileSection
+{
+    uint64 offset;
+    uint64 size;
+};
+
+struct MeshFileLevel
+{
+    MeshFileSection vertices;           // Vertex
+    MeshFileSection compactVertices;    // CompactVertex against compactRange (or empty)
+    MeshFileSection indices;            // uint16 or uint32, see indexFormat
+    MeshFileSection adjacencyOffsets;   // uint32, face count + 1 (or empty)
+    MeshFileSection adjacencyNeighbors; // uint32
+    MeshFileSection meshlets;           // Meshlet
+    Math::AABB localBounds;
+    Math::BoundingSphere localSphere;
+    float lodError;
+    uint32 indexFormat;                 // IndexFormat, 16-bit below 65536 vertices
+    QuantizationRange compactRange;
+};
+
+static_assert(sizeof(MeshFileHeader) == 32, "MeshFileHeader layout mismatch");
+static_assert(sizeof(MeshFileLevel) == 168, "MeshFileLevel layout mismatch");
+
+// Binary mesh container read through a memory mapping. Open checks the
+// header and section table only, so opening a large mesh costs page faults
+// on first use rather than parsing; Upload hands the mapped vertex and index
+// streams straight to the device, in the renderer's vertex format. Index values are not range-checked on
+// that path: files are expected to come from Write.
+class MeshFile
+{
+public:
+    static constexpr uint32 MAGIC = 0x4D455252;    // "RREM"
+    static constexpr uint32 VERSION = 2;
+
+    // Writes mesh and its LOD chain (the BVH is not stored; rebuild it
+    // after loading if ray queries are needed)
+    static bool Write(const char* path, const Mesh& mesh);
+
+    // Maps path and validates its layout, closing any previous file
+    bool Open(const char* path);
+    void Close();
+    bool IsOpen() const { return m_levels != nullptr; }
+
+    // Views of one level's sections, valid while the file stays open
+    struct LevelView
+    {
+        const Vertex* vertices = nullptr;
+        uint32 vertexCount = 0;
+        const CompactVertex* compactVertices = nullptr;   // null when not stored
+        QuantizationRange compactRange;
+        IndexFormat indexFormat = IndexFormat::UInt32;
+        const uint32* indices = nullptr;            // UInt32 levels
+        const uint16* indices16 = nullptr;          // UInt16 levels
+        uint32 indexCount = 0;
+        const uint32* adjacencyOffsets = nullptr;   // null when not stored
+        const uint32* adjacencyNeighbors = nullptr;
+        uint32 adjacencyNeighborCount = 0;
+        const Meshlet* meshlets = nullptr;
+        uint32 meshletCount = 0;
+    };
+
+    uint32 GetLevelCount() const;
+    const MeshFileLevel& GetLevelInfo(uint32 level) const { return m_levels[level]; }
+    LevelView GetLevel(uint32 level) const;
+
+    // Builds the mesh with its lods. Without copyStreams the vertex, index
+    // and adjacency arrays stay empty: the mesh carries bounds, meshlets and
+    // LOD errors for culling, and Upload supplies its buffers from the
+    // mapping (again after every Renderer::ClearMeshCache, which the
+    // renderer cannot undo on its own). With copyStreams, fails if an index
+    // or the adjacency is out of range.
+    bool Load(Mesh& mesh, bool copyStreams = true) const;
+
+    // Uploads every level of mesh (as returned by Load on this file) from
+    // the mapped streams, so the renderer never reads mesh->vertices.
+    // Levels still cached are kept; false if any level has no buffers.
+    bool Upload(Renderer& renderer, const Mesh& mesh) const;
+
+private:
+    MappedFile m_file;
+    const MeshFileLevel* m_levels = nullptr;
+};
+
+} // namespace RRE
@@ -0,0 +1,836 @@
+#include "Renderer/MeshImporter.h"
+#include "Core/MappedFile.h"
+#include "Core/ThreadPool.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+
+using namespace DirectX;
+
+namespace RRE
+{
+
+namespace
+{
+
+using Face = std::array<uint32, 3>;
+
+// OBJ text per parse task; chunk starts move forward to the next line
+const uint64 OBJ_CHUNK_BYTES = 1u << 20;
+
+// Binary PLY records per parse task
+const uint32 PLY_VERTICES_PER_TASK = 1u << 16;
+const uint32 PLY_FACES_PER_TASK = 1u << 16;
+
+void ParallelFor(ThreadPool* pool, uint32 count, uint32 grain,
+    const std::function<void(uint32, uint32)>& fn)
+{
+    if (pool)
+        pool->ParallelFor(count, grain, fn);
+    else if (count > 0)
+        fn(0, count);
+}
+
+bool HasExtension(const char* path, const char* extension)
+{
+    size_t pathLength = strlen(path);
+    size_t extensionLength = strlen(extension);
+    if (pathLength < extensionLength)
+        return false;
+    const char* tail = path + pathLength - extensionLength;
+    for (size_t i = 0; i < extensionLength; ++i)
+    {
+        if (std::tolower(static_cast<unsigned char>(tail[i])) != extension[i])
+            return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Text parsing
+
+bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+bool IsBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+void SkipBlanks(const char*& p, const char* end)
+{
+    while (p < end && IsBlank(*p))
+    {
+        ++p;
+    }
+}
+
+const char* FindLineEnd(const char* p, const char* end)
+{
+    const void* newline = memchr(p, '\n', static_cast<size_t>(end - p));
+    return newline ? static_cast<const char*>(newline) : end;
+}
+
+double ScaleByPowerOfTen(double value, int32 exponent)
+{
+    // Powers of ten are exact in double up to 1e22
+    static const double exact[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    if (exponent >= 0 && exponent <= 22)
+        return value * exact[exponent];
+    if (exponent < 0 && exponent >= -22)
+        return value / exact[-exponent];
+    return value * std::pow(10.0, exponent);
+}
+
+// [sign] digits [. digits] [e [sign] digits], stopping at the first other
+// character. Up to 19 significant digits are kept, so any float written
+// with enough digits round-trips (the double result rounds once more to
+// float). No inf/nan or hex forms.
+bool ParseFloat(const char*& p, const char* end, float& value)
+{
+    const char* s = p;
+    bool negative = false;
+    if (s < end && (*s == '-' || *s == '+'))
+    {
+        negative = *s == '-';
+        ++s;
+    }
+
+    uint64 mantissa = 0;
+    uint32 digits = 0;      // significant digits in mantissa
+    int32 exponent = 0;
+    bool any = false;
+    for (; s < end && IsDigit(*s); ++s)
+    {
+        any = true;
+        if (digits < 19)
+        {
+            mantissa = mantissa * 10 + static_cast<uint64>(*s - '0');
+            digits += mantissa != 0;
+        }
+        else
+        {
+            ++exponent;
+        }
+    }
+    if (s < end && *s == '.')
+    {
+        for (++s; s < end && IsDigit(*s); ++s)
+        {
+            any = true;
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + static_cast<uint64>(*s - '0');
+                digits += mantissa != 0;
+                --exponent;
+            }
+        }
+    }
+    if (!any)
+        return false;
+
+    if (s < end && (*s == 'e' || *s == 'E'))
+    {
+        ++s;
+        bool exponentNegative = false;
+        if (s < end && (*s == '-' || *s == '+'))
+        {
+            exponentNegative = *s == '-';
+            ++s;
+        }
+        int32 written = 0;
+        bool exponentAny = false;
+        for (; s < end && IsDigit(*s); ++s)
+        {
+            exponentAny = true;
+            written = std::min(written * 10 + (*s - '0'), 100000);
+        }
+        if (!exponentAny)
+            return false;
+        exponent += exponentNegative ? -written : written;
+    }
+
+    double result = ScaleByPowerOfTen(static_cast<double>(mantissa), exponent);
+    value = static_cast<float>(negative ? -result : result);
+    p = s;
+    return true;
+}
+
+bool ParseInt(const char*& p, const char* end, int64& value)
+{
+    const char* s = p;
+    bool negative = false;
+    if (s < end && (*s == '-' || *s == '+'))
+    {
+        negative = *s == '-';
+        ++s;
+    }
+    int64 result = 0;
+    bool any = false;
+    for (; s < end && IsDigit(*s); ++s)
+    {
+        any = true;
+        result = std::min<int64>(result * 10 + (*s - '0'), INT64_C(1) << 40);
+    }
+    if (!any)
+        return false;
+    value = negative ? -result : result;
+    p = s;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// OBJ
+
+// Corner whose index counts back from the chunk's own positions ("f -1 ...");
+// resolved once the positions of earlier chunks are counted
+struct RelativeCorner
+{
+    uint64 corner;      // face * 3 + k within the chunk
+    int64 index;        // relative to the chunk's first position
+};
+
+struct ObjChunk
+{
+    std::vector<XMFLOAT3> positions;
+    std::vector<Face> faces;
+    std::vector<RelativeCorner> relative;
+    bool ok = true;
+};
+
+struct ObjCorner
+{
+    int64 index;
+    bool relative;
+};
+
+// "v x y z ..." and "f a/b/c ..." lines; everything else is skipped
+bool ParseObjChunk(const char* p, const char* end, ObjChunk& chunk)
+{
+    std::vector<ObjCorner> polygon;
+    while (p < end)
+    {
+        const char* lineEnd = FindLineEnd(p, end);
+        SkipBlanks(p, lineEnd);
+        if (lineEnd - p >= 2 && IsBlank(p[1]) && p[0] == 'v')
+        {
+            const char* s = p + 1;
+            XMFLOAT3 position;
+            SkipBlanks(s, lineEnd);
+            if (!ParseFloat(s, lineEnd, position.x))
+                return false;
+            SkipBlanks(s, lineEnd);
+            if (!ParseFloat(s, lineEnd, position.y))
+                return false;
+            SkipBlanks(s, lineEnd);
+            if (!ParseFloat(s, lineEnd, position.z))
+                return false;
+            chunk.positions.push_back(position);
+        }
+        else if (lineEnd - p >= 2 && IsBlank(p[1]) && p[0] == 'f')
+        {
+            const char* s = p + 1;
+            polygon.clear();
+            for (;;)
+            {
+                SkipBlanks(s, lineEnd);
+                if (s >= lineEnd || *s == '#')
+                    break;
+                int64 index;
+                if (!ParseInt(s, lineEnd, index) || index == 0)
+                    return false;
+                if (index > 0)
+                    polygon.push_back({ index - 1, false });
+                else
+                    polygon.push_back({ static_cast<int64>(chunk.positions.size()) + index, true });
+
+                // Texture and normal references
+                while (s < lineEnd && !IsBlank(*s))
+                {
+                    ++s;
+                }
+            }
+
+            // Fan triangulation; points and lines have no triangles
+            for (size_t i = 2; i < polygon.size(); ++i)
+            {
+                const ObjCorner corners[3] = { polygon[0], polygon[i - 1], polygon[i] };
+                Face face;
+                for (uint32 k = 0; k < 3; ++k)
+                {
+                    face[k] = 0;
+                    if (corners[k].relative)
+                        chunk.relative.push_back({ chunk.faces.size() * 3 + k, corners[k].index });
+                    else if (corners[k].index > UINT32_MAX)
+                        return false;
+                    else
+                        face[k] = static_cast<uint32>(corners[k].index);
+                }
+                chunk.faces.push_back(face);
+            }
+        }
+        p = lineEnd < end ? lineEnd + 1 : end;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// PLY
+
+enum class PlyType
+{
+    None,
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Float32,
+    Float64
+};
+
+PlyType ParsePlyType(const std::string& name)
+{
+    if (name == "char" || name == "int8")       return PlyType::Int8;
+    if (name == "uchar" || name == "uint8")     return PlyType::UInt8;
+    if (name == "short" || name == "int16")     return PlyType::Int16;
+    if (name == "ushort" || name == "uint16")   return PlyType::UInt16;
+    if (name == "int" || name == "int32")       return PlyType::Int32;
+    if (name == "uint" || name == "uint32")     return PlyType::UInt32;
+    if (name == "float" || name == "float32")   return PlyType::Float32;
+    if (name == "double" || name == "float64")  return PlyType::Float64;
+    return PlyType::None;
+}
+
+uint32 PlyTypeSize(PlyType type)
+{
+    switch (type)
+    {
+    case PlyType::Int8:
+    case PlyType::UInt8:    return 1;
+    case PlyType::Int16:
+    case PlyType::UInt16:   return 2;
+    case PlyType::Int32:
+    case PlyType::UInt32:
+    case PlyType::Float32:  return 4;
+    case PlyType::Float64:  return 8;
+    case PlyType::None:     break;
+    }
+    return 0;
+}
+
+struct PlyProperty
+{
+    std::string name;
+    PlyType type = PlyType::None;       // list entries for lists
+    PlyType countType = PlyType::None;  // set for lists only
+};
+
+struct PlyElement
+{
+    std::string name;
+    uint64 count = 0;
+    std::vector<PlyProperty> properties;
+
+    // Record size, or 0 when it holds a list
+    uint32 GetStride() const
+    {
+        uint32 stride = 0;
+        for (const PlyProperty& property : properties)
+        {
+            if (property.countType != PlyType::None)
+                return 0;
+            stride += PlyTypeSize(property.type);
+        }
+        return stride;
+    }
+};
+
+struct PlyHeader
+{
+    bool bigEndian = false;
+    std::vector<PlyElement> elements;
+    uint64 dataOffset = 0;
+};
+
+std::vector<std::string> SplitWords(const char* p, const char* end)
+{
+    std::vector<std::string> words;
+    for (;;)
+    {
+        SkipBlanks(p, end);
+        if (p >= end)
+            return words;
+        const char* start = p;
+        while (p < end && !IsBlank(*p))
+        {
+            ++p;
+        }
+        words.emplace_back(start, p);
+    }
+}
+
+bool ParsePlyHeader(const char* text, uint64 size, PlyHeader& header)
+{
+    const char* p = text;
+    const char* end = text + size;
+    bool first = true;
+    bool formatSeen = false;
+    while (p < end)
+    {
+        const char* lineEnd = FindLineEnd(p, end);
+        if (lineEnd == end)
+            return false;
+        std::vector<std::string> words = SplitWords(p, lineEnd);
+        p = lineEnd + 1;
+
+        if (first)
+        {
+            if (words.size() != 1 || words[0] != "ply")
+                return false;
+            first = false;
+        }
+        else if (words.empty() || words[0] == "comment" || words[0] == "obj_info")
+        {
+            continue;
+        }
+        else if (words[0] == "format")
+        {
+            // ASCII PLY would need the text path; scans are binary
+            if (words.size() != 3 || words[2] != "1.0")
+                return false;
+            if (words[1] == "binary_little_endian")
+                header.bigEndian = false;
+            else if (words[1] == "binary_big_endian")
+                header.bigEndian = true;
+            else
+                return false;
+            formatSeen = true;
+        }
+        else if (words[0] == "element")
+        {
+            if (words.size() != 3)
+                return false;
+            PlyElement element;
+            element.name = words[1];
+            element.count = std::strtoull(words[2].c_str(), nullptr, 10);
+            header.elements.push_back(element);
+        }
+        else if (words[0] == "property")
+        {
+            if (header.elements.empty())
+                return false;
+            PlyProperty property;
+            if (words.size() == 5 && words[1] == "list")
+            {
+                property.countType = ParsePlyType(words[2]);
+                property.type = ParsePlyType(words[3]);
+                property.name = words[4];
+                if (property.countType == PlyType::None)
+                    return false;
+            }
+            else if (words.size() == 3)
+            {
+                property.type = ParsePlyType(words[1]);
+                property.name = words[2];
+            }
+            if (property.type == PlyType::None)
+                return false;
+            header.elements.back().properties.push_back(property);
+        }
+        else if (words[0] == "end_header")
+        {
+            header.dataOffset = static_cast<uint64>(p - text);
+            return formatSeen;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+T LoadValue(const uint8* p, bool swap)
+{
+    uint8 bytes[sizeof(T)];
+    memcpy(bytes, p, sizeof(T));
+    if (swap)
+        std::reverse(bytes, bytes + sizeof(T));
+    T value;
+    memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+// Binary values in file order; swap for big-endian files on this
+// (little-endian) engine
+double ReadScalar(const uint8* p, PlyType type, bool swap)
+{
+    switch (type)
+    {
+    case PlyType::Int8:     return LoadValue<int8_t>(p, swap);
+    case PlyType::UInt8:    return LoadValue<uint8>(p, swap);
+    case PlyType::Int16:    return LoadValue<int16_t>(p, swap);
+    case PlyType::UInt16:   return LoadValue<uint16>(p, swap);
+    case PlyType::Int32:    return LoadValue<int32>(p, swap);
+    case PlyType::UInt32:   return LoadValue<uint32>(p, swap);
+    case PlyType::Float32:  return LoadValue<float>(p, swap);
+    case PlyType::Float64:  return LoadValue<double>(p, swap);
+    case PlyType::None:     break;
+    }
+    return 0.0;
+}
+
+int64 ReadInteger(const uint8* p, PlyType type, bool swap)
+{
+    switch (type)
+    {
+    case PlyType::Int8:     return LoadValue<int8_t>(p, swap);
+    case PlyType::UInt8:    return LoadValue<uint8>(p, swap);
+    case PlyType::Int16:    return LoadValue<int16_t>(p, swap);
+    case PlyType::UInt16:   return LoadValue<uint16>(p, swap);
+    case PlyType::Int32:    return LoadValue<int32>(p, swap);
+    case PlyType::UInt32:   return LoadValue<uint32>(p, swap);
+    default:                return static_cast<int64>(ReadScalar(p, type, swap));
+    }
+}
+
+// Where x, y, z sit in a vertex record
+struct PlyVertexLayout
+{
+    uint32 stride = 0;
+    uint32 offsets[3] = {};
+    PlyType types[3] = { PlyType::None, PlyType::None, PlyType::None };
+};
+
+bool GetVertexLayout(const PlyElement& element, PlyVertexLayout& layout)
+{
+    layout.stride = element.GetStride();
+    if (layout.stride == 0)
+        return false;
+    static const char* const axes[3] = { "x", "y", "z" };
+    uint32 offset = 0;
+    for (const PlyProperty& property : element.properties)
+    {
+        for (uint32 axis = 0; axis < 3; ++axis)
+        {
+            if (property.name == axes[axis])
+            {
+                layout.offsets[axis] = offset;
+                layout.types[axis] = property.type;
+            }
+        }
+        offset += PlyTypeSize(property.type);
+    }
+    return layout.types[0] != PlyType::None && layout.types[1] != PlyType::None &&
+        layout.types[2] != PlyType::None;
+}
+
+// Bytes around the index list of a face record
+struct PlyFaceLayout
+{
+    uint32 before = 0;
+    uint32 after = 0;
+    PlyType countType = PlyType::None;
+    PlyType indexType = PlyType::None;
+};
+
+bool GetFaceLayout(const PlyElement& element, PlyFaceLayout& layout)
+{
+    bool listSeen = false;
+    for (const PlyProperty& property : element.properties)
+    {
+        if (property.countType != PlyType::None)
+        {
+            if (listSeen || (property.name != "vertex_indices" && property.name != "vertex_index"))
+                return false;
+            listSeen = true;
+            layout.countType = property.countType;
+            layout.indexType = property.type;
+        }
+        else
+        {
+            (listSeen ? layout.after : layout.before) += PlyTypeSize(property.type);
+        }
+    }
+    return listSeen;
+}
+
+// Walks the face records (only their counts are read) to find where every
+// PLY_FACES_PER_TASK run starts and how many triangles precede it
+bool ScanFaces(const uint8* data, uint64 size, uint64 offset, uint64 count,
+    const PlyFaceLayout& layout, bool swap, std::vector<uint64>& taskOffsets,
+    std::vector<uint64>& taskTriangles, uint64& triangleCount, uint64& endOffset)
+{
+    uint32 countSize = PlyTypeSize(layout.countType);
+    uint32 indexSize = PlyTypeSize(layout.indexType);
+    triangleCount = 0;
+    for (uint64 f = 0; f < count; ++f)
+    {
+        if (f % PLY_FACES_PER_TASK == 0)
+        {
+            taskOffsets.push_back(offset);
+            taskTriangles.push_back(triangleCount);
+        }
+        offset += layout.before;
+        if (offset + countSize > size)
+            return false;
+        int64 corners = ReadInteger(data + offset, layout.countType, swap);
+        if (corners < 0)
+            return false;
+        offset += countSize + static_cast<uint64>(corners) * indexSize + layout.after;
+        if (offset > size)
+            return false;
+        if (corners >= 3)
+            triangleCount += static_cast<uint64>(corners - 2);
+    }
+    endOffset = offset;
+    return true;
+}
+
+} // anonymous namespace
+
+bool MeshImporter::Load(const char* path, Mesh& mesh, MeshShading shading, ThreadPool* pool)
+{
+    if (!path)
+        return false;
+    if (HasExtension(path, ".obj"))
+        return LoadOBJ(path, mesh, shading, pool);
+    if (HasExtension(path, ".ply"))
+        return LoadPLY(path, mesh, shading, pool);
+    return false;
+}
+
+bool MeshImporter::LoadOBJ(const char* path, Mesh& mesh, MeshShading shading, ThreadPool* pool)
+{
+    std::vector<XMFLOAT3> positions;
+    std::vector<Face> faces;
+    if (!ReadOBJ(path, positions, faces, pool) || faces.empty())
+        return false;
+    mesh = MeshFactory::CreateFromFaces(positions, faces, shading);
+    return true;
+}
+
+bool MeshImporter::LoadPLY(const char* path, Mesh& mesh, MeshShading shading, ThreadPool* pool)
+{
+    std::vector<XMFLOAT3> positions;
+    std::vector<Face> faces;
+    if (!ReadPLY(path, positions, faces, pool) || faces.empty())
+        return false;
+    mesh = MeshFactory::CreateFromFaces(positions, faces, shading);
+    return true;
+}
+
+bool MeshImporter::ReadOBJ(const char* path, std::vector<XMFLOAT3>& positions,
+    std::vector<Face>& faces, ThreadPool* pool)
+{
+    MappedFile file;
+    if (!file.Open(path))
+        return false;
+    const char* text = reinterpret_cast<const char*>(file.GetData());
+    const char* end = text + file.GetSize();
+
+    // Line-aligned chunk starts, about OBJ_CHUNK_BYTES apart
+    std::vector<const char*> starts = { text };
+    for (uint64 offset = OBJ_CHUNK_BYTES; offset < file.GetSize(); offset += OBJ_CHUNK_BYTES)
+    {
+        const char* from = std::max(text + offset, starts.back());
+        const char* lineEnd = FindLineEnd(from, end);
+        if (lineEnd >= end - 1)
+            break;
+        starts.push_back(lineEnd + 1);
+    }
+    starts.push_back(end);
+
+    uint32 chunkCount = static_cast<uint32>(starts.size() - 1);
+    std::vector<ObjChunk> chunks(chunkCount);
+    ParallelFor(pool, chunkCount, 1, [&](uint32 begin, uint32 last) {
+        for (uint32 c = begin; c < last; ++c)
+        {
+            chunks[c].ok = ParseObjChunk(starts[c], starts[c + 1], chunks[c]);
+        }
+    });
+
+    // Chunk outputs land at prefix-summed offsets
+    std::vector<uint64> positionBases(chunkCount + 1, 0);
+    std::vector<uint64> faceBases(chunkCount + 1, 0);
+    for (uint32 c = 0; c < chunkCount; ++c)
+    {
+        if (!chunks[c].ok)
+            return false;
+        positionBases[c + 1] = positionBases[c] + chunks[c].positions.size();
+        faceBases[c + 1] = faceBases[c] + chunks[c].faces.size();
+    }
+    uint64 positionCount = positionBases[chunkCount];
+    if (positionCount > UINT32_MAX)
+        return false;
+
+    positions.resize(static_cast<size_t>(positionCount));
+    faces.resize(static_cast<size_t>(faceBases[chunkCount]));
+    ParallelFor(pool, chunkCount, 1, [&](uint32 begin, uint32 last) {
+        for (uint32 c = begin; c < last; ++c)
+        {
+            ObjChunk& chunk = chunks[c];
+            std::copy(chunk.positions.begin(), chunk.positions.end(),
+                positions.begin() + static_cast<size_t>(positionBases[c]));
+
+            Face* out = faces.data() + faceBases[c];
+            for (const Face& face : chunk.faces)
+            {
+                if (face[0] >= positionCount || face[1] >= positionCount || face[2] >= positionCount)
+                    chunk.ok = false;
+                *out++ = face;
+            }
+            for (const RelativeCorner& corner : chunk.relative)
+            {
+                int64 index = static_cast<int64>(positionBases[c]) + corner.index;
+                if (index < 0 || static_cast<uint64>(index) >= positionCount)
+                    chunk.ok = false;
+                else
+                    faces[faceBases[c] + corner.corner / 3][corner.corner % 3] = static_cast<uint32>(index);
+            }
+
+            // Release as we go to keep the peak near one copy
+            chunk.positions = std::vector<XMFLOAT3>();
+            chunk.faces = std::vector<Face>();
+            chunk.relative = std::vector<RelativeCorner>();
+        }
+    });
+
+    for (const ObjChunk& chunk : chunks)
+    {
+        if (!chunk.ok)
+            return false;
+    }
+    return true;
+}
+
+bool MeshImporter::ReadPLY(const char* path, std::vector<XMFLOAT3>& positions,
+    std::vector<Face>& faces, ThreadPool* pool)
+{
+    MappedFile file;
+    if (!file.Open(path))
+        return false;
+    const uint8* data = file.GetData();
+    uint64 size = file.GetSize();
+
+    PlyHeader header;
+    if (!ParsePlyHeader(reinterpret_cast<const char*>(data), size, header))
+        return false;
+    bool swap = header.bigEndian;
+
+    // Locate the vertex and face records; other elements are skipped by size
+    const PlyElement* vertexElement = nullptr;
+    const PlyElement* faceElement = nullptr;
+    PlyVertexLayout vertexLayout;
+    PlyFaceLayout faceLayout;
+    uint64 vertexOffset = 0;
+    uint64 faceOffset = 0;
+    uint64 triangleCount = 0;
+    std::vector<uint64> taskOffsets;
+    std::vector<uint64> taskTriangles;
+    uint64 offset = header.dataOffset;
+    for (const PlyElement& element : header.elements)
+    {
+        if (vertexElement && faceElement)
+            break;
+
+        if (element.name == "vertex" && !vertexElement)
+        {
+            if (!GetVertexLayout(element, vertexLayout) || element.count > UINT32_MAX)
+                return false;
+            if (element.count > (size - offset) / vertexLayout.stride)
+                return false;
+            vertexElement = &element;
+            vertexOffset = offset;
+            offset += element.count * vertexLayout.stride;
+        }
+        else if (element.name == "face" && !faceElement)
+        {
+            if (!GetFaceLayout(element, faceLayout))
+                return false;
+            faceElement = &element;
+            faceOffset = offset;
+            if (!ScanFaces(data, size, faceOffset, element.count, faceLayout, swap,
+                taskOffsets, taskTriangles, triangleCount, offset))
+                return false;
+        }
+        else
+        {
+            uint32 stride = element.GetStride();
+            if (element.count > 0 && (stride == 0 || element.count > (size - offset) / stride))
+                return false;
+            offset += element.count * stride;
+        }
+    }
+    if (!vertexElement || !faceElement)
+        return false;
+
+    uint32 vertexCount = static_cast<uint32>(vertexElement->count);
+    positions.resize(vertexCount);
+    ParallelFor(pool, vertexCount, PLY_VERTICES_PER_TASK, [&](uint32 begin, uint32 last) {
+        for (uint32 v = begin; v < last; ++v)
+        {
+            const uint8* record = data + vertexOffset + static_cast<uint64>(v) * vertexLayout.stride;
+            positions[v].x = static_cast<float>(ReadScalar(record + vertexLayout.offsets[0], vertexLayout.types[0], swap));
+            positions[v].y = static_cast<float>(ReadScalar(record + vertexLayout.offsets[1], vertexLayout.types[1], swap));
+            positions[v].z = static_cast<float>(ReadScalar(record + vertexLayout.offsets[2], vertexLayout.types[2], swap));
+        }
+    });
+
+    // Each task decodes its run of records into its triangle range
+    faces.resize(static_cast<size_t>(triangleCount));
+    uint32 taskCount = static_cast<uint32>(taskOffsets.size());
+    std::vector<uint8> taskOk(taskCount, 1);
+    uint32 countSize = PlyTypeSize(faceLayout.countType);
+    uint32 indexSize = PlyTypeSize(faceLayout.indexType);
+    ParallelFor(pool, taskCount, 1, [&](uint32 begin, uint32 last) {
+        for (uint32 t = begin; t < last; ++t)
+        {
+            const uint8* p = data + taskOffsets[t];
+            Face* out = faces.data() + taskTriangles[t];
+            uint64 firstFace = static_cast<uint64>(t) * PLY_FACES_PER_TASK;
+            uint64 lastFace = std::min(faceElement->count, firstFace + PLY_FACES_PER_TASK);
+            for (uint64 f = firstFace; f < lastFace; ++f)
+            {
+                p += faceLayout.before;
+                int64 corners = ReadInteger(p, faceLayout.countType, swap);
+                p += countSize;
+
+                uint32 first = 0;
+                uint32 previous = 0;
+                for (int64 k = 0; k < corners; ++k, p += indexSize)
+                {
+                    int64 index = ReadInteger(p, faceLayout.indexType, swap);
+                    if (index < 0 || index >= vertexCount)
+                    {
+                        taskOk[t] = 0;
+                        index = 0;
+                    }
+                    uint32 current = static_cast<uint32>(index);
+                    if (k == 0)
+                        first = current;
+                    else if (k >= 2)
+                        *out++ = { first, previous, current };
+                    previous = current;
+                }
+                p += faceLayout.after;
+            }
+        }
+    });
+
+    return std::find(taskOk.begin(), taskOk.end(), 0) == taskOk.end();
+}
+
+} // namespace RRE
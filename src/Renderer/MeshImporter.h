@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Renderer/Mesh.h"
+#include "Renderer/MeshFactory.h"
+#include "Core/Types.h"
+#include <DirectXMath.h>
+#include <array>
+#include <vector>
+
+namespace RRE
+{
+
+class ThreadPool;
+
+// Loads triangle meshes from Wavefront OBJ and binary PLY files. The file is
+// memory-mapped and parsed in place: OBJ text is split into line-aligned
+// chunks, PLY records into vertex and face ranges, and the pieces are parsed
+// on the pool (or the calling thread without one). Only positions and faces
+// are read; polygons are fan-triangulated, and normals and palette colors
+// come from MeshFactory::CreateFromFaces. Smooth shading is the default as
+// scans share positions between faces.
+class MeshImporter
+{
+public:
+    // By extension: .obj or .ply (any case)
+    static bool Load(const char* path, Mesh& mesh,
+        MeshShading shading = MeshShading::Smooth, ThreadPool* pool = nullptr);
+
+    static bool LoadOBJ(const char* path, Mesh& mesh,
+        MeshShading shading = MeshShading::Smooth, ThreadPool* pool = nullptr);
+    static bool LoadPLY(const char* path, Mesh& mesh,
+        MeshShading shading = MeshShading::Smooth, ThreadPool* pool = nullptr);
+
+    // Positions and triangles as stored, without building a Mesh. OBJ
+    // negative (relative) indices are resolved; any index outside the
+    // positions fails the read.
+    static bool ReadOBJ(const char* path, std::vector<DirectX::XMFLOAT3>& positions,
+        std::vector<std::array<uint32, 3>>& faces, ThreadPool* pool = nullptr);
+
+    // binary_little_endian or binary_big_endian 1.0; a vertex element with
+    // scalar x, y, z and a face element with one vertex_indices (or
+    // vertex_index) list. Elements before those must be fixed-size.
+    static bool ReadPLY(const char* path, std::vector<DirectX::XMFLOAT3>& positions,
+        std::vector<std::array<uint32, 3>>& faces, ThreadPool* pool = nullptr);
+};
+
+} // namespace RRE
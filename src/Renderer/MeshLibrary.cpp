@@ -0,0 +1,159 @@
+#include "Renderer/MeshLibrary.h"
+#include "Core/Hash.h"
+#include "Core/ThreadPool.h"
+
+namespace RRE
+{
+
+namespace
+{
+
+Mesh GenerateMesh(const MeshDesc& desc)
+{
+    switch (desc.shape)
+    {
+    case MeshShape::Sphere:      return MeshFactory::CreateSphere(desc.segments, desc.rings, desc.shading);
+    case MeshShape::Tetrahedron: return MeshFactory::CreateTetrahedron(desc.shading);
+    case MeshShape::Cube:        return MeshFactory::CreateCube(desc.shading);
+    case MeshShape::Cylinder:    return MeshFactory::CreateCylinder(desc.segments, desc.height, desc.shading);
+    }
+    return Mesh();
+}
+
+} // anonymous namespace
+
+MeshDesc MeshDesc::Sphere(uint32 segments, uint32 rings, MeshShading shading)
+{
+    MeshDesc desc;
+    desc.shape = MeshShape::Sphere;
+    desc.segments = segments;
+    desc.rings = rings;
+    desc.shading = shading;
+    return desc;
+}
+
+MeshDesc MeshDesc::Tetrahedron(MeshShading shading)
+{
+    MeshDesc desc;
+    desc.shape = MeshShape::Tetrahedron;
+    desc.shading = shading;
+    return desc;
+}
+
+MeshDesc MeshDesc::Cube(MeshShading shading)
+{
+    MeshDesc desc;
+    desc.shape = MeshShape::Cube;
+    desc.shading = shading;
+    return desc;
+}
+
+MeshDesc MeshDesc::Cylinder(uint32 segments, float height, MeshShading shading)
+{
+    MeshDesc desc;
+    desc.shape = MeshShape::Cylinder;
+    desc.segments = segments;
+    desc.height = height;
+    desc.shading = shading;
+    return desc;
+}
+
+bool MeshDesc::operator==(const MeshDesc& other) const
+{
+    return shape == other.shape && segments == other.segments && rings == other.rings &&
+        height == other.height && shading == other.shading;
+}
+
+size_t MeshLibrary::DescHash::operator()(const MeshDesc& desc) const
+{
+    // Folded height bits, so heights equal under operator== hash alike
+    FloatBitsKey<1> height(&desc.height);
+    uint32 words[5] = { static_cast<uint32>(desc.shape), desc.segments, desc.rings,
+        height.words[0], static_cast<uint32>(desc.shading) };
+    return static_cast<size_t>(HashWords(words, 5));
+}
+
+MeshLibrary::MeshLibrary(ThreadPool* pool)
+    : m_pool(pool)
+{
+}
+
+MeshLibrary::~MeshLibrary()
+{
+    // Queued jobs still hold this; they find their entries claimed or
+    // generate them, either way they finish quickly
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_changed.wait(lock, [this]() { return m_jobsInFlight == 0; });
+}
+
+void MeshLibrary::Request(const MeshDesc& desc)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto inserted = m_entries.emplace(desc, Entry());
+    if (!inserted.second)
+        return;
+    ++m_pending;
+    if (!m_pool)
+        return;
+
+    ++m_jobsInFlight;
+    Entry* entry = &inserted.first->second;
+    lock.unlock();
+    m_pool->Submit([this, desc, entry]() {
+        std::unique_lock<std::mutex> jobLock(m_mutex);
+        if (entry->state == State::Queued)
+            Generate(desc, *entry, jobLock);
+        --m_jobsInFlight;
+        m_changed.notify_all();
+    });
+}
+
+std::shared_ptr<const Mesh> MeshLibrary::TryGet(const MeshDesc& desc)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(desc);
+        if (it != m_entries.end())
+            return it->second.state == State::Ready ? it->second.mesh : nullptr;
+    }
+    Request(desc);
+    return nullptr;
+}
+
+std::shared_ptr<const Mesh> MeshLibrary::Get(const MeshDesc& desc)
+{
+    Request(desc);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    Entry& entry = m_entries.find(desc)->second;
+    if (entry.state == State::Queued)
+        Generate(desc, entry, lock);
+    m_changed.wait(lock, [&entry]() { return entry.state == State::Ready; });
+    return entry.mesh;
+}
+
+uint32 MeshLibrary::GetPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pending;
+}
+
+uint32 MeshLibrary::GetMeshCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<uint32>(m_entries.size()) - m_pending;
+}
+
+void MeshLibrary::Generate(const MeshDesc& desc, Entry& entry, std::unique_lock<std::mutex>& lock)
+{
+    entry.state = State::Generating;
+    lock.unlock();
+    auto mesh = std::make_shared<const Mesh>(GenerateMesh(desc));
+    lock.lock();
+
+    entry.mesh = std::move(mesh);
+    entry.state = State::Ready;
+    --m_pending;
+    m_changed.notify_all();
+}
+
+} // namespace RRE
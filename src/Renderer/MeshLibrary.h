@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Renderer/Mesh.h"
+#include "Renderer/MeshFactory.h"
+#include "Core/Types.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace RRE
+{
+
+class ThreadPool;
+
+enum class MeshShape
+{
+    Sphere,
+    Tetrahedron,
+    Cube,
+    Cylinder
+};
+
+// MeshFactory parameters; equal descs name the same mesh. Fields a shape
+// does not use are normalized by the named constructors, so build descs
+// through them.
+struct MeshDesc
+{
+    MeshShape shape = MeshShape::Cube;
+    uint32 segments = 0;        // sphere, cylinder
+    uint32 rings = 0;           // sphere
+    float height = 0.0f;        // cylinder
+    MeshShading shading = MeshShading::Flat;
+
+    static MeshDesc Sphere(uint32 segments = 16, uint32 rings = 16,
+        MeshShading shading = MeshShading::Flat);
+    static MeshDesc Tetrahedron(MeshShading shading = MeshShading::Flat);
+    static MeshDesc Cube(MeshShading shading = MeshShading::Flat);
+    static MeshDesc Cylinder(uint32 segments = 16, float height = 2.0f,
+        MeshShading shading = MeshShading::Flat);
+
+    bool operator==(const MeshDesc& other) const;
+};
+
+// Memoized procedural meshes generated on a thread pool. Every desc is
+// generated once; all callers share the resulting immutable mesh, which
+// stays alive while the library or any caller holds it. Request starts
+// generation without waiting, so slow high-tessellation meshes can finish
+// while the caller renders what is already available.
+class MeshLibrary
+{
+public:
+    // Without a pool, meshes are generated on the thread that asks first
+    explicit MeshLibrary(ThreadPool* pool = nullptr);
+    ~MeshLibrary();     // waits for generation still running
+
+    MeshLibrary(const MeshLibrary&) = delete;
+    MeshLibrary& operator=(const MeshLibrary&) = delete;
+
+    // Queue generation unless desc is known already
+    void Request(const MeshDesc& desc);
+
+    // The finished mesh, or null (after requesting it) while it is generating
+    std::shared_ptr<const Mesh> TryGet(const MeshDesc& desc);
+
+    // The mesh, waiting for it or generating it on this thread if no
+    // worker has started it yet
+    std::shared_ptr<const Mesh> Get(const MeshDesc& desc);
+
+    uint32 GetPendingCount() const;     // requested, not finished
+    uint32 GetMeshCount() const;        // finished
+
+private:
+    struct DescHash
+    {
+        size_t operator()(const MeshDesc& desc) const;
+    };
+
+    enum class State
+    {
+        Queued,
+        Generating,
+        Ready
+    };
+
+    struct Entry
+    {
+        State state = State::Queued;
+        std::shared_ptr<const Mesh> mesh;
+    };
+
+    // Claim a queued entry and generate it on the calling thread (lock is
+    // released while generating)
+    void Generate(const MeshDesc& desc, Entry& entry, std::unique_lock<std::mutex>& lock);
+
+    ThreadPool* m_pool = nullptr;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::unordered_map<MeshDesc, Entry, DescHash> m_entries;  // nodes never move
+    uint32 m_pending = 0;
+    uint32 m_jobsInFlight = 0;      // submitted jobs that may still touch this
+};
+
+} // namespace RRE
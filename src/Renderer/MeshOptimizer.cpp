@@ -0,0 +1,264 @@
+#include "Renderer/MeshOptimizer.h"
+#include "Renderer/MeshletBuilder.h"
+#include <algorithm>
+
+namespace RRE
+{
+
+namespace
+{
+
+constexpr uint32 INVALID = UINT32_MAX;
+
+// Tipsify working state; every array is indexed by vertex or triangle
+struct TipsifyState
+{
+    const std::vector<uint32>& indices;
+    std::vector<uint32> offsets;        // vertexCount + 1, into triangles
+    std::vector<uint32> triangles;      // triangles around each vertex
+    std::vector<uint32> live;           // not yet emitted triangles per vertex
+    std::vector<uint32> stamps;         // cache time of each vertex
+    std::vector<uint8> emitted;
+    std::vector<uint32> deadEnd;        // recently used vertices, as a stack
+    uint32 cursor = 0;
+
+    TipsifyState(const std::vector<uint32>& source, uint32 vertexCount)
+        : indices(source)
+    {
+        uint32 triangleCount = static_cast<uint32>(indices.size() / 3);
+
+        offsets.assign(vertexCount + 1, 0);
+        for (uint32 i = 0; i < triangleCount * 3; ++i)
+        {
+            ++offsets[indices[i] + 1];
+        }
+        live.resize(vertexCount);
+        for (uint32 v = 0; v < vertexCount; ++v)
+        {
+            live[v] = offsets[v + 1];
+            offsets[v + 1] += offsets[v];
+        }
+
+        triangles.resize(triangleCount * 3);
+        std::vector<uint32> fill(offsets.begin(), offsets.end() - 1);
+        for (uint32 i = 0; i < triangleCount * 3; ++i)
+        {
+            triangles[fill[indices[i]]++] = i / 3;
+        }
+
+        stamps.assign(vertexCount, 0);
+        emitted.assign(triangleCount, 0);
+        deadEnd.reserve(triangleCount * 3);
+    }
+
+    // Most recent vertex that still has triangles, else the next one in
+    // index order
+    uint32 SkipDeadEnd()
+    {
+        while (!deadEnd.empty())
+        {
+            uint32 v = deadEnd.back();
+            deadEnd.pop_back();
+            if (live[v] > 0)
+                return v;
+        }
+        for (; cursor < live.size(); ++cursor)
+        {
+            if (live[cursor] > 0)
+                return cursor;
+        }
+        return INVALID;
+    }
+};
+
+} // anonymous namespace
+
+VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32>& indices,
+    uint32 vertexCount, uint32 cacheSize)
+{
+    VertexCacheStats stats;
+    uint32 triangleCount = static_cast<uint32>(indices.size() / 3);
+    if (triangleCount == 0)
+        return stats;
+
+    // FIFO: a vertex is cached while fewer than cacheSize misses followed it
+    std::vector<uint32> stamps(vertexCount, 0);
+    std::vector<uint8> referenced(vertexCount, 0);
+    uint32 time = cacheSize + 1;
+    uint32 referencedCount = 0;
+    for (uint32 i = 0; i < triangleCount * 3; ++i)
+    {
+        uint32 v = indices[i];
+        if (time - stamps[v] > cacheSize)
+        {
+            stamps[v] = time++;
+            ++stats.transformed;
+        }
+        if (!referenced[v])
+        {
+            referenced[v] = 1;
+            ++referencedCount;
+        }
+    }
+
+    stats.acmr = static_cast<float>(stats.transformed) / static_cast<float>(triangleCount);
+    stats.atvr = static_cast<float>(stats.transformed) / static_cast<float>(referencedCount);
+    return stats;
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::vector<uint32>& indices, uint32 vertexCount,
+    uint32 cacheSize, std::vector<uint32>* triangleOrder)
+{
+    uint32 triangleCount = static_cast<uint32>(indices.size() / 3);
+    TipsifyState state(indices, vertexCount);
+
+    std::vector<uint32> result;
+    result.reserve(triangleCount * 3);
+    std::vector<uint32> order;
+    order.reserve(triangleCount);
+    std::vector<uint32> candidates;
+    uint32 time = cacheSize + 1;
+
+    uint32 fanning = state.SkipDeadEnd();
+    while (fanning != INVALID)
+    {
+        // Emit every remaining triangle around the fanning vertex
+        candidates.clear();
+        for (uint32 i = state.offsets[fanning]; i < state.offsets[fanning + 1]; ++i)
+        {
+            uint32 t = state.triangles[i];
+            if (state.emitted[t])
+                continue;
+            state.emitted[t] = 1;
+            order.push_back(t);
+
+            for (uint32 c = 0; c < 3; ++c)
+            {
+                uint32 v = indices[t * 3 + c];
+                result.push_back(v);
+                state.deadEnd.push_back(v);
+                candidates.push_back(v);
+                --state.live[v];
+                if (time - state.stamps[v] > cacheSize)
+                {
+                    state.stamps[v] = time++;
+                }
+            }
+        }
+
+        // Next fan: the oldest candidate that will still be cached once its
+        // own triangles are emitted; anything live beats nothing
+        uint32 next = INVALID;
+        int64 bestPriority = -1;
+        for (uint32 v : candidates)
+        {
+            if (state.live[v] == 0)
+                continue;
+            int64 priority = 0;
+            uint32 age = time - state.stamps[v];
+            if (age + 2 * state.live[v] <= cacheSize)
+                priority = age;
+            if (priority > bestPriority)
+            {
+                bestPriority = priority;
+                next = v;
+            }
+        }
+        fanning = next != INVALID ? next : state.SkipDeadEnd();
+    }
+
+    // Keep a trailing partial triangle, if any, where it was
+    result.insert(result.end(), indices.begin() + triangleCount * 3, indices.end());
+    indices = std::move(result);
+    if (triangleOrder)
+        *triangleOrder = std::move(order);
+}
+
+uint32 MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32>& indices)
+{
+    uint32 vertexCount = static_cast<uint32>(vertices.size());
+    std::vector<uint32> remap(vertexCount, INVALID);
+    uint32 next = 0;
+    for (uint32& index : indices)
+    {
+        if (remap[index] == INVALID)
+            remap[index] = next++;
+        index = remap[index];
+    }
+    uint32 referenced = next;
+
+    std::vector<Vertex> result(vertexCount);
+    for (uint32 v = 0; v < vertexCount; ++v)
+    {
+        if (remap[v] == INVALID)
+            remap[v] = next++;
+        result[remap[v]] = vertices[v];
+    }
+    vertices = std::move(result);
+    return referenced;
+}
+
+void MeshOptimizer::ReorderTriangles(Mesh& mesh, const std::vector<uint32>& order)
+{
+    uint32 triangleCount = static_cast<uint32>(order.size());
+    std::vector<uint32> indices(mesh.indices.size());
+    for (uint32 n = 0; n < triangleCount; ++n)
+    {
+        for (uint32 c = 0; c < 3; ++c)
+        {
+            indices[n * 3 + c] = mesh.indices[order[n] * 3 + c];
+        }
+    }
+    std::copy(mesh.indices.begin() + triangleCount * 3, mesh.indices.end(), indices.begin() + triangleCount * 3);
+    mesh.indices = std::move(indices);
+
+    // Adjacency is per triangle: move the rows and renumber their entries
+    if (mesh.faceAdjacency.size() != triangleCount)
+        return;
+
+    std::vector<uint32> newIndex(triangleCount);
+    for (uint32 n = 0; n < triangleCount; ++n)
+    {
+        newIndex[order[n]] = n;
+    }
+
+    const AdjacencyGraph& source = mesh.faceAdjacency;
+    AdjacencyGraph adjacency;
+    adjacency.offsets.resize(triangleCount + 1);
+    adjacency.neighbors.resize(source.neighbors.size());
+    adjacency.offsets[0] = 0;
+    for (uint32 n = 0; n < triangleCount; ++n)
+    {
+        uint32 write = adjacency.offsets[n];
+        for (uint32 face : source[order[n]])
+        {
+            adjacency.neighbors[write++] = newIndex[face];
+        }
+        std::sort(adjacency.neighbors.begin() + adjacency.offsets[n], adjacency.neighbors.begin() + write);
+        adjacency.offsets[n + 1] = write;
+    }
+    mesh.faceAdjacency = std::move(adjacency);
+}
+
+MeshOptimizeResult MeshOptimizer::Optimize(Mesh& mesh, uint32 cacheSize)
+{
+    MeshOptimizeResult result;
+    uint32 vertexCount = static_cast<uint32>(mesh.vertices.size());
+    result.before = AnalyzeVertexCache(mesh.indices, vertexCount, cacheSize);
+
+    std::vector<uint32> order;
+    std::vector<uint32> indices = mesh.indices;
+    OptimizeVertexCache(indices, vertexCount, cacheSize, &order);
+    ReorderTriangles(mesh, order);
+
+    OptimizeVertexFetch(mesh.vertices, mesh.indices);
+    result.after = AnalyzeVertexCache(mesh.indices, vertexCount, cacheSize);
+
+    if (!mesh.meshlets.empty())
+        MeshletBuilder::Build(mesh);
+    else if (mesh.triangleBVH)
+        mesh.BuildTriangleBVH();
+    return result;
+}
+
+} // namespace RRE
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Renderer/Mesh.h"
+#include "Core/Types.h"
+#include <vector>
+
+namespace RRE
+{
+
+// Post-transform vertex cache efficiency of an index buffer, simulated with a
+// FIFO cache of the given size
+struct VertexCacheStats
+{
+    uint32 transformed = 0;     // cache misses
+    float acmr = 0.0f;          // misses per triangle (0.5 ideal, 3 worst)
+    float atvr = 0.0f;          // misses per referenced vertex (1 ideal)
+};
+
+struct MeshOptimizeResult
+{
+    VertexCacheStats before;
+    VertexCacheStats after;
+};
+
+// Linear-time reordering passes for indexed meshes. OptimizeVertexCache
+// reorders triangles with Tipsify (Sander, Nehab and Barczak 2007): it fans
+// around the most recently used vertex that keeps its neighbours in the
+// cache and falls back to a dead-end stack instead of a global search.
+// Triangle winding is preserved. OptimizeVertexFetch then renumbers vertices
+// in first-use order so the input assembler reads memory sequentially.
+class MeshOptimizer
+{
+public:
+    static constexpr uint32 DEFAULT_CACHE_SIZE = 16;
+
+    static VertexCacheStats AnalyzeVertexCache(const std::vector<uint32>& indices,
+        uint32 vertexCount, uint32 cacheSize = DEFAULT_CACHE_SIZE);
+
+    // triangleOrder (optional) receives the old triangle index of each new one
+    static void OptimizeVertexCache(std::vector<uint32>& indices, uint32 vertexCount,
+        uint32 cacheSize = DEFAULT_CACHE_SIZE, std::vector<uint32>* triangleOrder = nullptr);
+
+    // Unreferenced vertices move to the end. Returns the referenced count.
+    static uint32 OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32>& indices);
+
+    // Put triangle order[n] at position n, moving faceAdjacency along (its
+    // entries renumbered) when it has one row per triangle
+    static void ReorderTriangles(Mesh& mesh, const std::vector<uint32>& order);
+
+    // Both passes on a mesh: faceAdjacency follows the new triangle order and
+    // meshlets and the triangle BVH are rebuilt if the mesh had them
+    static MeshOptimizeResult Optimize(Mesh& mesh, uint32 cacheSize = DEFAULT_CACHE_SIZE);
+};
+
+} // namespace RRE
@@ -0,0 +1,509 @@
+#include "Renderer/MeshSimplifier.h"
+#include "Renderer/MeshFactory.h"
+#include "Renderer/MeshletBuilder.h"
+#include "Renderer/FaceColorPalette.h"
+#include "Renderer/VertexWelder.h"
+#include <DirectXMath.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <queue>
+
+using namespace DirectX;
+
+namespace RRE
+{
+
+namespace
+{
+
+constexpr uint32 INVALID = UINT32_MAX;
+
+// Open borders keep their outline: the plane through a border edge,
+// perpendicular to its face, weighs this much more than the face itself
+const double BOUNDARY_WEIGHT = 10.0;
+
+// A face may not turn further than this (cosine of old vs new normal)
+const double MIN_NORMAL_DOT = 0.2;
+
+// Levels that remove less than this fraction of triangles end the chain
+const float MIN_LOD_REDUCTION = 0.1f;
+
+// Symmetric 4x4 plane quadric and the total weight of its planes
+struct Quadric
+{
+    double a[10] = {};  // xx xy xz xw yy yz yw zz zw ww
+    double weight = 0.0;
+
+    void AddPlane(double nx, double ny, double nz, double d, double w)
+    {
+        a[0] += w * nx * nx; a[1] += w * nx * ny; a[2] += w * nx * nz; a[3] += w * nx * d;
+        a[4] += w * ny * ny; a[5] += w * ny * nz; a[6] += w * ny * d;
+        a[7] += w * nz * nz; a[8] += w * nz * d;
+        a[9] += w * d * d;
+        weight += w;
+    }
+
+    void Add(const Quadric& other)
+    {
+        for (uint32 i = 0; i < 10; ++i)
+        {
+            a[i] += other.a[i];
+        }
+        weight += other.weight;
+    }
+
+    // Weighted mean squared distance of p to the planes
+    double Error(const XMFLOAT3& p) const
+    {
+        if (weight <= 0.0)
+            return 0.0;
+        double x = p.x, y = p.y, z = p.z;
+        double e = a[0] * x * x + a[4] * y * y + a[7] * z * z + a[9] +
+            2.0 * (a[1] * x * y + a[2] * x * z + a[5] * y * z + a[3] * x + a[6] * y + a[8] * z);
+        return std::max(e, 0.0) / weight;
+    }
+};
+
+struct Collapse
+{
+    double cost;
+    uint32 from;
+    uint32 to;
+    uint32 fromStamp;   // versions of both endpoints when queued
+    uint32 toStamp;
+
+    bool operator>(const Collapse& other) const { return cost > other.cost; }
+};
+
+uint32 PaletteIndex(const XMFLOAT4& color)
+{
+    for (uint32 c = 0; c < FaceColorPalette::PALETTE_SIZE; ++c)
+    {
+        if (memcmp(&FaceColorPalette::GetColor(c), &color, sizeof(XMFLOAT4)) == 0)
+            return c;
+    }
+    return INVALID;
+}
+
+XMVECTOR Cross(const XMFLOAT3& p0, const XMFLOAT3& p1, const XMFLOAT3& p2)
+{
+    XMVECTOR a = XMLoadFloat3(&p0);
+    return XMVector3Cross(XMVectorSubtract(XMLoadFloat3(&p1), a), XMVectorSubtract(XMLoadFloat3(&p2), a));
+}
+
+// Indexed triangle soup over welded positions, collapsed in place
+class Collapser
+{
+public:
+    std::vector<XMFLOAT3> positions;
+    std::vector<std::array<uint32, 3>> faces;
+    uint32 liveFaces = 0;
+
+    void Weld(const Mesh& mesh, std::vector<uint32>& cornerPositions)
+    {
+        std::vector<uint32> vertexPositions;
+        VertexWelder::WeldPositions(mesh.vertices, positions, vertexPositions);
+
+        cornerPositions.resize(mesh.indices.size() / 3 * 3);
+        for (size_t i = 0; i < cornerPositions.size(); ++i)
+        {
+            cornerPositions[i] = vertexPositions[mesh.indices[i]];
+        }
+    }
+
+    // faces must be filled; triangles with repeated positions are dropped
+    void Init()
+    {
+        uint32 positionCount = static_cast<uint32>(positions.size());
+        uint32 faceCount = static_cast<uint32>(faces.size());
+        m_quadrics.assign(positionCount, Quadric());
+        m_positionFaces.assign(positionCount, {});
+        m_stamps.assign(positionCount, 0);
+        m_marks.assign(positionCount, 0);
+        m_aliveFaces.assign(faceCount, 0);
+        m_alivePositions.assign(positionCount, 0);
+
+        for (uint32 f = 0; f < faceCount; ++f)
+        {
+            const auto& face = faces[f];
+            if (face[0] == face[1] || face[1] == face[2] || face[0] == face[2])
+                continue;
+            m_aliveFaces[f] = 1;
+            ++liveFaces;
+
+            XMFLOAT3 normal;
+            XMStoreFloat3(&normal, Cross(positions[face[0]], positions[face[1]], positions[face[2]]));
+            double length = std::sqrt(double(normal.x) * normal.x + double(normal.y) * normal.y +
+                double(normal.z) * normal.z);
+            double area = length * 0.5;
+            for (uint32 c = 0; c < 3; ++c)
+            {
+                m_positionFaces[face[c]].push_back(f);
+                m_alivePositions[face[c]] = 1;
+            }
+            if (length <= 0.0)
+                continue;
+
+            double nx = normal.x / length, ny = normal.y / length, nz = normal.z / length;
+            const XMFLOAT3& p0 = positions[face[0]];
+            double d = -(nx * p0.x + ny * p0.y + nz * p0.z);
+            for (uint32 c = 0; c < 3; ++c)
+            {
+                m_quadrics[face[c]].AddPlane(nx, ny, nz, d, area);
+            }
+        }
+
+        AddBoundaryPlanes();
+
+        for (uint32 f = 0; f < faceCount; ++f)
+        {
+            if (!m_aliveFaces[f])
+                continue;
+            for (uint32 c = 0; c < 3; ++c)
+            {
+                uint32 a = faces[f][c];
+                uint32 b = faces[f][(c + 1) % 3];
+                if (a < b)
+                    Queue(a, b);
+            }
+        }
+        // Border edges appear once, in either direction
+        for (uint32 f = 0; f < faceCount; ++f)
+        {
+            if (!m_aliveFaces[f])
+                continue;
+            for (uint32 c = 0; c < 3; ++c)
+            {
+                uint32 a = faces[f][c];
+                uint32 b = faces[f][(c + 1) % 3];
+                if (a > b && CountEdgeFaces(a, b) == 1)
+                    Queue(a, b);
+            }
+        }
+    }
+
+    // Collapses until targetFaces remain or the next collapse costs more
+    // than maxErrorSq; returns the largest cost accepted
+    double Run(uint32 targetFaces, double maxErrorSq)
+    {
+        double largest = 0.0;
+        while (liveFaces > targetFaces && !m_heap.empty())
+        {
+            Collapse collapse = m_heap.top();
+            m_heap.pop();
+            if (!m_alivePositions[collapse.from] || !m_alivePositions[collapse.to] ||
+                m_stamps[collapse.from] != collapse.fromStamp || m_stamps[collapse.to] != collapse.toStamp)
+                continue;
+            if (collapse.cost > maxErrorSq)
+                break;
+            if (!IsValid(collapse.from, collapse.to))
+                continue;
+
+            Apply(collapse.from, collapse.to);
+            largest = std::max(largest, collapse.cost);
+        }
+        return largest;
+    }
+
+    bool IsFaceAlive(uint32 f) const { return m_aliveFaces[f] != 0; }
+
+private:
+    std::vector<Quadric> m_quadrics;
+    std::vector<std::vector<uint32>> m_positionFaces;   // may hold dead faces
+    std::vector<uint32> m_stamps;
+    std::vector<uint32> m_marks;
+    uint32 m_markTag = 0;
+    std::vector<uint8> m_aliveFaces;
+    std::vector<uint8> m_alivePositions;
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> m_heap;
+
+    uint32 CountEdgeFaces(uint32 a, uint32 b) const
+    {
+        uint32 count = 0;
+        for (uint32 f : m_positionFaces[a])
+        {
+            const auto& face = faces[f];
+            count += m_aliveFaces[f] && (face[0] == b || face[1] == b || face[2] == b);
+        }
+        return count;
+    }
+
+    void AddBoundaryPlanes()
+    {
+        for (uint32 f = 0; f < faces.size(); ++f)
+        {
+            if (!m_aliveFaces[f])
+                continue;
+            const auto& face = faces[f];
+            XMVECTOR normal = Cross(positions[face[0]], positions[face[1]], positions[face[2]]);
+            for (uint32 c = 0; c < 3; ++c)
+            {
+                uint32 a = face[c];
+                uint32 b = face[(c + 1) % 3];
+                if (CountEdgeFaces(a, b) != 1)
+                    continue;
+
+                XMVECTOR pa = XMLoadFloat3(&positions[a]);
+                XMVECTOR edge = XMVectorSubtract(XMLoadFloat3(&positions[b]), pa);
+                XMFLOAT3 n;
+                XMStoreFloat3(&n, XMVector3Cross(edge, normal));
+                double length = std::sqrt(double(n.x) * n.x + double(n.y) * n.y + double(n.z) * n.z);
+                if (length <= 0.0)
+                    continue;
+                double nx = n.x / length, ny = n.y / length, nz = n.z / length;
+                double d = -(nx * positions[a].x + ny * positions[a].y + nz * positions[a].z);
+                double weight = BOUNDARY_WEIGHT * XMVectorGetX(XMVector3LengthSq(edge));
+                m_quadrics[a].AddPlane(nx, ny, nz, d, weight);
+                m_quadrics[b].AddPlane(nx, ny, nz, d, weight);
+            }
+        }
+    }
+
+    // Queues the cheaper direction of edge (a, b)
+    void Queue(uint32 a, uint32 b)
+    {
+        Quadric merged = m_quadrics[a];
+        merged.Add(m_quadrics[b]);
+        double toB = merged.Error(positions[b]);
+        double toA = merged.Error(positions[a]);
+        if (toA < toB)
+            std::swap(a, b);
+        m_heap.push({ std::min(toA, toB), a, b, m_stamps[a], m_stamps[b] });
+    }
+
+    bool IsValid(uint32 from, uint32 to)
+    {
+        // Link condition: the endpoints may only share the neighbors of the
+        // faces on their edge, or the collapse pinches the surface
+        ++m_markTag;
+        for (uint32 f : m_positionFaces[to])
+        {
+            if (!m_aliveFaces[f])
+                continue;
+            for (uint32 p : faces[f])
+            {
+                m_marks[p] = m_markTag;
+            }
+        }
+
+        uint32 edgeFaces = 0;
+        uint32 shared = 0;
+        uint32 sharedTag = ++m_markTag;
+        for (uint32 f : m_positionFaces[from])
+        {
+            if (!m_aliveFaces[f])
+                continue;
+            const auto& face = faces[f];
+            if (face[0] == to || face[1] == to || face[2] == to)
+            {
+                ++edgeFaces;
+                continue;
+            }
+
+            for (uint32 p : face)
+            {
+                if (p != from && m_marks[p] == sharedTag - 1)
+                {
+                    m_marks[p] = sharedTag;
+                    ++shared;
+                }
+            }
+
+            // The moved face must keep its orientation and not double an
+            // existing face
+            XMFLOAT3 moved[3];
+            for (uint32 c = 0; c < 3; ++c)
+            {
+                moved[c] = positions[face[c] == from ? to : face[c]];
+            }
+            XMVECTOR before = Cross(positions[face[0]], positions[face[1]], positions[face[2]]);
+            XMVECTOR after = Cross(moved[0], moved[1], moved[2]);
+            double dot = XMVectorGetX(XMVector3Dot(before, after));
+            double lengths = std::sqrt(double(XMVectorGetX(XMVector3LengthSq(before))) *
+                XMVectorGetX(XMVector3LengthSq(after)));
+            if (lengths <= 0.0 || dot < MIN_NORMAL_DOT * lengths)
+                return false;
+        }
+        // Neighbors of the edge faces are shared too; anything else pinches
+        if (edgeFaces == 0 || shared != edgeFaces)
+            return false;
+
+        return !DuplicatesFace(from, to);
+    }
+
+    bool DuplicatesFace(uint32 from, uint32 to) const
+    {
+        for (uint32 f : m_positionFaces[from])
+        {
+            if (!m_aliveFaces[f])
+                continue;
+            const auto& face = faces[f];
+            if (face[0] == to || face[1] == to || face[2] == to)
+                continue;
+            for (uint32 g : m_positionFaces[to])
+            {
+                if (!m_aliveFaces[g])
+                    continue;
+                uint32 matches = 0;
+                for (uint32 p : face)
+                {
+                    if (p == from)
+                        continue;
+                    const auto& other = faces[g];
+                    matches += other[0] == p || other[1] == p || other[2] == p;
+                }
+                if (matches == 2)
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    void Apply(uint32 from, uint32 to)
+    {
+        std::vector<uint32>& toFaces = m_positionFaces[to];
+        for (uint32 f : m_positionFaces[from])
+        {
+            if (!m_aliveFaces[f])
+                continue;
+            auto& face = faces[f];
+            if (face[0] == to || face[1] == to || face[2] == to)
+            {
+                m_aliveFaces[f] = 0;
+                --liveFaces;
+                continue;
+            }
+            for (uint32& p : face)
+            {
+                if (p == from)
+                    p = to;
+            }
+            toFaces.push_back(f);
+        }
+        m_positionFaces[from].clear();
+        m_positionFaces[from].shrink_to_fit();
+        m_alivePositions[from] = 0;
+        m_quadrics[to].Add(m_quadrics[from]);
+        ++m_stamps[to];
+
+        // Drop dead faces, then requeue every edge around the kept position
+        toFaces.erase(std::remove_if(toFaces.begin(), toFaces.end(),
+            [this](uint32 f) { return !m_aliveFaces[f]; }), toFaces.end());
+        ++m_markTag;
+        m_marks[to] = m_markTag;
+        for (uint32 f : toFaces)
+        {
+            for (uint32 p : faces[f])
+            {
+                if (m_marks[p] == m_markTag)
+                    continue;
+                m_marks[p] = m_markTag;
+                Queue(to, p);
+            }
+        }
+    }
+};
+
+} // anonymous namespace
+
+Mesh MeshSimplifier::Simplify(const Mesh& mesh, uint32 targetTriangles, float maxError)
+{
+    Collapser collapser;
+    std::vector<uint32> corners;
+    collapser.Weld(mesh, corners);
+    uint32 faceCount = static_cast<uint32>(corners.size() / 3);
+    collapser.faces.resize(faceCount);
+    memcpy(collapser.faces.data(), corners.data(), corners.size() * sizeof(uint32));
+
+    // Factory meshes are flat exactly when no vertex is shared by two corners
+    std::vector<uint8> used(mesh.vertices.size(), 0);
+    MeshShading shading = MeshShading::Flat;
+    for (size_t i = 0; i < corners.size(); ++i)
+    {
+        if (used[mesh.indices[i]]++)
+        {
+            shading = MeshShading::Smooth;
+            break;
+        }
+    }
+
+    // Palette colors per face (flat) or per position (smooth)
+    uint32 positionCount = static_cast<uint32>(collapser.positions.size());
+    std::vector<uint32> colors(shading == MeshShading::Flat ? faceCount : positionCount, INVALID);
+    bool paletteColors = true;
+    for (size_t i = 0; i < corners.size() && paletteColors; ++i)
+    {
+        uint32 color = PaletteIndex(mesh.vertices[mesh.indices[i]].color);
+        paletteColors = color != INVALID;
+        colors[shading == MeshShading::Flat ? i / 3 : corners[i]] = color;
+    }
+
+    collapser.Init();
+    double maxErrorSq = maxError < FLT_MAX ? double(maxError) * maxError : DBL_MAX;
+    double largest = collapser.Run(targetTriangles, maxErrorSq);
+
+    // Compact the survivors
+    std::vector<uint32> remap(positionCount, INVALID);
+    std::vector<XMFLOAT3> positions;
+    std::vector<std::array<uint32, 3>> faces;
+    std::vector<uint32> keptColors;
+    faces.reserve(collapser.liveFaces);
+    for (uint32 f = 0; f < faceCount; ++f)
+    {
+        if (!collapser.IsFaceAlive(f))
+            continue;
+        std::array<uint32, 3> face;
+        for (uint32 c = 0; c < 3; ++c)
+        {
+            uint32 p = collapser.faces[f][c];
+            if (remap[p] == INVALID)
+            {
+                remap[p] = static_cast<uint32>(positions.size());
+                positions.push_back(collapser.positions[p]);
+                if (shading == MeshShading::Smooth)
+                    keptColors.push_back(colors[p]);
+            }
+            face[c] = remap[p];
+        }
+        if (shading == MeshShading::Flat)
+            keptColors.push_back(colors[f]);
+        faces.push_back(face);
+    }
+
+    Mesh result = MeshFactory::CreateFromFaces(positions, faces, shading,
+        paletteColors ? &keptColors : nullptr);
+    result.lodError = mesh.lodError + static_cast<float>(std::sqrt(largest));
+    return result;
+}
+
+uint32 MeshSimplifier::BuildLODChain(Mesh& mesh, uint32 maxLevels, float ratio, uint32 minTriangles)
+{
+    mesh.lods.clear();
+    uint32 triangles = mesh.GetPolygonCount();
+    float lastError = mesh.lodError;
+    for (uint32 level = 0; level < maxLevels; ++level)
+    {
+        uint32 target = static_cast<uint32>(static_cast<float>(triangles) * ratio);
+        if (target < minTriangles)
+            break;
+
+        auto lod = std::make_shared<Mesh>(Simplify(mesh, target));
+        uint32 lodTriangles = lod->GetPolygonCount();
+        if (lodTriangles > static_cast<float>(triangles) * (1.0f - MIN_LOD_REDUCTION))
+            break;
+
+        // Coarser levels never claim less error than finer ones
+        lod->lodError = std::max(lod->lodError, lastError);
+        lastError = lod->lodError;
+        if (!mesh.meshlets.empty())
+            MeshletBuilder::Build(*lod);
+        mesh.lods.push_back(std::move(lod));
+        triangles = lodTriangles;
+    }
+    return static_cast<uint32>(mesh.lods.size());
+}
+
+} // namespace RRE
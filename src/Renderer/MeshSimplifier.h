@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Renderer/Mesh.h"
+#include "Core/Types.h"
+#include <cfloat>
+
+namespace RRE
+{
+
+// Quadric error metric edge-collapse simplification (Garland and Heckbert
+// 1997). Vertices are welded by position, each one accumulates the area-
+// weighted planes of its faces (plus perpendicular planes along open borders)
+// and the cheapest edge is collapsed onto one of its endpoints until the
+// target is reached. Collapses that would flip or fold a face or pinch the
+// surface (link condition) are skipped. The error of a collapse is the RMS
+// distance of the kept position to the planes merged into it, in mesh units.
+//
+// The result is rebuilt through MeshFactory::CreateFromFaces with the
+// source's shading. Palette colors survive with their faces (Flat) or
+// positions (Smooth) and are repaired where a collapse made neighbors equal,
+// so adjacent faces or positions keep distinct colors.
+class MeshSimplifier
+{
+public:
+    // Stops at targetTriangles or before the first collapse costing more than
+    // maxError. The result's lodError is the largest error accepted.
+    static Mesh Simplify(const Mesh& mesh, uint32 targetTriangles, float maxError = FLT_MAX);
+
+    // Replaces mesh.lods with up to maxLevels meshes of about ratio times the
+    // previous level's triangles, each simplified from mesh itself, stopping
+    // below minTriangles or when a level no longer shrinks. Levels get
+    // meshlets if mesh has them. Returns the level count.
+    static uint32 BuildLODChain(Mesh& mesh, uint32 maxLevels = 4, float ratio = 0.5f,
+        uint32 minTriangles = 32);
+};
+
+} // namespace RRE
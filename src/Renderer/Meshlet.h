@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Math/Bounds.h"
+#include "Core/Types.h"
+#include <DirectXMath.h>
+#include <cmath>
+
+namespace RRE
+{
+
+// A cluster of spatially close triangles, contiguous in Mesh::indices so a
+// run of visible meshlets is one index range. Bounds and cone are in mesh
+// space; the cone covers the winding normals (cross(p1 - p0, p2 - p0)).
+struct Meshlet
+{
+    uint32 firstIndex = 0;
+    uint32 indexCount = 0;
+    uint32 vertexCount = 0;     // distinct vertices referenced
+    Math::BoundingSphere bounds;
+    DirectX::XMFLOAT3 coneAxis = { 0.0f, 0.0f, 0.0f };
+    float coneCutoff = 1.0f;    // sine of the cone's half-angle; 1 = no cone
+
+    // True when no triangle can face a viewer at this mesh-space position:
+    // every winding normal points away from it (the rasterizer's back face).
+    // Affine transforms keep the result, so test with the viewer moved into
+    // mesh space instead of moving the cone out.
+    bool IsBackFacing(const DirectX::XMFLOAT3& viewer) const
+    {
+        if (coneCutoff >= 1.0f || !bounds.IsValid())
+            return false;
+
+        float dx = bounds.center.x - viewer.x;
+        float dy = bounds.center.y - viewer.y;
+        float dz = bounds.center.z - viewer.z;
+        float along = dx * coneAxis.x + dy * coneAxis.y + dz * coneAxis.z;
+        return along >= coneCutoff * std::sqrt(dx * dx + dy * dy + dz * dz) + bounds.radius;
+    }
+};
+
+} // namespace RRE
@@ -0,0 +1,238 @@
+#include "Renderer/MeshletBuilder.h"
+#include "Renderer/MeshOptimizer.h"
+#include <DirectXMath.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace DirectX;
+
+namespace RRE
+{
+
+namespace
+{
+
+constexpr uint32 INVALID = UINT32_MAX;
+
+// Cones wider than this (minimum normal dot axis) can never be back-facing
+// as a whole, so they are stored as "no cone"
+const float MIN_CONE_DOT = 0.1f;
+
+void ComputeMeshletBounds(const Mesh& mesh, Meshlet& meshlet)
+{
+    const uint32* indices = mesh.indices.data() + meshlet.firstIndex;
+
+    Math::AABB box;
+    for (uint32 i = 0; i < meshlet.indexCount; ++i)
+    {
+        box.Expand(mesh.vertices[indices[i]].position);
+    }
+    meshlet.bounds.center = box.GetCenter();
+    float maxDistSq = 0.0f;
+    for (uint32 i = 0; i < meshlet.indexCount; ++i)
+    {
+        const XMFLOAT3& p = mesh.vertices[indices[i]].position;
+        float dx = p.x - meshlet.bounds.center.x;
+        float dy = p.y - meshlet.bounds.center.y;
+        float dz = p.z - meshlet.bounds.center.z;
+        maxDistSq = std::fmaxf(maxDistSq, dx * dx + dy * dy + dz * dz);
+    }
+    meshlet.bounds.radius = std::sqrt(maxDistSq);
+
+    // Cone axis: mean of the unit winding normals
+    uint32 triangleCount = meshlet.indexCount / 3;
+    std::vector<XMVECTOR> normals;
+    normals.reserve(triangleCount);
+    XMVECTOR sum = XMVectorZero();
+    for (uint32 t = 0; t < triangleCount; ++t)
+    {
+        XMVECTOR p0 = XMLoadFloat3(&mesh.vertices[indices[t * 3]].position);
+        XMVECTOR p1 = XMLoadFloat3(&mesh.vertices[indices[t * 3 + 1]].position);
+        XMVECTOR p2 = XMLoadFloat3(&mesh.vertices[indices[t * 3 + 2]].position);
+        XMVECTOR cross = XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0));
+        float length = XMVectorGetX(XMVector3Length(cross));
+        if (length <= 0.0f)
+            continue;   // degenerate triangles are never rasterized
+        XMVECTOR normal = XMVectorScale(cross, 1.0f / length);
+        normals.push_back(normal);
+        sum = XMVectorAdd(sum, normal);
+    }
+
+    meshlet.coneAxis = { 0.0f, 0.0f, 0.0f };
+    meshlet.coneCutoff = 1.0f;
+    float sumLength = XMVectorGetX(XMVector3Length(sum));
+    if (normals.empty() || sumLength <= 0.0f)
+        return;
+
+    XMVECTOR axis = XMVectorScale(sum, 1.0f / sumLength);
+    float minDot = 1.0f;
+    for (FXMVECTOR normal : normals)
+    {
+        minDot = std::fminf(minDot, XMVectorGetX(XMVector3Dot(axis, normal)));
+    }
+    if (minDot <= MIN_CONE_DOT)
+        return;
+
+    XMStoreFloat3(&meshlet.coneAxis, axis);
+    meshlet.coneCutoff = std::sqrt(std::fmaxf(0.0f, 1.0f - minDot * minDot));
+}
+
+} // anonymous namespace
+
+uint32 MeshletBuilder::Build(Mesh& mesh, uint32 maxVertices, uint32 maxTriangles)
+{
+    mesh.meshlets.clear();
+    uint32 triangleCount = static_cast<uint32>(mesh.indices.size() / 3);
+    uint32 vertexCount = static_cast<uint32>(mesh.vertices.size());
+    if (triangleCount == 0 || maxVertices < 3 || maxTriangles == 0)
+        return 0;
+
+    // Triangles around each vertex (CSR)
+    std::vector<uint32> offsets(vertexCount + 1, 0);
+    for (uint32 i = 0; i < triangleCount * 3; ++i)
+    {
+        ++offsets[mesh.indices[i] + 1];
+    }
+    for (uint32 v = 0; v < vertexCount; ++v)
+    {
+        offsets[v + 1] += offsets[v];
+    }
+    std::vector<uint32> vertexTriangles(triangleCount * 3);
+    std::vector<uint32> fill(offsets.begin(), offsets.end() - 1);
+    for (uint32 i = 0; i < triangleCount * 3; ++i)
+    {
+        vertexTriangles[fill[mesh.indices[i]]++] = i / 3;
+    }
+
+    std::vector<uint32> live(vertexCount);     // unemitted triangles per vertex
+    for (uint32 v = 0; v < vertexCount; ++v)
+    {
+        live[v] = offsets[v + 1] - offsets[v];
+    }
+    std::vector<uint8> emitted(triangleCount, 0);
+    std::vector<uint32> owner(vertexCount, INVALID);    // last meshlet using each vertex
+    std::vector<uint32> candidates;
+    std::vector<uint32> order;
+    order.reserve(triangleCount);
+
+    Meshlet current;
+    uint32 meshletId = 0;
+    uint32 cursor = 0;
+
+    // Running sum of the current meshlet's triangle centroids (x3)
+    XMFLOAT3 centroidSum = { 0.0f, 0.0f, 0.0f };
+    auto distanceSq = [&](uint32 t) {
+        float inv = 1.0f / static_cast<float>(current.indexCount / 3);
+        float d[3] = { -centroidSum.x * inv, -centroidSum.y * inv, -centroidSum.z * inv };
+        for (uint32 c = 0; c < 3; ++c)
+        {
+            const XMFLOAT3& p = mesh.vertices[mesh.indices[t * 3 + c]].position;
+            d[0] += p.x;
+            d[1] += p.y;
+            d[2] += p.z;
+        }
+        return d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+    };
+    auto newVertices = [&](uint32 t) {
+        uint32 count = 0;
+        for (uint32 c = 0; c < 3; ++c)
+        {
+            count += owner[mesh.indices[t * 3 + c]] != meshletId;
+        }
+        return count;
+    };
+
+    while (order.size() < triangleCount)
+    {
+        // Best candidate next to the current meshlet (dropping emitted ones):
+        // fewest new vertices, then fewest remaining triangles around its
+        // vertices (fills gaps instead of leaving islands), then closest to
+        // the centroid to keep the cluster round
+        uint32 best = INVALID;
+        uint32 bestCost = 4;
+        uint32 bestLive = 0;
+        float bestDistance = 0.0f;
+        uint32 kept = 0;
+        for (uint32 t : candidates)
+        {
+            if (emitted[t])
+                continue;
+            candidates[kept++] = t;
+            uint32 cost = newVertices(t);
+            if (cost > bestCost)
+                continue;
+            uint32 liveSum = live[mesh.indices[t * 3]] + live[mesh.indices[t * 3 + 1]] + live[mesh.indices[t * 3 + 2]];
+            if (cost == bestCost && liveSum > bestLive)
+                continue;
+            float distance = distanceSq(t);
+            if (cost < bestCost || liveSum < bestLive || distance < bestDistance)
+            {
+                bestCost = cost;
+                bestLive = liveSum;
+                bestDistance = distance;
+                best = t;
+            }
+        }
+        candidates.resize(kept);
+
+        bool full = current.indexCount / 3 == maxTriangles ||
+            (best != INVALID && current.vertexCount + bestCost > maxVertices);
+        if (current.indexCount > 0 && (full || best == INVALID))
+        {
+            mesh.meshlets.push_back(current);
+            current = Meshlet();
+            centroidSum = { 0.0f, 0.0f, 0.0f };
+            current.firstIndex = static_cast<uint32>(order.size() * 3);
+            ++meshletId;
+            candidates.clear();
+            continue;
+        }
+
+        // Seed with the first remaining triangle in input order: meshlets then
+        // follow the input's (vertex cache) sweep and share vertices mostly
+        // with recent ones, which keeps per-draw vertex ranges short
+        if (best == INVALID)
+        {
+            while (emitted[cursor])
+            {
+                ++cursor;
+            }
+            best = cursor;
+        }
+
+        emitted[best] = 1;
+        order.push_back(best);
+        current.indexCount += 3;
+        for (uint32 c = 0; c < 3; ++c)
+        {
+            uint32 v = mesh.indices[best * 3 + c];
+            --live[v];
+            const XMFLOAT3& p = mesh.vertices[v].position;
+            centroidSum = { centroidSum.x + p.x, centroidSum.y + p.y, centroidSum.z + p.z };
+            if (owner[v] == meshletId)
+                continue;
+            owner[v] = meshletId;
+            ++current.vertexCount;
+            for (uint32 i = offsets[v]; i < offsets[v + 1]; ++i)
+            {
+                if (!emitted[vertexTriangles[i]])
+                    candidates.push_back(vertexTriangles[i]);
+            }
+        }
+    }
+    mesh.meshlets.push_back(current);
+
+    // Vertices follow the meshlets so each one reads a compact range
+    MeshOptimizer::ReorderTriangles(mesh, order);
+    MeshOptimizer::OptimizeVertexFetch(mesh.vertices, mesh.indices);
+    for (Meshlet& meshlet : mesh.meshlets)
+    {
+        ComputeMeshletBounds(mesh, meshlet);
+    }
+
+    if (mesh.triangleBVH)
+        mesh.BuildTriangleBVH();
+    return static_cast<uint32>(mesh.meshlets.size());
+}
+
+} // namespace RRE
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Renderer/Mesh.h"
+#include "Core/Types.h"
+
+namespace RRE
+{
+
+// Splits a mesh into meshlets of at most maxVertices distinct vertices and
+// maxTriangles triangles. Clusters grow greedily from the first remaining
+// triangle through shared vertices, preferring triangles that add the fewest
+// new vertices, then ones that close gaps, then ones near the centroid, so
+// run it after MeshOptimizer to make clusters follow the cache-friendly
+// order. Triangles are reordered so each meshlet is a contiguous index range
+// (faceAdjacency follows), vertices are renumbered in first-use order and the
+// triangle BVH is rebuilt if the mesh had one. Linear in the triangle count
+// for bounded vertex valence.
+class MeshletBuilder
+{
+public:
+    // Mesh shader limits (64 vertices, 124 triangles fit one 128-thread group)
+    static constexpr uint32 MAX_VERTICES = 64;
+    static constexpr uint32 MAX_TRIANGLES = 124;
+
+    // Replaces mesh.meshlets; returns their count
+    static uint32 Build(Mesh& mesh, uint32 maxVertices = MAX_VERTICES,
+        uint32 maxTriangles = MAX_TRIANGLES);
+};
+
+} // namespace RRE
@@ -1,51 +1,151 @@
 #include "Renderer/Renderer.h"
 #include "Renderer/Mesh.h"
 #include "Renderer/Vertex.h"
-#include "RHI/D3D12/D3D12Context.h"
-#include "RHI/D3D12/D3D12Buffer.h"
+#include "RHI/RHIDevice.h"
+#include "RHI/RHIContext.h"
 #include "Scene/SceneGraph.h"
 #include "Scene/SceneNode.h"
 #include "Scene/Camera.h"
 #include "Lighting/PointLight.h"
+#include "Math/Frustum.h"
 #include <DirectXMath.h>
-#include <d3d12.h>
+#include <cmath>
 
 using namespace DirectX;
 
 namespace RRE
 {
 
-void Renderer::SetContext(D3D12Context* context, ID3D12Device* device)
+namespace
 {
-    m_context = context;
-    m_d3dDevice = device;
+
+// Tight world-sphere test for nodes whose world AABB passed the BVH query
+// (the AABB of a rotated mesh is loose around its corners)
+bool IsMeshVisible(const Math::Frustum& frustum, const Mesh& mesh, FXMMATRIX world)
+{
+    if (!mesh.localSphere.IsValid())
+        return true;
+
+    return frustum.IntersectsSphere(Math::TransformSphere(mesh.localSphere, world));
 }
 
-void Renderer::UploadMesh(Mesh* mesh)
+} // anonymous namespace
+
+void Renderer::SetDevice(IRHIDevice* device)
 {
-    if (!mesh || !m_d3dDevice || m_meshCache.count(mesh))
-        return;
+    m_device = device;
+    m_context = device ? device->GetContext() : nullptr;
+}
+
+bool Renderer::UploadMesh(const Mesh* mesh)
+{
+    if (!mesh)
+        return false;
+    if (m_meshCache.count(mesh))
+        return true;
+
+    // Stream-less meshes (MeshFile::Load without copyStreams) get their
+    // buffers from their owner; empty buffers would draw nothing silently
+    if (mesh->vertices.empty() || mesh->indices.empty())
+        return false;
+    return UploadMesh(mesh, mesh->vertices.data(), static_cast<uint32>(mesh->vertices.size()),
+        mesh->indices.data(), static_cast<uint32>(mesh->indices.size()));
+}
+
+bool Renderer::UploadMesh(const Mesh* mesh, const Vertex* vertices, uint32 vertexCount,
+    const uint32* indices, uint32 indexCount)
+{
+    if (!mesh || !m_device)
+        return false;
+    if (m_meshCache.count(mesh))
+        return true;
+
+    // Narrow to 16-bit indices whenever the vertex count allows it
+    if (SelectIndexFormat(vertexCount) == IndexFormat::UInt16)
+    {
+        std::vector<uint16> narrow(indexCount);
+        for (uint32 i = 0; i < indexCount; ++i)
+        {
+            narrow[i] = static_cast<uint16>(indices[i]);
+        }
+        return UploadStreams(mesh, vertices, vertexCount, narrow.data(), indexCount, IndexFormat::UInt16);
+    }
+    return UploadStreams(mesh, vertices, vertexCount, indices, indexCount, IndexFormat::UInt32);
+}
+
+bool Renderer::UploadMesh(const Mesh* mesh, const Vertex* vertices, uint32 vertexCount,
+    const uint16* indices, uint32 indexCount)
+{
+    if (!mesh || !m_device)
+        return false;
+    if (m_meshCache.count(mesh))
+        return true;
+    return UploadStreams(mesh, vertices, vertexCount, indices, indexCount, IndexFormat::UInt16);
+}
+
+bool Renderer::UploadMesh(const Mesh* mesh, const CompactVertex* vertices, const QuantizationRange& range,
+    uint32 vertexCount, const void* indices, uint32 indexCount, IndexFormat indexFormat)
+{
+    if (!mesh || !m_device || m_vertexFormat != VertexFormat::Compact)
+        return false;
+    if (m_meshCache.count(mesh))
+        return true;
+    return CreateBuffers(mesh, vertices, vertexCount, range, indices, indexCount, indexFormat);
+}
+
+bool Renderer::UploadStreams(const Mesh* mesh, const Vertex* vertices, uint32 vertexCount,
+    const void* indices, uint32 indexCount, IndexFormat indexFormat)
+{
+    if (m_vertexFormat == VertexFormat::Compact)
+    {
+        std::vector<CompactVertex> compact;
+        QuantizationRange range = VertexQuantizer::Encode(vertices, vertexCount, compact);
+        return CreateBuffers(mesh, compact.data(), vertexCount, range, indices, indexCount, indexFormat);
+    }
+    return CreateBuffers(mesh, vertices, vertexCount, QuantizationRange(), indices, indexCount, indexFormat);
+}
 
+bool Renderer::CreateBuffers(const Mesh* mesh, const void* vertices, uint32 vertexCount,
+    const QuantizationRange& range, const void* indices, uint32 indexCount, IndexFormat indexFormat)
+{
     MeshBuffers buffers;
+    buffers.format = m_vertexFormat;
+    buffers.range = range;
+
+    uint32 vertexSize = m_vertexFormat == VertexFormat::Compact
+        ? static_cast<uint32>(sizeof(CompactVertex)) : static_cast<uint32>(sizeof(Vertex));
+    buffers.vb = m_device->CreateBuffer(vertices, vertexCount * vertexSize, vertexSize);
 
-    auto vb = std::make_unique<D3D12Buffer>();
-    uint32 vbSize = static_cast<uint32>(mesh->vertices.size() * sizeof(Vertex));
-    vb->Initialize(m_d3dDevice, mesh->vertices.data(), vbSize, sizeof(Vertex));
-    buffers.vb = std::move(vb);
+    // The index stride tells every backend the index width
+    uint32 indexSize = GetIndexSize(indexFormat);
+    buffers.ib = m_device->CreateBuffer(indices, indexCount * indexSize, indexSize);
 
-    auto ib = std::make_unique<D3D12Buffer>();
-    uint32 ibSize = static_cast<uint32>(mesh->indices.size() * sizeof(uint32));
-    ib->Initialize(m_d3dDevice, mesh->indices.data(), ibSize, sizeof(uint32));
-    buffers.ib = std::move(ib);
+    if (!buffers.vb || !buffers.ib)
+        return false;
 
-    buffers.indexCount = static_cast<uint32>(mesh->indices.size());
+    buffers.indexCount = indexCount;
 
     m_meshCache[mesh] = std::move(buffers);
+    return true;
 }
 
 void Renderer::ClearMeshCache()
 {
     m_meshCache.clear();
+    m_instanceBatches.clear();
+}
+
+void Renderer::SetVertexFormat(VertexFormat format)
+{
+    if (format == m_vertexFormat)
+        return;
+    m_vertexFormat = format;
+    ClearMeshCache();
+}
+
+void Renderer::SetDrawFormat(const MeshBuffers& buffers)
+{
+    m_context->SetVertexFormat(buffers.format, buffers.range.offset, buffers.range.scale);
 }
 
 void Renderer::RenderScene(SceneGraph& graph, Camera& camera, PointLight* light,
@@ -75,26 +175,166 @@ void Renderer::RenderScene(SceneGraph& graph, Camera& camera, PointLight* light,
             light->GetQuadraticAttenuation());
     }
 
-    // Traverse scene graph and draw each node with a mesh
-    graph.Traverse([this](SceneNode* node, const XMMATRIX& worldMatrix) {
-        Mesh* mesh = node->GetMesh();
-        if (!mesh)
-            return;
+    m_cullingStats = {};
+    XMFLOAT3 viewer = camera.GetPosition();
+    SetLODView(camera);
+
+    if (!m_frustumCulling)
+    {
+        graph.Traverse([this](SceneNode* node, const XMMATRIX& worldMatrix) {
+            if (node->GetMesh())
+                AddInstance(SelectLOD(node->GetMesh(), worldMatrix), worldMatrix);
+        });
+        DrawInstanceBatches(nullptr, viewer);
+        return;
+    }
+
+    // Frustum planes from the untransposed view-projection
+    Math::Frustum frustum = Math::Frustum::FromViewProjection(view * projection);
+
+    // The BVH query returns mesh nodes whose world AABB touches the frustum;
+    // everything else is rejected before any upload or constant buffer write
+    graph.UpdateSpatialIndex();
+    m_cullingStats.tested = graph.GetSpatialNodeCount();
+    graph.QueryFrustum(frustum, [this, &frustum](SceneNode* node, const XMMATRIX& worldMatrix) {
+        const Mesh* mesh = node->GetMesh();
+        if (IsMeshVisible(frustum, *mesh, worldMatrix))
+            AddInstance(SelectLOD(mesh, worldMatrix), worldMatrix);
+    });
+    DrawInstanceBatches(&frustum, viewer);
+    m_cullingStats.culled = m_cullingStats.tested - m_cullingStats.drawn - m_cullingStats.notUploaded;
+}
+
+void Renderer::SetLODView(const Camera& camera)
+{
+    m_lodViewer = camera.GetPosition();
+    bool ortho = camera.GetProjectionMode() == ProjectionMode::Orthographic;
+    m_lodViewHeight = ortho ? camera.GetOrthoSize() * 2.0f : 0.0f;
+    m_lodTanHalfFov = std::tan(camera.GetFov() * 0.5f);
+}
+
+const Mesh* Renderer::SelectLOD(const Mesh* mesh, FXMMATRIX worldMatrix)
+{
+    if (mesh->lods.empty() || m_lodThreshold <= 0.0f || !mesh->localSphere.IsValid() ||
+        mesh->localSphere.radius <= 0.0f)
+        return mesh;
+
+    // Screen height covered by one mesh unit: world scale over the view
+    // height at the sphere's nearest point (the whole view when inside it)
+    Math::BoundingSphere sphere = Math::TransformSphere(mesh->localSphere, worldMatrix);
+    float scale = sphere.radius / mesh->localSphere.radius;
+    float viewHeight = m_lodViewHeight;
+    if (viewHeight <= 0.0f)
+    {
+        XMVECTOR offset = XMVectorSubtract(XMLoadFloat3(&sphere.center), XMLoadFloat3(&m_lodViewer));
+        float distance = XMVectorGetX(XMVector3Length(offset)) - sphere.radius;
+        if (distance <= 0.0f)
+            return mesh;
+        viewHeight = 2.0f * distance * m_lodTanHalfFov;
+    }
+    float maxError = m_lodThreshold * viewHeight / scale;
+
+    const Mesh* selected = mesh;
+    for (const auto& lod : mesh->lods)
+    {
+        if (lod->lodError > maxError)
+            break;
+        selected = lod.get();
+    }
+    if (selected != mesh)
+        m_cullingStats.lodReduced++;
+    return selected;
+}
+
+void Renderer::AddInstance(const Mesh* mesh, FXMMATRIX worldMatrix)
+{
+    // Transpose for HLSL column-major layout
+    XMFLOAT4X4 worldFloat;
+    XMStoreFloat4x4(&worldFloat, XMMatrixTranspose(worldMatrix));
+    m_instanceBatches[mesh].push_back(worldFloat);
+}
+
+void Renderer::DrawInstanceBatches(const Math::Frustum* frustum, const XMFLOAT3& viewer)
+{
+    for (auto& [mesh, worlds] : m_instanceBatches)
+    {
+        if (worlds.empty())
+            continue;
 
         // Ensure mesh is uploaded
-        UploadMesh(mesh);
+        if (!UploadMesh(mesh))
+            m_cullingStats.notUploaded += static_cast<uint32>(worlds.size());
 
         auto it = m_meshCache.find(mesh);
-        if (it == m_meshCache.end())
-            return;
+        if (it != m_meshCache.end())
+            SetDrawFormat(it->second);
+        if (it != m_meshCache.end() && m_clusterCulling && mesh->meshlets.size() > 1)
+        {
+            DrawMeshletInstances(*mesh, it->second, worlds, frustum, viewer);
+        }
+        else if (it != m_meshCache.end())
+        {
+            uint32 count = static_cast<uint32>(worlds.size());
+            m_context->DrawPrimitivesInstanced(it->second.vb.get(), it->second.ib.get(),
+                worlds.data(), count);
+            m_cullingStats.drawn += count;
+            m_cullingStats.drawCalls++;
+        }
+        worlds.clear();
+    }
+}
 
-        // Transpose for HLSL column-major layout
-        XMMATRIX transposed = XMMatrixTranspose(worldMatrix);
-        XMFLOAT4X4 worldFloat;
-        XMStoreFloat4x4(&worldFloat, transposed);
+void Renderer::DrawMeshletInstances(const Mesh& mesh, const MeshBuffers& buffers,
+    const std::vector<XMFLOAT4X4>& worlds, const Math::Frustum* frustum, const XMFLOAT3& viewer)
+{
+    XMVECTOR viewerPos = XMLoadFloat3(&viewer);
+    for (const XMFLOAT4X4& worldFloat : worlds)
+    {
+        XMMATRIX world = XMMatrixTranspose(XMLoadFloat4x4(&worldFloat));
 
-        m_context->DrawPrimitives(it->second.vb.get(), it->second.ib.get(), worldFloat);
-    });
+        // Cone tests run in mesh space; a mirroring world flips which side
+        // the rasterizer culls, so those instances skip them
+        XMVECTOR determinant;
+        XMMATRIX inverse = XMMatrixInverse(&determinant, world);
+        bool coneTests = XMVectorGetX(determinant) > 0.0f;
+        XMFLOAT3 localViewer;
+        XMStoreFloat3(&localViewer, XMVector3TransformCoord(viewerPos, inverse));
+
+        // Visible meshlets that follow each other in the index buffer merge
+        // into one range draw
+        uint32 runFirst = 0;
+        uint32 runCount = 0;
+        uint32 draws = 0;
+        auto flush = [&]() {
+            if (runCount == 0)
+                return;
+            m_context->DrawPrimitivesRange(buffers.vb.get(), buffers.ib.get(), runFirst, runCount, worldFloat);
+            ++draws;
+            runCount = 0;
+        };
+
+        for (const Meshlet& meshlet : mesh.meshlets)
+        {
+            m_cullingStats.clustersTested++;
+            if ((coneTests && meshlet.IsBackFacing(localViewer)) ||
+                (frustum && !frustum->IntersectsSphere(Math::TransformSphere(meshlet.bounds, world))))
+            {
+                m_cullingStats.clustersCulled++;
+                continue;
+            }
+
+            if (runCount > 0 && meshlet.firstIndex != runFirst + runCount)
+                flush();
+            if (runCount == 0)
+                runFirst = meshlet.firstIndex;
+            runCount += meshlet.indexCount;
+        }
+        flush();
+
+        if (draws > 0)
+            m_cullingStats.drawn++;
+        m_cullingStats.drawCalls += draws;
+    }
 }
 
 void Renderer::RenderLightIndicator(PointLight* light, bool show,
@@ -109,6 +349,8 @@ void Renderer::RenderLightIndicator(PointLight* light, bool show,
     XMFLOAT4X4 lightWorldFloat;
     XMStoreFloat4x4(&lightWorldFloat, lightWorld);
 
+    // The indicator sphere is a full-format buffer owned by the caller
+    m_context->SetVertexFormat(VertexFormat::Full, { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f });
     m_context->SetUnlitMode(true, light->GetColor());
     m_context->DrawPrimitives(sphereVB, sphereIB, lightWorldFloat);
     m_context->SetUnlitMode(false, { 1.0f, 1.0f, 1.0f });
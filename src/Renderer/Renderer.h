@@ -1,31 +1,75 @@
 #pragma once
 
 #include "Core/Types.h"
+#include "Renderer/VertexQuantizer.h"
+#include "RHI/RHIBuffer.h"
+#include <DirectXMath.h>
 #include <memory>
 #include <unordered_map>
-
-struct ID3D12Device;
+#include <vector>
 
 namespace RRE
 {
 
-class D3D12Context;
-class IRHIBuffer;
+class IRHIDevice;
+class IRHIContext;
 class Mesh;
 class SceneGraph;
 class Camera;
 class PointLight;
 
+namespace Math
+{
+class Frustum;
+}
+
+// Per-frame frustum culling counters (mesh-bearing nodes only).
+// tested = nodes in the spatial index, culled = tested - drawn.
+// drawCalls = draws submitted for the drawn nodes: one instanced draw per
+// mesh, or one per run of visible meshlets for meshes that have them.
+struct CullingStats
+{
+    uint32 tested = 0;
+    uint32 culled = 0;
+    uint32 drawn = 0;
+    uint32 drawCalls = 0;
+    uint32 clustersTested = 0;  // meshlets x instances
+    uint32 clustersCulled = 0;  // back-facing or outside the frustum
+    uint32 lodReduced = 0;      // drawn nodes that used a coarser LOD
+    uint32 notUploaded = 0;     // visible nodes skipped: UploadMesh refused their mesh
+};
+
 class Renderer
 {
 public:
     Renderer() = default;
     ~Renderer() = default;
 
-    void SetContext(D3D12Context* context, ID3D12Device* device);
+    // Any backend; buffers are created through the device, draws go to its context
+    void SetDevice(IRHIDevice* device);
 
-    // Upload mesh VB/IB to GPU (cached, idempotent)
-    void UploadMesh(Mesh* mesh);
+    // Upload mesh VB/IB to GPU (cached, idempotent). Returns whether mesh
+    // has buffers: a mesh without streams of its own is refused.
+    bool UploadMesh(const Mesh* mesh);
+
+    // Upload streams held outside the mesh (e.g. a mapped MeshFile) as mesh's
+    // buffers; the mesh itself only supplies bounds, meshlets and LODs.
+    // ClearMeshCache drops them like any other upload, and draws of the mesh
+    // are then skipped (CullingStats::notUploaded) until the owner uploads
+    // again. 32-bit indices are narrowed to 16 bits when vertexCount is
+    // below 65536.
+    bool UploadMesh(const Mesh* mesh, const Vertex* vertices, uint32 vertexCount,
+        const uint32* indices, uint32 indexCount);
+    bool UploadMesh(const Mesh* mesh, const Vertex* vertices, uint32 vertexCount,
+        const uint16* indices, uint32 indexCount);
+
+    // Vertices already encoded against range (e.g. a MeshFile's compact
+    // stream) and indices already in indexFormat, uploaded without any
+    // conversion. Only while the vertex format is Compact; false otherwise.
+    bool UploadMesh(const Mesh* mesh, const CompactVertex* vertices, const QuantizationRange& range,
+        uint32 vertexCount, const void* indices, uint32 indexCount, IndexFormat indexFormat);
+
+    bool IsMeshUploaded(const Mesh* mesh) const { return m_meshCache.count(mesh) != 0; }
 
     // Render entire scene graph
     void RenderScene(SceneGraph& graph, Camera& camera, PointLight* light,
@@ -37,17 +81,82 @@ public:
 
     void ClearMeshCache();
 
+    // Vertex layout of later uploads (default Full). Compact quantizes each
+    // mesh against its own bounds (16 instead of 40 bytes per vertex);
+    // switching formats clears the mesh cache.
+    void SetVertexFormat(VertexFormat format);
+    VertexFormat GetVertexFormat() const { return m_vertexFormat; }
+
+    // Frustum culling (enabled by default); stats reflect the last RenderScene
+    void SetFrustumCulling(bool enabled) { m_frustumCulling = enabled; }
+    bool GetFrustumCulling() const { return m_frustumCulling; }
+    const CullingStats& GetCullingStats() const { return m_cullingStats; }
+
+    // Per-meshlet back-face and frustum culling for meshes with meshlets
+    // (enabled by default; such meshes are drawn per instance, not instanced)
+    void SetClusterCulling(bool enabled) { m_clusterCulling = enabled; }
+    bool GetClusterCulling() const { return m_clusterCulling; }
+
+    // Meshes with a LOD chain draw the coarsest level whose error projects
+    // to at most this fraction of the view height (default: about a pixel
+    // at 1080p; 0 always draws the full mesh)
+    static constexpr float DEFAULT_LOD_THRESHOLD = 1.0f / 1080.0f;
+    void SetLODThreshold(float fraction) { m_lodThreshold = fraction; }
+    float GetLODThreshold() const { return m_lodThreshold; }
+
 private:
+    // Queue a visible node; nodes sharing a mesh are drawn together
+    void AddInstance(const Mesh* mesh, DirectX::FXMMATRIX worldMatrix);
+
+    // Per-frame projection terms for SelectLOD
+    void SetLODView(const Camera& camera);
+
+    // mesh or the coarsest of its lods that is accurate enough at world
+    const Mesh* SelectLOD(const Mesh* mesh, DirectX::FXMMATRIX worldMatrix);
+
+    // One instanced draw per queued mesh (uploading as needed), then reset.
+    // frustum is null when frustum culling is off.
+    void DrawInstanceBatches(const Math::Frustum* frustum, const DirectX::XMFLOAT3& viewer);
+
     struct MeshBuffers
     {
         std::unique_ptr<IRHIBuffer> vb;
         std::unique_ptr<IRHIBuffer> ib;
         uint32 indexCount = 0;
+        VertexFormat format = VertexFormat::Full;
+        QuantizationRange range;    // Compact only
     };
 
-    D3D12Context* m_context = nullptr;
-    ID3D12Device* m_d3dDevice = nullptr;
-    std::unordered_map<Mesh*, MeshBuffers> m_meshCache;
+    // Encodes vertices in the vertex format, then CreateBuffers
+    bool UploadStreams(const Mesh* mesh, const Vertex* vertices, uint32 vertexCount,
+        const void* indices, uint32 indexCount, IndexFormat indexFormat);
+
+    // Creates and caches mesh's buffers from streams already in the vertex
+    // format (range: Compact only) and indexFormat
+    bool CreateBuffers(const Mesh* mesh, const void* vertices, uint32 vertexCount,
+        const QuantizationRange& range, const void* indices, uint32 indexCount, IndexFormat indexFormat);
+
+    // Vertex layout and position decoding of buffers for the next draws
+    void SetDrawFormat(const MeshBuffers& buffers);
+
+    // Index ranges of the meshlets visible from viewer, per instance
+    void DrawMeshletInstances(const Mesh& mesh, const MeshBuffers& buffers,
+        const std::vector<DirectX::XMFLOAT4X4>& worlds, const Math::Frustum* frustum,
+        const DirectX::XMFLOAT3& viewer);
+
+    IRHIDevice* m_device = nullptr;
+    IRHIContext* m_context = nullptr;
+    std::unordered_map<const Mesh*, MeshBuffers> m_meshCache;
+    // Transposed world matrices per mesh for the current frame (storage reused)
+    std::unordered_map<const Mesh*, std::vector<DirectX::XMFLOAT4X4>> m_instanceBatches;
+    VertexFormat m_vertexFormat = VertexFormat::Full;
+    bool m_frustumCulling = true;
+    bool m_clusterCulling = true;
+    float m_lodThreshold = DEFAULT_LOD_THRESHOLD;
+    DirectX::XMFLOAT3 m_lodViewer = { 0.0f, 0.0f, 0.0f };
+    float m_lodViewHeight = 0.0f;       // orthographic view height, or 0
+    float m_lodTanHalfFov = 0.0f;       // perspective
+    CullingStats m_cullingStats;
 };
 
 } // namespace RRE
@@ -1,7 +1,7 @@
 #pragma once
 
+#include "Core/Types.h"
 #include <DirectXMath.h>
-#include <d3d12.h>
 #include <cstddef>
 
 namespace RRE
@@ -19,13 +19,26 @@ static_assert(offsetof(Vertex, color)    == 12, "color offset mismatch");
 static_assert(offsetof(Vertex, normal)   == 28, "normal offset mismatch");
 static_assert(sizeof(Vertex)             == 40, "Vertex size mismatch");
 
-inline const D3D12_INPUT_ELEMENT_DESC VERTEX_INPUT_LAYOUT[] =
+// Vertex buffer layouts understood by every backend
+enum class VertexFormat : uint32
 {
-    { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0,  0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-    { "COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT,  0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-    { "NORMAL",   0, DXGI_FORMAT_R32G32B32_FLOAT,     0, 28, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+    Full,       // Vertex
+    Compact     // CompactVertex
 };
 
-inline constexpr UINT VERTEX_INPUT_LAYOUT_COUNT = _countof(VERTEX_INPUT_LAYOUT);
+// Quantized vertex (VertexQuantizer): position as unorm16 across a range
+// given per draw (w unused), octahedral-encoded unit normal as two snorm16,
+// RGBA8 color packed R | G << 8 | B << 16 | A << 24
+struct CompactVertex
+{
+    uint16 position[4];
+    int16 normal[2];
+    uint32 color;
+};
+
+static_assert(offsetof(CompactVertex, position) == 0, "compact position offset mismatch");
+static_assert(offsetof(CompactVertex, normal)   == 8, "compact normal offset mismatch");
+static_assert(offsetof(CompactVertex, color)    == 12, "compact color offset mismatch");
+static_assert(sizeof(CompactVertex)             == 16, "CompactVertex size mismatch");
 
 } // namespace RRE
@@ -0,0 +1,156 @@
+#include "Renderer/VertexQuantizer.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using namespace DirectX;
+
+namespace RRE
+{
+
+namespace
+{
+
+const float UNORM16_MAX = 65535.0f;
+const float SNORM16_MAX = 32767.0f;
+
+uint16 ToUnorm16(float value, float offset, float scale)
+{
+    float t = scale > 0.0f ? (value - offset) / scale : 0.0f;
+    t = std::min(std::max(t, 0.0f), 1.0f);
+    return static_cast<uint16>(t * UNORM16_MAX + 0.5f);
+}
+
+int16 ToSnorm16(float value)
+{
+    value = std::min(std::max(value, -1.0f), 1.0f);
+    return static_cast<int16>(std::lround(value * SNORM16_MAX));
+}
+
+// D3D snorm conversion: -32768 and -32767 both map to -1
+float FromSnorm16(int16 value)
+{
+    return std::max(static_cast<float>(value) / SNORM16_MAX, -1.0f);
+}
+
+uint8 ToUnorm8(float value)
+{
+    value = std::min(std::max(value, 0.0f), 1.0f);
+    return static_cast<uint8>(value * 255.0f + 0.5f);
+}
+
+float SignNotZero(float value)
+{
+    return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+} // anonymous namespace
+
+QuantizationRange VertexQuantizer::ComputeRange(const Vertex* vertices, uint32 count)
+{
+    QuantizationRange range;
+    if (count == 0)
+        return range;
+
+    XMFLOAT3 minimum = { FLT_MAX, FLT_MAX, FLT_MAX };
+    XMFLOAT3 maximum = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (uint32 i = 0; i < count; ++i)
+    {
+        const XMFLOAT3& p = vertices[i].position;
+        minimum = { std::min(minimum.x, p.x), std::min(minimum.y, p.y), std::min(minimum.z, p.z) };
+        maximum = { std::max(maximum.x, p.x), std::max(maximum.y, p.y), std::max(maximum.z, p.z) };
+    }
+    range.offset = minimum;
+    range.scale = { maximum.x - minimum.x, maximum.y - minimum.y, maximum.z - minimum.z };
+    return range;
+}
+
+CompactVertex VertexQuantizer::Encode(const Vertex& vertex, const QuantizationRange& range)
+{
+    CompactVertex out;
+    out.position[0] = ToUnorm16(vertex.position.x, range.offset.x, range.scale.x);
+    out.position[1] = ToUnorm16(vertex.position.y, range.offset.y, range.scale.y);
+    out.position[2] = ToUnorm16(vertex.position.z, range.offset.z, range.scale.z);
+    out.position[3] = 0;
+    EncodeOctahedral(vertex.normal, out.normal);
+    out.color = PackColor(vertex.color);
+    return out;
+}
+
+Vertex VertexQuantizer::Decode(const CompactVertex& vertex, const QuantizationRange& range)
+{
+    Vertex out;
+    out.position.x = range.offset.x + (vertex.position[0] / UNORM16_MAX) * range.scale.x;
+    out.position.y = range.offset.y + (vertex.position[1] / UNORM16_MAX) * range.scale.y;
+    out.position.z = range.offset.z + (vertex.position[2] / UNORM16_MAX) * range.scale.z;
+    out.normal = DecodeOctahedral(vertex.normal);
+    out.color = UnpackColor(vertex.color);
+    return out;
+}
+
+QuantizationRange VertexQuantizer::Encode(const Vertex* vertices, uint32 count,
+    std::vector<CompactVertex>& out)
+{
+    QuantizationRange range = ComputeRange(vertices, count);
+    out.resize(count);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        out[i] = Encode(vertices[i], range);
+    }
+    return range;
+}
+
+void VertexQuantizer::EncodeOctahedral(const XMFLOAT3& normal, int16 out[2])
+{
+    float length = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+    if (length == 0.0f)
+    {
+        out[0] = 0;
+        out[1] = 0;
+        return;
+    }
+
+    // Project onto the octahedron; the lower half folds over the diagonals
+    float x = normal.x / length;
+    float y = normal.y / length;
+    if (normal.z < 0.0f)
+    {
+        float foldedX = (1.0f - std::fabs(y)) * SignNotZero(x);
+        float foldedY = (1.0f - std::fabs(x)) * SignNotZero(y);
+        x = foldedX;
+        y = foldedY;
+    }
+    out[0] = ToSnorm16(x);
+    out[1] = ToSnorm16(y);
+}
+
+XMFLOAT3 VertexQuantizer::DecodeOctahedral(const int16 encoded[2])
+{
+    float x = FromSnorm16(encoded[0]);
+    float y = FromSnorm16(encoded[1]);
+    float z = 1.0f - std::fabs(x) - std::fabs(y);
+    float t = std::max(-z, 0.0f);
+    x += x >= 0.0f ? -t : t;
+    y += y >= 0.0f ? -t : t;
+
+    float length = std::sqrt(x * x + y * y + z * z);
+    return { x / length, y / length, z / length };
+}
+
+uint32 VertexQuantizer::PackColor(const XMFLOAT4& color)
+{
+    return uint32(ToUnorm8(color.x)) | (uint32(ToUnorm8(color.y)) << 8) |
+        (uint32(ToUnorm8(color.z)) << 16) | (uint32(ToUnorm8(color.w)) << 24);
+}
+
+XMFLOAT4 VertexQuantizer::UnpackColor(uint32 packed)
+{
+    return {
+        static_cast<float>(packed & 0xFF) / 255.0f,
+        static_cast<float>((packed >> 8) & 0xFF) / 255.0f,
+        static_cast<float>((packed >> 16) & 0xFF) / 255.0f,
+        static_cast<float>(packed >> 24) / 255.0f,
+    };
+}
+
+} // namespace RRE
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Renderer/Vertex.h"
+#include "Core/Types.h"
+#include <DirectXMath.h>
+#include <vector>
+
+namespace RRE
+{
+
+// Position range of a compact stream: position = offset + unorm * scale,
+// with unorm = stored / 65535 as the input assembler reads it
+struct QuantizationRange
+{
+    DirectX::XMFLOAT3 offset = { 0.0f, 0.0f, 0.0f };
+    DirectX::XMFLOAT3 scale = { 1.0f, 1.0f, 1.0f };
+};
+
+// Encode/decode kernels for CompactVertex. Positions keep 1/65535 of the
+// range per axis, normals are within 0.01 degrees and colors keep 8 bits per
+// channel (palette colors are exact). Decode mirrors the vertex shader.
+class VertexQuantizer
+{
+public:
+    // Bounds of the positions (a zero extent keeps scale 0)
+    static QuantizationRange ComputeRange(const Vertex* vertices, uint32 count);
+
+    static CompactVertex Encode(const Vertex& vertex, const QuantizationRange& range);
+    static Vertex Decode(const CompactVertex& vertex, const QuantizationRange& range);
+
+    // Whole stream; returns the range the positions were encoded against
+    static QuantizationRange Encode(const Vertex* vertices, uint32 count,
+        std::vector<CompactVertex>& out);
+
+    // Unit vector on the octahedron, folded into the unit square
+    static void EncodeOctahedral(const DirectX::XMFLOAT3& normal, int16 out[2]);
+    static DirectX::XMFLOAT3 DecodeOctahedral(const int16 encoded[2]);
+
+    static uint32 PackColor(const DirectX::XMFLOAT4& color);
+    static DirectX::XMFLOAT4 UnpackColor(uint32 packed);
+};
+
+} // namespace RRE
@@ -0,0 +1,95 @@
+#include "Renderer/VertexWelder.h"
+#include "Core/Hash.h"
+
+using namespace DirectX;
+
+namespace RRE
+{
+
+namespace
+{
+
+constexpr uint32 EMPTY = UINT32_MAX;
+
+using VertexKey = FloatBitsKey<sizeof(Vertex) / sizeof(uint32)>;
+using PositionKey = FloatBitsKey<3>;
+
+// Open-addressing dedupe of count keys: remap[i] is the unique index of key i,
+// firsts[u] the input index where unique key u first occurs (ascending)
+template <typename Key, typename GetKey>
+void Deduplicate(uint32 count, GetKey getKey, std::vector<uint32>& remap, std::vector<uint32>& firsts)
+{
+    // Power-of-two table at most half full
+    uint32 tableSize = 1;
+    while (tableSize < count * 2)
+    {
+        tableSize <<= 1;
+    }
+    std::vector<uint32> table(tableSize, EMPTY);
+    std::vector<Key> keys;
+    keys.reserve(count);
+
+    remap.resize(count);
+    firsts.clear();
+    for (uint32 i = 0; i < count; ++i)
+    {
+        Key key = getKey(i);
+        uint32 slot = static_cast<uint32>(key.Hash()) & (tableSize - 1);
+        while (table[slot] != EMPTY && !(keys[table[slot]] == key))
+        {
+            slot = (slot + 1) & (tableSize - 1);
+        }
+
+        if (table[slot] == EMPTY)
+        {
+            table[slot] = static_cast<uint32>(keys.size());
+            keys.push_back(key);
+            firsts.push_back(i);
+        }
+        remap[i] = table[slot];
+    }
+}
+
+} // anonymous namespace
+
+uint32 VertexWelder::Weld(std::vector<Vertex>& vertices, std::vector<uint32>& indices)
+{
+    uint32 vertexCount = static_cast<uint32>(vertices.size());
+    if (vertexCount == 0)
+        return 0;
+
+    std::vector<uint32> remap;
+    std::vector<uint32> firsts;
+    Deduplicate<VertexKey>(vertexCount, [&](uint32 i) { return VertexKey(&vertices[i]); }, remap, firsts);
+
+    // firsts ascends and firsts[u] >= u, so compacting in place is safe
+    uint32 uniqueCount = static_cast<uint32>(firsts.size());
+    for (uint32 u = 0; u < uniqueCount; ++u)
+    {
+        vertices[u] = vertices[firsts[u]];
+    }
+    vertices.resize(uniqueCount);
+    for (uint32& index : indices)
+    {
+        index = remap[index];
+    }
+    return uniqueCount;
+}
+
+uint32 VertexWelder::WeldPositions(const std::vector<Vertex>& vertices,
+    std::vector<XMFLOAT3>& positions, std::vector<uint32>& remap)
+{
+    uint32 vertexCount = static_cast<uint32>(vertices.size());
+    std::vector<uint32> firsts;
+    Deduplicate<PositionKey>(vertexCount, [&](uint32 i) { return PositionKey(&vertices[i].position); },
+        remap, firsts);
+
+    positions.resize(firsts.size());
+    for (size_t u = 0; u < firsts.size(); ++u)
+    {
+        positions[u] = vertices[firsts[u]].position;
+    }
+    return static_cast<uint32>(positions.size());
+}
+
+} // namespace RRE
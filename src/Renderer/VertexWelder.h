@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Renderer/Vertex.h"
+#include "Core/Types.h"
+#include <vector>
+
+namespace RRE
+{
+
+// Merges vertices whose position, color and normal are bitwise equal (+0 and
+// -0 count as equal) through an open-addressing hash table, and rewrites the
+// indices to match. Survivors keep their first-occurrence order, so the
+// input's memory locality carries over.
+class VertexWelder
+{
+public:
+    // Returns the new vertex count
+    static uint32 Weld(std::vector<Vertex>& vertices, std::vector<uint32>& indices);
+
+    // Position-only welding that leaves vertices alone: positions receives
+    // the distinct positions (first-occurrence order) and remap maps each
+    // vertex to its position. Returns the position count.
+    static uint32 WeldPositions(const std::vector<Vertex>& vertices,
+        std::vector<DirectX::XMFLOAT3>& positions, std::vector<uint32>& remap);
+};
+
+} // namespace RRE
@@ -30,6 +30,7 @@ public:
     float GetFov() const { return m_fov; }
     float GetFovDegrees() const;
     ProjectionMode GetProjectionMode() const { return m_projectionMode; }
+    float GetOrthoSize() const { return m_orthoSize; }  // half the orthographic view height
     const char* GetProjectionModeName() const;
 
     // Mutators
@@ -0,0 +1,339 @@
+#include "Scene/DynamicBVH.h"
+#include <algorithm>
+
+namespace RRE
+{
+
+DynamicBVH::DynamicBVH(float margin)
+    : m_margin(margin)
+{
+}
+
+void DynamicBVH::Clear()
+{
+    m_nodes.clear();
+    m_root = INVALID_INDEX;
+    m_freeList = INVALID_INDEX;
+    m_proxyCount = 0;
+}
+
+uint32 DynamicBVH::AllocateNode()
+{
+    if (m_freeList == INVALID_INDEX)
+    {
+        m_nodes.emplace_back();
+        m_nodes.back().height = 0;
+        return static_cast<uint32>(m_nodes.size() - 1);
+    }
+
+    uint32 index = m_freeList;
+    m_freeList = m_nodes[index].parent;
+    m_nodes[index] = Node();
+    m_nodes[index].height = 0;
+    return index;
+}
+
+void DynamicBVH::FreeNode(uint32 index)
+{
+    m_nodes[index].parent = m_freeList;
+    m_nodes[index].height = -1;
+    m_freeList = index;
+}
+
+uint32 DynamicBVH::CreateProxy(const Math::AABB& aabb, void* userData)
+{
+    uint32 proxyId = AllocateNode();
+    Node& node = m_nodes[proxyId];
+    node.aabb.min = { aabb.min.x - m_margin, aabb.min.y - m_margin, aabb.min.z - m_margin };
+    node.aabb.max = { aabb.max.x + m_margin, aabb.max.y + m_margin, aabb.max.z + m_margin };
+    node.userData = userData;
+
+    InsertLeaf(proxyId);
+    m_proxyCount++;
+    return proxyId;
+}
+
+void DynamicBVH::DestroyProxy(uint32 proxyId)
+{
+    RemoveLeaf(proxyId);
+    FreeNode(proxyId);
+    m_proxyCount--;
+}
+
+bool DynamicBVH::MoveProxy(uint32 proxyId, const Math::AABB& aabb)
+{
+    if (Math::Contains(m_nodes[proxyId].aabb, aabb))
+        return false;
+
+    RemoveLeaf(proxyId);
+    Node& node = m_nodes[proxyId];
+    node.aabb.min = { aabb.min.x - m_margin, aabb.min.y - m_margin, aabb.min.z - m_margin };
+    node.aabb.max = { aabb.max.x + m_margin, aabb.max.y + m_margin, aabb.max.z + m_margin };
+    InsertLeaf(proxyId);
+    return true;
+}
+
+void DynamicBVH::InsertLeaf(uint32 leaf)
+{
+    if (m_root == INVALID_INDEX)
+    {
+        m_root = leaf;
+        m_nodes[leaf].parent = INVALID_INDEX;
+        return;
+    }
+
+    // Descend towards the sibling with the lowest surface-area cost
+    Math::AABB leafAABB = m_nodes[leaf].aabb;
+    uint32 index = m_root;
+    while (!m_nodes[index].IsLeaf())
+    {
+        const Node& node = m_nodes[index];
+        float area = Math::HalfSurfaceArea(node.aabb);
+        float combinedArea = Math::HalfSurfaceArea(Math::Union(node.aabb, leafAABB));
+
+        // Cost of making a new parent for this node and the leaf
+        float cost = 2.0f * combinedArea;
+        // Minimum cost of pushing the leaf further down
+        float inheritance = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](uint32 child) {
+            const Math::AABB& childAABB = m_nodes[child].aabb;
+            float unionArea = Math::HalfSurfaceArea(Math::Union(leafAABB, childAABB));
+            if (m_nodes[child].IsLeaf())
+                return unionArea + inheritance;
+            return unionArea - Math::HalfSurfaceArea(childAABB) + inheritance;
+        };
+        float cost1 = descendCost(node.child1);
+        float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    uint32 sibling = index;
+    uint32 oldParent = m_nodes[sibling].parent;
+    uint32 newParent = AllocateNode();
+    m_nodes[newParent].parent = oldParent;
+    m_nodes[newParent].aabb = Math::Union(leafAABB, m_nodes[sibling].aabb);
+    m_nodes[newParent].height = m_nodes[sibling].height + 1;
+    m_nodes[newParent].child1 = sibling;
+    m_nodes[newParent].child2 = leaf;
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+
+    if (oldParent != INVALID_INDEX)
+    {
+        if (m_nodes[oldParent].child1 == sibling)
+            m_nodes[oldParent].child1 = newParent;
+        else
+            m_nodes[oldParent].child2 = newParent;
+    }
+    else
+    {
+        m_root = newParent;
+    }
+
+    RefitAncestors(m_nodes[leaf].parent);
+}
+
+void DynamicBVH::RemoveLeaf(uint32 leaf)
+{
+    if (leaf == m_root)
+    {
+        m_root = INVALID_INDEX;
+        return;
+    }
+
+    uint32 parent = m_nodes[leaf].parent;
+    uint32 grandParent = m_nodes[parent].parent;
+    uint32 sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    if (grandParent != INVALID_INDEX)
+    {
+        if (m_nodes[grandParent].child1 == parent)
+            m_nodes[grandParent].child1 = sibling;
+        else
+            m_nodes[grandParent].child2 = sibling;
+        m_nodes[sibling].parent = grandParent;
+        FreeNode(parent);
+
+        RefitAncestors(grandParent);
+    }
+    else
+    {
+        m_root = sibling;
+        m_nodes[sibling].parent = INVALID_INDEX;
+        FreeNode(parent);
+    }
+}
+
+void DynamicBVH::RefitAncestors(uint32 index)
+{
+    while (index != INVALID_INDEX)
+    {
+        index = Balance(index);
+
+        Node& node = m_nodes[index];
+        const Node& child1 = m_nodes[node.child1];
+        const Node& child2 = m_nodes[node.child2];
+        node.height = 1 + std::max(child1.height, child2.height);
+        node.aabb = Math::Union(child1.aabb, child2.aabb);
+
+        index = node.parent;
+    }
+}
+
+// Rotate the taller grandchild up when A's subtrees differ in height by
+// more than one. Returns the index now occupying A's position.
+uint32 DynamicBVH::Balance(uint32 iA)
+{
+    Node* A = &m_nodes[iA];
+    if (A->IsLeaf() || A->height < 2)
+        return iA;
+
+    uint32 iB = A->child1;
+    uint32 iC = A->child2;
+    Node* B = &m_nodes[iB];
+    Node* C = &m_nodes[iC];
+    int32 balance = C->height - B->height;
+
+    if (balance > 1)
+    {
+        // Rotate C up
+        uint32 iF = C->child1;
+        uint32 iG = C->child2;
+        Node* F = &m_nodes[iF];
+        Node* G = &m_nodes[iG];
+
+        C->child1 = iA;
+        C->parent = A->parent;
+        A->parent = iC;
+
+        if (C->parent != INVALID_INDEX)
+        {
+            if (m_nodes[C->parent].child1 == iA)
+                m_nodes[C->parent].child1 = iC;
+            else
+                m_nodes[C->parent].child2 = iC;
+        }
+        else
+        {
+            m_root = iC;
+        }
+
+        if (F->height > G->height)
+        {
+            C->child2 = iF;
+            A->child2 = iG;
+            G->parent = iA;
+            A->aabb = Math::Union(B->aabb, G->aabb);
+            C->aabb = Math::Union(A->aabb, F->aabb);
+            A->height = 1 + std::max(B->height, G->height);
+            C->height = 1 + std::max(A->height, F->height);
+        }
+        else
+        {
+            C->child2 = iG;
+            A->child2 = iF;
+            F->parent = iA;
+            A->aabb = Math::Union(B->aabb, F->aabb);
+            C->aabb = Math::Union(A->aabb, G->aabb);
+            A->height = 1 + std::max(B->height, F->height);
+            C->height = 1 + std::max(A->height, G->height);
+        }
+        return iC;
+    }
+
+    if (balance < -1)
+    {
+        // Rotate B up
+        uint32 iD = B->child1;
+        uint32 iE = B->child2;
+        Node* D = &m_nodes[iD];
+        Node* E = &m_nodes[iE];
+
+        B->child1 = iA;
+        B->parent = A->parent;
+        A->parent = iB;
+
+        if (B->parent != INVALID_INDEX)
+        {
+            if (m_nodes[B->parent].child1 == iA)
+                m_nodes[B->parent].child1 = iB;
+            else
+                m_nodes[B->parent].child2 = iB;
+        }
+        else
+        {
+            m_root = iB;
+        }
+
+        if (D->height > E->height)
+        {
+            B->child2 = iD;
+            A->child1 = iE;
+            E->parent = iA;
+            A->aabb = Math::Union(C->aabb, E->aabb);
+            B->aabb = Math::Union(A->aabb, D->aabb);
+            A->height = 1 + std::max(C->height, E->height);
+            B->height = 1 + std::max(A->height, D->height);
+        }
+        else
+        {
+            B->child2 = iE;
+            A->child1 = iD;
+            D->parent = iA;
+            A->aabb = Math::Union(C->aabb, D->aabb);
+            B->aabb = Math::Union(A->aabb, E->aabb);
+            A->height = 1 + std::max(C->height, D->height);
+            B->height = 1 + std::max(A->height, E->height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
+
+bool DynamicBVH::Validate() const
+{
+    if (m_root == INVALID_INDEX)
+        return m_proxyCount == 0;
+
+    if (m_nodes[m_root].parent != INVALID_INDEX)
+        return false;
+
+    uint32 leaves = 0;
+    std::vector<uint32> stack = { m_root };
+    while (!stack.empty())
+    {
+        uint32 index = stack.back();
+        stack.pop_back();
+        const Node& node = m_nodes[index];
+
+        if (node.IsLeaf())
+        {
+            if (node.height != 0)
+                return false;
+            leaves++;
+            continue;
+        }
+
+        const Node& child1 = m_nodes[node.child1];
+        const Node& child2 = m_nodes[node.child2];
+        if (child1.parent != index || child2.parent != index)
+            return false;
+        if (node.height != 1 + std::max(child1.height, child2.height))
+            return false;
+        if (!Math::Contains(node.aabb, child1.aabb) || !Math::Contains(node.aabb, child2.aabb))
+            return false;
+
+        stack.push_back(node.child1);
+        stack.push_back(node.child2);
+    }
+
+    return leaves == m_proxyCount;
+}
+
+} // namespace RRE
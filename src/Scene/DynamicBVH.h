@@ -0,0 +1,204 @@
+#pragma once
+
+#include "Core/Types.h"
+#include "Math/Bounds.h"
+#include "Math/Frustum.h"
+#include <DirectXMath.h>
+#include <vector>
+
+namespace RRE
+{
+
+// Dynamic AABB tree (incremental insert/remove, AVL-style rotations).
+// Leaves store "fat" boxes enlarged by a margin, so small movements only
+// update the proxy's tight box and leave the tree untouched.
+class DynamicBVH
+{
+public:
+    static constexpr uint32 INVALID_INDEX = UINT32_MAX;
+
+    explicit DynamicBVH(float margin = 0.1f);
+    ~DynamicBVH() = default;
+
+    void Clear();
+
+    // Returns a proxy id that stays valid until DestroyProxy
+    uint32 CreateProxy(const Math::AABB& aabb, void* userData);
+    void DestroyProxy(uint32 proxyId);
+
+    // Re-insert only if the new box escapes the fat box.
+    // Returns true if the tree was restructured.
+    bool MoveProxy(uint32 proxyId, const Math::AABB& aabb);
+
+    void* GetUserData(uint32 proxyId) const { return m_nodes[proxyId].userData; }
+    const Math::AABB& GetFatAABB(uint32 proxyId) const { return m_nodes[proxyId].aabb; }
+
+    uint32 GetProxyCount() const { return m_proxyCount; }
+    int32 GetHeight() const { return m_root == INVALID_INDEX ? 0 : m_nodes[m_root].height; }
+
+    // Checks parent links, heights and box containment (for tests)
+    bool Validate() const;
+
+    // Queries call fn(proxyId) for each overlapping leaf; return false to stop.
+    // Query takes a custom overlaps(fatAABB) -> bool test.
+    template <typename Test, typename Fn>
+    void Query(Test&& overlaps, Fn&& fn) const;
+    template <typename Fn>
+    void QueryAABB(const Math::AABB& aabb, Fn&& fn) const;
+    template <typename Fn>
+    void QuerySphere(const DirectX::XMFLOAT3& center, float radius, Fn&& fn) const;
+    template <typename Fn>
+    void QueryFrustum(const Math::Frustum& frustum, Fn&& fn) const;
+
+    // Ray query: fn(proxyId, tEnter) returns the new maximum distance, which
+    // prunes subtrees beyond it (return 0 to stop, maxT to continue unchanged)
+    template <typename Fn>
+    void QueryRay(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction,
+        float maxT, Fn&& fn) const;
+
+private:
+    struct Node
+    {
+        Math::AABB aabb;
+        void* userData = nullptr;
+        uint32 parent = INVALID_INDEX;     // next free node while on the free list
+        uint32 child1 = INVALID_INDEX;
+        uint32 child2 = INVALID_INDEX;
+        int32 height = -1;                 // 0 = leaf, -1 = free
+
+        bool IsLeaf() const { return child1 == INVALID_INDEX; }
+    };
+
+    // AVL-balanced height stays well below this for any practical proxy count
+    static constexpr uint32 STACK_CAPACITY = 256;
+
+    uint32 AllocateNode();
+    void FreeNode(uint32 index);
+    void InsertLeaf(uint32 leaf);
+    void RemoveLeaf(uint32 leaf);
+    uint32 Balance(uint32 index);
+    void RefitAncestors(uint32 index);
+
+    std::vector<Node> m_nodes;
+    uint32 m_root = INVALID_INDEX;
+    uint32 m_freeList = INVALID_INDEX;
+    uint32 m_proxyCount = 0;
+    float m_margin;
+};
+
+template <typename Test, typename Fn>
+void DynamicBVH::Query(Test&& overlaps, Fn&& fn) const
+{
+    if (m_root == INVALID_INDEX)
+        return;
+
+    uint32 stack[STACK_CAPACITY];
+    uint32 top = 0;
+    stack[top++] = m_root;
+
+    while (top > 0)
+    {
+        const Node& node = m_nodes[stack[--top]];
+        if (!overlaps(node.aabb))
+            continue;
+
+        if (node.IsLeaf())
+        {
+            if (!fn(static_cast<uint32>(&node - m_nodes.data())))
+                return;
+        }
+        else
+        {
+            stack[top++] = node.child1;
+            stack[top++] = node.child2;
+        }
+    }
+}
+
+template <typename Fn>
+void DynamicBVH::QueryAABB(const Math::AABB& aabb, Fn&& fn) const
+{
+    Query([&aabb](const Math::AABB& box) { return Math::Overlaps(aabb, box); }, fn);
+}
+
+template <typename Fn>
+void DynamicBVH::QuerySphere(const DirectX::XMFLOAT3& center, float radius, Fn&& fn) const
+{
+    Query([&center, radius](const Math::AABB& box) {
+        return Math::SphereOverlapsAABB(center, radius, box);
+    }, fn);
+}
+
+template <typename Fn>
+void DynamicBVH::QueryFrustum(const Math::Frustum& frustum, Fn&& fn) const
+{
+    Query([&frustum](const Math::AABB& box) { return frustum.IntersectsAABB(box); }, fn);
+}
+
+template <typename Fn>
+void DynamicBVH::QueryRay(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction,
+    float maxT, Fn&& fn) const
+{
+    if (m_root == INVALID_INDEX)
+        return;
+
+    DirectX::XMFLOAT3 invDir = { 1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z };
+
+    struct Entry
+    {
+        uint32 index;
+        float tEnter;
+    };
+    Entry stack[STACK_CAPACITY];
+    uint32 top = 0;
+
+    float t = 0.0f;
+    if (!Math::RayIntersectsAABB(origin, invDir, maxT, m_nodes[m_root].aabb, t))
+        return;
+    stack[top++] = { m_root, t };
+
+    while (top > 0)
+    {
+        Entry entry = stack[--top];
+        if (entry.tEnter > maxT)
+            continue;
+
+        const Node& node = m_nodes[entry.index];
+        if (node.IsLeaf())
+        {
+            maxT = fn(entry.index, entry.tEnter);
+            if (maxT <= 0.0f)
+                return;
+            continue;
+        }
+
+        // Push the farther child first so the nearer one is visited next
+        float t1 = 0.0f;
+        float t2 = 0.0f;
+        bool hit1 = Math::RayIntersectsAABB(origin, invDir, maxT, m_nodes[node.child1].aabb, t1);
+        bool hit2 = Math::RayIntersectsAABB(origin, invDir, maxT, m_nodes[node.child2].aabb, t2);
+        if (hit1 && hit2)
+        {
+            if (t1 <= t2)
+            {
+                stack[top++] = { node.child2, t2 };
+                stack[top++] = { node.child1, t1 };
+            }
+            else
+            {
+                stack[top++] = { node.child1, t1 };
+                stack[top++] = { node.child2, t2 };
+            }
+        }
+        else if (hit1)
+        {
+            stack[top++] = { node.child1, t1 };
+        }
+        else if (hit2)
+        {
+            stack[top++] = { node.child2, t2 };
+        }
+    }
+}
+
+} // namespace RRE
@@ -1,5 +1,9 @@
 #include "Scene/SceneGraph.h"
 #include "Renderer/Mesh.h"
+#include "Core/ThreadPool.h"
+#include "Math/Ray.h"
+#include <algorithm>
+#include <cstring>
 
 namespace RRE
 {
@@ -7,28 +11,92 @@ namespace RRE
 SceneGraph::SceneGraph()
     : m_root(std::make_unique<SceneNode>())
 {
+    m_root->m_graph = this;
 }
 
 void SceneGraph::Traverse(const Visitor& visitor) const
 {
-    if (m_root)
+    Traverse<const Visitor&>(visitor);
+}
+
+void SceneGraph::SyncHierarchy() const
+{
+    // Nodes are stored in pre-order, so a changed child list is always seen
+    // at the parent before any (possibly destroyed) removed child is touched
+    bool structureChanged = m_hierarchyNodes.empty();
+    uint32 count = m_hierarchy.GetCount();
+    for (uint32 i = 0; i < count && !structureChanged; ++i)
+    {
+        structureChanged = m_hierarchyNodes[i]->GetStructureVersion() != m_hierarchyStructureVersions[i];
+    }
+
+    if (structureChanged)
+    {
+        RebuildHierarchy();
+    }
+    else
+    {
+        // Copy TRS only for nodes whose transform changed since the last sync
+        for (uint32 i = 0; i < count; ++i)
+        {
+            SceneNode* node = m_hierarchyNodes[i];
+            const Transform& transform = node->GetTransform();
+            if (transform.GetVersion() != m_hierarchyTransformVersions[i])
+            {
+                m_hierarchy.SetPosition(i, transform.GetPosition());
+                m_hierarchy.SetRotation(i, transform.GetRotation());
+                m_hierarchy.SetScale(i, transform.GetScale());
+                m_hierarchyTransformVersions[i] = transform.GetVersion();
+            }
+            m_hierarchy.SetMesh(i, node->GetMesh());
+        }
+    }
+
+    if (m_threadPool && m_hierarchy.GetCount() >= PARALLEL_UPDATE_THRESHOLD)
     {
-        DirectX::XMMATRIX identity = DirectX::XMMatrixIdentity();
-        TraverseNode(m_root.get(), identity, visitor);
+        m_hierarchy.UpdateWorldMatricesParallel(*m_threadPool);
+    }
+    else
+    {
+        m_hierarchy.UpdateWorldMatrices();
     }
 }
 
-void SceneGraph::TraverseNode(SceneNode* node, const DirectX::XMMATRIX& parentWorld,
-    const Visitor& visitor) const
+void SceneGraph::RebuildHierarchy() const
 {
-    DirectX::XMMATRIX localMatrix = node->GetTransform().GetLocalMatrix();
-    DirectX::XMMATRIX worldMatrix = localMatrix * parentWorld;
+    m_hierarchy.Clear();
+    m_hierarchyNodes.clear();
+    m_hierarchyTransformVersions.clear();
+    m_hierarchyStructureVersions.clear();
 
-    visitor(node, worldMatrix);
+    // Pre-order walk (same visiting order as the tree traversal), which
+    // guarantees parents are stored before their children
+    struct StackEntry
+    {
+        SceneNode* node;
+        uint32 parentIndex;
+    };
+    std::vector<StackEntry> stack;
+    stack.push_back({ m_root.get(), TransformHierarchy::INVALID_INDEX });
 
-    for (auto& child : node->GetChildren())
+    while (!stack.empty())
     {
-        TraverseNode(child.get(), worldMatrix, visitor);
+        StackEntry entry = stack.back();
+        stack.pop_back();
+
+        const Transform& transform = entry.node->GetTransform();
+        uint32 index = m_hierarchy.AddNode(entry.parentIndex,
+            transform.GetPosition(), transform.GetRotation(), transform.GetScale(),
+            entry.node->GetMesh());
+        m_hierarchyNodes.push_back(entry.node);
+        m_hierarchyTransformVersions.push_back(transform.GetVersion());
+        m_hierarchyStructureVersions.push_back(entry.node->GetStructureVersion());
+
+        const auto& children = entry.node->GetChildren();
+        for (auto it = children.rbegin(); it != children.rend(); ++it)
+        {
+            stack.push_back({ it->get(), index });
+        }
     }
 }
 
@@ -36,24 +104,284 @@ uint32 SceneGraph::GetTotalPolygonCount() const
 {
     if (!m_root)
         return 0;
-    return CountPolygons(m_root.get());
+
+    uint32 count = 0;
+    std::vector<const SceneNode*> stack = { m_root.get() };
+    while (!stack.empty())
+    {
+        const SceneNode* node = stack.back();
+        stack.pop_back();
+
+        if (node->GetMesh())
+        {
+            count += node->GetMesh()->GetPolygonCount();
+        }
+
+        for (auto& child : node->GetChildren())
+        {
+            stack.push_back(child.get());
+        }
+    }
+
+    return count;
 }
 
-uint32 SceneGraph::CountPolygons(SceneNode* node) const
+void SceneGraph::OnSubtreeAttached(SceneNode* node)
 {
-    uint32 count = 0;
+    std::vector<SceneNode*> stack = { node };
+    while (!stack.empty())
+    {
+        SceneNode* current = stack.back();
+        stack.pop_back();
 
-    if (node->GetMesh())
+        current->m_graph = this;
+        if (current->m_mesh)
+        {
+            AddSpatialEntry(current);
+        }
+        for (auto& child : current->m_children)
+        {
+            stack.push_back(child.get());
+        }
+    }
+}
+
+void SceneGraph::OnSubtreeDetached(SceneNode* node)
+{
+    std::vector<SceneNode*> stack = { node };
+    while (!stack.empty())
     {
-        count += node->GetMesh()->GetPolygonCount();
+        SceneNode* current = stack.back();
+        stack.pop_back();
+
+        RemoveSpatialEntry(current);
+        current->m_graph = nullptr;
+        for (auto& child : current->m_children)
+        {
+            stack.push_back(child.get());
+        }
     }
+}
 
-    for (auto& child : node->GetChildren())
+void SceneGraph::OnMeshChanged(SceneNode* node)
+{
+    if (!node->m_mesh)
+    {
+        RemoveSpatialEntry(node);
+    }
+    else if (node->m_spatialSlot == UINT32_MAX)
+    {
+        AddSpatialEntry(node);
+    }
+    else
     {
-        count += CountPolygons(child.get());
+        // Different local bounds: force a refit on the next update
+        m_spatialEntries[node->m_spatialSlot].boundsDirty = true;
     }
+}
 
-    return count;
+void SceneGraph::AddSpatialEntry(SceneNode* node)
+{
+    if (node->m_spatialSlot != UINT32_MAX)
+        return;
+
+    // Bounds are unknown until the world matrix is resolved, so the BVH
+    // proxy is created by the next UpdateSpatialIndex
+    node->m_spatialSlot = static_cast<uint32>(m_spatialEntries.size());
+    m_spatialEntries.push_back({ node, DynamicBVH::INVALID_INDEX, true, {}, Math::AABB() });
+}
+
+void SceneGraph::RemoveSpatialEntry(SceneNode* node)
+{
+    uint32 slot = node->m_spatialSlot;
+    if (slot == UINT32_MAX)
+        return;
+
+    if (m_spatialEntries[slot].proxyId != DynamicBVH::INVALID_INDEX)
+    {
+        m_spatialIndex.DestroyProxy(m_spatialEntries[slot].proxyId);
+    }
+
+    // Swap-remove, patching the moved node's slot
+    m_spatialEntries[slot] = m_spatialEntries.back();
+    m_spatialEntries[slot].node->m_spatialSlot = slot;
+    m_spatialEntries.pop_back();
+    node->m_spatialSlot = UINT32_MAX;
+}
+
+void SceneGraph::UpdateSpatialIndex()
+{
+    if (m_spatialEntries.empty())
+        return;
+
+    // A regular traversal resolves world matrices in the active storage mode
+    Traverse([this](SceneNode* node, const DirectX::XMMATRIX& worldMatrix) {
+        if (node->m_spatialSlot == UINT32_MAX)
+            return;
+
+        // Empty meshes have no bounds and never enter the tree
+        if (!node->m_mesh->localBounds.IsValid())
+            return;
+
+        SpatialEntry& entry = m_spatialEntries[node->m_spatialSlot];
+        DirectX::XMFLOAT4X4 world;
+        DirectX::XMStoreFloat4x4(&world, worldMatrix);
+        if (!entry.boundsDirty && std::memcmp(&world, &entry.world, sizeof(world)) == 0)
+            return;
+
+        entry.world = world;
+        entry.worldBounds = Math::TransformAABB(node->m_mesh->localBounds, worldMatrix);
+        entry.boundsDirty = false;
+
+        if (entry.proxyId == DynamicBVH::INVALID_INDEX)
+        {
+            entry.proxyId = m_spatialIndex.CreateProxy(entry.worldBounds, node);
+        }
+        else
+        {
+            m_spatialIndex.MoveProxy(entry.proxyId, entry.worldBounds);
+        }
+    });
+}
+
+SceneNode* SceneGraph::PickNode(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction,
+    float maxDistance, float* outDistance) const
+{
+    DirectX::XMFLOAT3 invDir = { 1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z };
+    SceneNode* closest = nullptr;
+    float closestT = maxDistance;
+
+    m_spatialIndex.QueryRay(origin, direction, maxDistance, [&](uint32 proxyId, float) {
+        SceneNode* node = static_cast<SceneNode*>(m_spatialIndex.GetUserData(proxyId));
+        float t = 0.0f;
+        if (Math::RayIntersectsAABB(origin, invDir, closestT,
+            m_spatialEntries[node->m_spatialSlot].worldBounds, t))
+        {
+            closest = node;
+            closestT = t;
+        }
+        return closestT;
+    });
+
+    if (closest && outDistance)
+    {
+        *outDistance = closestT;
+    }
+    return closest;
+}
+
+RaycastHit SceneGraph::Raycast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction,
+    float maxDistance) const
+{
+    using namespace DirectX;
+
+    RaycastHit result;
+    result.distance = maxDistance;
+
+    m_spatialIndex.QueryRay(origin, direction, maxDistance, [&](uint32 proxyId, float) {
+        SceneNode* node = static_cast<SceneNode*>(m_spatialIndex.GetUserData(proxyId));
+        const MeshBVH* bvh = node->m_mesh->triangleBVH.get();
+        if (!bvh)
+            return result.distance;
+
+        // Into mesh space; the direction is not renormalized, so the ray
+        // parameter (and thus the hit distance) is the same in both spaces
+        const SpatialEntry& entry = m_spatialEntries[node->m_spatialSlot];
+        XMMATRIX invWorld = XMMatrixInverse(nullptr, XMLoadFloat4x4(&entry.world));
+        XMFLOAT3 localOrigin;
+        XMFLOAT3 localDirection;
+        XMStoreFloat3(&localOrigin, XMVector3TransformCoord(XMLoadFloat3(&origin), invWorld));
+        XMStoreFloat3(&localDirection, XMVector3TransformNormal(XMLoadFloat3(&direction), invWorld));
+
+        MeshBVH::Hit hit;
+        hit.distance = result.distance;
+        if (bvh->Raycast(localOrigin, localDirection, hit))
+        {
+            result.node = node;
+            result.triangle = hit.triangle;
+            result.u = hit.u;
+            result.v = hit.v;
+            result.distance = hit.distance;
+        }
+        return result.distance;
+    });
+
+    if (!result.node)
+    {
+        result.distance = FLT_MAX;
+    }
+    return result;
+}
+
+void SceneGraph::RaycastBatch(const DirectX::XMFLOAT3* origins, const DirectX::XMFLOAT3* directions,
+    uint32 count, RaycastHit* hits, float maxDistance) const
+{
+    using namespace DirectX;
+
+    for (uint32 base = 0; base < count; base += 4)
+    {
+        uint32 lanes = std::min<uint32>(4, count - base);
+        Math::RayPacket4 packet = Math::RayPacket4::Load(origins + base, directions + base, lanes);
+
+        // Per-lane closest distance; unused lanes get -1 so nothing hits them
+        MeshBVH::Hit laneHits[4];
+        for (uint32 lane = 0; lane < 4; ++lane)
+        {
+            laneHits[lane].distance = lane < lanes ? maxDistance : -1.0f;
+        }
+        SceneNode* laneNodes[4] = {};
+        XMVECTOR tBest = XMVectorSet(laneHits[0].distance, laneHits[1].distance,
+            laneHits[2].distance, laneHits[3].distance);
+
+        m_spatialIndex.Query(
+            [&](const Math::AABB& box) { return Math::AnyLane(packet.IntersectAABB(box, tBest)); },
+            [&](uint32 proxyId) {
+                SceneNode* node = static_cast<SceneNode*>(m_spatialIndex.GetUserData(proxyId));
+                const MeshBVH* bvh = node->m_mesh->triangleBVH.get();
+                if (!bvh)
+                    return true;
+
+                const SpatialEntry& entry = m_spatialEntries[node->m_spatialSlot];
+                XMMATRIX invWorld = XMMatrixInverse(nullptr, XMLoadFloat4x4(&entry.world));
+                XMFLOAT3 localOrigins[4];
+                XMFLOAT3 localDirections[4];
+                for (uint32 lane = 0; lane < lanes; ++lane)
+                {
+                    XMStoreFloat3(&localOrigins[lane],
+                        XMVector3TransformCoord(XMLoadFloat3(&origins[base + lane]), invWorld));
+                    XMStoreFloat3(&localDirections[lane],
+                        XMVector3TransformNormal(XMLoadFloat3(&directions[base + lane]), invWorld));
+                }
+
+                uint32 improved = bvh->Raycast4(
+                    Math::RayPacket4::Load(localOrigins, localDirections, lanes), laneHits);
+                if (improved)
+                {
+                    for (uint32 lane = 0; lane < 4; ++lane)
+                    {
+                        if (improved & (1u << lane))
+                            laneNodes[lane] = node;
+                    }
+                    tBest = XMVectorSet(laneHits[0].distance, laneHits[1].distance,
+                        laneHits[2].distance, laneHits[3].distance);
+                }
+                return true;
+            });
+
+        for (uint32 lane = 0; lane < lanes; ++lane)
+        {
+            RaycastHit& out = hits[base + lane];
+            out = RaycastHit();
+            if (laneNodes[lane])
+            {
+                out.node = laneNodes[lane];
+                out.triangle = laneHits[lane].triangle;
+                out.u = laneHits[lane].u;
+                out.v = laneHits[lane].v;
+                out.distance = laneHits[lane].distance;
+            }
+        }
+    }
 }
 
 } // namespace RRE
@@ -1,34 +1,233 @@
 #pragma once
 
 #include "Scene/SceneNode.h"
+#include "Scene/TransformHierarchy.h"
+#include "Scene/DynamicBVH.h"
+#include "Math/Frustum.h"
 #include "Core/Types.h"
+#include <cfloat>
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace RRE
 {
 
+class ThreadPool;
+
+// Result of SceneGraph::Raycast. Barycentrics follow MeshBVH::Hit
+// (P = (1 - u - v) * v0 + u * v1 + v * v2 of the hit triangle).
+struct RaycastHit
+{
+    SceneNode* node = nullptr;
+    uint32 triangle = 0;
+    float u = 0.0f;
+    float v = 0.0f;
+    float distance = FLT_MAX;
+
+    bool IsHit() const { return node != nullptr; }
+};
+
+// How SceneGraph resolves world matrices during traversal
+enum class SceneStorage
+{
+    Tree,   // walk the SceneNode pointer tree using per-node caches
+    Flat    // mirror the tree into a TransformHierarchy and update it linearly
+};
+
 class SceneGraph
 {
 public:
     SceneGraph();
     ~SceneGraph() = default;
 
+    // Nodes keep a back-pointer to their graph
+    SceneGraph(const SceneGraph&) = delete;
+    SceneGraph& operator=(const SceneGraph&) = delete;
+
     SceneNode* GetRoot() const { return m_root.get(); }
 
     // Depth-first traversal: visitor(node, worldMatrix)
+    // World matrices come from each node's cache and are only recomputed for
+    // nodes whose transform (or an ancestor's) changed since the last update.
+    // The walk uses an explicit stack, so hierarchy depth is not limited by
+    // the call stack. Any callable is accepted and inlined at the call site.
+    template <typename Fn>
+    void Traverse(Fn&& visitor) const;
+
+    // Type-erased overload (kept for callers that store a Visitor)
     using Visitor = std::function<void(SceneNode*, const DirectX::XMMATRIX&)>;
     void Traverse(const Visitor& visitor) const;
 
+    // Storage mode (Tree by default). Flat mode visits nodes in the same
+    // depth-first order but reads world matrices from contiguous arrays.
+    void SetStorage(SceneStorage storage) { m_storage = storage; }
+    SceneStorage GetStorage() const { return m_storage; }
+
+    // Optional worker pool for Flat mode: hierarchies with at least
+    // PARALLEL_UPDATE_THRESHOLD nodes update world matrices across the pool
+    static constexpr uint32 PARALLEL_UPDATE_THRESHOLD = 16384;
+    void SetThreadPool(ThreadPool* pool) { m_threadPool = pool; }
+
+    // Flat mirror of the tree; up to date after a Flat-mode Traverse
+    const TransformHierarchy& GetHierarchy() const { return m_hierarchy; }
+    const std::vector<SceneNode*>& GetHierarchyNodes() const { return m_hierarchyNodes; }
+
     // Sum of all mesh polygon counts
     uint32 GetTotalPolygonCount() const;
 
+    // Spatial index: a dynamic BVH over the world bounds of mesh nodes.
+    // Nodes are registered/unregistered as they are attached, detached or
+    // get a mesh; UpdateSpatialIndex refits bounds of nodes whose world
+    // matrix changed (in either storage mode) and must be called before
+    // querying each frame.
+    void UpdateSpatialIndex();
+    const DynamicBVH& GetSpatialIndex() const { return m_spatialIndex; }
+    uint32 GetSpatialNodeCount() const { return static_cast<uint32>(m_spatialEntries.size()); }
+
+    // Queries over the last UpdateSpatialIndex: fn(node, worldMatrix) for
+    // every mesh node whose world AABB intersects the volume
+    template <typename Fn>
+    void QueryFrustum(const Math::Frustum& frustum, Fn&& fn) const;
+    template <typename Fn>
+    void QuerySphere(const DirectX::XMFLOAT3& center, float radius, Fn&& fn) const;
+
+    // Closest mesh node whose world AABB the ray hits (nullptr if none)
+    SceneNode* PickNode(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction,
+        float maxDistance, float* outDistance = nullptr) const;
+
+    // Closest triangle hit. Node bounds reject early, then each candidate's
+    // Mesh::triangleBVH is tested in mesh-local space. Meshes without a
+    // triangle BVH are skipped. Distances are in units of |direction|.
+    RaycastHit Raycast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction,
+        float maxDistance = FLT_MAX) const;
+
+    // Same as Raycast for many rays; rays travel in packets of four through
+    // both BVH levels and are tested against triangles with SIMD.
+    void RaycastBatch(const DirectX::XMFLOAT3* origins, const DirectX::XMFLOAT3* directions,
+        uint32 count, RaycastHit* hits, float maxDistance = FLT_MAX) const;
+
 private:
-    void TraverseNode(SceneNode* node, const DirectX::XMMATRIX& parentWorld,
-        const Visitor& visitor) const;
-    uint32 CountPolygons(SceneNode* node) const;
+    friend class SceneNode;
+
+    struct SpatialEntry
+    {
+        SceneNode* node;
+        uint32 proxyId;                 // DynamicBVH::INVALID_INDEX until first update
+        bool boundsDirty;               // mesh changed since the last update
+        DirectX::XMFLOAT4X4 world;      // world matrix the bounds were computed from
+        Math::AABB worldBounds;         // tight bounds (the BVH stores fat ones)
+    };
+
+    // SceneNode notifications
+    void OnSubtreeAttached(SceneNode* node);
+    void OnSubtreeDetached(SceneNode* node);
+    void OnMeshChanged(SceneNode* node);
+    void AddSpatialEntry(SceneNode* node);
+    void RemoveSpatialEntry(SceneNode* node);
+
+    template <typename Fn>
+    void TraverseTree(Fn& visitor) const;
+    template <typename Fn>
+    void TraverseFlat(Fn& visitor) const;
+    void SyncHierarchy() const;
+    void RebuildHierarchy() const;
 
     std::unique_ptr<SceneNode> m_root;
+    SceneStorage m_storage = SceneStorage::Tree;
+    ThreadPool* m_threadPool = nullptr;  // non-owning
+    mutable std::vector<SceneNode*> m_traversalStack;    // TraverseTree scratch, capacity kept
+
+    // Flat mirror (rebuilt when the tree structure changes)
+    mutable TransformHierarchy m_hierarchy;
+    mutable std::vector<SceneNode*> m_hierarchyNodes;
+    mutable std::vector<uint32> m_hierarchyTransformVersions;
+    mutable std::vector<uint32> m_hierarchyStructureVersions;
+
+    // Spatial index (entries indexed by SceneNode::m_spatialSlot)
+    DynamicBVH m_spatialIndex;
+    std::vector<SpatialEntry> m_spatialEntries;
 };
 
+template <typename Fn>
+void SceneGraph::Traverse(Fn&& visitor) const
+{
+    if (!m_root)
+        return;
+
+    if (m_storage == SceneStorage::Flat)
+    {
+        TraverseFlat(visitor);
+        return;
+    }
+
+    TraverseTree(visitor);
+}
+
+template <typename Fn>
+void SceneGraph::TraverseTree(Fn& visitor) const
+{
+    // Borrow the scratch stack (a visitor that traverses again gets a fresh one)
+    std::vector<SceneNode*> stack = std::move(m_traversalStack);
+    stack.clear();
+    stack.push_back(m_root.get());
+
+    while (!stack.empty())
+    {
+        SceneNode* node = stack.back();
+        stack.pop_back();
+
+        // Parent was refreshed before its children, so the cache check is enough
+        node->UpdateWorldMatrix();
+        DirectX::XMMATRIX worldMatrix = DirectX::XMLoadFloat4x4(&node->GetCachedWorldMatrix());
+
+        visitor(node, worldMatrix);
+
+        // Push in reverse so children are visited in insertion order
+        const auto& children = node->GetChildren();
+        for (auto it = children.rbegin(); it != children.rend(); ++it)
+        {
+            stack.push_back(it->get());
+        }
+    }
+    m_traversalStack = std::move(stack);
+}
+
+template <typename Fn>
+void SceneGraph::TraverseFlat(Fn& visitor) const
+{
+    SyncHierarchy();
+
+    uint32 count = m_hierarchy.GetCount();
+    for (uint32 i = 0; i < count; ++i)
+    {
+        DirectX::XMMATRIX worldMatrix = DirectX::XMLoadFloat4x4(&m_hierarchy.GetWorldMatrix(i));
+        visitor(m_hierarchyNodes[i], worldMatrix);
+    }
+}
+
+template <typename Fn>
+void SceneGraph::QueryFrustum(const Math::Frustum& frustum, Fn&& fn) const
+{
+    m_spatialIndex.QueryFrustum(frustum, [&](uint32 proxyId) {
+        SceneNode* node = static_cast<SceneNode*>(m_spatialIndex.GetUserData(proxyId));
+        const SpatialEntry& entry = m_spatialEntries[node->m_spatialSlot];
+        if (frustum.IntersectsAABB(entry.worldBounds))
+            fn(node, DirectX::XMLoadFloat4x4(&entry.world));
+        return true;
+    });
+}
+
+template <typename Fn>
+void SceneGraph::QuerySphere(const DirectX::XMFLOAT3& center, float radius, Fn&& fn) const
+{
+    m_spatialIndex.QuerySphere(center, radius, [&](uint32 proxyId) {
+        SceneNode* node = static_cast<SceneNode*>(m_spatialIndex.GetUserData(proxyId));
+        const SpatialEntry& entry = m_spatialEntries[node->m_spatialSlot];
+        if (Math::SphereOverlapsAABB(center, radius, entry.worldBounds))
+            fn(node, DirectX::XMLoadFloat4x4(&entry.world));
+        return true;
+    });
+}
+
 } // namespace RRE
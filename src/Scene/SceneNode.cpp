@@ -1,13 +1,37 @@
 #include "Scene/SceneNode.h"
+#include "Scene/SceneGraph.h"
 
 namespace RRE
 {
 
+SceneNode::~SceneNode()
+{
+    // Release the subtree iteratively so deep chains don't recurse through
+    // nested unique_ptr destructors
+    std::vector<std::unique_ptr<SceneNode>> pending = std::move(m_children);
+    while (!pending.empty())
+    {
+        std::unique_ptr<SceneNode> node = std::move(pending.back());
+        pending.pop_back();
+        for (auto& child : node->m_children)
+        {
+            pending.push_back(std::move(child));
+        }
+        node->m_children.clear();
+    }
+}
+
 SceneNode* SceneNode::AddChild(std::unique_ptr<SceneNode> child)
 {
     child->m_parent = this;
+    child->m_cacheValid = false;
     SceneNode* rawPtr = child.get();
     m_children.push_back(std::move(child));
+    MarkStructureChanged();
+    if (m_graph)
+    {
+        m_graph->OnSubtreeAttached(rawPtr);
+    }
     return rawPtr;
 }
 
@@ -17,25 +41,89 @@ std::unique_ptr<SceneNode> SceneNode::RemoveChild(SceneNode* child)
     {
         if (it->get() == child)
         {
+            if (m_graph)
+            {
+                m_graph->OnSubtreeDetached(child);
+            }
             child->m_parent = nullptr;
+            child->m_cacheValid = false;
             std::unique_ptr<SceneNode> removed = std::move(*it);
             m_children.erase(it);
+            MarkStructureChanged();
             return removed;
         }
     }
     return nullptr;
 }
 
+void SceneNode::SetMesh(const Mesh* mesh)
+{
+    if (m_mesh == mesh)
+        return;
+
+    m_mesh = mesh;
+    if (m_graph)
+    {
+        m_graph->OnMeshChanged(this);
+    }
+}
+
+void SceneNode::MarkStructureChanged()
+{
+    m_structureVersion++;
+}
+
 DirectX::XMMATRIX SceneNode::GetWorldMatrix() const
 {
-    DirectX::XMMATRIX localMatrix = m_localTransform.GetLocalMatrix();
+    RefreshWorldMatrix();
+    return DirectX::XMLoadFloat4x4(&m_worldMatrix);
+}
+
+void SceneNode::RefreshWorldMatrix() const
+{
+    // Collect the ancestor chain, then update top-down without recursion
+    std::vector<const SceneNode*> chain;
+    for (const SceneNode* node = this; node; node = node->m_parent)
+    {
+        chain.push_back(node);
+    }
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+    {
+        (*it)->UpdateWorldMatrix();
+    }
+}
 
+bool SceneNode::UpdateWorldMatrix() const
+{
+    uint32 transformVersion = m_localTransform.GetVersion();
+    uint64 parentGeneration = m_parent ? m_parent->m_worldGeneration : 0;
+
+    bool localDirty = !m_cacheValid || m_cachedTransformVersion != transformVersion;
+    if (!localDirty && m_cachedParentGeneration == parentGeneration)
+        return false;
+
+    // Only rebuild the TRS product when this node's own transform changed
+    if (localDirty)
+    {
+        DirectX::XMStoreFloat4x4(&m_localMatrix, m_localTransform.GetLocalMatrix());
+        m_cachedTransformVersion = transformVersion;
+    }
+
+    DirectX::XMMATRIX localMatrix = DirectX::XMLoadFloat4x4(&m_localMatrix);
     if (m_parent)
     {
-        return localMatrix * m_parent->GetWorldMatrix();
+        DirectX::XMMATRIX parentWorld = DirectX::XMLoadFloat4x4(&m_parent->m_worldMatrix);
+        DirectX::XMStoreFloat4x4(&m_worldMatrix, localMatrix * parentWorld);
+    }
+    else
+    {
+        m_worldMatrix = m_localMatrix;
     }
 
-    return localMatrix;
+    m_cachedParentGeneration = parentGeneration;
+    m_cacheValid = true;
+    m_worldGeneration++;
+    return true;
 }
 
 } // namespace RRE
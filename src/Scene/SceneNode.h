@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Scene/Transform.h"
+#include "Core/Types.h"
 #include <DirectXMath.h>
 #include <vector>
 #include <memory>
@@ -9,12 +10,13 @@ namespace RRE
 {
 
 class Mesh;
+class SceneGraph;
 
 class SceneNode
 {
 public:
     SceneNode() = default;
-    ~SceneNode() = default;
+    ~SceneNode();
 
     // Tree operations
     SceneNode* AddChild(std::unique_ptr<SceneNode> child);
@@ -22,22 +24,57 @@ public:
     SceneNode* GetParent() const { return m_parent; }
     const std::vector<std::unique_ptr<SceneNode>>& GetChildren() const { return m_children; }
 
-    // World matrix: parent's world matrix * local matrix (recursive)
+    // Incremented whenever a child is added to or removed from this node
+    // (O(1); observers compare it per node instead of per subtree)
+    uint32 GetStructureVersion() const { return m_structureVersion; }
+
+    // World matrix: parent's world matrix * local matrix.
+    // Refreshes stale ancestors first, then returns the cached result.
     DirectX::XMMATRIX GetWorldMatrix() const;
 
+    // Recompute the cached world matrix if the local transform or the parent's
+    // world matrix changed. Assumes the parent cache is already up to date
+    // (top-down traversal). Returns true if the world matrix was recomputed.
+    bool UpdateWorldMatrix() const;
+
+    // Cached world matrix as of the last update (no staleness check)
+    const DirectX::XMFLOAT4X4& GetCachedWorldMatrix() const { return m_worldMatrix; }
+
+    // Incremented every time the cached world matrix is recomputed
+    uint64 GetWorldGeneration() const { return m_worldGeneration; }
+
     // Transform
     Transform& GetTransform() { return m_localTransform; }
     const Transform& GetTransform() const { return m_localTransform; }
 
     // Mesh (nullable)
-    void SetMesh(Mesh* mesh) { m_mesh = mesh; }
-    Mesh* GetMesh() const { return m_mesh; }
+    void SetMesh(const Mesh* mesh);
+    const Mesh* GetMesh() const { return m_mesh; }
+
+    // Owning graph (nullptr while detached)
+    SceneGraph* GetGraph() const { return m_graph; }
 
 private:
+    friend class SceneGraph;
+
+    void RefreshWorldMatrix() const;
+    void MarkStructureChanged();
+
     Transform m_localTransform;
-    Mesh* m_mesh = nullptr;
+    const Mesh* m_mesh = nullptr;
     SceneNode* m_parent = nullptr;
     std::vector<std::unique_ptr<SceneNode>> m_children;
+    uint32 m_structureVersion = 0;
+    SceneGraph* m_graph = nullptr;
+    uint32 m_spatialSlot = UINT32_MAX;   // index into the graph's spatial entries
+
+    // Matrix cache (lazily refreshed, hence mutable)
+    mutable DirectX::XMFLOAT4X4 m_localMatrix = {};
+    mutable DirectX::XMFLOAT4X4 m_worldMatrix = {};
+    mutable uint32 m_cachedTransformVersion = 0;
+    mutable uint64 m_cachedParentGeneration = 0;
+    mutable uint64 m_worldGeneration = 0;
+    mutable bool m_cacheValid = false;   // cleared on reparent
 };
 
 } // namespace RRE
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Core/Types.h"
 #include <DirectXMath.h>
 
 namespace RRE
@@ -13,18 +14,31 @@ public:
 
     DirectX::XMMATRIX GetLocalMatrix() const;
 
-    void SetPosition(const DirectX::XMFLOAT3& pos) { m_position = pos; }
-    void SetRotation(const DirectX::XMFLOAT3& rot) { m_rotation = rot; }
-    void SetScale(const DirectX::XMFLOAT3& s) { m_scale = s; }
+    // Setters only bump the version when the value actually changes
+    void SetPosition(const DirectX::XMFLOAT3& pos) { Assign(m_position, pos); }
+    void SetRotation(const DirectX::XMFLOAT3& rot) { Assign(m_rotation, rot); }
+    void SetScale(const DirectX::XMFLOAT3& s) { Assign(m_scale, s); }
 
     const DirectX::XMFLOAT3& GetPosition() const { return m_position; }
     const DirectX::XMFLOAT3& GetRotation() const { return m_rotation; }
     const DirectX::XMFLOAT3& GetScale() const { return m_scale; }
 
+    // Incremented on every effective change (used for matrix caching)
+    uint32 GetVersion() const { return m_version; }
+
 private:
+    void Assign(DirectX::XMFLOAT3& dst, const DirectX::XMFLOAT3& src)
+    {
+        if (dst.x == src.x && dst.y == src.y && dst.z == src.z)
+            return;
+        dst = src;
+        m_version++;
+    }
+
     DirectX::XMFLOAT3 m_position = { 0.0f, 0.0f, 0.0f };
     DirectX::XMFLOAT3 m_rotation = { 0.0f, 0.0f, 0.0f }; // Euler angles in radians
     DirectX::XMFLOAT3 m_scale    = { 1.0f, 1.0f, 1.0f };
+    uint32 m_version = 0;
 };
 
 } // namespace RRE
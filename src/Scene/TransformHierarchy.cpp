@@ -0,0 +1,169 @@
+#include "Scene/TransformHierarchy.h"
+#include "Core/ThreadPool.h"
+#include "Math/MathUtil.h"
+#include <algorithm>
+#include <atomic>
+
+using namespace DirectX;
+
+namespace RRE
+{
+
+void TransformHierarchy::Clear()
+{
+    m_positions.clear();
+    m_rotations.clear();
+    m_scales.clear();
+    m_parents.clear();
+    m_depths.clear();
+    m_meshes.clear();
+    m_flags.clear();
+    m_localMatrices.clear();
+    m_worldMatrices.clear();
+    m_levelNodes.clear();
+    m_levelOffsets.clear();
+    m_levelsDirty = true;
+}
+
+void TransformHierarchy::Reserve(uint32 count)
+{
+    m_positions.reserve(count);
+    m_rotations.reserve(count);
+    m_scales.reserve(count);
+    m_parents.reserve(count);
+    m_depths.reserve(count);
+    m_meshes.reserve(count);
+    m_flags.reserve(count);
+    m_localMatrices.reserve(count);
+    m_worldMatrices.reserve(count);
+}
+
+uint32 TransformHierarchy::AddNode(uint32 parentIndex, const XMFLOAT3& position,
+    const XMFLOAT3& rotation, const XMFLOAT3& scale, const Mesh* mesh)
+{
+    // Enforce parent-before-child ordering
+    if (parentIndex != INVALID_INDEX && parentIndex >= GetCount())
+        return INVALID_INDEX;
+
+    uint32 index = GetCount();
+    m_positions.push_back(position);
+    m_rotations.push_back(rotation);
+    m_scales.push_back(scale);
+    m_parents.push_back(parentIndex);
+    m_depths.push_back(parentIndex != INVALID_INDEX ? m_depths[parentIndex] + 1 : 0);
+    m_meshes.push_back(mesh);
+    m_flags.push_back(LOCAL_DIRTY);
+    m_localMatrices.emplace_back();
+    m_worldMatrices.emplace_back();
+    m_levelsDirty = true;
+    return index;
+}
+
+uint32 TransformHierarchy::UpdateWorldMatrices()
+{
+    uint32 count = GetCount();
+    uint32 updated = 0;
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        if (UpdateNode(i))
+            updated++;
+    }
+
+    return updated;
+}
+
+uint32 TransformHierarchy::UpdateWorldMatricesParallel(ThreadPool& pool, uint32 minNodesPerTask)
+{
+    if (m_levelsDirty)
+        BuildLevels();
+
+    // Nodes within one depth level never depend on each other, and every
+    // parent lives in an earlier level, so levels are processed in order
+    std::atomic<uint32> updated{ 0 };
+    uint32 levelCount = static_cast<uint32>(m_levelOffsets.size()) - 1;
+
+    for (uint32 level = 0; level < levelCount; ++level)
+    {
+        const uint32* levelNodes = m_levelNodes.data() + m_levelOffsets[level];
+        uint32 levelSize = m_levelOffsets[level + 1] - m_levelOffsets[level];
+
+        pool.ParallelFor(levelSize, minNodesPerTask, [&](uint32 begin, uint32 end) {
+            uint32 localUpdated = 0;
+            for (uint32 i = begin; i < end; ++i)
+            {
+                if (UpdateNode(levelNodes[i]))
+                    localUpdated++;
+            }
+            updated.fetch_add(localUpdated, std::memory_order_relaxed);
+        });
+    }
+
+    return updated.load();
+}
+
+void TransformHierarchy::BuildLevels()
+{
+    // Counting sort by depth keeps ascending index order inside each level
+    uint32 count = GetCount();
+    uint32 maxDepth = 0;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        maxDepth = std::max(maxDepth, m_depths[i]);
+    }
+
+    uint32 levelCount = count > 0 ? maxDepth + 1 : 0;
+    m_levelOffsets.assign(levelCount + 1, 0);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        m_levelOffsets[m_depths[i] + 1]++;
+    }
+    for (uint32 level = 0; level < levelCount; ++level)
+    {
+        m_levelOffsets[level + 1] += m_levelOffsets[level];
+    }
+
+    std::vector<uint32> cursor(m_levelOffsets.begin(), m_levelOffsets.end() - 1);
+    m_levelNodes.resize(count);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        m_levelNodes[cursor[m_depths[i]]++] = i;
+    }
+
+    m_levelsDirty = false;
+}
+
+bool TransformHierarchy::UpdateNode(uint32 i)
+{
+    uint32 parent = m_parents[i];
+    bool localDirty = (m_flags[i] & LOCAL_DIRTY) != 0;
+    bool parentUpdated = parent != INVALID_INDEX && (m_flags[parent] & WORLD_UPDATED) != 0;
+
+    if (!localDirty && !parentUpdated)
+    {
+        m_flags[i] = 0;
+        return false;
+    }
+
+    if (localDirty)
+    {
+        XMStoreFloat4x4(&m_localMatrices[i],
+            Math::CreateTRSMatrix(m_positions[i], m_rotations[i], m_scales[i]));
+    }
+
+    if (parent != INVALID_INDEX)
+    {
+        XMMATRIX local = XMLoadFloat4x4(&m_localMatrices[i]);
+        XMMATRIX parentWorld = XMLoadFloat4x4(&m_worldMatrices[parent]);
+        XMStoreFloat4x4(&m_worldMatrices[i], local * parentWorld);
+    }
+    else
+    {
+        m_worldMatrices[i] = m_localMatrices[i];
+    }
+
+    m_flags[i] = WORLD_UPDATED;
+    return true;
+}
+
+} // namespace RRE
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Core/Types.h"
+#include <DirectXMath.h>
+#include <vector>
+
+namespace RRE
+{
+
+class Mesh;
+class ThreadPool;
+
+// Flat structure-of-arrays transform storage.
+// Nodes are stored parent-before-child (a node's parent index is always lower
+// than its own), so world matrices can be resolved in one linear pass.
+class TransformHierarchy
+{
+public:
+    static constexpr uint32 INVALID_INDEX = UINT32_MAX;
+
+    TransformHierarchy() = default;
+    ~TransformHierarchy() = default;
+
+    void Clear();
+    void Reserve(uint32 count);
+
+    // Append a node. parentIndex must refer to an existing node (or INVALID_INDEX
+    // for a root). Returns the new node index, or INVALID_INDEX on bad parent.
+    uint32 AddNode(uint32 parentIndex,
+        const DirectX::XMFLOAT3& position = { 0.0f, 0.0f, 0.0f },
+        const DirectX::XMFLOAT3& rotation = { 0.0f, 0.0f, 0.0f },
+        const DirectX::XMFLOAT3& scale = { 1.0f, 1.0f, 1.0f },
+        const Mesh* mesh = nullptr);
+
+    uint32 GetCount() const { return static_cast<uint32>(m_parents.size()); }
+
+    // Per-node streams
+    void SetPosition(uint32 index, const DirectX::XMFLOAT3& pos) { m_positions[index] = pos; m_flags[index] |= LOCAL_DIRTY; }
+    void SetRotation(uint32 index, const DirectX::XMFLOAT3& rot) { m_rotations[index] = rot; m_flags[index] |= LOCAL_DIRTY; }
+    void SetScale(uint32 index, const DirectX::XMFLOAT3& s) { m_scales[index] = s; m_flags[index] |= LOCAL_DIRTY; }
+    void SetMesh(uint32 index, const Mesh* mesh) { m_meshes[index] = mesh; }
+
+    const DirectX::XMFLOAT3& GetPosition(uint32 index) const { return m_positions[index]; }
+    const DirectX::XMFLOAT3& GetRotation(uint32 index) const { return m_rotations[index]; }
+    const DirectX::XMFLOAT3& GetScale(uint32 index) const { return m_scales[index]; }
+    uint32 GetParent(uint32 index) const { return m_parents[index]; }
+    const Mesh* GetMesh(uint32 index) const { return m_meshes[index]; }
+
+    // World matrices as of the last UpdateWorldMatrices()
+    const DirectX::XMFLOAT4X4& GetWorldMatrix(uint32 index) const { return m_worldMatrices[index]; }
+    const std::vector<DirectX::XMFLOAT4X4>& GetWorldMatrices() const { return m_worldMatrices; }
+
+    // Linear pass: recompute world matrices of nodes whose local transform
+    // changed or whose parent was recomputed. Returns the recomputed count.
+    uint32 UpdateWorldMatrices();
+
+    // Same result as UpdateWorldMatrices() (bit-for-bit), computed level by
+    // level across the pool. Levels smaller than minNodesPerTask run inline.
+    uint32 UpdateWorldMatricesParallel(ThreadPool& pool, uint32 minNodesPerTask = 1024);
+
+    uint32 GetDepth(uint32 index) const { return m_depths[index]; }
+
+private:
+    bool UpdateNode(uint32 index);
+    void BuildLevels();
+
+    static constexpr uint8 LOCAL_DIRTY   = 1 << 0;  // TRS changed since last update
+    static constexpr uint8 WORLD_UPDATED = 1 << 1;  // world recomputed in the last pass
+
+    std::vector<DirectX::XMFLOAT3> m_positions;
+    std::vector<DirectX::XMFLOAT3> m_rotations;
+    std::vector<DirectX::XMFLOAT3> m_scales;
+    std::vector<uint32> m_parents;
+    std::vector<uint32> m_depths;
+    std::vector<const Mesh*> m_meshes;
+    std::vector<uint8> m_flags;
+    std::vector<DirectX::XMFLOAT4X4> m_localMatrices;
+    std::vector<DirectX::XMFLOAT4X4> m_worldMatrices;
+
+    // Node indices bucketed by depth (rebuilt lazily after AddNode/Clear)
+    std::vector<uint32> m_levelNodes;
+    std::vector<uint32> m_levelOffsets;
+    bool m_levelsDirty = true;
+};
+
+} // namespace RRE
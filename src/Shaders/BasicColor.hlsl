@@ -17,14 +17,25 @@ cbuffer PerObjectCB : register(b0)
     float Kq;
     float Unlit;
     float3 ColorOverride;
-    float _pad6;
+    float Instanced;
+    float3 PositionOffset;
+    float CompactVertices;
+    float3 PositionScale;
+    float _pad5;
 };
 
+// Per-instance world matrices (read instead of World when Instanced is set)
+StructuredBuffer<float4x4> InstanceWorlds : register(t0);
+
+// Either input layout: Vertex (float3 position, float4 color, float3 normal)
+// or CompactVertex (unorm16 position within PositionOffset/Scale, RGBA8
+// color, octahedral normal in normal.xy as snorm16)
 struct VSInput
 {
     float3 position : POSITION;
     float4 color    : COLOR;
     float3 normal   : NORMAL;
+    uint instanceId : SV_InstanceID;
 };
 
 struct PSInput
@@ -35,14 +46,33 @@ struct PSInput
     float3 worldPos  : TEXCOORD0;
 };
 
+// Octahedral unit vector folded into [-1, 1]^2
+float3 DecodeOctahedral(float2 e)
+{
+    float3 n = float3(e, 1.0f - abs(e.x) - abs(e.y));
+    float t = saturate(-n.z);
+    n.xy += n.xy >= 0.0f ? -t : t;
+    return normalize(n);
+}
+
 PSInput VSMain(VSInput input)
 {
     PSInput output;
 
-    float4 worldPos = mul(float4(input.position, 1.0f), World);
+    float3 position = input.position;
+    float3 normal = input.normal;
+    if (CompactVertices > 0.5f)
+    {
+        position = PositionOffset + position * PositionScale;
+        normal = DecodeOctahedral(input.normal.xy);
+    }
+
+    float4x4 world = Instanced > 0.5f ? InstanceWorlds[input.instanceId] : World;
+
+    float4 worldPos = mul(float4(position, 1.0f), world);
     output.worldPos = worldPos.xyz;
     output.position = mul(worldPos, ViewProj);
-    output.normal = normalize(mul(input.normal, (float3x3)World));
+    output.normal = normalize(mul(normal, (float3x3)world));
     output.color = input.color;
 
     return output;
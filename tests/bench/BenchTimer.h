@@ -0,0 +1,39 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// Minimal timing helpers for the DISABLED_ benchmark tests.
+// Run with --gtest_also_run_disabled_tests --gtest_filter=*Bench*
+
+namespace RRE
+{
+namespace Bench
+{
+
+// Run fn `iterations` times and return the median wall time in microseconds
+template <typename Fn>
+double MedianMicroseconds(int iterations, Fn&& fn)
+{
+    std::vector<double> samples;
+    samples.reserve(iterations);
+    for (int i = 0; i < iterations; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+inline void Report(const char* name, double microseconds)
+{
+    std::printf("[ BENCH    ] %-40s %12.1f us\n", name, microseconds);
+}
+
+} // namespace Bench
+} // namespace RRE
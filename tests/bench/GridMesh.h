@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Core/Types.h"
+#include <array>
+#include <vector>
+
+// Index helpers for the n x n quad grid the tests and benchmarks build over
+// (n + 1)^2 row-major positions
+
+namespace RRE
+{
+namespace GridMesh
+{
+
+// Corners of quad (x, y), counter-clockwise from its lowest index
+inline std::array<uint32, 4> Quad(uint32 n, uint32 x, uint32 y)
+{
+    uint32 i = y * (n + 1) + x;
+    return { i, i + 1, i + n + 2, i + n + 1 };
+}
+
+// Two faces per quad, split along the corner 1 - corner 3 diagonal, in row order
+inline std::vector<std::array<uint32, 3>> Faces(uint32 n)
+{
+    std::vector<std::array<uint32, 3>> faces;
+    faces.reserve(static_cast<size_t>(n) * n * 2);
+    for (uint32 y = 0; y < n; ++y)
+    {
+        for (uint32 x = 0; x < n; ++x)
+        {
+            std::array<uint32, 4> q = Quad(n, x, y);
+            faces.push_back({ q[0], q[3], q[1] });
+            faces.push_back({ q[1], q[3], q[2] });
+        }
+    }
+    return faces;
+}
+
+} // namespace GridMesh
+} // namespace RRE
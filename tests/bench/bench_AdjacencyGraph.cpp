@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "Renderer/AdjacencyGraph.h"
+#include "BenchTimer.h"
+#include "GridMesh.h"
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+
+using namespace RRE;
+
+namespace
+{
+
+// The std::map builder AdjacencyGraph replaced, for comparison
+std::vector<std::vector<uint32>> BuildMapAdjacency(const std::vector<std::array<uint32, 3>>& faces)
+{
+    std::vector<std::vector<uint32>> adjacency(faces.size());
+    std::map<std::pair<uint32, uint32>, std::vector<uint32>> edgeToFaces;
+    for (uint32 f = 0; f < faces.size(); ++f)
+    {
+        for (int e = 0; e < 3; ++e)
+        {
+            uint32 a = faces[f][e];
+            uint32 b = faces[f][(e + 1) % 3];
+            edgeToFaces[{ std::min(a, b), std::max(a, b) }].push_back(f);
+        }
+    }
+    for (auto& pair : edgeToFaces)
+    {
+        auto& faceList = pair.second;
+        for (size_t i = 0; i < faceList.size(); ++i)
+        {
+            for (size_t j = i + 1; j < faceList.size(); ++j)
+            {
+                adjacency[faceList[i]].push_back(faceList[j]);
+                adjacency[faceList[j]].push_back(faceList[i]);
+            }
+        }
+    }
+    for (auto& adj : adjacency)
+    {
+        std::sort(adj.begin(), adj.end());
+        adj.erase(std::unique(adj.begin(), adj.end()), adj.end());
+    }
+    return adjacency;
+}
+
+void RunAdjacencyBench(uint32 n, bool withMap)
+{
+    auto faces = GridMesh::Faces(n);
+    std::string faceCount = std::to_string(faces.size()) + " faces";
+    int iterations = faces.size() >= 10000000 ? 3 : 5;
+
+    size_t neighbors = 0;
+    double csr = Bench::MedianMicroseconds(iterations, [&]() {
+        neighbors = AdjacencyGraph::FromFaceEdges(faces).neighbors.size();
+    });
+    Bench::Report(("csr, " + faceCount).c_str(), csr);
+    EXPECT_EQ(neighbors, faces.size() * 3 - n * 4);
+
+    if (!withMap)
+        return;
+    double map = Bench::MedianMicroseconds(iterations, [&]() {
+        neighbors = BuildMapAdjacency(faces).size();
+    });
+    Bench::Report(("std::map, " + faceCount).c_str(), map);
+}
+
+} // anonymous namespace
+
+// Grids of about 10k, 100k, 1M and 10M faces; the map baseline stops at 1M
+TEST(AdjacencyGraphBench, DISABLED_Faces10k) { RunAdjacencyBench(71, true); }
+TEST(AdjacencyGraphBench, DISABLED_Faces100k) { RunAdjacencyBench(224, true); }
+TEST(AdjacencyGraphBench, DISABLED_Faces1M) { RunAdjacencyBench(708, true); }
+TEST(AdjacencyGraphBench, DISABLED_Faces10M) { RunAdjacencyBench(2237, false); }
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "Renderer/FaceColorPalette.h"
+#include "Core/ThreadPool.h"
+#include "BenchTimer.h"
+#include "GridMesh.h"
+#include <array>
+#include <cstdio>
+#include <random>
+#include <string>
+
+using namespace RRE;
+
+namespace
+{
+
+// n x n quads over shared positions; irregular flips random diagonals and
+// shuffles the position numbering, so greedy order has no structure to use
+std::vector<std::array<uint32, 3>> MakeGridFaces(uint32 n, bool irregular)
+{
+    std::mt19937 rng(9);
+    std::vector<uint32> remap((n + 1) * (n + 1));
+    for (uint32 i = 0; i < remap.size(); ++i)
+    {
+        remap[i] = i;
+    }
+    if (irregular)
+        std::shuffle(remap.begin(), remap.end(), rng);
+
+    std::vector<std::array<uint32, 3>> faces = GridMesh::Faces(n);
+    for (auto& face : faces)
+    {
+        for (uint32& index : face)
+        {
+            index = remap[index];
+        }
+    }
+    if (irregular)
+    {
+        // Faces come in quad pairs { a, d, b }, { b, d, c }
+        for (size_t f = 0; f < faces.size(); f += 2)
+        {
+            if (rng() & 1)
+            {
+                uint32 a = faces[f][0], b = faces[f][2], c = faces[f + 1][2], d = faces[f][1];
+                faces[f] = { a, d, c };
+                faces[f + 1] = { a, c, b };
+            }
+        }
+    }
+    return faces;
+}
+
+void Report(const std::string& label, double microseconds, const std::vector<uint32>& colors)
+{
+    Bench::Report(label.c_str(), microseconds);
+    std::printf("[ BENCH    ] %s: %u colors\n", label.c_str(), FaceColorPalette::CountColors(colors));
+}
+
+// Position graphs (valence about 6) are the hard case; face graphs of
+// manifold meshes have at most 3 neighbors
+void RunFaceColoringBench(uint32 n, bool irregular)
+{
+    auto faces = MakeGridFaces(n, irregular);
+    uint32 positionCount = (n + 1) * (n + 1);
+    AdjacencyGraph graph = AdjacencyGraph::FromPositionEdges(faces, positionCount);
+    std::string name = std::to_string(positionCount) + (irregular ? " irregular" : " grid") + " positions, ";
+    ThreadPool pool;
+
+    std::vector<uint32> colors;
+    double time = Bench::MedianMicroseconds(5, [&]() {
+        colors.assign(graph.size(), UINT32_MAX);
+        FaceColorPalette::RepairFaceColors(graph, colors);
+    });
+    Report(name + "greedy", time, colors);
+
+    time = Bench::MedianMicroseconds(5, [&]() { colors = FaceColorPalette::AssignFaceColorsDSATUR(graph); });
+    Report(name + "DSATUR", time, colors);
+
+    time = Bench::MedianMicroseconds(5, [&]() { colors = FaceColorPalette::AssignFaceColorsParallel(graph, pool); });
+    Report(name + "parallel", time, colors);
+}
+
+} // anonymous namespace
+
+TEST(FaceColoringBench, DISABLED_Grid1M) { RunFaceColoringBench(1000, false); }
+TEST(FaceColoringBench, DISABLED_Irregular1M) { RunFaceColoringBench(1000, true); }
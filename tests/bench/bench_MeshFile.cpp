@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "Renderer/MeshFile.h"
+#include "Renderer/MeshFactory.h"
+#include "BenchTimer.h"
+#include <cstdio>
+#include <string>
+
+using namespace RRE;
+
+namespace
+{
+
+// Reads every 64th byte of the level's streams, faulting each page in
+uint64 TouchStreams(const MeshFile::LevelView& view)
+{
+    uint64 sum = 0;
+    const uint8* vertices = reinterpret_cast<const uint8*>(view.vertices);
+    for (uint64 i = 0; i < uint64(view.vertexCount) * sizeof(Vertex); i += 64)
+    {
+        sum += vertices[i];
+    }
+    for (uint32 i = 0; i < view.indexCount; i += 16)
+    {
+        sum += view.indices16 ? view.indices16[i] : view.indices[i];
+    }
+    return sum;
+}
+
+} // anonymous namespace
+
+// About 50 MB on disk: 525k vertices, 1M triangles with adjacency
+TEST(MeshFileBench, DISABLED_LoadVersusGenerate)
+{
+    double generate = Bench::MedianMicroseconds(3, []() {
+        Mesh mesh = MeshFactory::CreateSphere(1024, 512, MeshShading::Smooth);
+    });
+    Bench::Report("generate sphere 1024x512", generate);
+
+    Mesh mesh = MeshFactory::CreateSphere(1024, 512, MeshShading::Smooth);
+    std::string path = ::testing::TempDir() + "mesh_file_bench.rrm";
+    ASSERT_TRUE(MeshFile::Write(path.c_str(), mesh));
+
+    double write = Bench::MedianMicroseconds(3, [&]() { MeshFile::Write(path.c_str(), mesh); });
+    Bench::Report("write", write);
+
+    double open = Bench::MedianMicroseconds(5, [&]() {
+        MeshFile file;
+        file.Open(path.c_str());
+    });
+    Bench::Report("open (map + validate)", open);
+
+    uint64 sum = 0;
+    double touch = Bench::MedianMicroseconds(5, [&]() {
+        MeshFile file;
+        file.Open(path.c_str());
+        sum += TouchStreams(file.GetLevel(0));
+    });
+    Bench::Report("open + fault in vertex/index streams", touch);
+
+    double copy = Bench::MedianMicroseconds(5, [&]() {
+        MeshFile file;
+        file.Open(path.c_str());
+        Mesh loaded;
+        file.Load(loaded);
+    });
+    Bench::Report("open + Load (copy into Mesh)", copy);
+
+    std::printf("[ BENCH    ] checksum %llu\n", static_cast<unsigned long long>(sum));
+    std::remove(path.c_str());
+}
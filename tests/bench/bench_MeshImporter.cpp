@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "Renderer/MeshImporter.h"
+#include "Core/ThreadPool.h"
+#include "BenchTimer.h"
+#include "GridMesh.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace DirectX;
+using namespace RRE;
+
+namespace
+{
+
+// n x n grid of quads split into triangles, as OBJ text
+void WriteGridObj(const std::string& path, uint32 n)
+{
+    FILE* file = std::fopen(path.c_str(), "wb");
+    for (uint32 y = 0; y <= n; ++y)
+    {
+        for (uint32 x = 0; x <= n; ++x)
+        {
+            std::fprintf(file, "v %.6f %.6f %.6f\n", x * 0.001, y * 0.001, 0.01 * ((x * 7 + y * 3) % 13));
+        }
+    }
+    for (uint32 y = 0; y < n; ++y)
+    {
+        for (uint32 x = 0; x < n; ++x)
+        {
+            std::array<uint32, 4> q = GridMesh::Quad(n, x, y);
+            std::fprintf(file, "f %u %u %u\nf %u %u %u\n",
+                q[0] + 1, q[1] + 1, q[2] + 1, q[0] + 1, q[2] + 1, q[3] + 1);
+        }
+    }
+    std::fclose(file);
+}
+
+// The same grid as binary little-endian PLY
+void WriteGridPly(const std::string& path, uint32 n)
+{
+    FILE* file = std::fopen(path.c_str(), "wb");
+    std::fprintf(file, "ply\nformat binary_little_endian 1.0\nelement vertex %u\n"
+        "property float x\nproperty float y\nproperty float z\nelement face %u\n"
+        "property list uchar int vertex_indices\nend_header\n", (n + 1) * (n + 1), 2 * n * n);
+    for (uint32 y = 0; y <= n; ++y)
+    {
+        for (uint32 x = 0; x <= n; ++x)
+        {
+            float position[3] = { x * 0.001f, y * 0.001f, 0.01f * ((x * 7 + y * 3) % 13) };
+            std::fwrite(position, sizeof(position), 1, file);
+        }
+    }
+    for (uint32 y = 0; y < n; ++y)
+    {
+        for (uint32 x = 0; x < n; ++x)
+        {
+            std::array<uint32, 4> q = GridMesh::Quad(n, x, y);
+            int32 faces[2][3] = {
+                { static_cast<int32>(q[0]), static_cast<int32>(q[1]), static_cast<int32>(q[2]) },
+                { static_cast<int32>(q[0]), static_cast<int32>(q[2]), static_cast<int32>(q[3]) } };
+            for (const auto& face : faces)
+            {
+                uint8 count = 3;
+                std::fwrite(&count, 1, 1, file);
+                std::fwrite(face, sizeof(face), 1, file);
+            }
+        }
+    }
+    std::fclose(file);
+}
+
+// The straightforward parser: strtof/strtol over a copy of each line
+uint64 ReadObjWithStrtof(const std::string& path)
+{
+    FILE* file = std::fopen(path.c_str(), "rb");
+    std::vector<XMFLOAT3> positions;
+    std::vector<std::array<uint32, 3>> faces;
+    char line[256];
+    while (std::fgets(line, sizeof(line), file))
+    {
+        char* p = line + 2;
+        if (line[0] == 'v' && line[1] == ' ')
+        {
+            XMFLOAT3 position;
+            position.x = std::strtof(p, &p);
+            position.y = std::strtof(p, &p);
+            position.z = std::strtof(p, &p);
+            positions.push_back(position);
+        }
+        else if (line[0] == 'f' && line[1] == ' ')
+        {
+            std::array<uint32, 3> face;
+            for (uint32& index : face)
+            {
+                index = static_cast<uint32>(std::strtol(p, &p, 10) - 1);
+            }
+            faces.push_back(face);
+        }
+    }
+    std::fclose(file);
+    return positions.size() + faces.size();
+}
+
+} // anonymous namespace
+
+// 1000 x 1000 quads: 1M positions, 2M triangles (~60 MB of OBJ text)
+TEST(MeshImporterBench, DISABLED_ParseGrid)
+{
+    const uint32 n = 1000;
+    std::string objPath = ::testing::TempDir() + "importer_bench.obj";
+    std::string plyPath = ::testing::TempDir() + "importer_bench.ply";
+    WriteGridObj(objPath, n);
+    WriteGridPly(plyPath, n);
+
+    std::vector<XMFLOAT3> positions;
+    std::vector<std::array<uint32, 3>> faces;
+    ThreadPool pool;
+
+    double strtofTime = Bench::MedianMicroseconds(3, [&]() { ReadObjWithStrtof(objPath); });
+    Bench::Report("OBJ, fgets + strtof", strtofTime);
+
+    double objSerial = Bench::MedianMicroseconds(3, [&]() {
+        MeshImporter::ReadOBJ(objPath.c_str(), positions, faces);
+    });
+    Bench::Report("OBJ, mapped chunks, serial", objSerial);
+
+    double objParallel = Bench::MedianMicroseconds(3, [&]() {
+        MeshImporter::ReadOBJ(objPath.c_str(), positions, faces, &pool);
+    });
+    std::string label = "OBJ, mapped chunks, " + std::to_string(pool.GetWorkerCount()) + " workers";
+    Bench::Report(label.c_str(), objParallel);
+
+    double plySerial = Bench::MedianMicroseconds(3, [&]() {
+        MeshImporter::ReadPLY(plyPath.c_str(), positions, faces);
+    });
+    Bench::Report("PLY, serial", plySerial);
+
+    double plyParallel = Bench::MedianMicroseconds(3, [&]() {
+        MeshImporter::ReadPLY(plyPath.c_str(), positions, faces, &pool);
+    });
+    Bench::Report("PLY, pool", plyParallel);
+
+    EXPECT_EQ(faces.size(), 2u * n * n);
+    std::remove(objPath.c_str());
+    std::remove(plyPath.c_str());
+}
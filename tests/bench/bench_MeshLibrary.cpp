@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "Renderer/MeshLibrary.h"
+#include "Core/ThreadPool.h"
+#include "BenchTimer.h"
+#include <string>
+#include <vector>
+
+using namespace RRE;
+
+namespace
+{
+
+// A startup-like set: a few dense meshes among many small ones
+std::vector<MeshDesc> MakeStartupSet()
+{
+    std::vector<MeshDesc> descs;
+    for (uint32 i = 0; i < 4; ++i)
+    {
+        descs.push_back(MeshDesc::Sphere(192 + i * 16, 192, MeshShading::Smooth));
+    }
+    for (uint32 i = 0; i < 32; ++i)
+    {
+        descs.push_back(MeshDesc::Sphere(16 + i, 16));
+        descs.push_back(MeshDesc::Cylinder(16 + i, 2.0f, MeshShading::Smooth));
+    }
+    descs.push_back(MeshDesc::Cube());
+    descs.push_back(MeshDesc::Tetrahedron());
+    return descs;
+}
+
+} // anonymous namespace
+
+TEST(MeshLibraryBench, DISABLED_Startup)
+{
+    std::vector<MeshDesc> descs = MakeStartupSet();
+    ThreadPool pool;
+
+    double serial = Bench::MedianMicroseconds(3, [&]() {
+        MeshLibrary library;
+        for (const MeshDesc& desc : descs)
+        {
+            library.Get(desc);
+        }
+    });
+    Bench::Report("serial, all meshes", serial);
+
+    double firstMesh = 0.0;
+    double parallel = Bench::MedianMicroseconds(3, [&]() {
+        auto start = std::chrono::steady_clock::now();
+        MeshLibrary library(&pool);
+        for (const MeshDesc& desc : descs)
+        {
+            library.Request(desc);
+        }
+        library.Get(MeshDesc::Cube());
+        firstMesh = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        for (const MeshDesc& desc : descs)
+        {
+            library.Get(desc);
+        }
+    });
+    std::string label = "pool (" + std::to_string(pool.GetWorkerCount()) + " workers), all meshes";
+    Bench::Report(label.c_str(), parallel);
+    Bench::Report("pool, first frame's mesh", firstMesh);
+
+    // Repeated requests are cache hits
+    MeshLibrary library(&pool);
+    library.Get(descs[0]);
+    double hit = Bench::MedianMicroseconds(5, [&]() { library.Get(descs[0]); });
+    Bench::Report("cached Get", hit);
+}
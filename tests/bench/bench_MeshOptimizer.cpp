@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "Renderer/MeshOptimizer.h"
+#include "Renderer/MeshFactory.h"
+#include "BenchTimer.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+using namespace RRE;
+
+namespace
+{
+
+// Smooth sphere in generation order (welded but not reordered), then the
+// optimizer's cost and the cache statistics it buys
+void RunMeshOptimizerBench(uint32 segments)
+{
+    Mesh smooth = MeshFactory::CreateSphere(segments, segments, MeshShading::Smooth);
+    Mesh source;
+    source.vertices = smooth.vertices;
+    source.indices = smooth.indices;
+    source.faceAdjacency = smooth.faceAdjacency;
+
+    // Generation-like order: row-major by the first vertex's height
+    std::vector<uint32> order(source.GetPolygonCount());
+    for (uint32 t = 0; t < order.size(); ++t)
+    {
+        order[t] = t;
+    }
+    std::sort(order.begin(), order.end(), [&](uint32 a, uint32 b) {
+        const Vertex& va = source.vertices[source.indices[a * 3]];
+        const Vertex& vb = source.vertices[source.indices[b * 3]];
+        return va.position.y != vb.position.y ? va.position.y > vb.position.y : a < b;
+    });
+    std::vector<uint32> indices;
+    indices.reserve(source.indices.size());
+    for (uint32 t : order)
+    {
+        indices.insert(indices.end(), source.indices.begin() + t * 3, source.indices.begin() + t * 3 + 3);
+    }
+    source.indices = std::move(indices);
+    source.faceAdjacency.clear();
+
+    MeshOptimizeResult result;
+    double time = Bench::MedianMicroseconds(5, [&]() {
+        Mesh mesh = source;
+        result = MeshOptimizer::Optimize(mesh);
+    });
+
+    std::string label = "sphere " + std::to_string(segments) + "x" + std::to_string(segments) +
+        " (" + std::to_string(source.GetPolygonCount()) + " tris)";
+    Bench::Report(label.c_str(), time);
+    std::printf("[ BENCH    ] %s: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n", label.c_str(),
+        result.before.acmr, result.after.acmr, result.before.atvr, result.after.atvr);
+}
+
+} // anonymous namespace
+
+TEST(MeshOptimizerBench, DISABLED_Sphere64) { RunMeshOptimizerBench(64); }
+TEST(MeshOptimizerBench, DISABLED_Sphere512) { RunMeshOptimizerBench(512); }
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "Renderer/MeshBVH.h"
+#include "Renderer/MeshFactory.h"
+#include "Scene/SceneGraph.h"
+#include "Scene/SceneNode.h"
+#include "BenchTimer.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace DirectX;
+using namespace RRE;
+
+namespace
+{
+
+// A grid of rays fired down +z through a field of tessellated spheres
+void RunRaycastBench(uint32 segments, uint32 nodeCount, uint32 rayCount)
+{
+    Mesh sphere = MeshFactory::CreateSphere(segments, segments);
+    SceneGraph graph;
+
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> pos(-20.0f, 20.0f);
+    for (uint32 i = 0; i < nodeCount; ++i)
+    {
+        SceneNode* node = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+        node->GetTransform().SetPosition({ pos(rng), pos(rng), pos(rng) });
+        node->SetMesh(&sphere);
+    }
+    graph.UpdateSpatialIndex();
+
+    std::vector<XMFLOAT3> origins;
+    std::vector<XMFLOAT3> directions;
+    uint32 side = static_cast<uint32>(std::sqrt(static_cast<float>(rayCount)));
+    for (uint32 y = 0; y < side; ++y)
+    {
+        for (uint32 x = 0; x < side; ++x)
+        {
+            float fx = -20.0f + 40.0f * static_cast<float>(x) / static_cast<float>(side);
+            float fy = -20.0f + 40.0f * static_cast<float>(y) / static_cast<float>(side);
+            origins.push_back({ fx, fy, -30.0f });
+            directions.push_back({ 0.0f, 0.0f, 1.0f });
+        }
+    }
+    uint32 count = static_cast<uint32>(origins.size());
+    std::vector<RaycastHit> hits(count);
+
+    uint32 singleHits = 0;
+    double single = Bench::MedianMicroseconds(5, [&]() {
+        singleHits = 0;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            if (graph.Raycast(origins[i], directions[i]).IsHit())
+                singleHits++;
+        }
+    });
+
+    uint32 batchHits = 0;
+    double batch = Bench::MedianMicroseconds(5, [&]() {
+        graph.RaycastBatch(origins.data(), directions.data(), count, hits.data());
+        batchHits = 0;
+        for (const RaycastHit& hit : hits)
+        {
+            if (hit.IsHit())
+                batchHits++;
+        }
+    });
+    EXPECT_EQ(singleHits, batchHits);
+
+    std::string label = std::to_string(count) + " rays, " + std::to_string(nodeCount) + " x "
+        + std::to_string(sphere.GetPolygonCount()) + " tris";
+    Bench::Report((label + " single").c_str(), single);
+    Bench::Report((label + " batch").c_str(), batch);
+    std::printf("[ BENCH    ] %s: %u hits\n", label.c_str(), batchHits);
+}
+
+} // anonymous namespace
+
+TEST(RaycastBench, DISABLED_SmallMeshes) { RunRaycastBench(16, 1000, 65536); }
+TEST(RaycastBench, DISABLED_LargeMeshes) { RunRaycastBench(256, 100, 65536); }
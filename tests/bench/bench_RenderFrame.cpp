@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "RHI/Null/NullDevice.h"
+#include "Renderer/Renderer.h"
+#include "Renderer/MeshFactory.h"
+#include "Scene/SceneGraph.h"
+#include "Scene/SceneNode.h"
+#include "Scene/Camera.h"
+#include "Lighting/PointLight.h"
+#include "Core/ThreadPool.h"
+#include "BenchTimer.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+
+using namespace DirectX;
+using namespace RRE;
+
+namespace
+{
+
+// Full CPU frame (traversal, culling, batching, constant and instance writes)
+// against the null backend, so the numbers contain no driver or GPU time
+void RunRenderFrameBench(uint32 count, bool culling)
+{
+    NullDevice device;
+    ASSERT_TRUE(device.Initialize(nullptr, 1280, 720));
+
+    Mesh cube = MeshFactory::CreateCube();
+    Mesh sphere = MeshFactory::CreateSphere(16, 16);
+    ThreadPool pool;
+    SceneGraph graph;
+    graph.SetStorage(SceneStorage::Flat);
+    graph.SetThreadPool(&pool);
+
+    std::mt19937 rng(7);
+    float extent = std::cbrt(static_cast<float>(count)) * 2.0f;
+    std::uniform_real_distribution<float> pos(-extent, extent);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        SceneNode* node = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+        node->GetTransform().SetPosition({ pos(rng), pos(rng), pos(rng) });
+        node->SetMesh((i % 4) ? &cube : &sphere);
+    }
+
+    Renderer renderer;
+    renderer.SetDevice(&device);
+    renderer.SetFrustumCulling(culling);
+    Camera camera;
+    camera.SetPosition({ 0.0f, 0.0f, -extent });
+    PointLight light;
+
+    IRHIContext* context = device.GetContext();
+    auto frame = [&]() {
+        context->BeginFrame();
+        renderer.RenderScene(graph, camera, &light, 16.0f / 9.0f);
+        context->EndFrame();
+    };
+    frame();
+    device.ResetStats();
+
+    double time = Bench::MedianMicroseconds(10, frame);
+
+    const NullRHIStats& stats = device.GetStats();
+    std::string label = std::to_string(count) + " nodes, culling " + (culling ? "on" : "off");
+    Bench::Report(label.c_str(), time);
+    std::printf("[ BENCH    ] %s: %llu draws, %llu instances, %llu KB transient per frame\n",
+        label.c_str(),
+        static_cast<unsigned long long>(stats.drawCalls / stats.frames),
+        static_cast<unsigned long long>(stats.instances / stats.frames),
+        static_cast<unsigned long long>(stats.constantBytes / stats.frames / 1024));
+}
+
+} // anonymous namespace
+
+TEST(RenderFrameBench, DISABLED_CullingOn) { RunRenderFrameBench(100000, true); }
+TEST(RenderFrameBench, DISABLED_CullingOff) { RunRenderFrameBench(100000, false); }
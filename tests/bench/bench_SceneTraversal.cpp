@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "Scene/SceneGraph.h"
+#include "Scene/SceneNode.h"
+#include "BenchTimer.h"
+#include <string>
+
+using namespace DirectX;
+using namespace RRE;
+
+namespace
+{
+
+// Single chain: every node has exactly one child
+void BuildDeepGraph(SceneGraph& graph, uint32 depth)
+{
+    SceneNode* node = graph.GetRoot();
+    for (uint32 i = 0; i < depth; ++i)
+    {
+        node = node->AddChild(std::make_unique<SceneNode>());
+        node->GetTransform().SetPosition({ 0.01f, 0.0f, 0.0f });
+    }
+}
+
+// Two levels: `groups` children under the root, each with `fanOut` leaves
+void BuildWideGraph(SceneGraph& graph, uint32 groups, uint32 fanOut)
+{
+    for (uint32 g = 0; g < groups; ++g)
+    {
+        SceneNode* group = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+        group->GetTransform().SetPosition({ static_cast<float>(g), 0.0f, 0.0f });
+        for (uint32 i = 0; i < fanOut; ++i)
+        {
+            SceneNode* leaf = group->AddChild(std::make_unique<SceneNode>());
+            leaf->GetTransform().SetPosition({ 0.0f, static_cast<float>(i), 0.0f });
+        }
+    }
+}
+
+void CompareTraversals(const char* label, const SceneGraph& graph)
+{
+    const int iterations = 50;
+    float sink = 0.0f;
+
+    // Warm the matrix caches so both runs measure traversal only
+    graph.Traverse([](SceneNode*, const XMMATRIX&) {});
+
+    double templ = Bench::MedianMicroseconds(iterations, [&]() {
+        graph.Traverse([&sink](SceneNode*, const XMMATRIX& world) {
+            sink += XMVectorGetX(world.r[3]);
+        });
+    });
+
+    SceneGraph::Visitor visitor = [&sink](SceneNode*, const XMMATRIX& world) {
+        sink += XMVectorGetX(world.r[3]);
+    };
+    double erased = Bench::MedianMicroseconds(iterations, [&]() {
+        graph.Traverse(visitor);
+    });
+
+    std::string name = label;
+    Bench::Report((name + " template").c_str(), templ);
+    Bench::Report((name + " std::function").c_str(), erased);
+    EXPECT_NE(sink, -1.0f);
+}
+
+} // anonymous namespace
+
+TEST(SceneTraversalBench, DISABLED_DeepChain)
+{
+    SceneGraph graph;
+    BuildDeepGraph(graph, 100000);
+    CompareTraversals("deep 100k", graph);
+}
+
+TEST(SceneTraversalBench, DISABLED_WideFanOut)
+{
+    SceneGraph graph;
+    BuildWideGraph(graph, 100, 1000);
+    CompareTraversals("wide 100x1000", graph);
+}
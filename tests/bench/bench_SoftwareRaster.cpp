@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "RHI/Software/SoftwareDevice.h"
+#include "Renderer/Renderer.h"
+#include "Renderer/MeshFactory.h"
+#include "Renderer/MeshletBuilder.h"
+#include "Scene/SceneGraph.h"
+#include "Scene/SceneNode.h"
+#include "Scene/Camera.h"
+#include "Lighting/PointLight.h"
+#include "BenchTimer.h"
+#include <cstdio>
+#include <string>
+
+using namespace DirectX;
+using namespace RRE;
+
+namespace
+{
+
+// The engine's default scene (a mesh at the origin and one orbiting at x = 3)
+// rendered at 1080p by the software backend
+void RunSoftwareRasterBench(const char* name, Mesh mesh, VertexFormat format = VertexFormat::Full)
+{
+    SoftwareDevice device;
+    ASSERT_TRUE(device.Initialize(nullptr, 1920, 1080));
+
+    SceneGraph graph;
+    SceneNode* parent = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+    parent->SetMesh(&mesh);
+    parent->GetTransform().SetRotation({ 0.0f, 0.6f, 0.0f });
+    SceneNode* child = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+    child->SetMesh(&mesh);
+    child->GetTransform().SetPosition({ 3.0f, 0.0f, 0.0f });
+
+    Renderer renderer;
+    renderer.SetDevice(&device);
+    renderer.SetVertexFormat(format);
+    Camera camera;
+    PointLight light;
+
+    IRHIContext* context = device.GetContext();
+    auto frame = [&]() {
+        context->BeginFrame();
+        context->Clear({ 0.1f, 0.1f, 0.1f, 1.0f });
+        renderer.RenderScene(graph, camera, &light, 1920.0f / 1080.0f);
+        context->EndFrame();
+    };
+    frame();
+
+    double time = Bench::MedianMicroseconds(30, frame);
+    std::string label = std::string("1080p ") + name;
+    Bench::Report(label.c_str(), time);
+
+    const SoftwareRasterStats& stats = device.GetRasterizer().GetStats();
+    std::printf("[ BENCH    ] %s: %.0f FPS, %llu tris, %llu culled, %llu tile bins, %llu pixels\n",
+        label.c_str(), 1e6 / time,
+        static_cast<unsigned long long>(stats.triangles),
+        static_cast<unsigned long long>(stats.culled),
+        static_cast<unsigned long long>(stats.tileBins),
+        static_cast<unsigned long long>(stats.pixelsWritten));
+}
+
+} // anonymous namespace
+
+TEST(SoftwareRasterBench, DISABLED_Sphere) { RunSoftwareRasterBench("sphere", MeshFactory::CreateSphere()); }
+TEST(SoftwareRasterBench, DISABLED_Cylinder) { RunSoftwareRasterBench("cylinder", MeshFactory::CreateCylinder()); }
+TEST(SoftwareRasterBench, DISABLED_DenseSphere) { RunSoftwareRasterBench("sphere 256x256", MeshFactory::CreateSphere(256, 256)); }
+
+TEST(SoftwareRasterBench, DISABLED_DenseSphereMeshlets)
+{
+    Mesh sphere = MeshFactory::CreateSphere(256, 256, MeshShading::Smooth);
+    RunSoftwareRasterBench("smooth sphere 256x256", sphere);
+    MeshletBuilder::Build(sphere);
+    RunSoftwareRasterBench("smooth sphere 256x256, meshlets", sphere);
+}
+
+// Vertex streams at 40 vs 16 bytes per vertex (the compact one is decoded
+// per referenced vertex)
+TEST(SoftwareRasterBench, DISABLED_DenseSphereCompact)
+{
+    Mesh sphere = MeshFactory::CreateSphere(256, 256, MeshShading::Smooth);
+    RunSoftwareRasterBench("smooth sphere 256x256, full", sphere);
+    RunSoftwareRasterBench("smooth sphere 256x256, compact", sphere, VertexFormat::Compact);
+}
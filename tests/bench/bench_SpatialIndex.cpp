@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "Scene/SceneGraph.h"
+#include "Scene/SceneNode.h"
+#include "Scene/Camera.h"
+#include "Renderer/MeshFactory.h"
+#include "BenchTimer.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+
+using namespace DirectX;
+using namespace RRE;
+
+namespace
+{
+
+// Mesh nodes scattered uniformly in a cube that grows with the node count,
+// so density (and the fraction inside the frustum) drops as n grows
+void BuildScatteredGraph(SceneGraph& graph, Mesh& mesh, uint32 count)
+{
+    std::mt19937 rng(99);
+    float extent = std::cbrt(static_cast<float>(count)) * 4.0f;
+    std::uniform_real_distribution<float> pos(-extent, extent);
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        SceneNode* node = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+        node->GetTransform().SetPosition({ pos(rng), pos(rng), pos(rng) });
+        node->SetMesh(&mesh);
+    }
+}
+
+void RunSpatialBench(uint32 count)
+{
+    Mesh cube = MeshFactory::CreateCube();
+    SceneGraph graph;
+    BuildScatteredGraph(graph, cube, count);
+
+    std::string label = std::to_string(count) + " nodes";
+
+    double build = Bench::MedianMicroseconds(1, [&]() { graph.UpdateSpatialIndex(); });
+    Bench::Report((label + " build").c_str(), build);
+
+    Camera camera;
+    Math::Frustum frustum = Math::Frustum::FromViewProjection(
+        camera.GetViewMatrix() * camera.GetProjectionMatrix(16.0f / 9.0f));
+
+    uint32 visible = 0;
+    double bvhFrustum = Bench::MedianMicroseconds(20, [&]() {
+        visible = 0;
+        graph.QueryFrustum(frustum, [&](SceneNode*, const XMMATRIX&) { visible++; });
+    });
+
+    uint32 bruteVisible = 0;
+    double bruteFrustum = Bench::MedianMicroseconds(5, [&]() {
+        bruteVisible = 0;
+        graph.Traverse([&](SceneNode* node, const XMMATRIX& world) {
+            if (node->GetMesh() && frustum.IntersectsAABB(Math::TransformAABB(node->GetMesh()->localBounds, world)))
+                bruteVisible++;
+        });
+    });
+    EXPECT_EQ(visible, bruteVisible);
+
+    double ray = Bench::MedianMicroseconds(20, [&]() {
+        graph.PickNode({ 0.0f, 0.0f, -1e4f }, { 0.0f, 0.0f, 1.0f }, 2e4f);
+    });
+
+    uint32 nearby = 0;
+    double sphere = Bench::MedianMicroseconds(20, [&]() {
+        nearby = 0;
+        graph.QuerySphere({ 0.0f, 0.0f, 0.0f }, 10.0f, [&](SceneNode*, const XMMATRIX&) { nearby++; });
+    });
+
+    // Small per-frame motion: mostly absorbed by the fat margins
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> jitter(-0.05f, 0.05f);
+    const auto& children = graph.GetRoot()->GetChildren();
+    double refit = Bench::MedianMicroseconds(5, [&]() {
+        for (size_t i = 0; i < children.size(); i += 10)
+        {
+            XMFLOAT3 p = children[i]->GetTransform().GetPosition();
+            children[i]->GetTransform().SetPosition({ p.x + jitter(rng), p.y, p.z });
+        }
+        graph.UpdateSpatialIndex();
+    });
+
+    Bench::Report((label + " frustum (bvh)").c_str(), bvhFrustum);
+    Bench::Report((label + " frustum (full traverse)").c_str(), bruteFrustum);
+    Bench::Report((label + " ray pick").c_str(), ray);
+    Bench::Report((label + " sphere r=10").c_str(), sphere);
+    std::printf("[ BENCH    ] %s: %u in frustum, %u within sphere\n", label.c_str(), visible, nearby);
+    Bench::Report((label + " refit 10% moved").c_str(), refit);
+}
+
+} // anonymous namespace
+
+TEST(SpatialIndexBench, DISABLED_Nodes1K) { RunSpatialBench(1000); }
+TEST(SpatialIndexBench, DISABLED_Nodes10K) { RunSpatialBench(10000); }
+TEST(SpatialIndexBench, DISABLED_Nodes100K) { RunSpatialBench(100000); }
+TEST(SpatialIndexBench, DISABLED_Nodes1M) { RunSpatialBench(1000000); }
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "RHI/Software/SoftwareDevice.h"
+#include "Renderer/Renderer.h"
+#include "Renderer/MeshFactory.h"
+#include "Scene/SceneGraph.h"
+#include "Scene/SceneNode.h"
+#include "Scene/Camera.h"
+#include "Lighting/PointLight.h"
+#include "BenchTimer.h"
+#include <cstdio>
+#include <deque>
+#include <vector>
+
+using namespace DirectX;
+using namespace RRE;
+
+// Batch thumbnail rendering: one offscreen frame per thumbnail, each readback
+// resolved LATENCY frames later instead of waiting right after submission
+TEST(ThumbnailBench, DISABLED_PipelinedReadback)
+{
+    const uint32 THUMBNAILS = 256;
+    const uint32 SIZE = 128;
+    const uint32 LATENCY = 2;
+
+    SoftwareDevice device;
+    ASSERT_TRUE(device.Initialize(nullptr, SIZE, SIZE));
+    auto target = device.CreateRenderTarget(SIZE, SIZE);
+    ASSERT_NE(target, nullptr);
+
+    Mesh mesh = MeshFactory::CreateSphere(32, 32);
+    SceneGraph graph;
+    SceneNode* node = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+    node->SetMesh(&mesh);
+
+    Renderer renderer;
+    renderer.SetDevice(&device);
+    Camera camera;
+    PointLight light;
+
+    IRHIContext* context = device.GetContext();
+    std::vector<uint32> pixels(SIZE * SIZE);
+    uint64 checksum = 0;
+    auto batch = [&]() {
+        std::deque<uint64> inFlight;
+        auto resolveOldest = [&]() {
+            while (context->ResolveReadback(inFlight.front(), pixels.data()) == ReadbackStatus::Pending)
+            {
+                context->WaitForGPU();
+            }
+            checksum += pixels[SIZE * SIZE / 2];
+            inFlight.pop_front();
+        };
+
+        for (uint32 i = 0; i < THUMBNAILS; ++i)
+        {
+            node->GetTransform().SetRotation({ 0.0f, 0.05f * static_cast<float>(i), 0.0f });
+            context->BeginFrame();
+            context->SetRenderTarget(target.get());
+            context->Clear({ 0.1f, 0.1f, 0.1f, 1.0f });
+            renderer.RenderScene(graph, camera, &light, 1.0f);
+            inFlight.push_back(context->ReadPixels(target.get()));
+            context->EndFrame();
+
+            if (inFlight.size() > LATENCY)
+            {
+                resolveOldest();
+            }
+        }
+        while (!inFlight.empty())
+        {
+            resolveOldest();
+        }
+    };
+    batch();
+
+    double time = Bench::MedianMicroseconds(5, batch);
+    Bench::Report("256 thumbnails 128x128", time);
+    std::printf("[ BENCH    ] %.1f us per thumbnail (checksum %llu)\n",
+        time / THUMBNAILS, static_cast<unsigned long long>(checksum));
+}
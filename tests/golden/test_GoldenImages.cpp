@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+#include "RHI/Software/SoftwareDevice.h"
+#include "Renderer/Renderer.h"
+#include "Renderer/MeshFactory.h"
+#include "Scene/SceneGraph.h"
+#include "Scene/SceneNode.h"
+#include "Scene/Camera.h"
+#include "Lighting/PointLight.h"
+#include "Core/ImageDiff.h"
+#include "Core/ImageReader.h"
+#include "Core/ImageWriter.h"
+#include "../bench/BenchTimer.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Golden-image regression tests: every MeshFactory shape under every light
+// preset is rendered by the software backend and compared with the PPM in
+// tests/golden/reference. On a mismatch the actual image and a diff image
+// (differing pixels in red) are written as PNGs to RRE_GOLDEN_OUT, or the
+// gtest temp dir. Set RRE_UPDATE_GOLDEN=1 to rewrite the references.
+// Each case also records its median render time (render_us) and the
+// number of differing pixels as test properties; the console only shows
+// failures.
+
+#ifndef RRE_GOLDEN_DIR
+#define RRE_GOLDEN_DIR "tests/golden/reference/"
+#endif
+
+using namespace DirectX;
+using namespace RRE;
+
+namespace
+{
+
+constexpr uint32 IMAGE_WIDTH = 128;
+constexpr uint32 IMAGE_HEIGHT = 96;
+
+// Perceptual threshold per pixel, and the share of pixels allowed past it
+// (edge pixels may flip between compilers' float code generation)
+constexpr float DIFF_THRESHOLD = 0.1f;
+constexpr float ALLOWED_DIFF_FRACTION = 0.002f;
+
+struct Shape
+{
+    const char* name;
+    Mesh (*create)();
+};
+
+struct LightPreset
+{
+    const char* name;
+    XMFLOAT3 position;
+    XMFLOAT3 color;
+    bool showIndicator;
+};
+
+const Shape SHAPES[] = {
+    { "sphere", []() { return MeshFactory::CreateSphere(); } },
+    { "tetrahedron", []() { return MeshFactory::CreateTetrahedron(); } },
+    { "cube", []() { return MeshFactory::CreateCube(); } },
+    { "cylinder", []() { return MeshFactory::CreateCylinder(); } },
+    { "sphere_smooth", []() { return MeshFactory::CreateSphere(16, 16, MeshShading::Smooth); } },
+    { "cylinder_smooth", []() { return MeshFactory::CreateCylinder(16, 2.0f, MeshShading::Smooth); } },
+};
+
+// Light menu colors at the default and a low side position
+const LightPreset PRESETS[] = {
+    { "white", { 2.0f, 3.0f, -2.0f }, { 1.0f, 1.0f, 1.0f }, true },
+    { "red", { 2.0f, 3.0f, -2.0f }, { 1.0f, 0.0f, 0.0f }, false },
+    { "cyan_low", { -3.0f, -2.0f, -3.0f }, { 0.0f, 1.0f, 1.0f }, false },
+};
+
+struct GoldenCase
+{
+    const Shape* shape;
+    const LightPreset* preset;
+};
+
+std::vector<GoldenCase> AllCases()
+{
+    std::vector<GoldenCase> cases;
+    for (const Shape& shape : SHAPES)
+    {
+        for (const LightPreset& preset : PRESETS)
+        {
+            cases.push_back({ &shape, &preset });
+        }
+    }
+    return cases;
+}
+
+std::string CaseName(const GoldenCase& golden)
+{
+    return std::string(golden.shape->name) + "_" + golden.preset->name;
+}
+
+std::string OutputDir()
+{
+    const char* dir = std::getenv("RRE_GOLDEN_OUT");
+    return dir ? std::string(dir) + "/" : ::testing::TempDir();
+}
+
+bool UpdateRequested()
+{
+    const char* update = std::getenv("RRE_UPDATE_GOLDEN");
+    return update && update[0] == '1';
+}
+
+class GoldenImageTest : public ::testing::TestWithParam<GoldenCase>
+{
+};
+
+} // anonymous namespace
+
+TEST_P(GoldenImageTest, MatchesReference)
+{
+    const GoldenCase& golden = GetParam();
+    std::string name = CaseName(golden);
+
+    SoftwareDevice device;
+    ASSERT_TRUE(device.Initialize(nullptr, IMAGE_WIDTH, IMAGE_HEIGHT));
+    auto target = device.CreateRenderTarget(IMAGE_WIDTH, IMAGE_HEIGHT);
+    ASSERT_NE(target, nullptr);
+
+    Mesh mesh = golden.shape->create();
+    SceneGraph graph;
+    SceneNode* node = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+    node->SetMesh(&mesh);
+    node->GetTransform().SetRotation({ 0.4f, 0.6f, 0.0f });
+
+    Mesh indicator = MeshFactory::CreateSphere(8, 8);
+    auto indicatorVB = device.CreateBuffer(indicator.vertices.data(),
+        static_cast<uint32>(indicator.vertices.size() * sizeof(Vertex)), sizeof(Vertex));
+    auto indicatorIB = device.CreateBuffer(indicator.indices.data(),
+        static_cast<uint32>(indicator.indices.size() * sizeof(uint32)), sizeof(uint32));
+
+    Renderer renderer;
+    renderer.SetDevice(&device);
+    Camera camera;
+    PointLight light;
+    light.SetPosition(golden.preset->position);
+    light.SetColor(golden.preset->color);
+
+    IRHIContext* context = device.GetContext();
+    auto render = [&]() {
+        context->BeginFrame();
+        context->SetRenderTarget(target.get());
+        context->Clear({ 0.1f, 0.1f, 0.1f, 1.0f });
+        renderer.RenderScene(graph, camera, &light,
+            static_cast<float>(IMAGE_WIDTH) / static_cast<float>(IMAGE_HEIGHT));
+        renderer.RenderLightIndicator(&light, golden.preset->showIndicator,
+            indicatorVB.get(), indicatorIB.get());
+        context->EndFrame();
+    };
+    render();
+    double renderTime = Bench::MedianMicroseconds(5, render);
+    RecordProperty("render_us", static_cast<int>(renderTime + 0.5));
+
+    context->BeginFrame();
+    uint64 ticket = context->ReadPixels(target.get());
+    context->EndFrame();
+    std::vector<uint32> actual(IMAGE_WIDTH * IMAGE_HEIGHT);
+    ASSERT_EQ(context->ResolveReadback(ticket, actual.data()), ReadbackStatus::Ready);
+
+    std::string referencePath = std::string(RRE_GOLDEN_DIR) + name + ".ppm";
+    if (UpdateRequested())
+    {
+        ASSERT_TRUE(ImageWriter::WritePPM(referencePath.c_str(), actual.data(),
+            IMAGE_WIDTH, IMAGE_HEIGHT, IMAGE_WIDTH));
+        std::printf("[ GOLDEN   ] updated %s\n", referencePath.c_str());
+        return;
+    }
+
+    std::vector<uint32> reference;
+    uint32 width = 0;
+    uint32 height = 0;
+    ASSERT_TRUE(ImageReader::ReadPPM(referencePath.c_str(), reference, width, height))
+        << "missing reference " << referencePath << " (run with RRE_UPDATE_GOLDEN=1)";
+    ASSERT_EQ(width, IMAGE_WIDTH);
+    ASSERT_EQ(height, IMAGE_HEIGHT);
+
+    std::vector<uint32> diffImage(IMAGE_WIDTH * IMAGE_HEIGHT);
+    ImageDiffResult diff = ImageDiff::Compare(reference.data(), IMAGE_WIDTH,
+        actual.data(), IMAGE_WIDTH, IMAGE_WIDTH, IMAGE_HEIGHT, DIFF_THRESHOLD, diffImage.data());
+    RecordProperty("different_pixels", static_cast<int>(diff.differentPixels));
+
+    uint32 allowed = static_cast<uint32>(IMAGE_WIDTH * IMAGE_HEIGHT * ALLOWED_DIFF_FRACTION);
+    if (diff.differentPixels > allowed)
+    {
+        std::string actualPath = OutputDir() + name + "_actual.png";
+        std::string diffPath = OutputDir() + name + "_diff.png";
+        ImageWriter::WritePNG(actualPath.c_str(), actual.data(), IMAGE_WIDTH, IMAGE_HEIGHT, IMAGE_WIDTH);
+        ImageWriter::WritePNG(diffPath.c_str(), diffImage.data(), IMAGE_WIDTH, IMAGE_HEIGHT, IMAGE_WIDTH);
+        ADD_FAILURE() << diff.differentPixels << " pixels differ (allowed " << allowed
+            << "), max delta " << diff.maxDelta << "; wrote " << actualPath << " and " << diffPath;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Golden, GoldenImageTest, ::testing::ValuesIn(AllCases()),
+    [](const ::testing::TestParamInfo<GoldenCase>& info) { return CaseName(info.param); });
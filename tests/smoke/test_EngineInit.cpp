@@ -69,7 +69,7 @@ TEST(EngineInit, SceneGraphWithRendererOneCycle)
 
     // Create Renderer
     RRE::Renderer renderer;
-    renderer.SetContext(context, device.GetD3DDevice());
+    renderer.SetDevice(&device);
 
     // Create camera and light
     RRE::Camera camera;
@@ -1,7 +1,13 @@
 #include <gtest/gtest.h>
 #include "RHI/D3D12/D3D12Device.h"
+#include "RHI/D3D12/D3D12Buffer.h"
+#include "RHI/D3D12/D3D12Context.h"
 #include "RHI/RHIContext.h"
+#include "Renderer/MeshFactory.h"
 #include <windows.h>
+#include <chrono>
+#include <string>
+#include <vector>
 
 namespace
 {
@@ -92,3 +98,178 @@ TEST(RHIBackend, OnResize)
     device.Shutdown();
     DestroyWindow(hwnd);
 }
+
+TEST(RHIBackend, DrawInstanced)
+{
+    HWND hwnd = CreateTestWindow();
+    ASSERT_NE(hwnd, nullptr);
+
+    RRE::D3D12Device device;
+    bool result = device.InitializeWARP(hwnd, 320, 240);
+    ASSERT_TRUE(result);
+
+    RRE::Mesh cube = RRE::MeshFactory::CreateCube();
+    RRE::D3D12Buffer vb;
+    RRE::D3D12Buffer ib;
+    ASSERT_TRUE(vb.Initialize(device.GetD3DDevice(), cube.vertices.data(),
+        static_cast<RRE::uint32>(cube.vertices.size() * sizeof(RRE::Vertex)), sizeof(RRE::Vertex)));
+    ASSERT_TRUE(ib.Initialize(device.GetD3DDevice(), cube.indices.data(),
+        static_cast<RRE::uint32>(cube.indices.size() * sizeof(RRE::uint32)), sizeof(RRE::uint32)));
+
+    // A row of cubes in one draw
+    std::vector<DirectX::XMFLOAT4X4> worlds(100);
+    for (size_t i = 0; i < worlds.size(); ++i)
+    {
+        DirectX::XMStoreFloat4x4(&worlds[i], DirectX::XMMatrixTranspose(
+            DirectX::XMMatrixTranslation(static_cast<float>(i) * 2.0f, 0.0f, 5.0f)));
+    }
+
+    RRE::IRHIContext* context = device.GetContext();
+    context->BeginFrame();
+    context->Clear(DirectX::XMFLOAT4(0.0f, 0.28f, 0.67f, 1.0f));
+    context->DrawPrimitivesInstanced(&vb, &ib, worlds.data(), static_cast<RRE::uint32>(worlds.size()));
+    context->DrawPrimitives(&vb, &ib, worlds[0]);
+    context->EndFrame();
+
+    device.Shutdown();
+    DestroyWindow(hwnd);
+}
+
+TEST(RHIBackend, ManyDrawsPerFrame)
+{
+    HWND hwnd = CreateTestWindow();
+    ASSERT_NE(hwnd, nullptr);
+
+    RRE::D3D12Device device;
+    bool result = device.InitializeWARP(hwnd, 320, 240);
+    ASSERT_TRUE(result);
+
+    RRE::Mesh cube = RRE::MeshFactory::CreateCube();
+    RRE::D3D12Buffer vb;
+    RRE::D3D12Buffer ib;
+    ASSERT_TRUE(vb.Initialize(device.GetD3DDevice(), cube.vertices.data(),
+        static_cast<RRE::uint32>(cube.vertices.size() * sizeof(RRE::Vertex)), sizeof(RRE::Vertex)));
+    ASSERT_TRUE(ib.Initialize(device.GetD3DDevice(), cube.indices.data(),
+        static_cast<RRE::uint32>(cube.indices.size() * sizeof(RRE::uint32)), sizeof(RRE::uint32)));
+
+    // Far more draws than one constant page holds, over several frames so
+    // retired pages get recycled
+    RRE::IRHIContext* context = device.GetContext();
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        context->BeginFrame();
+        context->Clear(DirectX::XMFLOAT4(0.0f, 0.28f, 0.67f, 1.0f));
+        for (int i = 0; i < 2000; ++i)
+        {
+            DirectX::XMFLOAT4X4 world;
+            DirectX::XMStoreFloat4x4(&world, DirectX::XMMatrixTranspose(
+                DirectX::XMMatrixTranslation(static_cast<float>(i % 50) - 25.0f, 0.0f, 30.0f)));
+            context->DrawPrimitives(&vb, &ib, world);
+        }
+        context->EndFrame();
+    }
+
+    device.Shutdown();
+    DestroyWindow(hwnd);
+}
+
+TEST(RHIBackend, FramesInFlightCpuFrameTime)
+{
+    HWND hwnd = CreateTestWindow();
+    ASSERT_NE(hwnd, nullptr);
+
+    RRE::D3D12Device device;
+    bool result = device.InitializeWARP(hwnd, 320, 240);
+    ASSERT_TRUE(result);
+
+    RRE::Mesh sphere = RRE::MeshFactory::CreateSphere(64, 64);
+    RRE::D3D12Buffer vb;
+    RRE::D3D12Buffer ib;
+    ASSERT_TRUE(vb.Initialize(device.GetD3DDevice(), sphere.vertices.data(),
+        static_cast<RRE::uint32>(sphere.vertices.size() * sizeof(RRE::Vertex)), sizeof(RRE::Vertex)));
+    ASSERT_TRUE(ib.Initialize(device.GetD3DDevice(), sphere.indices.data(),
+        static_cast<RRE::uint32>(sphere.indices.size() * sizeof(RRE::uint32)), sizeof(RRE::uint32)));
+
+    std::vector<DirectX::XMFLOAT4X4> worlds(400);
+    for (size_t i = 0; i < worlds.size(); ++i)
+    {
+        DirectX::XMStoreFloat4x4(&worlds[i], DirectX::XMMatrixTranspose(DirectX::XMMatrixTranslation(
+            static_cast<float>(i % 20) - 10.0f, static_cast<float>(i / 20) - 10.0f, 25.0f)));
+    }
+
+    // Average CPU time per BeginFrame..EndFrame; with one frame in flight
+    // the CPU also waits for the GPU to finish the previous frame
+    auto* context = static_cast<RRE::D3D12Context*>(device.GetContext());
+    double frameMs[RRE::FrameRing::MAX_FRAMES_IN_FLIGHT + 1] = {};
+    for (RRE::uint32 framesInFlight = 1; framesInFlight <= RRE::FrameRing::MAX_FRAMES_IN_FLIGHT; ++framesInFlight)
+    {
+        context->SetFramesInFlight(framesInFlight);
+        EXPECT_EQ(context->GetFramesInFlight(), framesInFlight);
+
+        const int frames = 30;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            context->BeginFrame();
+            context->Clear(DirectX::XMFLOAT4(0.0f, 0.28f, 0.67f, 1.0f));
+            context->DrawPrimitivesInstanced(&vb, &ib, worlds.data(), static_cast<RRE::uint32>(worlds.size()));
+            context->EndFrame();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        frameMs[framesInFlight] = std::chrono::duration<double, std::milli>(end - start).count() / frames;
+    }
+    context->WaitForGPU();
+
+    // Timings go to the test report (--gtest_output=xml), not the console
+    for (RRE::uint32 framesInFlight = 1; framesInFlight <= RRE::FrameRing::MAX_FRAMES_IN_FLIGHT; ++framesInFlight)
+    {
+        EXPECT_GT(frameMs[framesInFlight], 0.0);
+        RecordProperty("cpu_us_per_frame_" + std::to_string(framesInFlight) + "_in_flight",
+            static_cast<int>(frameMs[framesInFlight] * 1000.0 + 0.5));
+    }
+
+    device.Shutdown();
+    DestroyWindow(hwnd);
+}
+
+TEST(RHIBackend, OffscreenReadback)
+{
+    HWND hwnd = CreateTestWindow();
+    ASSERT_NE(hwnd, nullptr);
+
+    RRE::D3D12Device device;
+    bool result = device.InitializeWARP(hwnd, 320, 240);
+    ASSERT_TRUE(result);
+
+    // Width is not a multiple of the 256-byte copy row alignment
+    auto target = device.CreateRenderTarget(70, 30);
+    ASSERT_NE(target, nullptr);
+
+    // Several frames queued before the first resolve, the way a thumbnail
+    // batch keeps the GPU busy
+    RRE::IRHIContext* context = device.GetContext();
+    std::vector<RRE::uint64> tickets;
+    for (int frame = 0; frame < 4; ++frame)
+    {
+        context->BeginFrame();
+        context->SetRenderTarget(target.get());
+        context->Clear(DirectX::XMFLOAT4(frame * 0.25f, 1.0f, 0.0f, 1.0f));
+        tickets.push_back(context->ReadPixels(target.get()));
+        EXPECT_EQ(context->ResolveReadback(tickets.back(), nullptr), RRE::ReadbackStatus::Pending);
+        context->EndFrame();
+    }
+
+    context->WaitForGPU();
+    std::vector<RRE::uint32> pixels(70 * 30);
+    for (int frame = 0; frame < 4; ++frame)
+    {
+        ASSERT_EQ(context->ResolveReadback(tickets[frame], pixels.data()), RRE::ReadbackStatus::Ready);
+        RRE::uint32 red = static_cast<RRE::uint32>(frame * 0.25f * 255.0f + 0.5f);
+        EXPECT_EQ(pixels[0], red | 0xFF00u | 0xFF000000u);
+        EXPECT_EQ(pixels[70 * 30 - 1], pixels[0]);
+        EXPECT_EQ(context->ResolveReadback(tickets[frame], pixels.data()), RRE::ReadbackStatus::Invalid);
+    }
+
+    device.Shutdown();
+    DestroyWindow(hwnd);
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "Renderer/AdjacencyGraph.h"
+#include <algorithm>
+#include <array>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace RRE;
+
+namespace
+{
+
+using Faces = std::vector<std::array<uint32, 3>>;
+
+std::vector<uint32> Row(const AdjacencyGraph& graph, uint32 node)
+{
+    return std::vector<uint32>(graph[node].begin(), graph[node].end());
+}
+
+// Quadratic reference: faces sharing two distinct positions
+std::vector<std::vector<uint32>> BruteForceFaceAdjacency(const Faces& faces)
+{
+    std::vector<std::vector<uint32>> adjacency(faces.size());
+    for (uint32 f = 0; f < faces.size(); ++f)
+    {
+        std::set<uint32> a(faces[f].begin(), faces[f].end());
+        for (uint32 g = 0; g < faces.size(); ++g)
+        {
+            if (g == f)
+                continue;
+            uint32 shared = 0;
+            for (uint32 p : std::set<uint32>(faces[g].begin(), faces[g].end()))
+            {
+                shared += a.count(p) ? 1 : 0;
+            }
+            if (shared >= 2)
+                adjacency[f].push_back(g);
+        }
+    }
+    return adjacency;
+}
+
+} // anonymous namespace
+
+TEST(AdjacencyGraph, QuadSharesOneEdge)
+{
+    Faces faces = { { 0, 1, 2 }, { 2, 1, 3 } };
+    AdjacencyGraph graph = AdjacencyGraph::FromFaceEdges(faces);
+    ASSERT_EQ(graph.size(), 2u);
+    EXPECT_EQ(Row(graph, 0), (std::vector<uint32>{ 1 }));
+    EXPECT_EQ(Row(graph, 1), (std::vector<uint32>{ 0 }));
+    EXPECT_EQ(graph.offsets, (std::vector<uint32>{ 0, 1, 2 }));
+
+    AdjacencyGraph positions = AdjacencyGraph::FromPositionEdges(faces, 5);
+    ASSERT_EQ(positions.size(), 5u);
+    EXPECT_EQ(Row(positions, 1), (std::vector<uint32>{ 0, 2, 3 }));
+    EXPECT_EQ(Row(positions, 2), (std::vector<uint32>{ 0, 1, 3 }));
+    EXPECT_TRUE(positions[4].empty());
+}
+
+TEST(AdjacencyGraph, NonManifoldEdgeJoinsEveryFace)
+{
+    // Three faces on edge 0-1, one of them wound the other way
+    Faces faces = { { 0, 1, 2 }, { 1, 0, 3 }, { 0, 1, 4 }, { 5, 6, 7 } };
+    AdjacencyGraph graph = AdjacencyGraph::FromFaceEdges(faces);
+    EXPECT_EQ(Row(graph, 0), (std::vector<uint32>{ 1, 2 }));
+    EXPECT_EQ(Row(graph, 1), (std::vector<uint32>{ 0, 2 }));
+    EXPECT_EQ(Row(graph, 2), (std::vector<uint32>{ 0, 1 }));
+    EXPECT_TRUE(graph[3].empty());
+}
+
+TEST(AdjacencyGraph, MatchesBruteForceOnRandomFaces)
+{
+    // Few positions, so faces share edges, repeat and double up
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<uint32> position(0, 11);
+    Faces faces;
+    while (faces.size() < 200)
+    {
+        std::array<uint32, 3> face = { position(rng), position(rng), position(rng) };
+        if (face[0] != face[1] && face[1] != face[2] && face[0] != face[2])
+            faces.push_back(face);
+    }
+
+    AdjacencyGraph graph = AdjacencyGraph::FromFaceEdges(faces);
+    auto expected = BruteForceFaceAdjacency(faces);
+    ASSERT_EQ(graph.size(), faces.size());
+    for (uint32 f = 0; f < faces.size(); ++f)
+    {
+        EXPECT_EQ(Row(graph, f), expected[f]);
+    }
+    EXPECT_EQ(graph.offsets.back(), graph.neighbors.size());
+}
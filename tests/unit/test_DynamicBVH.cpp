@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+#include "Scene/DynamicBVH.h"
+#include "Scene/SceneGraph.h"
+#include "Scene/SceneNode.h"
+#include "Scene/Camera.h"
+#include "Renderer/MeshFactory.h"
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+using namespace RRE;
+
+namespace
+{
+
+Math::AABB MakeBox(float x, float y, float z, float halfSize)
+{
+    Math::AABB box;
+    box.min = { x - halfSize, y - halfSize, z - halfSize };
+    box.max = { x + halfSize, y + halfSize, z + halfSize };
+    return box;
+}
+
+} // anonymous namespace
+
+TEST(DynamicBVH, InsertRemoveKeepsTreeValid)
+{
+    DynamicBVH bvh;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> pos(-100.0f, 100.0f);
+
+    std::vector<uint32> proxies;
+    for (int i = 0; i < 1000; ++i)
+    {
+        proxies.push_back(bvh.CreateProxy(MakeBox(pos(rng), pos(rng), pos(rng), 1.0f), nullptr));
+    }
+    EXPECT_TRUE(bvh.Validate());
+    EXPECT_EQ(bvh.GetProxyCount(), 1000u);
+    EXPECT_LT(bvh.GetHeight(), 30);
+
+    for (size_t i = 0; i < proxies.size(); i += 2)
+    {
+        bvh.DestroyProxy(proxies[i]);
+    }
+    EXPECT_TRUE(bvh.Validate());
+    EXPECT_EQ(bvh.GetProxyCount(), 500u);
+}
+
+TEST(DynamicBVH, QueryMatchesBruteForce)
+{
+    DynamicBVH bvh(0.0f);
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> pos(-50.0f, 50.0f);
+
+    std::vector<Math::AABB> boxes;
+    for (int i = 0; i < 500; ++i)
+    {
+        boxes.push_back(MakeBox(pos(rng), pos(rng), pos(rng), 2.0f));
+        bvh.CreateProxy(boxes.back(), nullptr);
+    }
+
+    Math::AABB query = MakeBox(0.0f, 0.0f, 0.0f, 20.0f);
+    std::vector<uint32> found;
+    bvh.QueryAABB(query, [&](uint32 proxyId) { found.push_back(proxyId); return true; });
+
+    uint32 expected = 0;
+    for (const auto& box : boxes)
+    {
+        if (Math::Overlaps(query, box))
+            expected++;
+    }
+    EXPECT_EQ(found.size(), expected);
+    for (uint32 id : found)
+    {
+        EXPECT_TRUE(Math::Overlaps(query, bvh.GetFatAABB(id)));
+    }
+}
+
+TEST(DynamicBVH, SmallMoveStaysInFatBox)
+{
+    DynamicBVH bvh(0.5f);
+    uint32 proxy = bvh.CreateProxy(MakeBox(0.0f, 0.0f, 0.0f, 1.0f), nullptr);
+    bvh.CreateProxy(MakeBox(10.0f, 0.0f, 0.0f, 1.0f), nullptr);
+
+    EXPECT_FALSE(bvh.MoveProxy(proxy, MakeBox(0.2f, 0.0f, 0.0f, 1.0f)));
+    EXPECT_TRUE(bvh.MoveProxy(proxy, MakeBox(5.0f, 0.0f, 0.0f, 1.0f)));
+    EXPECT_TRUE(bvh.Validate());
+}
+
+TEST(DynamicBVH, RayVisitsNearestFirst)
+{
+    DynamicBVH bvh(0.0f);
+    uint32 nearProxy = bvh.CreateProxy(MakeBox(0.0f, 0.0f, 5.0f, 1.0f), nullptr);
+    bvh.CreateProxy(MakeBox(0.0f, 0.0f, 15.0f, 1.0f), nullptr);
+    bvh.CreateProxy(MakeBox(10.0f, 0.0f, 5.0f, 1.0f), nullptr);
+
+    std::vector<uint32> hits;
+    bvh.QueryRay({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, 100.0f, [&](uint32 proxyId, float tEnter) {
+        hits.push_back(proxyId);
+        return tEnter;  // closest-hit: clip to this entry distance
+    });
+
+    ASSERT_FALSE(hits.empty());
+    EXPECT_EQ(hits.back(), nearProxy);
+}
+
+TEST(SceneSpatialIndex, TracksAttachDetachAndMesh)
+{
+    Mesh cube = MeshFactory::CreateCube();
+    SceneGraph graph;
+
+    SceneNode* a = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+    a->SetMesh(&cube);
+    auto subtree = std::make_unique<SceneNode>();
+    subtree->SetMesh(&cube);
+    SceneNode* b = subtree->AddChild(std::make_unique<SceneNode>());
+    b->SetMesh(&cube);
+    EXPECT_EQ(b->GetGraph(), nullptr);
+
+    SceneNode* subtreePtr = graph.GetRoot()->AddChild(std::move(subtree));
+    EXPECT_EQ(b->GetGraph(), &graph);
+    EXPECT_EQ(graph.GetSpatialNodeCount(), 3u);
+
+    graph.UpdateSpatialIndex();
+    EXPECT_EQ(graph.GetSpatialIndex().GetProxyCount(), 3u);
+
+    auto removed = graph.GetRoot()->RemoveChild(subtreePtr);
+    EXPECT_EQ(graph.GetSpatialNodeCount(), 1u);
+    EXPECT_EQ(graph.GetSpatialIndex().GetProxyCount(), 1u);
+    EXPECT_EQ(b->GetGraph(), nullptr);
+
+    a->SetMesh(nullptr);
+    EXPECT_EQ(graph.GetSpatialNodeCount(), 0u);
+    EXPECT_TRUE(graph.GetSpatialIndex().Validate());
+}
+
+TEST(SceneSpatialIndex, QueriesFollowTransforms)
+{
+    Mesh cube = MeshFactory::CreateCube();
+    SceneGraph graph;
+
+    std::vector<SceneNode*> nodes;
+    for (int i = 0; i < 20; ++i)
+    {
+        SceneNode* node = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+        node->SetMesh(&cube);
+        node->GetTransform().SetPosition({ static_cast<float>(i) * 10.0f, 0.0f, 0.0f });
+        nodes.push_back(node);
+    }
+    graph.UpdateSpatialIndex();
+
+    std::vector<SceneNode*> found;
+    graph.QuerySphere({ 50.0f, 0.0f, 0.0f }, 2.0f, [&](SceneNode* node, const XMMATRIX&) {
+        found.push_back(node);
+    });
+    ASSERT_EQ(found.size(), 1u);
+    EXPECT_EQ(found[0], nodes[5]);
+
+    // Moving the parent moves every child's bounds
+    graph.GetRoot()->GetTransform().SetPosition({ 0.0f, 100.0f, 0.0f });
+    graph.UpdateSpatialIndex();
+
+    found.clear();
+    graph.QuerySphere({ 50.0f, 0.0f, 0.0f }, 2.0f, [&](SceneNode* node, const XMMATRIX&) {
+        found.push_back(node);
+    });
+    EXPECT_TRUE(found.empty());
+
+    float distance = 0.0f;
+    SceneNode* picked = graph.PickNode({ 30.0f, 100.0f, -50.0f }, { 0.0f, 0.0f, 1.0f }, 1000.0f, &distance);
+    EXPECT_EQ(picked, nodes[3]);
+    EXPECT_NEAR(distance, 49.0f, 1e-3f);
+    EXPECT_TRUE(graph.GetSpatialIndex().Validate());
+}
+
+TEST(SceneSpatialIndex, FlatStorageMatchesTree)
+{
+    Mesh cube = MeshFactory::CreateCube();
+    SceneGraph graph;
+    SceneNode* parent = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+    parent->GetTransform().SetRotation({ 0.0f, 0.5f, 0.0f });
+    for (int i = 0; i < 10; ++i)
+    {
+        SceneNode* node = parent->AddChild(std::make_unique<SceneNode>());
+        node->SetMesh(&cube);
+        node->GetTransform().SetPosition({ static_cast<float>(i) * 3.0f, 0.0f, 0.0f });
+    }
+
+    graph.SetStorage(SceneStorage::Flat);
+    graph.UpdateSpatialIndex();
+
+    Camera camera;
+    Math::Frustum frustum = Math::Frustum::FromViewProjection(
+        camera.GetViewMatrix() * camera.GetProjectionMatrix(1.0f));
+
+    uint32 flatCount = 0;
+    graph.QueryFrustum(frustum, [&](SceneNode*, const XMMATRIX&) { flatCount++; });
+
+    SceneGraph treeGraph;
+    SceneNode* treeParent = treeGraph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+    treeParent->GetTransform().SetRotation({ 0.0f, 0.5f, 0.0f });
+    for (int i = 0; i < 10; ++i)
+    {
+        SceneNode* node = treeParent->AddChild(std::make_unique<SceneNode>());
+        node->SetMesh(&cube);
+        node->GetTransform().SetPosition({ static_cast<float>(i) * 3.0f, 0.0f, 0.0f });
+    }
+    treeGraph.UpdateSpatialIndex();
+
+    uint32 treeCount = 0;
+    treeGraph.QueryFrustum(frustum, [&](SceneNode*, const XMMATRIX&) { treeCount++; });
+
+    EXPECT_GT(flatCount, 0u);
+    EXPECT_LT(flatCount, 10u);
+    EXPECT_EQ(flatCount, treeCount);
+}
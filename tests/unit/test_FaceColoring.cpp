@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 #include "Renderer/MeshFactory.h"
 #include "Renderer/FaceColorPalette.h"
+#include "Core/ThreadPool.h"
+#include "../bench/GridMesh.h"
+#include <array>
+#include <utility>
+#include <vector>
 
 using namespace RRE;
 
@@ -74,6 +79,44 @@ void VerifyValidPaletteColors(const Mesh& mesh)
     }
 }
 
+// Undirected graph from an edge list
+AdjacencyGraph MakeGraph(uint32 nodeCount, const std::vector<std::pair<uint32, uint32>>& edges)
+{
+    AdjacencyGraph graph;
+    graph.offsets.assign(nodeCount + 1, 0);
+    for (const auto& edge : edges)
+    {
+        ++graph.offsets[edge.first + 1];
+        ++graph.offsets[edge.second + 1];
+    }
+    for (uint32 n = 0; n < nodeCount; ++n)
+    {
+        graph.offsets[n + 1] += graph.offsets[n];
+    }
+    graph.neighbors.resize(graph.offsets[nodeCount]);
+    std::vector<uint32> fill(graph.offsets.begin(), graph.offsets.end() - 1);
+    for (const auto& edge : edges)
+    {
+        graph.neighbors[fill[edge.first]++] = edge.second;
+        graph.neighbors[fill[edge.second]++] = edge.first;
+    }
+    graph.SortRows();
+    return graph;
+}
+
+void VerifyGraphColoring(const AdjacencyGraph& graph, const std::vector<uint32>& colors)
+{
+    ASSERT_EQ(colors.size(), graph.size());
+    for (uint32 n = 0; n < graph.size(); ++n)
+    {
+        EXPECT_LT(colors[n], FaceColorPalette::PALETTE_SIZE);
+        for (uint32 neighbor : graph[n])
+        {
+            EXPECT_NE(colors[n], colors[neighbor]) << n << " and " << neighbor;
+        }
+    }
+}
+
 } // anonymous namespace
 
 TEST(FaceColoring, TetrahedronAdjacentFacesDifferent)
@@ -107,3 +150,47 @@ TEST(FaceColoring, CylinderAdjacentFacesDifferent)
     VerifyAdjacentFacesHaveDifferentColors(mesh);
     VerifyValidPaletteColors(mesh);
 }
+
+TEST(FaceColoring, DSATURRescuesGreedyOrder)
+{
+    // Crown graph: a_i joined to every b_j with j != i, numbered a0 b0 a1
+    // b1 ...; greedy order needs one color per pair, two are enough
+    const uint32 pairs = 10;
+    std::vector<std::pair<uint32, uint32>> edges;
+    for (uint32 i = 0; i < pairs; ++i)
+    {
+        for (uint32 j = 0; j < pairs; ++j)
+        {
+            if (i != j)
+                edges.push_back({ i * 2, j * 2 + 1 });
+        }
+    }
+    AdjacencyGraph graph = MakeGraph(pairs * 2, edges);
+
+    std::vector<uint32> greedy(graph.size(), UINT32_MAX);
+    FaceColorPalette::RepairFaceColors(graph, greedy);
+    EXPECT_EQ(greedy.back(), UINT32_MAX);
+
+    std::vector<uint32> dsatur = FaceColorPalette::AssignFaceColorsDSATUR(graph);
+    VerifyGraphColoring(graph, dsatur);
+    EXPECT_EQ(FaceColorPalette::CountColors(dsatur), 2u);
+
+    // The default falls back to DSATUR instead of leaving faces uncolored
+    VerifyGraphColoring(graph, FaceColorPalette::AssignFaceColors(graph));
+}
+
+TEST(FaceColoring, ParallelColoringIsValid)
+{
+    // Dual of a 128 x 128 quad grid plus its position graph (valence 6)
+    const uint32 n = 128;
+    std::vector<std::array<uint32, 3>> faces = GridMesh::Faces(n);
+
+    ThreadPool pool(4);
+    AdjacencyGraph faceGraph = AdjacencyGraph::FromFaceEdges(faces);
+    std::vector<uint32> faceColors = FaceColorPalette::AssignFaceColorsParallel(faceGraph, pool, 256);
+    VerifyGraphColoring(faceGraph, faceColors);
+    EXPECT_LE(FaceColorPalette::CountColors(faceColors), 4u);
+
+    AdjacencyGraph positionGraph = AdjacencyGraph::FromPositionEdges(faces, (n + 1) * (n + 1));
+    VerifyGraphColoring(positionGraph, FaceColorPalette::AssignFaceColorsParallel(positionGraph, pool, 256));
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "RHI/FrameRing.h"
+#include <algorithm>
+#include <deque>
+
+using namespace RRE;
+
+TEST(FrameRing, CyclesSlots)
+{
+    FrameRing ring(3);
+    EXPECT_EQ(ring.GetFramesInFlight(), 3u);
+
+    for (uint32 frame = 0; frame < 7; ++frame)
+    {
+        EXPECT_EQ(ring.GetFrameIndex(), frame % 3);
+        ring.EndFrame(ring.NextFenceValue());
+    }
+    EXPECT_EQ(ring.GetFrameNumber(), 7u);
+}
+
+TEST(FrameRing, SlotWaitsForItsOwnPreviousFrame)
+{
+    FrameRing ring(2);
+
+    // Fresh slots never wait
+    EXPECT_EQ(ring.GetWaitValue(), 0u);
+    ring.EndFrame(ring.NextFenceValue());     // frame 0 -> fence 1
+    EXPECT_EQ(ring.GetWaitValue(), 0u);
+    ring.EndFrame(ring.NextFenceValue());     // frame 1 -> fence 2
+
+    // Frame 2 reuses slot 0 and waits only for frame 0, not frame 1
+    EXPECT_EQ(ring.GetFrameIndex(), 0u);
+    EXPECT_EQ(ring.GetWaitValue(), 1u);
+    EXPECT_FALSE(ring.IsSlotReady(0));
+    EXPECT_TRUE(ring.IsSlotReady(1));
+}
+
+TEST(FrameRing, FlushesShareTheFenceTimeline)
+{
+    FrameRing ring(2);
+    ring.EndFrame(ring.NextFenceValue());     // 1
+    uint64 flush = ring.NextFenceValue();     // 2 (e.g. WaitForGPU)
+    ring.EndFrame(ring.NextFenceValue());     // 3
+
+    EXPECT_EQ(flush, 2u);
+    EXPECT_EQ(ring.GetLastFenceValue(), 3u);
+    EXPECT_EQ(ring.GetWaitValue(), 1u);
+}
+
+TEST(FrameRing, SimulatedGpuRunsAtMostNFramesBehind)
+{
+    // The "GPU" completes one queued frame whenever the CPU would block
+    for (uint32 framesInFlight = 1; framesInFlight <= FrameRing::MAX_FRAMES_IN_FLIGHT; ++framesInFlight)
+    {
+        FrameRing ring(framesInFlight);
+        std::deque<uint64> queued;
+        uint64 completed = 0;
+        uint32 maxQueued = 0;
+
+        for (int frame = 0; frame < 20; ++frame)
+        {
+            while (!ring.IsSlotReady(completed))
+            {
+                completed = queued.front();
+                queued.pop_front();
+            }
+
+            uint64 value = ring.NextFenceValue();
+            queued.push_back(value);
+            ring.EndFrame(value);
+            maxQueued = std::max(maxQueued, static_cast<uint32>(queued.size()));
+        }
+        EXPECT_EQ(maxQueued, framesInFlight);
+    }
+}
+
+TEST(FrameRing, ResetClampsAndKeepsFenceTimeline)
+{
+    FrameRing ring(2);
+    ring.EndFrame(ring.NextFenceValue());
+    ring.EndFrame(ring.NextFenceValue());
+
+    ring.Reset(10);
+    EXPECT_EQ(ring.GetFramesInFlight(), FrameRing::MAX_FRAMES_IN_FLIGHT);
+    EXPECT_EQ(ring.GetFrameIndex(), 0u);
+    EXPECT_EQ(ring.GetWaitValue(), 0u);
+    EXPECT_EQ(ring.NextFenceValue(), 3u);
+
+    ring.Reset(0);
+    EXPECT_EQ(ring.GetFramesInFlight(), 1u);
+}
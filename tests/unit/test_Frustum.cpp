@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "Math/Frustum.h"
+#include "Math/Bounds.h"
+#include "Math/MathUtil.h"
+#include "Renderer/MeshFactory.h"
+#include "Scene/Camera.h"
+
+using namespace DirectX;
+using namespace RRE;
+using namespace RRE::Math;
+
+namespace
+{
+
+BoundingSphere MakeSphere(float x, float y, float z, float r)
+{
+    BoundingSphere s;
+    s.center = { x, y, z };
+    s.radius = r;
+    return s;
+}
+
+AABB MakeBox(const XMFLOAT3& center, float halfSize)
+{
+    AABB box;
+    box.min = { center.x - halfSize, center.y - halfSize, center.z - halfSize };
+    box.max = { center.x + halfSize, center.y + halfSize, center.z + halfSize };
+    return box;
+}
+
+// Default camera: at (0,0,-5) looking at the origin, 45 deg FOV, near 0.1, far 100
+Frustum DefaultFrustum()
+{
+    Camera camera;
+    return Frustum::FromViewProjection(camera.GetViewMatrix() * camera.GetProjectionMatrix(1.0f));
+}
+
+} // anonymous namespace
+
+TEST(Frustum, PlanesAreNormalized)
+{
+    Frustum frustum = DefaultFrustum();
+    for (int i = 0; i < Frustum::PLANE_COUNT; ++i)
+    {
+        XMFLOAT4 p = frustum.GetPlane(i);
+        EXPECT_TRUE(NearEqual(p.x * p.x + p.y * p.y + p.z * p.z, 1.0f, 1e-4f));
+    }
+}
+
+TEST(Frustum, SphereInsideAndOutside)
+{
+    Frustum frustum = DefaultFrustum();
+
+    EXPECT_TRUE(frustum.IntersectsSphere(MakeSphere(0.0f, 0.0f, 0.0f, 1.0f)));
+    EXPECT_FALSE(frustum.IntersectsSphere(MakeSphere(0.0f, 0.0f, -10.0f, 1.0f)));   // behind camera
+    EXPECT_FALSE(frustum.IntersectsSphere(MakeSphere(50.0f, 0.0f, 0.0f, 1.0f)));    // far right
+    EXPECT_FALSE(frustum.IntersectsSphere(MakeSphere(0.0f, 0.0f, 200.0f, 1.0f)));   // beyond far plane
+}
+
+TEST(Frustum, SphereStraddlingPlaneIsVisible)
+{
+    Frustum frustum = DefaultFrustum();
+
+    // Half-width at z=0 (distance 5) is 5*tan(22.5 deg) ~= 2.07
+    EXPECT_FALSE(frustum.IntersectsSphere(MakeSphere(4.0f, 0.0f, 0.0f, 1.0f)));
+    EXPECT_TRUE(frustum.IntersectsSphere(MakeSphere(4.0f, 0.0f, 0.0f, 2.5f)));
+}
+
+TEST(Frustum, AABBInsideAndOutside)
+{
+    Frustum frustum = DefaultFrustum();
+
+    EXPECT_TRUE(frustum.IntersectsAABB(MakeBox({ 0.0f, 0.0f, 0.0f }, 1.0f)));
+    EXPECT_TRUE(frustum.IntersectsAABB(MakeBox({ 2.5f, 0.0f, 0.0f }, 1.0f)));
+    EXPECT_FALSE(frustum.IntersectsAABB(MakeBox({ 0.0f, -20.0f, 0.0f }, 1.0f)));
+    EXPECT_FALSE(frustum.IntersectsAABB(MakeBox({ 0.0f, 0.0f, -8.0f }, 1.0f)));
+}
+
+TEST(Frustum, OrthographicProjection)
+{
+    Camera camera;
+    camera.SetProjectionMode(ProjectionMode::Orthographic);
+    Frustum frustum = Frustum::FromViewProjection(camera.GetViewMatrix() * camera.GetProjectionMatrix(1.0f));
+
+    EXPECT_TRUE(frustum.IntersectsSphere(MakeSphere(0.0f, 0.0f, 0.0f, 0.5f)));
+    EXPECT_FALSE(frustum.IntersectsSphere(MakeSphere(30.0f, 0.0f, 0.0f, 0.5f)));
+}
+
+TEST(Bounds, TransformAABBTranslatesAndScales)
+{
+    AABB box = MakeBox({ 0.0f, 0.0f, 0.0f }, 1.0f);
+    XMMATRIX world = XMMatrixScaling(2.0f, 1.0f, 1.0f) * XMMatrixTranslation(5.0f, 0.0f, 0.0f);
+
+    AABB result = TransformAABB(box, world);
+    EXPECT_TRUE(NearEqualVector3(result.min, { 3.0f, -1.0f, -1.0f }));
+    EXPECT_TRUE(NearEqualVector3(result.max, { 7.0f, 1.0f, 1.0f }));
+}
+
+TEST(Bounds, TransformAABBRotationEnclosesBox)
+{
+    AABB box = MakeBox({ 0.0f, 0.0f, 0.0f }, 1.0f);
+    AABB result = TransformAABB(box, XMMatrixRotationY(XM_PIDIV4));
+
+    float r = std::sqrt(2.0f);
+    EXPECT_TRUE(NearEqualVector3(result.min, { -r, -1.0f, -r }, 1e-4f));
+    EXPECT_TRUE(NearEqualVector3(result.max, { r, 1.0f, r }, 1e-4f));
+}
+
+TEST(Bounds, TransformSphereUsesLargestScale)
+{
+    BoundingSphere sphere = MakeSphere(1.0f, 0.0f, 0.0f, 1.0f);
+    BoundingSphere result = TransformSphere(sphere, XMMatrixScaling(1.0f, 3.0f, 2.0f));
+
+    EXPECT_TRUE(NearEqualVector3(result.center, { 1.0f, 0.0f, 0.0f }));
+    EXPECT_TRUE(NearEqual(result.radius, 3.0f));
+}
+
+TEST(Bounds, MeshFactoryComputesBounds)
+{
+    Mesh cube = MeshFactory::CreateCube();
+    ASSERT_TRUE(cube.localBounds.IsValid());
+    ASSERT_TRUE(cube.localSphere.IsValid());
+
+    for (const auto& v : cube.vertices)
+    {
+        EXPECT_GE(v.position.x, cube.localBounds.min.x);
+        EXPECT_LE(v.position.x, cube.localBounds.max.x);
+        float dx = v.position.x - cube.localSphere.center.x;
+        float dy = v.position.y - cube.localSphere.center.y;
+        float dz = v.position.z - cube.localSphere.center.z;
+        EXPECT_LE(std::sqrt(dx * dx + dy * dy + dz * dz), cube.localSphere.radius + 1e-5f);
+    }
+
+    Mesh empty;
+    empty.ComputeBounds();
+    EXPECT_FALSE(empty.localBounds.IsValid());
+    EXPECT_FALSE(empty.localSphere.IsValid());
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "Core/ImageDiff.h"
+#include <vector>
+
+using namespace RRE;
+
+namespace
+{
+
+uint32 Rgb(uint32 r, uint32 g, uint32 b)
+{
+    return r | (g << 8) | (b << 16) | 0xFF000000u;
+}
+
+} // anonymous namespace
+
+TEST(ImageDiff, IdenticalImagesMatch)
+{
+    std::vector<uint32> image(37 * 11);
+    for (uint32 i = 0; i < image.size(); ++i)
+    {
+        image[i] = i * 2654435761u;
+    }
+
+    ImageDiffResult diff = ImageDiff::Compare(image.data(), 37, image.data(), 37, 37, 11, 0.0f);
+    EXPECT_EQ(diff.differentPixels, 0u);
+    EXPECT_EQ(diff.maxDelta, 0.0f);
+}
+
+TEST(ImageDiff, BlackAgainstWhiteIsMaximal)
+{
+    // 7 pixels wide: one SSE step plus a scalar tail per row
+    std::vector<uint32> black(7 * 3, Rgb(0, 0, 0));
+    std::vector<uint32> white(7 * 3, Rgb(255, 255, 255));
+
+    ImageDiffResult diff = ImageDiff::Compare(black.data(), 7, white.data(), 7, 7, 3, 0.1f);
+    EXPECT_EQ(diff.differentPixels, 21u);
+    EXPECT_NEAR(diff.maxDelta, 1.0f, 1e-3f);
+}
+
+TEST(ImageDiff, LumaWeighsMoreThanChroma)
+{
+    // Same RGB distance: a step in green changes luma far more than in blue
+    std::vector<uint32> base(4, Rgb(100, 100, 100));
+    std::vector<uint32> greener(4, Rgb(100, 140, 100));
+    std::vector<uint32> bluer(4, Rgb(100, 100, 140));
+
+    ImageDiffResult green = ImageDiff::Compare(base.data(), 4, greener.data(), 4, 4, 1, 0.1f);
+    ImageDiffResult blue = ImageDiff::Compare(base.data(), 4, bluer.data(), 4, 4, 1, 0.1f);
+    EXPECT_GT(green.maxDelta, blue.maxDelta);
+    EXPECT_EQ(green.differentPixels, 4u);
+    EXPECT_EQ(blue.differentPixels, 0u);
+}
+
+TEST(ImageDiff, PitchAndDiffImage)
+{
+    // Padded rows; one changed pixel in the SSE part and one in the tail
+    const uint32 width = 6;
+    const uint32 height = 2;
+    std::vector<uint32> a(8 * height, Rgb(50, 50, 50));
+    std::vector<uint32> b(10 * height, Rgb(50, 50, 50));
+    b[10 + 1] = Rgb(250, 250, 250);
+    b[5] = Rgb(0, 0, 255);
+    a[6] = Rgb(255, 255, 255);  // padding, must be ignored
+
+    std::vector<uint32> diffImage(width * height, 0);
+    ImageDiffResult diff = ImageDiff::Compare(a.data(), 8, b.data(), 10, width, height, 0.1f, diffImage.data());
+    EXPECT_EQ(diff.differentPixels, 2u);
+    EXPECT_EQ(diffImage[width + 1], 0xFF0000FFu);
+    EXPECT_EQ(diffImage[5], 0xFF0000FFu);
+
+    // Unchanged pixels are a light gray
+    uint32 gray = diffImage[0];
+    EXPECT_EQ(gray & 0xFF, (gray >> 8) & 0xFF);
+    EXPECT_GT(gray & 0xFF, 200u);
+}
@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include "Core/ImageWriter.h"
+#include "Core/ImageReader.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace RRE;
+
+namespace
+{
+
+std::vector<uint8> ReadFile(const std::string& path)
+{
+    std::vector<uint8> bytes;
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file)
+        return bytes;
+    int c;
+    while ((c = std::fgetc(file)) != EOF)
+    {
+        bytes.push_back(static_cast<uint8>(c));
+    }
+    std::fclose(file);
+    return bytes;
+}
+
+uint32 ReadBigEndian(const uint8* p)
+{
+    return (uint32(p[0]) << 24) | (uint32(p[1]) << 16) | (uint32(p[2]) << 8) | uint32(p[3]);
+}
+
+// Bitwise reference CRC-32 (independent of the writer's table)
+uint32 ReferenceCrc(const uint8* data, size_t size)
+{
+    uint32 crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i)
+    {
+        crc ^= data[i];
+        for (int k = 0; k < 8; ++k)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+struct Chunk
+{
+    std::string type;
+    std::vector<uint8> data;
+};
+
+// Splits a PNG into chunks, verifying each CRC
+bool ParseChunks(const std::vector<uint8>& png, std::vector<Chunk>& chunks)
+{
+    static const uint8 signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    if (png.size() < 8 || !std::equal(signature, signature + 8, png.begin()))
+        return false;
+
+    size_t offset = 8;
+    while (offset + 12 <= png.size())
+    {
+        uint32 length = ReadBigEndian(&png[offset]);
+        if (offset + 12 + length > png.size())
+            return false;
+        if (ReferenceCrc(&png[offset + 4], length + 4) != ReadBigEndian(&png[offset + 8 + length]))
+            return false;
+
+        Chunk chunk;
+        chunk.type.assign(png.begin() + offset + 4, png.begin() + offset + 8);
+        chunk.data.assign(png.begin() + offset + 8, png.begin() + offset + 8 + length);
+        chunks.push_back(std::move(chunk));
+        offset += 12 + length;
+    }
+    return offset == png.size();
+}
+
+} // anonymous namespace
+
+TEST(ImageWriter, PNGRoundTripsStoredBlocks)
+{
+    // Large enough for the scanlines to span several 64 KB stored blocks
+    const uint32 width = 150;
+    const uint32 height = 120;
+    const uint32 pitch = 152;
+    std::vector<uint32> pixels(pitch * height);
+    for (uint32 i = 0; i < pixels.size(); ++i)
+    {
+        pixels[i] = i * 2654435761u;
+    }
+
+    std::string path = ::testing::TempDir() + "image_writer.png";
+    ASSERT_TRUE(ImageWriter::WritePNG(path.c_str(), pixels.data(), width, height, pitch));
+    std::vector<uint8> png = ReadFile(path);
+    std::remove(path.c_str());
+
+    std::vector<Chunk> chunks;
+    ASSERT_TRUE(ParseChunks(png, chunks));
+    ASSERT_EQ(chunks.size(), 3u);
+    EXPECT_EQ(chunks[0].type, "IHDR");
+    EXPECT_EQ(chunks[1].type, "IDAT");
+    EXPECT_EQ(chunks[2].type, "IEND");
+
+    const std::vector<uint8>& ihdr = chunks[0].data;
+    ASSERT_EQ(ihdr.size(), 13u);
+    EXPECT_EQ(ReadBigEndian(&ihdr[0]), width);
+    EXPECT_EQ(ReadBigEndian(&ihdr[4]), height);
+    EXPECT_EQ(ihdr[8], 8);
+    EXPECT_EQ(ihdr[9], 6);
+
+    // zlib header, stored blocks, Adler-32
+    const std::vector<uint8>& idat = chunks[1].data;
+    ASSERT_GT(idat.size(), 6u);
+    EXPECT_EQ((idat[0] * 256 + idat[1]) % 31, 0);
+    std::vector<uint8> raw;
+    size_t offset = 2;
+    bool last = false;
+    int blocks = 0;
+    while (!last)
+    {
+        ASSERT_LE(offset + 5, idat.size());
+        last = (idat[offset] & 1) != 0;
+        ASSERT_EQ(idat[offset] >> 1, 0);
+        uint32 length = idat[offset + 1] | (idat[offset + 2] << 8);
+        uint32 inverse = idat[offset + 3] | (idat[offset + 4] << 8);
+        ASSERT_EQ(length ^ 0xFFFFu, inverse);
+        ASSERT_LE(offset + 5 + length, idat.size());
+        raw.insert(raw.end(), idat.begin() + offset + 5, idat.begin() + offset + 5 + length);
+        offset += 5 + length;
+        blocks++;
+    }
+    EXPECT_GT(blocks, 1);
+    ASSERT_EQ(offset + 4, idat.size());
+
+    uint32 a = 1;
+    uint32 b = 0;
+    for (uint8 byte : raw)
+    {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    EXPECT_EQ(ReadBigEndian(&idat[offset]), (b << 16) | a);
+
+    // Unfiltered RGBA scanlines
+    ASSERT_EQ(raw.size(), height * (width * 4 + 1));
+    for (uint32 y = 0; y < height; ++y)
+    {
+        const uint8* row = &raw[y * (width * 4 + 1)];
+        ASSERT_EQ(row[0], 0);
+        for (uint32 x = 0; x < width; ++x)
+        {
+            uint32 p = pixels[y * pitch + x];
+            uint32 decoded = row[1 + x * 4] | (row[2 + x * 4] << 8) |
+                (row[3 + x * 4] << 16) | (uint32(row[4 + x * 4]) << 24);
+            ASSERT_EQ(decoded, p);
+        }
+    }
+}
+
+TEST(ImageWriter, PPMRoundTripsThroughReader)
+{
+    const uint32 width = 5;
+    const uint32 height = 3;
+    const uint32 pitch = 8;
+    std::vector<uint32> pixels(pitch * height);
+    for (uint32 i = 0; i < pixels.size(); ++i)
+    {
+        pixels[i] = i * 2654435761u;
+    }
+
+    std::string path = ::testing::TempDir() + "image_writer.ppm";
+    ASSERT_TRUE(ImageWriter::WritePPM(path.c_str(), pixels.data(), width, height, pitch));
+
+    std::vector<uint32> loaded;
+    uint32 loadedWidth = 0;
+    uint32 loadedHeight = 0;
+    ASSERT_TRUE(ImageReader::ReadPPM(path.c_str(), loaded, loadedWidth, loadedHeight));
+    std::remove(path.c_str());
+
+    ASSERT_EQ(loadedWidth, width);
+    ASSERT_EQ(loadedHeight, height);
+    ASSERT_EQ(loaded.size(), width * height);
+    for (uint32 y = 0; y < height; ++y)
+    {
+        for (uint32 x = 0; x < width; ++x)
+        {
+            // Alpha is not stored
+            EXPECT_EQ(loaded[y * width + x], pixels[y * pitch + x] | 0xFF000000u);
+        }
+    }
+
+    EXPECT_FALSE(ImageReader::ReadPPM(path.c_str(), loaded, loadedWidth, loadedHeight));
+}
+
+TEST(ImageWriter, RejectsInvalidArguments)
+{
+    uint32 pixel = 0;
+    std::string path = ::testing::TempDir() + "image_writer_invalid.png";
+    EXPECT_FALSE(ImageWriter::WritePNG(nullptr, &pixel, 1, 1, 1));
+    EXPECT_FALSE(ImageWriter::WritePNG(path.c_str(), nullptr, 1, 1, 1));
+    EXPECT_FALSE(ImageWriter::WritePNG(path.c_str(), &pixel, 0, 1, 1));
+    EXPECT_FALSE(ImageWriter::WritePPM(path.c_str(), &pixel, 1, 0, 1));
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "RHI/LinearAllocator.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace RRE;
+
+namespace
+{
+
+// CPU-only page source; fake GPU addresses start at distinct 1 MB boundaries
+class HeapPageSource : public ILinearPageSource
+{
+public:
+    bool CreatePage(uint64 size, LinearPage& page) override
+    {
+        if (failNext)
+            return false;
+
+        m_blocks.push_back(std::make_unique<uint8[]>(size));
+        page.cpuAddress = m_blocks.back().get();
+        page.gpuAddress = (++m_nextId) << 20;
+        page.size = size;
+        page.handle = page.cpuAddress;
+        created++;
+        return true;
+    }
+
+    void DestroyPage(LinearPage&) override { destroyed++; }
+
+    bool failNext = false;
+    uint32 created = 0;
+    uint32 destroyed = 0;
+
+private:
+    std::vector<std::unique_ptr<uint8[]>> m_blocks;
+    uint64 m_nextId = 0;
+};
+
+} // anonymous namespace
+
+TEST(LinearAllocator, AlignsAndPacksWithinPage)
+{
+    HeapPageSource source;
+    LinearAllocator allocator(4096);
+    allocator.SetPageSource(&source);
+
+    LinearAllocation a;
+    LinearAllocation b;
+    LinearAllocation c;
+    ASSERT_TRUE(allocator.Allocate(100, 256, a));
+    ASSERT_TRUE(allocator.Allocate(100, 256, b));
+    ASSERT_TRUE(allocator.Allocate(8, 16, c));
+
+    EXPECT_EQ(a.gpuAddress % 256, 0u);
+    EXPECT_EQ(b.gpuAddress - a.gpuAddress, 256u);
+    EXPECT_EQ(c.gpuAddress - b.gpuAddress, 112u);
+    EXPECT_EQ(b.cpuAddress - a.cpuAddress, 256);
+    EXPECT_EQ(allocator.GetPageCount(), 1u);
+    EXPECT_EQ(allocator.GetFrameBytes(), 208u);
+}
+
+TEST(LinearAllocator, GrowsPastOnePage)
+{
+    HeapPageSource source;
+    LinearAllocator allocator(4096);
+    allocator.SetPageSource(&source);
+
+    // 1000 constant slots: well past what one page (16 slots) holds
+    std::vector<uint64> addresses;
+    for (int i = 0; i < 1000; ++i)
+    {
+        LinearAllocation alloc;
+        ASSERT_TRUE(allocator.Allocate(224, 256, alloc));
+        addresses.push_back(alloc.gpuAddress);
+    }
+    EXPECT_EQ(allocator.GetPageCount(), 63u);
+
+    // No two slots overlap
+    std::sort(addresses.begin(), addresses.end());
+    for (size_t i = 1; i < addresses.size(); ++i)
+    {
+        EXPECT_GE(addresses[i] - addresses[i - 1], 256u);
+    }
+}
+
+TEST(LinearAllocator, RecyclesOnlyAfterFence)
+{
+    HeapPageSource source;
+    LinearAllocator allocator(4096);
+    allocator.SetPageSource(&source);
+
+    LinearAllocation alloc;
+    for (int i = 0; i < 40; ++i)
+    {
+        ASSERT_TRUE(allocator.Allocate(256, 256, alloc));
+    }
+    EXPECT_EQ(allocator.GetPageCount(), 3u);
+    allocator.FinishFrame(1);
+    EXPECT_EQ(allocator.GetRetiredPageCount(), 3u);
+
+    // The GPU has not reached fence 1: the next frame needs fresh pages
+    allocator.Recycle(0);
+    EXPECT_EQ(allocator.GetFreePageCount(), 0u);
+    ASSERT_TRUE(allocator.Allocate(256, 256, alloc));
+    EXPECT_EQ(allocator.GetPageCount(), 4u);
+    allocator.FinishFrame(2);
+
+    // Fence 1 done: frame 1's pages come back, frame 2's stay retired
+    allocator.Recycle(1);
+    EXPECT_EQ(allocator.GetFreePageCount(), 3u);
+    EXPECT_EQ(allocator.GetRetiredPageCount(), 1u);
+
+    // Steady state allocates no new pages
+    for (int i = 0; i < 40; ++i)
+    {
+        ASSERT_TRUE(allocator.Allocate(256, 256, alloc));
+    }
+    EXPECT_EQ(allocator.GetPageCount(), 4u);
+    EXPECT_EQ(source.created, 4u);
+}
+
+TEST(LinearAllocator, LargeRequestsGetDedicatedPage)
+{
+    HeapPageSource source;
+    LinearAllocator allocator(4096);
+    allocator.SetPageSource(&source);
+
+    LinearAllocation small;
+    LinearAllocation large;
+    ASSERT_TRUE(allocator.Allocate(64, 16, small));
+    ASSERT_TRUE(allocator.Allocate(100000, 16, large));
+    EXPECT_EQ(large.size, 100000u);
+    EXPECT_EQ(allocator.GetPageCount(), 2u);
+
+    allocator.FinishFrame(1);
+    allocator.Recycle(1);
+
+    // The large page is reused for the next large request
+    ASSERT_TRUE(allocator.Allocate(90000, 16, large));
+    EXPECT_EQ(allocator.GetPageCount(), 2u);
+
+    allocator.Release();
+    EXPECT_EQ(source.destroyed, 2u);
+    EXPECT_EQ(allocator.GetPageCount(), 0u);
+}
+
+TEST(LinearAllocator, FailsWithoutPages)
+{
+    LinearAllocator allocator(4096);
+    LinearAllocation alloc;
+    EXPECT_FALSE(allocator.Allocate(16, 16, alloc));
+
+    HeapPageSource source;
+    source.failNext = true;
+    allocator.SetPageSource(&source);
+    EXPECT_FALSE(allocator.Allocate(16, 16, alloc));
+}
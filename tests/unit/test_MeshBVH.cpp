@@ -0,0 +1,275 @@
+#include <gtest/gtest.h>
+#include "Renderer/MeshBVH.h"
+#include "Renderer/MeshFactory.h"
+#include "Scene/SceneGraph.h"
+#include "Scene/SceneNode.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+using namespace RRE;
+
+namespace
+{
+
+// Reference Moller-Trumbore over every triangle
+MeshBVH::Hit BruteForceRaycast(const Mesh& mesh, const XMFLOAT3& origin, const XMFLOAT3& direction)
+{
+    MeshBVH::Hit best;
+    XMVECTOR o = XMLoadFloat3(&origin);
+    XMVECTOR d = XMLoadFloat3(&direction);
+    for (uint32 tri = 0; tri < mesh.GetPolygonCount(); ++tri)
+    {
+        XMVECTOR v0 = XMLoadFloat3(&mesh.vertices[mesh.indices[tri * 3 + 0]].position);
+        XMVECTOR v1 = XMLoadFloat3(&mesh.vertices[mesh.indices[tri * 3 + 1]].position);
+        XMVECTOR v2 = XMLoadFloat3(&mesh.vertices[mesh.indices[tri * 3 + 2]].position);
+        XMVECTOR e1 = XMVectorSubtract(v1, v0);
+        XMVECTOR e2 = XMVectorSubtract(v2, v0);
+        XMVECTOR p = XMVector3Cross(d, e2);
+        float det = XMVectorGetX(XMVector3Dot(e1, p));
+        if (std::fabs(det) < 1e-12f)
+            continue;
+        float invDet = 1.0f / det;
+        XMVECTOR s = XMVectorSubtract(o, v0);
+        float u = XMVectorGetX(XMVector3Dot(s, p)) * invDet;
+        XMVECTOR q = XMVector3Cross(s, e1);
+        float v = XMVectorGetX(XMVector3Dot(d, q)) * invDet;
+        float t = XMVectorGetX(XMVector3Dot(e2, q)) * invDet;
+        if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t >= 0.0f && t < best.distance)
+        {
+            best.triangle = tri;
+            best.distance = t;
+            best.u = u;
+            best.v = v;
+        }
+    }
+    return best;
+}
+
+// Rays from a shell around the origin aimed at jittered points near it
+void MakeRays(uint32 count, uint32 seed, std::vector<XMFLOAT3>& origins, std::vector<XMFLOAT3>& directions)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    origins.clear();
+    directions.clear();
+    for (uint32 i = 0; i < count; ++i)
+    {
+        XMVECTOR from = XMVectorScale(XMVector3Normalize(XMVectorSet(unit(rng), unit(rng), unit(rng), 0.0f)), 3.0f);
+        XMVECTOR to = XMVectorSet(unit(rng) * 0.8f, unit(rng) * 0.8f, unit(rng) * 0.8f, 0.0f);
+        XMFLOAT3 o;
+        XMFLOAT3 d;
+        XMStoreFloat3(&o, from);
+        XMStoreFloat3(&d, XMVector3Normalize(XMVectorSubtract(to, from)));
+        origins.push_back(o);
+        directions.push_back(d);
+    }
+}
+
+XMFLOAT3 HitPoint(const Mesh& mesh, uint32 triangle, float u, float v)
+{
+    XMVECTOR v0 = XMLoadFloat3(&mesh.vertices[mesh.indices[triangle * 3 + 0]].position);
+    XMVECTOR v1 = XMLoadFloat3(&mesh.vertices[mesh.indices[triangle * 3 + 1]].position);
+    XMVECTOR v2 = XMLoadFloat3(&mesh.vertices[mesh.indices[triangle * 3 + 2]].position);
+    XMVECTOR p = XMVectorAdd(XMVectorScale(v0, 1.0f - u - v),
+        XMVectorAdd(XMVectorScale(v1, u), XMVectorScale(v2, v)));
+    XMFLOAT3 result;
+    XMStoreFloat3(&result, p);
+    return result;
+}
+
+} // anonymous namespace
+
+TEST(MeshBVH, FactoryMeshesHaveTriangleBVH)
+{
+    Mesh sphere = MeshFactory::CreateSphere();
+    ASSERT_NE(sphere.triangleBVH, nullptr);
+    EXPECT_EQ(sphere.triangleBVH->GetTriangleCount(), sphere.GetPolygonCount());
+
+    Math::AABB bounds = sphere.triangleBVH->GetBounds();
+    EXPECT_NEAR(bounds.min.x, sphere.localBounds.min.x, 1e-5f);
+    EXPECT_NEAR(bounds.max.y, sphere.localBounds.max.y, 1e-5f);
+}
+
+TEST(MeshBVH, RaycastMatchesBruteForce)
+{
+    Mesh sphere = MeshFactory::CreateSphere(32, 32);
+    const MeshBVH& bvh = *sphere.triangleBVH;
+
+    std::vector<XMFLOAT3> origins;
+    std::vector<XMFLOAT3> directions;
+    MakeRays(500, 11, origins, directions);
+
+    for (size_t i = 0; i < origins.size(); ++i)
+    {
+        MeshBVH::Hit expected = BruteForceRaycast(sphere, origins[i], directions[i]);
+        MeshBVH::Hit hit;
+        bool found = bvh.Raycast(origins[i], directions[i], hit);
+
+        ASSERT_EQ(found, expected.triangle != MeshBVH::INVALID_TRIANGLE);
+        if (found)
+        {
+            EXPECT_NEAR(hit.distance, expected.distance, 1e-4f);
+        }
+    }
+}
+
+TEST(MeshBVH, MissAndMaxDistance)
+{
+    Mesh cube = MeshFactory::CreateCube();
+    const MeshBVH& bvh = *cube.triangleBVH;
+
+    MeshBVH::Hit hit;
+    EXPECT_FALSE(bvh.Raycast({ 0.0f, 5.0f, -5.0f }, { 0.0f, 0.0f, 1.0f }, hit));
+    EXPECT_EQ(hit.triangle, MeshBVH::INVALID_TRIANGLE);
+
+    // The cube face at z = -1 is 4 units away
+    hit.distance = 3.5f;
+    EXPECT_FALSE(bvh.Raycast({ 0.0f, 0.0f, -5.0f }, { 0.0f, 0.0f, 1.0f }, hit));
+    hit.distance = FLT_MAX;
+    ASSERT_TRUE(bvh.Raycast({ 0.0f, 0.0f, -5.0f }, { 0.0f, 0.0f, 1.0f }, hit));
+    EXPECT_NEAR(hit.distance, 4.0f, 1e-5f);
+
+    // Barycentrics reconstruct the hit point
+    XMFLOAT3 p = HitPoint(cube, hit.triangle, hit.u, hit.v);
+    EXPECT_NEAR(p.x, 0.0f, 1e-5f);
+    EXPECT_NEAR(p.y, 0.0f, 1e-5f);
+    EXPECT_NEAR(p.z, -1.0f, 1e-5f);
+}
+
+TEST(MeshBVH, PacketMatchesSingleRay)
+{
+    Mesh sphere = MeshFactory::CreateSphere(24, 24);
+    const MeshBVH& bvh = *sphere.triangleBVH;
+
+    std::vector<XMFLOAT3> origins;
+    std::vector<XMFLOAT3> directions;
+    MakeRays(402, 5, origins, directions);
+
+    for (size_t base = 0; base < origins.size(); base += 4)
+    {
+        uint32 lanes = static_cast<uint32>(std::min<size_t>(4, origins.size() - base));
+        Math::RayPacket4 packet = Math::RayPacket4::Load(&origins[base], &directions[base], lanes);
+        MeshBVH::Hit hits[4];
+        for (uint32 lane = lanes; lane < 4; ++lane)
+        {
+            hits[lane].distance = -1.0f;
+        }
+        uint32 improved = bvh.Raycast4(packet, hits);
+
+        for (uint32 lane = 0; lane < lanes; ++lane)
+        {
+            MeshBVH::Hit expected;
+            bool found = bvh.Raycast(origins[base + lane], directions[base + lane], expected);
+            ASSERT_EQ(found, (improved & (1u << lane)) != 0);
+            if (found)
+            {
+                EXPECT_EQ(hits[lane].triangle, expected.triangle);
+                EXPECT_NEAR(hits[lane].distance, expected.distance, 1e-4f);
+            }
+        }
+        for (uint32 lane = lanes; lane < 4; ++lane)
+        {
+            EXPECT_EQ(improved & (1u << lane), 0u);
+        }
+    }
+}
+
+TEST(MeshBVH, LargeMeshStaysShallow)
+{
+    Mesh sphere = MeshFactory::CreateSphere(256, 256);
+    const MeshBVH& bvh = *sphere.triangleBVH;
+    EXPECT_EQ(bvh.GetTriangleCount(), sphere.GetPolygonCount());
+    EXPECT_LT(bvh.GetNodeCount(), 2 * sphere.GetPolygonCount());
+
+    MeshBVH::Hit hit;
+    ASSERT_TRUE(bvh.Raycast({ 0.0f, 0.0f, -3.0f }, { 0.0f, 0.0f, 1.0f }, hit));
+    EXPECT_NEAR(hit.distance, 2.0f, 1e-3f);
+}
+
+TEST(SceneRaycast, ReturnsClosestNodeTriangleAndBarycentrics)
+{
+    Mesh cube = MeshFactory::CreateCube();
+    SceneGraph graph;
+
+    SceneNode* near = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+    near->SetMesh(&cube);
+    near->GetTransform().SetPosition({ 0.0f, 0.0f, 5.0f });
+    near->GetTransform().SetScale({ 2.0f, 2.0f, 2.0f });
+    SceneNode* far = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+    far->SetMesh(&cube);
+    far->GetTransform().SetPosition({ 0.0f, 0.0f, 10.0f });
+    graph.UpdateSpatialIndex();
+
+    RaycastHit hit = graph.Raycast({ 0.25f, 0.25f, 0.0f }, { 0.0f, 0.0f, 1.0f });
+    ASSERT_TRUE(hit.IsHit());
+    EXPECT_EQ(hit.node, near);
+    EXPECT_NEAR(hit.distance, 3.0f, 1e-4f);
+
+    // Barycentrics are in mesh space: the scaled face at z = -1 maps to z = 3
+    XMFLOAT3 p = HitPoint(cube, hit.triangle, hit.u, hit.v);
+    EXPECT_NEAR(p.x, 0.125f, 1e-5f);
+    EXPECT_NEAR(p.y, 0.125f, 1e-5f);
+    EXPECT_NEAR(p.z, -1.0f, 1e-5f);
+
+    // A ray off to the side misses both cubes
+    EXPECT_FALSE(graph.Raycast({ 3.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }).IsHit());
+
+    // Limited distance stops short of the near cube
+    EXPECT_FALSE(graph.Raycast({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, 2.5f).IsHit());
+
+    // Moving the near cube away exposes the far one
+    near->GetTransform().SetPosition({ 0.0f, 20.0f, 5.0f });
+    graph.UpdateSpatialIndex();
+    hit = graph.Raycast({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f });
+    ASSERT_TRUE(hit.IsHit());
+    EXPECT_EQ(hit.node, far);
+    EXPECT_NEAR(hit.distance, 9.0f, 1e-4f);
+}
+
+TEST(SceneRaycast, BatchMatchesSingleRays)
+{
+    Mesh sphere = MeshFactory::CreateSphere(16, 16);
+    SceneGraph graph;
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> pos(-10.0f, 10.0f);
+    for (int i = 0; i < 64; ++i)
+    {
+        SceneNode* node = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+        node->SetMesh(&sphere);
+        node->GetTransform().SetPosition({ pos(rng), pos(rng), pos(rng) });
+        node->GetTransform().SetRotation({ pos(rng), pos(rng), 0.0f });
+    }
+    graph.UpdateSpatialIndex();
+
+    std::vector<XMFLOAT3> origins;
+    std::vector<XMFLOAT3> directions;
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    for (int i = 0; i < 257; ++i)
+    {
+        origins.push_back({ pos(rng), pos(rng), -20.0f });
+        XMFLOAT3 d;
+        XMStoreFloat3(&d, XMVector3Normalize(XMVectorSet(unit(rng) * 0.3f, unit(rng) * 0.3f, 1.0f, 0.0f)));
+        directions.push_back(d);
+    }
+
+    std::vector<RaycastHit> batch(origins.size());
+    graph.RaycastBatch(origins.data(), directions.data(), static_cast<uint32>(origins.size()), batch.data());
+
+    uint32 hitCount = 0;
+    for (size_t i = 0; i < origins.size(); ++i)
+    {
+        RaycastHit single = graph.Raycast(origins[i], directions[i]);
+        ASSERT_EQ(batch[i].IsHit(), single.IsHit()) << "ray " << i;
+        if (single.IsHit())
+        {
+            hitCount++;
+            EXPECT_EQ(batch[i].node, single.node);
+            EXPECT_EQ(batch[i].triangle, single.triangle);
+            EXPECT_NEAR(batch[i].distance, single.distance, 1e-4f);
+        }
+    }
+    EXPECT_GT(hitCount, 0u);
+}
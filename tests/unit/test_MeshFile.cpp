@@ -0,0 +1,360 @@
+#include <gtest/gtest.h>
+#include "Renderer/MeshFile.h"
+#include "Renderer/MeshFactory.h"
+#include "Renderer/MeshletBuilder.h"
+#include "Renderer/MeshSimplifier.h"
+#include "Renderer/Renderer.h"
+#include "RHI/Null/NullDevice.h"
+#include "Scene/SceneGraph.h"
+#include "Scene/SceneNode.h"
+#include "Scene/Camera.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace RRE;
+
+namespace
+{
+
+// Sphere with meshlets and a LOD chain, so every section is populated
+Mesh MakeDetailedMesh()
+{
+    Mesh mesh = MeshFactory::CreateSphere(32, 32);
+    MeshletBuilder::Build(mesh);
+    MeshSimplifier::BuildLODChain(mesh, 3);
+    return mesh;
+}
+
+template <typename T>
+bool SameBytes(const std::vector<T>& a, const std::vector<T>& b)
+{
+    return a.size() == b.size() && (a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+}
+
+void ExpectSameMesh(const Mesh& expected, const Mesh& actual)
+{
+    EXPECT_TRUE(SameBytes(expected.vertices, actual.vertices));
+    EXPECT_TRUE(SameBytes(expected.indices, actual.indices));
+    EXPECT_TRUE(SameBytes(expected.faceAdjacency.offsets, actual.faceAdjacency.offsets));
+    EXPECT_TRUE(SameBytes(expected.faceAdjacency.neighbors, actual.faceAdjacency.neighbors));
+    EXPECT_TRUE(SameBytes(expected.meshlets, actual.meshlets));
+    EXPECT_EQ(memcmp(&expected.localBounds, &actual.localBounds, sizeof(Math::AABB)), 0);
+    EXPECT_EQ(memcmp(&expected.localSphere, &actual.localSphere, sizeof(Math::BoundingSphere)), 0);
+    EXPECT_EQ(expected.lodError, actual.lodError);
+}
+
+std::vector<uint8> ReadFile(const std::string& path)
+{
+    std::vector<uint8> bytes;
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file)
+        return bytes;
+    int c;
+    while ((c = std::fgetc(file)) != EOF)
+    {
+        bytes.push_back(static_cast<uint8>(c));
+    }
+    std::fclose(file);
+    return bytes;
+}
+
+void WriteFile(const std::string& path, const std::vector<uint8>& bytes)
+{
+    FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fwrite(bytes.data(), 1, bytes.size(), file);
+    std::fclose(file);
+}
+
+} // anonymous namespace
+
+TEST(MeshFile, RoundTripKeepsEveryLevel)
+{
+    Mesh mesh = MakeDetailedMesh();
+    ASSERT_FALSE(mesh.lods.empty());
+    ASSERT_FALSE(mesh.meshlets.empty());
+
+    std::string path = ::testing::TempDir() + "mesh_file_roundtrip.rrm";
+    ASSERT_TRUE(MeshFile::Write(path.c_str(), mesh));
+
+    MeshFile file;
+    ASSERT_TRUE(file.Open(path.c_str()));
+    EXPECT_EQ(file.GetLevelCount(), 1u + mesh.lods.size());
+
+    Mesh loaded;
+    ASSERT_TRUE(file.Load(loaded));
+    ExpectSameMesh(mesh, loaded);
+    ASSERT_EQ(loaded.lods.size(), mesh.lods.size());
+    for (size_t i = 0; i < mesh.lods.size(); ++i)
+    {
+        ExpectSameMesh(*mesh.lods[i], *loaded.lods[i]);
+    }
+
+    file.Close();
+    std::remove(path.c_str());
+}
+
+TEST(MeshFile, SectionsAreAligned)
+{
+    Mesh mesh = MakeDetailedMesh();
+    std::string path = ::testing::TempDir() + "mesh_file_aligned.rrm";
+    ASSERT_TRUE(MeshFile::Write(path.c_str(), mesh));
+
+    MeshFile file;
+    ASSERT_TRUE(file.Open(path.c_str()));
+    for (uint32 level = 0; level < file.GetLevelCount(); ++level)
+    {
+        const MeshFileLevel& info = file.GetLevelInfo(level);
+        EXPECT_EQ(info.vertices.offset % 16, 0u);
+        EXPECT_EQ(info.compactVertices.offset % 16, 0u);
+        EXPECT_EQ(info.indices.offset % 16, 0u);
+        EXPECT_EQ(info.adjacencyOffsets.offset % 16, 0u);
+        EXPECT_EQ(info.adjacencyNeighbors.offset % 16, 0u);
+        EXPECT_EQ(info.meshlets.offset % 16, 0u);
+
+        // The mapping is page aligned, so the views are too
+        MeshFile::LevelView view = file.GetLevel(level);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(view.vertices) % 16, 0u);
+        const void* indices = view.indices16 ? static_cast<const void*>(view.indices16) : view.indices;
+        EXPECT_NE(indices, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(indices) % 16, 0u);
+    }
+    EXPECT_EQ(ReadFile(path).size() % 16, 0u);
+
+    file.Close();
+    std::remove(path.c_str());
+}
+
+TEST(MeshFile, IndexWidthFollowsVertexCount)
+{
+    // 257 x 257 = 66049 vertices keep 32-bit indices; the small LOD narrows
+    Mesh mesh = MeshFactory::CreateSphere(256, 256);
+    mesh.lods.push_back(std::make_shared<Mesh>(MeshFactory::CreateSphere(8, 8)));
+    ASSERT_EQ(mesh.GetIndexFormat(), IndexFormat::UInt32);
+    ASSERT_EQ(mesh.lods[0]->GetIndexFormat(), IndexFormat::UInt16);
+
+    std::string path = ::testing::TempDir() + "mesh_file_index_width.rrm";
+    ASSERT_TRUE(MeshFile::Write(path.c_str(), mesh));
+
+    MeshFile file;
+    ASSERT_TRUE(file.Open(path.c_str()));
+    MeshFile::LevelView full = file.GetLevel(0);
+    EXPECT_EQ(full.indexFormat, IndexFormat::UInt32);
+    EXPECT_NE(full.indices, nullptr);
+    EXPECT_EQ(file.GetLevelInfo(0).indices.size, mesh.indices.size() * sizeof(uint32));
+    MeshFile::LevelView lod = file.GetLevel(1);
+    EXPECT_EQ(lod.indexFormat, IndexFormat::UInt16);
+    EXPECT_NE(lod.indices16, nullptr);
+    EXPECT_EQ(file.GetLevelInfo(1).indices.size, mesh.lods[0]->indices.size() * sizeof(uint16));
+
+    // Both widths load back as the same 32-bit indices
+    Mesh loaded;
+    ASSERT_TRUE(file.Load(loaded));
+    EXPECT_TRUE(SameBytes(mesh.indices, loaded.indices));
+    ASSERT_EQ(loaded.lods.size(), 1u);
+    EXPECT_TRUE(SameBytes(mesh.lods[0]->indices, loaded.lods[0]->indices));
+
+    file.Close();
+    std::remove(path.c_str());
+}
+
+TEST(MeshFile, MappedStreamsUploadWithoutCopies)
+{
+    Mesh mesh = MakeDetailedMesh();
+    std::string path = ::testing::TempDir() + "mesh_file_mapped.rrm";
+    ASSERT_TRUE(MeshFile::Write(path.c_str(), mesh));
+
+    MeshFile file;
+    ASSERT_TRUE(file.Open(path.c_str()));
+    Mesh shell;
+    ASSERT_TRUE(file.Load(shell, false));
+    EXPECT_TRUE(shell.vertices.empty());
+    EXPECT_TRUE(shell.indices.empty());
+    EXPECT_EQ(shell.meshlets.size(), mesh.meshlets.size());
+    ASSERT_EQ(shell.lods.size(), mesh.lods.size());
+
+    NullDevice device;
+    ASSERT_TRUE(device.Initialize(nullptr, 1280, 720));
+    Renderer renderer;
+    renderer.SetDevice(&device);
+    ASSERT_TRUE(file.Upload(renderer, shell));
+
+    // Every level is small enough for 16-bit indices
+    uint64 expectedBytes = (mesh.vertices.size() * sizeof(Vertex)) + mesh.indices.size() * sizeof(uint16);
+    for (const auto& lod : mesh.lods)
+    {
+        expectedBytes += lod->vertices.size() * sizeof(Vertex) + lod->indices.size() * sizeof(uint16);
+    }
+    EXPECT_EQ(device.GetStats().buffersCreated, 2u * (1u + mesh.lods.size()));
+    EXPECT_EQ(device.GetStats().bytesUploaded, expectedBytes);
+
+    // Drawing the shell uses the mapped buffers, not its empty vectors
+    SceneGraph graph;
+    SceneNode* node = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+    node->SetMesh(&shell);
+    Camera camera;
+    device.ResetStats();
+    IRHIContext* context = device.GetContext();
+    context->BeginFrame();
+    renderer.RenderScene(graph, camera, nullptr, 16.0f / 9.0f);
+    context->EndFrame();
+    EXPECT_EQ(device.GetStats().buffersCreated, 0u);
+    EXPECT_GT(device.GetStats().indices, 0u);
+    EXPECT_EQ(renderer.GetCullingStats().drawn, 1u);
+
+    // After a cache clear the shell is refused, not drawn from empty
+    // buffers, until the file uploads it again
+    renderer.ClearMeshCache();
+    EXPECT_FALSE(renderer.UploadMesh(&shell));
+    device.ResetStats();
+    context->BeginFrame();
+    renderer.RenderScene(graph, camera, nullptr, 16.0f / 9.0f);
+    context->EndFrame();
+    EXPECT_EQ(device.GetStats().buffersCreated, 0u);
+    EXPECT_EQ(device.GetStats().indices, 0u);
+    EXPECT_EQ(renderer.GetCullingStats().notUploaded, 1u);
+    EXPECT_EQ(renderer.GetCullingStats().culled, 0u);
+
+    ASSERT_TRUE(file.Upload(renderer, shell));
+    EXPECT_TRUE(renderer.IsMeshUploaded(&shell));
+    context->BeginFrame();
+    renderer.RenderScene(graph, camera, nullptr, 16.0f / 9.0f);
+    context->EndFrame();
+    EXPECT_EQ(renderer.GetCullingStats().notUploaded, 0u);
+    EXPECT_EQ(renderer.GetCullingStats().drawn, 1u);
+
+    file.Close();
+    std::remove(path.c_str());
+}
+
+TEST(MeshFile, CompactStreamsUploadAsStored)
+{
+    Mesh mesh = MakeDetailedMesh();
+    std::string path = ::testing::TempDir() + "mesh_file_compact.rrm";
+    ASSERT_TRUE(MeshFile::Write(path.c_str(), mesh));
+
+    MeshFile file;
+    ASSERT_TRUE(file.Open(path.c_str()));
+    std::vector<const Mesh*> levels = { &mesh };
+    for (const auto& lod : mesh.lods)
+    {
+        levels.push_back(lod.get());
+    }
+    ASSERT_EQ(file.GetLevelCount(), levels.size());
+
+    // Each level stores what the renderer's own encode would produce
+    uint64 expectedBytes = 0;
+    for (uint32 level = 0; level < file.GetLevelCount(); ++level)
+    {
+        const Mesh& source = *levels[level];
+        std::vector<CompactVertex> compact;
+        QuantizationRange range = VertexQuantizer::Encode(source.vertices.data(),
+            static_cast<uint32>(source.vertices.size()), compact);
+        MeshFile::LevelView view = file.GetLevel(level);
+        ASSERT_NE(view.compactVertices, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(view.compactVertices) % 16, 0u);
+        EXPECT_EQ(memcmp(view.compactVertices, compact.data(), compact.size() * sizeof(CompactVertex)), 0);
+        EXPECT_EQ(memcmp(&view.compactRange, &range, sizeof(range)), 0);
+        expectedBytes += source.vertices.size() * sizeof(CompactVertex) + source.indices.size() * sizeof(uint16);
+    }
+
+    Mesh shell;
+    ASSERT_TRUE(file.Load(shell, false));
+    NullDevice device;
+    ASSERT_TRUE(device.Initialize(nullptr, 1280, 720));
+    Renderer renderer;
+    renderer.SetDevice(&device);
+    renderer.SetVertexFormat(VertexFormat::Compact);
+    ASSERT_TRUE(file.Upload(renderer, shell));
+    EXPECT_EQ(device.GetStats().buffersCreated, 2u * levels.size());
+    EXPECT_EQ(device.GetStats().bytesUploaded, expectedBytes);
+
+    // The pre-encoded overload is for Compact buffers only
+    Renderer fullRenderer;
+    fullRenderer.SetDevice(&device);
+    MeshFile::LevelView view = file.GetLevel(0);
+    EXPECT_FALSE(fullRenderer.UploadMesh(&shell, view.compactVertices, view.compactRange,
+        view.vertexCount, view.indices16, view.indexCount, view.indexFormat));
+
+    file.Close();
+    std::remove(path.c_str());
+}
+
+TEST(MeshFile, RejectsDamagedFiles)
+{
+    Mesh mesh = MeshFactory::CreateCube();
+    std::string path = ::testing::TempDir() + "mesh_file_damaged.rrm";
+    ASSERT_TRUE(MeshFile::Write(path.c_str(), mesh));
+    std::vector<uint8> bytes = ReadFile(path);
+    ASSERT_GT(bytes.size(), sizeof(MeshFileHeader));
+
+    MeshFile file;
+    EXPECT_FALSE(file.Open((::testing::TempDir() + "mesh_file_missing.rrm").c_str()));
+
+    // Truncated
+    std::vector<uint8> truncated(bytes.begin(), bytes.end() - 16);
+    WriteFile(path, truncated);
+    EXPECT_FALSE(file.Open(path.c_str()));
+
+    // Wrong magic
+    std::vector<uint8> badMagic = bytes;
+    badMagic[0] ^= 0xFF;
+    WriteFile(path, badMagic);
+    EXPECT_FALSE(file.Open(path.c_str()));
+
+    // Unknown index format
+    std::vector<uint8> badFormat = bytes;
+    MeshFileLevel formatLevel;
+    memcpy(&formatLevel, badFormat.data() + sizeof(MeshFileHeader), sizeof(formatLevel));
+    formatLevel.indexFormat = 7;
+    memcpy(badFormat.data() + sizeof(MeshFileHeader), &formatLevel, sizeof(formatLevel));
+    WriteFile(path, badFormat);
+    EXPECT_FALSE(file.Open(path.c_str()));
+
+    // Section pointing past the end
+    std::vector<uint8> badSection = bytes;
+    MeshFileLevel level;
+    memcpy(&level, badSection.data() + sizeof(MeshFileHeader), sizeof(level));
+    level.indices.offset = bytes.size();
+    memcpy(badSection.data() + sizeof(MeshFileHeader), &level, sizeof(level));
+    WriteFile(path, badSection);
+    EXPECT_FALSE(file.Open(path.c_str()));
+    EXPECT_FALSE(file.IsOpen());
+
+    // Compact stream shorter than the full one
+    std::vector<uint8> badCompact = bytes;
+    memcpy(&level, badCompact.data() + sizeof(MeshFileHeader), sizeof(level));
+    level.compactVertices.size -= sizeof(CompactVertex);
+    memcpy(badCompact.data() + sizeof(MeshFileHeader), &level, sizeof(level));
+    WriteFile(path, badCompact);
+    EXPECT_FALSE(file.Open(path.c_str()));
+
+    // Adjacency with a bad interior offset, then a neighbor past the last
+    // face: the table is fine, so Open succeeds and Load rejects the streams
+    ASSERT_GT(level.adjacencyOffsets.size, 2 * sizeof(uint32));
+    ASSERT_GT(level.adjacencyNeighbors.size, 0u);
+    uint32 faceCount = static_cast<uint32>(mesh.indices.size() / 3);
+    uint32 badValues[2] = { 0xFFFFFF00, faceCount };
+    uint64 badOffsets[2] = { level.adjacencyOffsets.offset + sizeof(uint32), level.adjacencyNeighbors.offset };
+    for (int i = 0; i < 2; ++i)
+    {
+        std::vector<uint8> badAdjacency = bytes;
+        memcpy(badAdjacency.data() + badOffsets[i], &badValues[i], sizeof(uint32));
+        WriteFile(path, badAdjacency);
+        ASSERT_TRUE(file.Open(path.c_str()));
+        Mesh loaded;
+        EXPECT_FALSE(file.Load(loaded));
+        EXPECT_TRUE(file.Load(loaded, false));
+        file.Close();
+    }
+
+    WriteFile(path, bytes);
+    EXPECT_TRUE(file.Open(path.c_str()));
+    Mesh loaded;
+    EXPECT_TRUE(file.Load(loaded));
+
+    file.Close();
+    std::remove(path.c_str());
+}
@@ -0,0 +1,305 @@
+#include <gtest/gtest.h>
+#include "Renderer/MeshImporter.h"
+#include "Core/ThreadPool.h"
+#include "../bench/GridMesh.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace DirectX;
+using namespace RRE;
+
+namespace
+{
+
+using Face = std::array<uint32, 3>;
+
+void WriteText(const std::string& path, const std::string& text)
+{
+    FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fwrite(text.data(), 1, text.size(), file);
+    std::fclose(file);
+}
+
+// (n + 1)^2 positions, n^2 quads as "f" lines; relative indices when asked
+std::string MakeGridObj(uint32 n, bool relative)
+{
+    std::string text = "# grid\n";
+    char line[128];
+    for (uint32 y = 0; y <= n; ++y)
+    {
+        for (uint32 x = 0; x <= n; ++x)
+        {
+            snprintf(line, sizeof(line), "v %.6f %.6f 0.25\n", x * 0.1, y * 0.1);
+            text += line;
+        }
+        if (y == 0)
+            continue;
+
+        // Quads of the row just finished
+        for (uint32 x = 0; x < n; ++x)
+        {
+            std::array<uint32, 4> q = GridMesh::Quad(n, x, y - 1);
+            uint32 a = q[0], b = q[1], c = q[2], d = q[3];
+            if (relative)
+            {
+                int32 count = static_cast<int32>((y + 1) * (n + 1));
+                snprintf(line, sizeof(line), "f %d %d %d %d\n", int32(a) - count, int32(b) - count,
+                    int32(c) - count, int32(d) - count);
+            }
+            else
+            {
+                snprintf(line, sizeof(line), "f %u/%u/%u %u/%u/%u %u/%u %u//%u\n",
+                    a + 1, a + 1, a + 1, b + 1, b + 1, b + 1, c + 1, c + 1, d + 1, d + 1);
+            }
+            text += line;
+        }
+    }
+    return text;
+}
+
+std::vector<Face> ExpectedGridFaces(uint32 n)
+{
+    std::vector<Face> faces;
+    for (uint32 y = 0; y < n; ++y)
+    {
+        for (uint32 x = 0; x < n; ++x)
+        {
+            // The importer fans each quad from its first corner
+            std::array<uint32, 4> q = GridMesh::Quad(n, x, y);
+            faces.push_back({ q[0], q[1], q[2] });
+            faces.push_back({ q[0], q[2], q[3] });
+        }
+    }
+    return faces;
+}
+
+template <typename T>
+void Append(std::vector<uint8>& out, T value, bool bigEndian)
+{
+    uint8 bytes[sizeof(T)];
+    memcpy(bytes, &value, sizeof(T));
+    if (bigEndian)
+        std::reverse(bytes, bytes + sizeof(T));
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+// Unit square as one quad plus a triangle, with properties around the
+// ones the importer reads
+std::vector<uint8> MakePly(bool bigEndian)
+{
+    std::string header = std::string("ply\r\nformat ") +
+        (bigEndian ? "binary_big_endian" : "binary_little_endian") + " 1.0\r\n"
+        "comment written by test\r\n"
+        "element camera 1\r\n"
+        "property float focal\r\n"
+        "element vertex 5\r\n"
+        "property uchar flags\r\n"
+        "property double x\r\n"
+        "property float y\r\n"
+        "property float z\r\n"
+        "property uchar red\r\n"
+        "element face 2\r\n"
+        "property uchar quality\r\n"
+        "property list uchar int vertex_indices\r\n"
+        "property float weight\r\n"
+        "end_header\r\n";
+    std::vector<uint8> bytes(header.begin(), header.end());
+
+    Append<float>(bytes, 35.0f, bigEndian);
+
+    const float corners[5][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 }, { 0.5f, 2, 1 } };
+    for (const auto& corner : corners)
+    {
+        Append<uint8>(bytes, 7, bigEndian);
+        Append<double>(bytes, corner[0], bigEndian);
+        Append<float>(bytes, corner[1], bigEndian);
+        Append<float>(bytes, corner[2], bigEndian);
+        Append<uint8>(bytes, 200, bigEndian);
+    }
+
+    Append<uint8>(bytes, 1, bigEndian);
+    Append<uint8>(bytes, 4, bigEndian);
+    for (int32 index : { 0, 1, 2, 3 })
+    {
+        Append<int32>(bytes, index, bigEndian);
+    }
+    Append<float>(bytes, 0.5f, bigEndian);
+
+    Append<uint8>(bytes, 1, bigEndian);
+    Append<uint8>(bytes, 3, bigEndian);
+    for (int32 index : { 3, 2, 4 })
+    {
+        Append<int32>(bytes, index, bigEndian);
+    }
+    Append<float>(bytes, 0.5f, bigEndian);
+    return bytes;
+}
+
+void WriteBytes(const std::string& path, const std::vector<uint8>& bytes)
+{
+    FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fwrite(bytes.data(), 1, bytes.size(), file);
+    std::fclose(file);
+}
+
+} // anonymous namespace
+
+TEST(MeshImporter, ReadsObjPolygons)
+{
+    // Cube with quads, texture/normal references, a relative face and CRLF
+    std::string path = ::testing::TempDir() + "importer_cube.obj";
+    WriteText(path,
+        "# cube\r\n"
+        "o cube\r\n"
+        "v -1 -1 -1\r\nv 1 -1 -1\r\nv 1 1 -1\r\nv -1 1 -1\r\n"
+        "v -1 -1 1\r\nv 1 -1 1\r\nv 1 1 1\r\nv -1 1 1\r\n"
+        "vt 0 0\r\nvn 0 0 1\r\n"
+        "f 1/1/1 4/1/1 3/1/1 2/1/1\r\n"
+        "f 5//1 6//1 7//1 8//1 # back\r\n"
+        "f -8 -7 -3 -4\r\n"
+        "\tf 2 3 7 6\r\n"
+        "f 3 4 8 7\r\n"
+        "f 4 1 5 8\r\n"
+        "l 1 2\r\n");
+
+    std::vector<XMFLOAT3> positions;
+    std::vector<Face> faces;
+    ASSERT_TRUE(MeshImporter::ReadOBJ(path.c_str(), positions, faces));
+    ASSERT_EQ(positions.size(), 8u);
+    EXPECT_EQ(positions[6].x, 1.0f);
+    EXPECT_EQ(positions[6].y, 1.0f);
+    EXPECT_EQ(positions[6].z, 1.0f);
+    ASSERT_EQ(faces.size(), 12u);
+    EXPECT_EQ(faces[0], (Face{ 0, 3, 2 }));
+    EXPECT_EQ(faces[1], (Face{ 0, 2, 1 }));
+    EXPECT_EQ(faces[4], (Face{ 0, 1, 5 }));
+    EXPECT_EQ(faces[5], (Face{ 0, 5, 4 }));
+
+    Mesh mesh;
+    ASSERT_TRUE(MeshImporter::Load(path.c_str(), mesh, MeshShading::Flat));
+    EXPECT_EQ(mesh.GetPolygonCount(), 12u);
+    EXPECT_EQ(mesh.faceAdjacency.size(), 12u);
+    EXPECT_TRUE(mesh.localBounds.IsValid());
+    std::remove(path.c_str());
+}
+
+TEST(MeshImporter, ParsesFloatsLikeStrtof)
+{
+    const char* values[] = {
+        "0", "-0", "1", "-1.5", "+2.", ".5", "-.25", "3.14159265358979", "1e3", "1E-3",
+        "6.02214076e23", "1.17549435e-38", "3.40282346e38", "123456789012345678901234",
+        "0.000000000000000000000000000001", "-7.0e+02", "0.1", "0.2", "0.3", "16777217",
+    };
+    std::string text;
+    for (const char* value : values)
+    {
+        text += std::string("v ") + value + " " + value + " " + value + "\n";
+    }
+    std::string path = ::testing::TempDir() + "importer_floats.obj";
+    WriteText(path, text);
+
+    std::vector<XMFLOAT3> positions;
+    std::vector<Face> faces;
+    ASSERT_TRUE(MeshImporter::ReadOBJ(path.c_str(), positions, faces));
+    ASSERT_EQ(positions.size(), sizeof(values) / sizeof(values[0]));
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        float expected = std::strtof(values[i], nullptr);
+        EXPECT_EQ(positions[i].x, expected) << values[i];
+        EXPECT_EQ(positions[i].z, expected) << values[i];
+    }
+    std::remove(path.c_str());
+}
+
+TEST(MeshImporter, ParallelChunksMatchSerial)
+{
+    // About 2.5 MB, so the text splits into several chunks, and relative
+    // indices reach back across chunk boundaries
+    const uint32 n = 220;
+    std::vector<Face> expected = ExpectedGridFaces(n);
+    ThreadPool pool(4);
+    for (bool relative : { false, true })
+    {
+        std::string path = ::testing::TempDir() + "importer_grid.obj";
+        WriteText(path, MakeGridObj(n, relative));
+
+        std::vector<XMFLOAT3> serialPositions;
+        std::vector<Face> serialFaces;
+        ASSERT_TRUE(MeshImporter::ReadOBJ(path.c_str(), serialPositions, serialFaces));
+        std::vector<XMFLOAT3> positions;
+        std::vector<Face> faces;
+        ASSERT_TRUE(MeshImporter::ReadOBJ(path.c_str(), positions, faces, &pool));
+
+        ASSERT_EQ(positions.size(), size_t(n + 1) * (n + 1));
+        EXPECT_EQ(memcmp(positions.data(), serialPositions.data(), positions.size() * sizeof(XMFLOAT3)), 0);
+        EXPECT_EQ(serialFaces, expected);
+        EXPECT_EQ(faces, expected);
+        EXPECT_FLOAT_EQ(positions[n + 2].x, 0.1f);
+        EXPECT_FLOAT_EQ(positions[n + 2].y, 0.1f);
+        std::remove(path.c_str());
+    }
+}
+
+TEST(MeshImporter, ReadsBinaryPly)
+{
+    ThreadPool pool(2);
+    for (bool bigEndian : { false, true })
+    {
+        std::string path = ::testing::TempDir() + "importer_square.ply";
+        WriteBytes(path, MakePly(bigEndian));
+
+        std::vector<XMFLOAT3> positions;
+        std::vector<Face> faces;
+        ASSERT_TRUE(MeshImporter::ReadPLY(path.c_str(), positions, faces, &pool)) << bigEndian;
+        ASSERT_EQ(positions.size(), 5u);
+        EXPECT_EQ(positions[2].x, 1.0f);
+        EXPECT_EQ(positions[2].y, 1.0f);
+        EXPECT_EQ(positions[4].x, 0.5f);
+        EXPECT_EQ(positions[4].y, 2.0f);
+        EXPECT_EQ(positions[4].z, 1.0f);
+        ASSERT_EQ(faces.size(), 3u);
+        EXPECT_EQ(faces[0], (Face{ 0, 1, 2 }));
+        EXPECT_EQ(faces[1], (Face{ 0, 2, 3 }));
+        EXPECT_EQ(faces[2], (Face{ 3, 2, 4 }));
+
+        Mesh mesh;
+        ASSERT_TRUE(MeshImporter::Load(path.c_str(), mesh, MeshShading::Smooth, &pool));
+        EXPECT_EQ(mesh.GetPolygonCount(), 3u);
+        std::remove(path.c_str());
+    }
+}
+
+TEST(MeshImporter, RejectsBadInput)
+{
+    std::vector<XMFLOAT3> positions;
+    std::vector<Face> faces;
+    std::string path = ::testing::TempDir() + "importer_bad.obj";
+
+    WriteText(path, "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 4\n");
+    EXPECT_FALSE(MeshImporter::ReadOBJ(path.c_str(), positions, faces));
+    WriteText(path, "v 0 0 0\nf -2 -1 -1\n");
+    EXPECT_FALSE(MeshImporter::ReadOBJ(path.c_str(), positions, faces));
+    WriteText(path, "v 0 zero 0\n");
+    EXPECT_FALSE(MeshImporter::ReadOBJ(path.c_str(), positions, faces));
+    std::remove(path.c_str());
+
+    std::string plyPath = ::testing::TempDir() + "importer_bad.ply";
+    WriteText(plyPath, "ply\nformat ascii 1.0\nelement vertex 0\nend_header\n");
+    EXPECT_FALSE(MeshImporter::ReadPLY(plyPath.c_str(), positions, faces));
+
+    // Truncated face records
+    std::vector<uint8> bytes = MakePly(false);
+    bytes.resize(bytes.size() - 8);
+    WriteBytes(plyPath, bytes);
+    EXPECT_FALSE(MeshImporter::ReadPLY(plyPath.c_str(), positions, faces));
+    std::remove(plyPath.c_str());
+
+    Mesh mesh;
+    EXPECT_FALSE(MeshImporter::Load("mesh.stl", mesh));
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "Renderer/MeshLibrary.h"
+#include "Core/ThreadPool.h"
+#include <thread>
+#include <vector>
+
+using namespace RRE;
+
+TEST(MeshLibrary, EqualDescsShareOneMesh)
+{
+    ThreadPool pool(2);
+    MeshLibrary library(&pool);
+
+    auto sphere = library.Get(MeshDesc::Sphere(12, 10));
+    ASSERT_NE(sphere, nullptr);
+    EXPECT_EQ(library.Get(MeshDesc::Sphere(12, 10)), sphere);
+    EXPECT_NE(library.Get(MeshDesc::Sphere(12, 12)), sphere);
+    EXPECT_NE(library.Get(MeshDesc::Sphere(12, 10, MeshShading::Smooth)), sphere);
+    EXPECT_EQ(library.GetMeshCount(), 3u);
+
+    // Same geometry as the factory call it stands for
+    Mesh expected = MeshFactory::CreateSphere(12, 10);
+    EXPECT_EQ(sphere->indices.size(), expected.indices.size());
+    EXPECT_EQ(sphere->vertices.size(), expected.vertices.size());
+
+    // Unused parameters do not split the cache
+    EXPECT_EQ(MeshDesc::Cube(), MeshDesc::Cube());
+    EXPECT_EQ(library.Get(MeshDesc::Cylinder(8, 1.0f)), library.Get(MeshDesc::Cylinder(8, 1.0f)));
+}
+
+TEST(MeshLibrary, RequestsFinishInBackground)
+{
+    ThreadPool pool(2);
+    MeshLibrary library(&pool);
+
+    std::vector<MeshDesc> descs = { MeshDesc::Sphere(128, 128), MeshDesc::Cube(),
+        MeshDesc::Cylinder(64), MeshDesc::Tetrahedron(MeshShading::Smooth) };
+    for (const MeshDesc& desc : descs)
+    {
+        library.Request(desc);
+    }
+    EXPECT_LE(library.GetPendingCount(), 4u);
+
+    // Small meshes become available while the large one may still run
+    while (!library.TryGet(MeshDesc::Cube()))
+    {
+        std::this_thread::yield();
+    }
+    for (const MeshDesc& desc : descs)
+    {
+        EXPECT_NE(library.Get(desc), nullptr);
+    }
+    EXPECT_EQ(library.GetPendingCount(), 0u);
+    EXPECT_EQ(library.GetMeshCount(), 4u);
+}
+
+TEST(MeshLibrary, WithoutPoolGeneratesOnGet)
+{
+    MeshLibrary library;
+    EXPECT_EQ(library.TryGet(MeshDesc::Cube()), nullptr);
+    EXPECT_EQ(library.GetPendingCount(), 1u);
+    auto cube = library.Get(MeshDesc::Cube());
+    ASSERT_NE(cube, nullptr);
+    EXPECT_EQ(cube->GetPolygonCount(), 12u);
+    EXPECT_EQ(library.TryGet(MeshDesc::Cube()), cube);
+}
+
+TEST(MeshLibrary, ConcurrentGetsGenerateOnce)
+{
+    ThreadPool pool(1);
+    auto library = std::make_unique<MeshLibrary>(&pool);
+
+    // Keep the only worker busy so callers race to claim the queued job
+    for (uint32 i = 0; i < 8; ++i)
+    {
+        library->Request(MeshDesc::Sphere(64 + i, 64));
+    }
+
+    std::vector<std::shared_ptr<const Mesh>> results(4);
+    std::vector<std::thread> threads;
+    for (uint32 t = 0; t < results.size(); ++t)
+    {
+        threads.emplace_back([&, t]() { results[t] = library->Get(MeshDesc::Cylinder(32)); });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (const auto& result : results)
+    {
+        ASSERT_NE(result, nullptr);
+        EXPECT_EQ(result, results[0]);
+    }
+
+    // Destruction waits for the queued spheres; held meshes outlive it
+    library.reset();
+    EXPECT_EQ(results[0]->GetPolygonCount(), MeshFactory::CreateCylinder(32).GetPolygonCount());
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "Renderer/MeshOptimizer.h"
+#include "Renderer/MeshFactory.h"
+#include "../bench/GridMesh.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace RRE;
+
+namespace
+{
+
+// n x n quads, two triangles each, in row order
+std::vector<uint32> MakeGridIndices(uint32 n)
+{
+    std::vector<uint32> indices;
+    for (const std::array<uint32, 3>& face : GridMesh::Faces(n))
+    {
+        indices.insert(indices.end(), face.begin(), face.end());
+    }
+    return indices;
+}
+
+// Triangles with their winding, rotated to start at the smallest index
+std::vector<std::array<uint32, 3>> CanonicalTriangles(const std::vector<uint32>& indices)
+{
+    std::vector<std::array<uint32, 3>> triangles;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        std::array<uint32, 3> t = { indices[i], indices[i + 1], indices[i + 2] };
+        std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+        triangles.push_back(t);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+} // anonymous namespace
+
+TEST(MeshOptimizer, AnalyzeCountsFifoMisses)
+{
+    std::vector<uint32> indices = { 0, 1, 2, 2, 1, 3 };
+    VertexCacheStats stats = MeshOptimizer::AnalyzeVertexCache(indices, 4);
+    EXPECT_EQ(stats.transformed, 4u);
+    EXPECT_FLOAT_EQ(stats.acmr, 2.0f);
+    EXPECT_FLOAT_EQ(stats.atvr, 1.0f);
+
+    // A three-entry cache has evicted vertex 0 by the time it comes back
+    indices = { 0, 1, 2, 3, 4, 5, 0, 1, 2 };
+    EXPECT_EQ(MeshOptimizer::AnalyzeVertexCache(indices, 6, 3).transformed, 9u);
+    EXPECT_EQ(MeshOptimizer::AnalyzeVertexCache(indices, 6, 6).transformed, 6u);
+}
+
+TEST(MeshOptimizer, ShuffledGridApproachesIdealAcmr)
+{
+    const uint32 n = 64;
+    std::vector<uint32> indices = MakeGridIndices(n);
+    uint32 vertexCount = (n + 1) * (n + 1);
+
+    // Shuffle whole triangles so the input has no locality at all
+    std::mt19937 rng(3);
+    std::vector<std::array<uint32, 3>> triangles(indices.size() / 3);
+    memcpy(triangles.data(), indices.data(), indices.size() * sizeof(uint32));
+    std::shuffle(triangles.begin(), triangles.end(), rng);
+    memcpy(indices.data(), triangles.data(), indices.size() * sizeof(uint32));
+    std::vector<uint32> original = indices;
+
+    VertexCacheStats before = MeshOptimizer::AnalyzeVertexCache(indices, vertexCount);
+    std::vector<uint32> order;
+    MeshOptimizer::OptimizeVertexCache(indices, vertexCount, MeshOptimizer::DEFAULT_CACHE_SIZE, &order);
+    VertexCacheStats after = MeshOptimizer::AnalyzeVertexCache(indices, vertexCount);
+
+    EXPECT_GT(before.acmr, 2.5f);
+    EXPECT_LT(after.acmr, 0.8f);
+    EXPECT_LT(after.atvr, 1.6f);
+    EXPECT_EQ(CanonicalTriangles(indices), CanonicalTriangles(original));
+
+    // order maps every new triangle back to its source
+    ASSERT_EQ(order.size(), indices.size() / 3);
+    for (uint32 t = 0; t < order.size(); ++t)
+    {
+        for (uint32 c = 0; c < 3; ++c)
+        {
+            EXPECT_EQ(indices[t * 3 + c], original[order[t] * 3 + c]);
+        }
+    }
+}
+
+TEST(MeshOptimizer, VertexFetchRenumbersInFirstUseOrder)
+{
+    std::vector<Vertex> vertices(5);
+    for (uint32 v = 0; v < 5; ++v)
+    {
+        vertices[v].position = { static_cast<float>(v), 0.0f, 0.0f };
+    }
+    std::vector<uint32> indices = { 3, 1, 4, 4, 1, 0 };
+
+    EXPECT_EQ(MeshOptimizer::OptimizeVertexFetch(vertices, indices), 4u);
+    EXPECT_EQ(indices, (std::vector<uint32>{ 0, 1, 2, 2, 1, 3 }));
+    ASSERT_EQ(vertices.size(), 5u);
+    EXPECT_EQ(vertices[0].position.x, 3.0f);
+    EXPECT_EQ(vertices[2].position.x, 4.0f);
+    EXPECT_EQ(vertices[3].position.x, 0.0f);
+    EXPECT_EQ(vertices[4].position.x, 2.0f);  // unreferenced, moved last
+}
+
+TEST(MeshOptimizer, OptimizeKeepsMeshConsistent)
+{
+    Mesh mesh = MeshFactory::CreateSphere(48, 48, MeshShading::Smooth);
+    Mesh source = mesh;
+    MeshOptimizeResult result = MeshOptimizer::Optimize(mesh);
+
+    // The factory already optimized smooth meshes, so a second pass holds
+    EXPECT_LT(result.after.acmr, 0.75f);
+    EXPECT_LE(result.after.acmr, result.before.acmr + 0.01f);
+    EXPECT_EQ(mesh.vertices.size(), source.vertices.size());
+    ASSERT_EQ(mesh.indices.size(), source.indices.size());
+    ASSERT_NE(mesh.triangleBVH, nullptr);
+    EXPECT_NE(mesh.triangleBVH, source.triangleBVH);
+
+    // Adjacent faces still share an edge after the renumbering
+    ASSERT_EQ(mesh.faceAdjacency.size(), mesh.GetPolygonCount());
+    for (uint32 f = 0; f < mesh.GetPolygonCount(); ++f)
+    {
+        for (uint32 g : mesh.faceAdjacency[f])
+        {
+            uint32 shared = 0;
+            for (uint32 a = 0; a < 3; ++a)
+            {
+                for (uint32 b = 0; b < 3; ++b)
+                {
+                    const Vertex& va = mesh.vertices[mesh.indices[f * 3 + a]];
+                    const Vertex& vb = mesh.vertices[mesh.indices[g * 3 + b]];
+                    shared += va.position.x == vb.position.x && va.position.y == vb.position.y &&
+                        va.position.z == vb.position.z;
+                }
+            }
+            EXPECT_EQ(shared, 2u);
+        }
+    }
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include "Renderer/MeshSimplifier.h"
+#include "Renderer/MeshFactory.h"
+#include "Renderer/MeshletBuilder.h"
+#include "Renderer/FaceColorPalette.h"
+#include "../bench/GridMesh.h"
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace DirectX;
+using namespace RRE;
+
+namespace
+{
+
+bool SameColor(const XMFLOAT4& a, const XMFLOAT4& b)
+{
+    return memcmp(&a, &b, sizeof(XMFLOAT4)) == 0;
+}
+
+bool IsPaletteColor(const XMFLOAT4& color)
+{
+    for (uint32 c = 0; c < FaceColorPalette::PALETTE_SIZE; ++c)
+    {
+        if (SameColor(color, FaceColorPalette::GetColor(c)))
+            return true;
+    }
+    return false;
+}
+
+// n x n quads in the z = 0 plane spanning [0, 1]
+Mesh MakePlane(uint32 n)
+{
+    std::vector<XMFLOAT3> positions;
+    for (uint32 y = 0; y <= n; ++y)
+    {
+        for (uint32 x = 0; x <= n; ++x)
+        {
+            positions.push_back({ static_cast<float>(x) / n, static_cast<float>(y) / n, 0.0f });
+        }
+    }
+    return MeshFactory::CreateFromFaces(positions, GridMesh::Faces(n), MeshShading::Smooth);
+}
+
+} // anonymous namespace
+
+TEST(MeshSimplifier, SphereStaysCloseToSurface)
+{
+    Mesh sphere = MeshFactory::CreateSphere(64, 64, MeshShading::Smooth);
+    Mesh simplified = MeshSimplifier::Simplify(sphere, 1000);
+
+    EXPECT_LE(simplified.GetPolygonCount(), 1000u);
+    EXPECT_GT(simplified.GetPolygonCount(), 900u);
+    EXPECT_GT(simplified.lodError, 0.0f);
+    EXPECT_LT(simplified.lodError, 0.02f);
+    ASSERT_NE(simplified.triangleBVH, nullptr);
+
+    // Still closed, and every kept vertex is an original one on the sphere
+    ASSERT_EQ(simplified.faceAdjacency.size(), simplified.GetPolygonCount());
+    for (uint32 f = 0; f < simplified.faceAdjacency.size(); ++f)
+    {
+        EXPECT_EQ(simplified.faceAdjacency[f].size(), 3u);
+    }
+    for (const Vertex& v : simplified.vertices)
+    {
+        const XMFLOAT3& p = v.position;
+        EXPECT_NEAR(std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z), 1.0f, 1e-4f);
+    }
+}
+
+TEST(MeshSimplifier, FlatColorsStayDistinctAcrossEdges)
+{
+    Mesh sphere = MeshFactory::CreateSphere(32, 32);
+    Mesh simplified = MeshSimplifier::Simplify(sphere, 300);
+    ASSERT_LE(simplified.GetPolygonCount(), 300u);
+
+    // Still flat: three vertices per face, one palette color each
+    ASSERT_EQ(simplified.vertices.size(), simplified.indices.size());
+    for (uint32 f = 0; f < simplified.GetPolygonCount(); ++f)
+    {
+        const XMFLOAT4& color = simplified.vertices[f * 3].color;
+        EXPECT_TRUE(IsPaletteColor(color));
+        for (uint32 g : simplified.faceAdjacency[f])
+        {
+            EXPECT_FALSE(SameColor(color, simplified.vertices[g * 3].color));
+        }
+    }
+}
+
+TEST(MeshSimplifier, SmoothColorsStayDistinctAlongEdges)
+{
+    Mesh cylinder = MeshFactory::CreateCylinder(48, 2.0f, MeshShading::Smooth);
+    Mesh simplified = MeshSimplifier::Simplify(cylinder, cylinder.GetPolygonCount() / 2);
+    ASSERT_LT(simplified.vertices.size(), simplified.indices.size());
+
+    for (uint32 i = 0; i < simplified.indices.size(); i += 3)
+    {
+        for (uint32 c = 0; c < 3; ++c)
+        {
+            const XMFLOAT4& a = simplified.vertices[simplified.indices[i + c]].color;
+            const XMFLOAT4& b = simplified.vertices[simplified.indices[i + (c + 1) % 3]].color;
+            EXPECT_TRUE(IsPaletteColor(a));
+            EXPECT_FALSE(SameColor(a, b));
+        }
+    }
+}
+
+TEST(MeshSimplifier, PlaneCollapsesWithoutErrorAndKeepsOutline)
+{
+    Mesh plane = MakePlane(16);
+    Mesh simplified = MeshSimplifier::Simplify(plane, 0, 1e-4f);
+
+    EXPECT_LE(simplified.GetPolygonCount(), 8u);
+    EXPECT_LT(simplified.lodError, 1e-4f);
+    EXPECT_EQ(simplified.localBounds.min.x, 0.0f);
+    EXPECT_EQ(simplified.localBounds.min.y, 0.0f);
+    EXPECT_EQ(simplified.localBounds.max.x, 1.0f);
+    EXPECT_EQ(simplified.localBounds.max.y, 1.0f);
+    float area = 0.0f;
+    for (uint32 i = 0; i < simplified.indices.size(); i += 3)
+    {
+        XMVECTOR p0 = XMLoadFloat3(&simplified.vertices[simplified.indices[i]].position);
+        XMVECTOR p1 = XMLoadFloat3(&simplified.vertices[simplified.indices[i + 1]].position);
+        XMVECTOR p2 = XMLoadFloat3(&simplified.vertices[simplified.indices[i + 2]].position);
+        area += 0.5f * XMVectorGetX(XMVector3Length(
+            XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0))));
+    }
+    EXPECT_NEAR(area, 1.0f, 1e-5f);
+
+    // A curved surface refuses the same bound
+    Mesh sphere = MeshFactory::CreateSphere(16, 16, MeshShading::Smooth);
+    EXPECT_EQ(MeshSimplifier::Simplify(sphere, 0, 1e-4f).GetPolygonCount(), sphere.GetPolygonCount());
+}
+
+TEST(MeshSimplifier, LODChainHalvesTriangles)
+{
+    Mesh sphere = MeshFactory::CreateSphere(64, 64, MeshShading::Smooth);
+    MeshletBuilder::Build(sphere);
+    uint32 levels = MeshSimplifier::BuildLODChain(sphere);
+    ASSERT_EQ(levels, 4u);
+    ASSERT_EQ(sphere.lods.size(), levels);
+
+    uint32 previousTriangles = sphere.GetPolygonCount();
+    float previousError = sphere.lodError;
+    for (const auto& lod : sphere.lods)
+    {
+        EXPECT_LE(lod->GetPolygonCount(), previousTriangles / 2);
+        EXPECT_GE(lod->lodError, previousError);
+        EXPECT_FALSE(lod->meshlets.empty());
+        EXPECT_TRUE(lod->lods.empty());
+        previousTriangles = lod->GetPolygonCount();
+        previousError = lod->lodError;
+    }
+    EXPECT_GT(previousError, 0.0f);
+}
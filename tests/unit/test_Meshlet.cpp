@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "Renderer/MeshletBuilder.h"
+#include "Renderer/MeshFactory.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace DirectX;
+using namespace RRE;
+
+namespace
+{
+
+// Corner positions of every triangle (vertices are renumbered by the build)
+std::vector<std::array<float, 9>> SortedTriangles(const Mesh& mesh)
+{
+    std::vector<std::array<float, 9>> triangles;
+    for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+    {
+        std::array<float, 9> t;
+        for (uint32 c = 0; c < 3; ++c)
+        {
+            const XMFLOAT3& p = mesh.vertices[mesh.indices[i + c]].position;
+            t[c * 3] = p.x;
+            t[c * 3 + 1] = p.y;
+            t[c * 3 + 2] = p.z;
+        }
+        triangles.push_back(t);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+XMVECTOR WindingNormal(const Mesh& mesh, uint32 triangle)
+{
+    XMVECTOR p0 = XMLoadFloat3(&mesh.vertices[mesh.indices[triangle * 3]].position);
+    XMVECTOR p1 = XMLoadFloat3(&mesh.vertices[mesh.indices[triangle * 3 + 1]].position);
+    XMVECTOR p2 = XMLoadFloat3(&mesh.vertices[mesh.indices[triangle * 3 + 2]].position);
+    return XMVector3Normalize(XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0)));
+}
+
+} // anonymous namespace
+
+TEST(Meshlet, PartitionRespectsLimits)
+{
+    Mesh mesh = MeshFactory::CreateSphere(64, 64, MeshShading::Smooth);
+    auto triangles = SortedTriangles(mesh);
+
+    uint32 count = MeshletBuilder::Build(mesh);
+    ASSERT_EQ(count, mesh.meshlets.size());
+    EXPECT_EQ(SortedTriangles(mesh), triangles);
+    ASSERT_NE(mesh.triangleBVH, nullptr);
+    EXPECT_EQ(mesh.triangleBVH->GetTriangleCount(), mesh.GetPolygonCount());
+
+    // Contiguous ranges covering the index buffer in order
+    uint32 next = 0;
+    for (const Meshlet& meshlet : mesh.meshlets)
+    {
+        EXPECT_EQ(meshlet.firstIndex, next);
+        next += meshlet.indexCount;
+
+        std::set<uint32> vertices(mesh.indices.begin() + meshlet.firstIndex,
+            mesh.indices.begin() + meshlet.firstIndex + meshlet.indexCount);
+        EXPECT_EQ(meshlet.vertexCount, vertices.size());
+        EXPECT_LE(meshlet.vertexCount, MeshletBuilder::MAX_VERTICES);
+        EXPECT_LE(meshlet.indexCount / 3, MeshletBuilder::MAX_TRIANGLES);
+    }
+    EXPECT_EQ(next, mesh.indices.size());
+
+    // Greedy growth keeps clusters well filled: 8064 triangles
+    EXPECT_LT(count, mesh.GetPolygonCount() / 80);
+}
+
+TEST(Meshlet, BoundsAndConesEncloseTriangles)
+{
+    Mesh mesh = MeshFactory::CreateSphere(32, 32, MeshShading::Smooth);
+    MeshletBuilder::Build(mesh, 32, 48);
+    ASSERT_GT(mesh.meshlets.size(), 1u);
+
+    uint32 withCone = 0;
+    for (const Meshlet& meshlet : mesh.meshlets)
+    {
+        XMVECTOR center = XMLoadFloat3(&meshlet.bounds.center);
+        XMVECTOR axis = XMLoadFloat3(&meshlet.coneAxis);
+        float minDot = std::sqrt(1.0f - meshlet.coneCutoff * meshlet.coneCutoff);
+        for (uint32 i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.indexCount; ++i)
+        {
+            XMVECTOR p = XMLoadFloat3(&mesh.vertices[mesh.indices[i]].position);
+            EXPECT_LE(XMVectorGetX(XMVector3Length(XMVectorSubtract(p, center))), meshlet.bounds.radius + 1e-5f);
+        }
+        if (meshlet.coneCutoff >= 1.0f)
+            continue;
+        ++withCone;
+        for (uint32 t = meshlet.firstIndex / 3; t < (meshlet.firstIndex + meshlet.indexCount) / 3; ++t)
+        {
+            EXPECT_GE(XMVectorGetX(XMVector3Dot(axis, WindingNormal(mesh, t))), minDot - 1e-4f);
+        }
+    }
+    EXPECT_EQ(withCone, mesh.meshlets.size());
+}
+
+TEST(Meshlet, BackFacingIsConservative)
+{
+    Mesh mesh = MeshFactory::CreateSphere(32, 32, MeshShading::Smooth);
+    MeshletBuilder::Build(mesh);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> coord(-6.0f, 6.0f);
+    uint32 culled = 0;
+    for (int trial = 0; trial < 64; ++trial)
+    {
+        XMFLOAT3 viewer = { coord(rng), coord(rng), coord(rng) };
+        XMVECTOR viewerPos = XMLoadFloat3(&viewer);
+        for (const Meshlet& meshlet : mesh.meshlets)
+        {
+            if (!meshlet.IsBackFacing(viewer))
+                continue;
+            ++culled;
+            // Every triangle's winding normal points away from the viewer
+            for (uint32 t = meshlet.firstIndex / 3; t < (meshlet.firstIndex + meshlet.indexCount) / 3; ++t)
+            {
+                XMVECTOR p0 = XMLoadFloat3(&mesh.vertices[mesh.indices[t * 3]].position);
+                EXPECT_GT(XMVectorGetX(XMVector3Dot(WindingNormal(mesh, t), XMVectorSubtract(p0, viewerPos))), 0.0f);
+            }
+        }
+    }
+    EXPECT_GT(culled, 0u);
+}
+
+TEST(Meshlet, CubeFacesHaveZeroWidthCones)
+{
+    // Six planar quads of four shared vertices, each a zero-width cone
+    Mesh cube = MeshFactory::CreateCube(MeshShading::Smooth);
+    MeshletBuilder::Build(cube, 4, 2);
+    ASSERT_EQ(cube.meshlets.size(), 6u);
+    for (const Meshlet& meshlet : cube.meshlets)
+    {
+        EXPECT_EQ(meshlet.indexCount, 6u);
+        EXPECT_NEAR(meshlet.coneCutoff, 0.0f, 1e-3f);
+    }
+}
@@ -0,0 +1,351 @@
+#include <gtest/gtest.h>
+#include "RHI/Null/NullDevice.h"
+#include "RHI/RHIBuffer.h"
+#include "Renderer/Renderer.h"
+#include "Renderer/MeshFactory.h"
+#include "Renderer/MeshletBuilder.h"
+#include "Renderer/MeshSimplifier.h"
+#include "Scene/SceneGraph.h"
+#include "Scene/SceneNode.h"
+#include "Scene/Camera.h"
+#include "Lighting/PointLight.h"
+#include <vector>
+
+using namespace DirectX;
+using namespace RRE;
+
+namespace
+{
+
+// count cubes spaced along x in front of the default camera, plus two spheres
+void BuildScene(SceneGraph& graph, Mesh& cube, Mesh& sphere, uint32 count)
+{
+    for (uint32 i = 0; i < count; ++i)
+    {
+        SceneNode* node = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+        node->GetTransform().SetPosition({ -1.0f + 0.2f * static_cast<float>(i % 10), 0.0f, 0.0f });
+        node->SetMesh(&cube);
+    }
+    for (uint32 i = 0; i < 2; ++i)
+    {
+        SceneNode* node = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+        node->GetTransform().SetPosition({ 0.0f, static_cast<float>(i), 0.0f });
+        node->SetMesh(&sphere);
+    }
+}
+
+} // anonymous namespace
+
+TEST(NullRHI, CreateBufferCountsBytes)
+{
+    NullDevice device;
+    ASSERT_TRUE(device.Initialize(nullptr, 640, 480));
+    EXPECT_EQ(device.GetWidth(), 640u);
+
+    uint32 data[16] = {};
+    auto buffer = device.CreateBuffer(data, sizeof(data), sizeof(uint32));
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_EQ(buffer->GetSize(), sizeof(data));
+    EXPECT_EQ(buffer->GetStride(), sizeof(uint32));
+
+    buffer->SetData(data, 32, sizeof(uint32));
+    EXPECT_EQ(device.GetStats().buffersCreated, 1u);
+    EXPECT_EQ(device.GetStats().bytesUploaded, sizeof(data) + 32u);
+
+    device.ResetStats();
+    EXPECT_EQ(device.GetStats().buffersCreated, 0u);
+}
+
+TEST(NullRHI, RendererBatchesByMesh)
+{
+    NullDevice device;
+    ASSERT_TRUE(device.Initialize(nullptr, 1280, 720));
+
+    Mesh cube = MeshFactory::CreateCube();
+    Mesh sphere = MeshFactory::CreateSphere(8, 8);
+    SceneGraph graph;
+    BuildScene(graph, cube, sphere, 50);
+
+    Renderer renderer;
+    renderer.SetDevice(&device);
+    Camera camera;
+    PointLight light;
+
+    IRHIContext* context = device.GetContext();
+    context->BeginFrame();
+    renderer.RenderScene(graph, camera, &light, 16.0f / 9.0f);
+    context->EndFrame();
+
+    // One instanced draw per mesh, each node is one instance
+    const NullRHIStats& stats = device.GetStats();
+    EXPECT_EQ(stats.frames, 1u);
+    EXPECT_EQ(stats.drawCalls, 2u);
+    EXPECT_EQ(stats.instancedDrawCalls, 2u);
+    EXPECT_EQ(stats.instances, 52u);
+    EXPECT_EQ(stats.indices, 50u * cube.indices.size() + 2u * sphere.indices.size());
+    EXPECT_EQ(stats.constantWrites, 2u);
+    EXPECT_EQ(stats.buffersCreated, 4u);
+
+    const CullingStats& culling = renderer.GetCullingStats();
+    EXPECT_EQ(culling.tested, 52u);
+    EXPECT_EQ(culling.drawn, 52u);
+    EXPECT_EQ(culling.culled, 0u);
+    EXPECT_EQ(culling.drawCalls, 2u);
+
+    // Meshes stay cached across frames
+    context->BeginFrame();
+    renderer.RenderScene(graph, camera, &light, 16.0f / 9.0f);
+    context->EndFrame();
+    EXPECT_EQ(device.GetStats().buffersCreated, 4u);
+    EXPECT_EQ(device.GetStats().drawCalls, 4u);
+}
+
+TEST(NullRHI, CompactVerticesUploadSixteenBytes)
+{
+    NullDevice device;
+    ASSERT_TRUE(device.Initialize(nullptr, 1280, 720));
+
+    Mesh sphere = MeshFactory::CreateSphere(16, 16);
+    uint64 vertexBytes = sphere.vertices.size() * sizeof(CompactVertex);
+    uint64 indexBytes = sphere.indices.size() * sizeof(uint16);
+
+    Renderer renderer;
+    renderer.SetDevice(&device);
+    renderer.UploadMesh(&sphere);
+    EXPECT_EQ(device.GetStats().bytesUploaded, sphere.vertices.size() * sizeof(Vertex) + indexBytes);
+
+    // Switching formats drops the cache; the next upload is compact
+    device.ResetStats();
+    renderer.SetVertexFormat(VertexFormat::Compact);
+    EXPECT_EQ(renderer.GetVertexFormat(), VertexFormat::Compact);
+    renderer.UploadMesh(&sphere);
+    EXPECT_EQ(device.GetStats().buffersCreated, 2u);
+    EXPECT_EQ(device.GetStats().bytesUploaded, vertexBytes + indexBytes);
+}
+
+TEST(NullRHI, SmallMeshesUseShortIndices)
+{
+    NullDevice device;
+    ASSERT_TRUE(device.Initialize(nullptr, 1280, 720));
+    EXPECT_EQ(SelectIndexFormat(65535), IndexFormat::UInt16);
+    EXPECT_EQ(SelectIndexFormat(65536), IndexFormat::UInt32);
+
+    // 33 x 33 vertices: 16-bit; 257 x 257: too many for 16 bits
+    Mesh small = MeshFactory::CreateSphere(32, 32);
+    Mesh large = MeshFactory::CreateSphere(256, 256);
+    Renderer renderer;
+    renderer.SetDevice(&device);
+    renderer.UploadMesh(&small);
+    EXPECT_EQ(device.GetStats().bytesUploaded,
+        small.vertices.size() * sizeof(Vertex) + small.indices.size() * sizeof(uint16));
+
+    device.ResetStats();
+    renderer.UploadMesh(&large);
+    EXPECT_EQ(device.GetStats().bytesUploaded,
+        large.vertices.size() * sizeof(Vertex) + large.indices.size() * sizeof(uint32));
+
+    // Draws count indices, not bytes, for either width
+    SceneGraph graph;
+    graph.GetRoot()->AddChild(std::make_unique<SceneNode>())->SetMesh(&small);
+    SceneNode* node = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+    node->GetTransform().SetPosition({ 1.0f, 0.0f, 0.0f });
+    node->SetMesh(&large);
+    renderer.SetClusterCulling(false);
+    Camera camera;
+    device.GetContext()->BeginFrame();
+    renderer.RenderScene(graph, camera, nullptr, 16.0f / 9.0f);
+    device.GetContext()->EndFrame();
+    EXPECT_EQ(device.GetStats().indices, small.indices.size() + large.indices.size());
+}
+
+TEST(NullRHI, CulledNodesAreNotDrawn)
+{
+    NullDevice device;
+    ASSERT_TRUE(device.Initialize(nullptr, 1280, 720));
+
+    Mesh cube = MeshFactory::CreateCube();
+    SceneGraph graph;
+    SceneNode* visible = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+    visible->SetMesh(&cube);
+    SceneNode* behind = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+    behind->GetTransform().SetPosition({ 0.0f, 0.0f, -50.0f });
+    behind->SetMesh(&cube);
+
+    Renderer renderer;
+    renderer.SetDevice(&device);
+    Camera camera;
+
+    device.GetContext()->BeginFrame();
+    renderer.RenderScene(graph, camera, nullptr, 1.0f);
+    device.GetContext()->EndFrame();
+
+    EXPECT_EQ(device.GetStats().instances, 1u);
+    EXPECT_EQ(renderer.GetCullingStats().culled, 1u);
+}
+
+TEST(NullRHI, BackFacingMeshletsAreNotDrawn)
+{
+    NullDevice device;
+    ASSERT_TRUE(device.Initialize(nullptr, 1280, 720));
+
+    Mesh sphere = MeshFactory::CreateSphere(64, 64, MeshShading::Smooth);
+    MeshletBuilder::Build(sphere);
+    SceneGraph graph;
+    SceneNode* node = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+    node->SetMesh(&sphere);
+
+    Renderer renderer;
+    renderer.SetDevice(&device);
+    Camera camera;
+    camera.SetPosition({ 0.0f, 0.0f, -6.0f });
+
+    auto render = [&]() {
+        device.ResetStats();
+        device.GetContext()->BeginFrame();
+        renderer.RenderScene(graph, camera, nullptr, 16.0f / 9.0f);
+        device.GetContext()->EndFrame();
+        return device.GetStats().indices;
+    };
+
+    // The sphere winds inward, so its near cap is the back-facing side; the
+    // clusters well inside the cap are skipped
+    uint64 culledIndices = render();
+    const CullingStats& culling = renderer.GetCullingStats();
+    EXPECT_EQ(culling.clustersTested, sphere.meshlets.size());
+    EXPECT_GT(culling.clustersCulled, sphere.meshlets.size() / 8);
+    EXPECT_LT(culling.clustersCulled, sphere.meshlets.size() / 2);
+    EXPECT_EQ(culling.drawn, 1u);
+    EXPECT_EQ(device.GetStats().drawCalls, culling.drawCalls);
+    EXPECT_LT(culledIndices, sphere.indices.size() * 7 / 8);
+
+    renderer.SetClusterCulling(false);
+    EXPECT_EQ(render(), sphere.indices.size());
+    EXPECT_EQ(renderer.GetCullingStats().clustersTested, 0u);
+}
+
+TEST(NullRHI, DistantNodesDrawCoarserLODs)
+{
+    NullDevice device;
+    ASSERT_TRUE(device.Initialize(nullptr, 1280, 720));
+
+    Mesh sphere = MeshFactory::CreateSphere(64, 64, MeshShading::Smooth);
+    ASSERT_GT(MeshSimplifier::BuildLODChain(sphere), 1u);
+    SceneGraph graph;
+    SceneNode* node = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+    node->SetMesh(&sphere);
+
+    Renderer renderer;
+    renderer.SetDevice(&device);
+    Camera camera;
+
+    auto render = [&](float distance) {
+        camera.SetPosition({ 0.0f, 0.0f, -distance });
+        device.ResetStats();
+        device.GetContext()->BeginFrame();
+        renderer.RenderScene(graph, camera, nullptr, 16.0f / 9.0f);
+        device.GetContext()->EndFrame();
+        return device.GetStats().indices;
+    };
+
+    // Close up the full mesh; far away a coarser level; the coarsest one
+    // once the whole sphere is a few pixels tall
+    EXPECT_EQ(render(1.5f), sphere.indices.size());
+    EXPECT_EQ(renderer.GetCullingStats().lodReduced, 0u);
+    uint64 far = render(10.0f);
+    EXPECT_LT(far, sphere.indices.size());
+    EXPECT_EQ(renderer.GetCullingStats().lodReduced, 1u);
+    EXPECT_EQ(render(90.0f), sphere.lods.back()->indices.size());
+    EXPECT_LE(render(90.0f), far);
+
+    // Orthographic views ignore distance
+    camera.SetProjectionMode(ProjectionMode::Orthographic);
+    EXPECT_EQ(render(1.5f), render(10.0f));
+
+    renderer.SetLODThreshold(0.0f);
+    EXPECT_EQ(render(90.0f), sphere.indices.size());
+}
+
+TEST(NullRHI, LightIndicatorIsOneDraw)
+{
+    NullDevice device;
+    ASSERT_TRUE(device.Initialize(nullptr, 1280, 720));
+
+    Mesh sphere = MeshFactory::CreateSphere(8, 8);
+    auto vb = device.CreateBuffer(sphere.vertices.data(),
+        static_cast<uint32>(sphere.vertices.size() * sizeof(Vertex)), sizeof(Vertex));
+    auto ib = device.CreateBuffer(sphere.indices.data(),
+        static_cast<uint32>(sphere.indices.size() * sizeof(uint32)), sizeof(uint32));
+
+    Renderer renderer;
+    renderer.SetDevice(&device);
+    PointLight light;
+    device.ResetStats();
+
+    renderer.RenderLightIndicator(&light, true, vb.get(), ib.get());
+    EXPECT_EQ(device.GetStats().drawCalls, 1u);
+    EXPECT_EQ(device.GetStats().instancedDrawCalls, 0u);
+    EXPECT_EQ(device.GetStats().constantWrites, 1u);
+
+    renderer.RenderLightIndicator(&light, false, vb.get(), ib.get());
+    EXPECT_EQ(device.GetStats().drawCalls, 1u);
+}
+
+TEST(NullRHI, FrameMemoryIsRecycled)
+{
+    NullDevice device;
+    ASSERT_TRUE(device.Initialize(nullptr, 1280, 720));
+
+    Mesh cube = MeshFactory::CreateCube();
+    Mesh sphere = MeshFactory::CreateSphere(8, 8);
+    SceneGraph graph;
+    BuildScene(graph, cube, sphere, 5000);
+
+    Renderer renderer;
+    renderer.SetDevice(&device);
+    Camera camera;
+
+    NullContext* context = static_cast<NullContext*>(device.GetContext());
+    context->BeginFrame();
+    renderer.RenderScene(graph, camera, nullptr, 1.0f);
+    context->EndFrame();
+    uint32 pages = context->GetFrameAllocator().GetPageCount();
+    EXPECT_GT(pages, 0u);
+
+    // Same scene every frame: no new pages once the first frame retired
+    for (int i = 0; i < 10; ++i)
+    {
+        context->BeginFrame();
+        renderer.RenderScene(graph, camera, nullptr, 1.0f);
+        context->EndFrame();
+    }
+    EXPECT_EQ(context->GetFrameAllocator().GetPageCount(), pages);
+}
+
+TEST(NullRHI, ReadbackCompletesWithFrame)
+{
+    NullDevice device;
+    ASSERT_TRUE(device.Initialize(nullptr, 640, 480));
+    auto target = device.CreateRenderTarget(8, 4);
+    ASSERT_NE(target, nullptr);
+    EXPECT_EQ(device.CreateRenderTarget(0, 4), nullptr);
+
+    IRHIContext* context = device.GetContext();
+    context->BeginFrame();
+    context->SetRenderTarget(target.get());
+    uint64 ticket = context->ReadPixels(target.get());
+    ASSERT_NE(ticket, 0u);
+
+    std::vector<uint32> pixels(8 * 4, 0xFFFFFFFFu);
+    EXPECT_EQ(context->ResolveReadback(ticket, pixels.data()), ReadbackStatus::Pending);
+    context->EndFrame();
+
+    EXPECT_EQ(context->ResolveReadback(ticket, pixels.data()), ReadbackStatus::Ready);
+    EXPECT_EQ(pixels[31], 0u);
+    EXPECT_EQ(context->ResolveReadback(ticket, pixels.data()), ReadbackStatus::Invalid);
+
+    const NullRHIStats& stats = device.GetStats();
+    EXPECT_EQ(stats.renderTargetsCreated, 1u);
+    EXPECT_EQ(stats.renderTargetSwitches, 1u);
+    EXPECT_EQ(stats.readbacks, 1u);
+    EXPECT_EQ(stats.readbackBytes, 8u * 4u * 4u);
+}
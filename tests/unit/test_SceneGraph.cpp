@@ -137,3 +137,151 @@ TEST(SceneGraph, GetTotalPolygonCountNoMesh)
     SceneGraph graph;
     EXPECT_EQ(graph.GetTotalPolygonCount(), 0u);
 }
+
+TEST(SceneGraph, WorldGenerationStableWhenNothingChanges)
+{
+    SceneGraph graph;
+    auto child = std::make_unique<SceneNode>();
+    child->GetTransform().SetPosition({ 1.0f, 0.0f, 0.0f });
+    SceneNode* childPtr = graph.GetRoot()->AddChild(std::move(child));
+
+    graph.Traverse([](SceneNode*, const XMMATRIX&) {});
+    uint64 rootGen = graph.GetRoot()->GetWorldGeneration();
+    uint64 childGen = childPtr->GetWorldGeneration();
+
+    // Re-setting identical values must not invalidate the cache
+    childPtr->GetTransform().SetPosition({ 1.0f, 0.0f, 0.0f });
+    graph.Traverse([](SceneNode*, const XMMATRIX&) {});
+
+    EXPECT_EQ(graph.GetRoot()->GetWorldGeneration(), rootGen);
+    EXPECT_EQ(childPtr->GetWorldGeneration(), childGen);
+}
+
+TEST(SceneGraph, ParentChangePropagatesToDescendants)
+{
+    SceneGraph graph;
+    auto parent = std::make_unique<SceneNode>();
+    SceneNode* parentPtr = graph.GetRoot()->AddChild(std::move(parent));
+    auto child = std::make_unique<SceneNode>();
+    child->GetTransform().SetPosition({ 1.0f, 0.0f, 0.0f });
+    SceneNode* childPtr = parentPtr->AddChild(std::move(child));
+    auto sibling = std::make_unique<SceneNode>();
+    SceneNode* siblingPtr = graph.GetRoot()->AddChild(std::move(sibling));
+
+    graph.Traverse([](SceneNode*, const XMMATRIX&) {});
+    uint64 childGen = childPtr->GetWorldGeneration();
+    uint64 siblingGen = siblingPtr->GetWorldGeneration();
+
+    parentPtr->GetTransform().SetPosition({ 0.0f, 2.0f, 0.0f });
+
+    XMFLOAT3 pos = {};
+    graph.Traverse([&](SceneNode* node, const XMMATRIX& world) {
+        if (node == childPtr)
+            XMStoreFloat3(&pos, XMVector4Transform(XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), world));
+    });
+
+    EXPECT_NE(childPtr->GetWorldGeneration(), childGen);
+    EXPECT_EQ(siblingPtr->GetWorldGeneration(), siblingGen);
+    EXPECT_TRUE(Math::NearEqual(pos.x, 1.0f));
+    EXPECT_TRUE(Math::NearEqual(pos.y, 2.0f));
+}
+
+TEST(SceneGraph, GetWorldMatrixRefreshesStaleAncestors)
+{
+    SceneGraph graph;
+    auto child = std::make_unique<SceneNode>();
+    SceneNode* childPtr = graph.GetRoot()->AddChild(std::move(child));
+    childPtr->GetWorldMatrix();
+
+    // Ancestor changes without a traversal in between
+    graph.GetRoot()->GetTransform().SetPosition({ 4.0f, 0.0f, 0.0f });
+
+    XMFLOAT3 pos;
+    XMStoreFloat3(&pos, XMVector4Transform(XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f),
+        childPtr->GetWorldMatrix()));
+    EXPECT_TRUE(Math::NearEqual(pos.x, 4.0f));
+}
+
+TEST(SceneGraph, ReparentInvalidatesWorldMatrix)
+{
+    SceneGraph graph;
+    auto a = std::make_unique<SceneNode>();
+    a->GetTransform().SetPosition({ 5.0f, 0.0f, 0.0f });
+    SceneNode* aPtr = graph.GetRoot()->AddChild(std::move(a));
+    auto child = std::make_unique<SceneNode>();
+    SceneNode* childPtr = graph.GetRoot()->AddChild(std::move(child));
+    childPtr->GetWorldMatrix();
+
+    auto detached = graph.GetRoot()->RemoveChild(childPtr);
+    aPtr->AddChild(std::move(detached));
+
+    XMFLOAT3 pos;
+    XMStoreFloat3(&pos, XMVector4Transform(XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f),
+        childPtr->GetWorldMatrix()));
+    EXPECT_TRUE(Math::NearEqual(pos.x, 5.0f));
+}
+
+TEST(SceneGraph, TemplateAndVisitorTraversalMatch)
+{
+    SceneGraph graph;
+    SceneNode* a = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+    SceneNode* b = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+    SceneNode* a1 = a->AddChild(std::make_unique<SceneNode>());
+    a1->GetTransform().SetPosition({ 1.0f, 2.0f, 3.0f });
+    b->GetTransform().SetScale({ 2.0f, 2.0f, 2.0f });
+
+    std::vector<SceneNode*> templOrder;
+    graph.Traverse([&](SceneNode* node, const XMMATRIX&) { templOrder.push_back(node); });
+
+    std::vector<SceneNode*> visitorOrder;
+    SceneGraph::Visitor visitor = [&](SceneNode* node, const XMMATRIX&) { visitorOrder.push_back(node); };
+    graph.Traverse(visitor);
+
+    std::vector<SceneNode*> expected = { graph.GetRoot(), a, a1, b };
+    EXPECT_EQ(templOrder, expected);
+    EXPECT_EQ(visitorOrder, expected);
+}
+
+TEST(SceneGraph, NestedTraversalIsIndependent)
+{
+    // The tree walk reuses a scratch stack; a visitor that traverses again
+    // must not disturb the outer walk
+    SceneGraph graph;
+    SceneNode* a = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+    a->AddChild(std::make_unique<SceneNode>());
+    graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+
+    uint32 outer = 0;
+    uint32 inner = 0;
+    for (int frame = 0; frame < 2; ++frame)
+    {
+        graph.Traverse([&](SceneNode*, const XMMATRIX&) {
+            outer++;
+            graph.Traverse([&](SceneNode*, const XMMATRIX&) { inner++; });
+        });
+    }
+    EXPECT_EQ(outer, 8u);
+    EXPECT_EQ(inner, 32u);
+}
+
+TEST(SceneGraph, DeepHierarchyDoesNotOverflow)
+{
+    const uint32 depth = 200000;
+    uint32 visited = 0;
+    XMFLOAT4X4 leafWorld;
+    {
+        SceneGraph graph;
+        SceneNode* node = graph.GetRoot();
+        for (uint32 i = 0; i < depth; ++i)
+        {
+            node = node->AddChild(std::make_unique<SceneNode>());
+            node->GetTransform().SetPosition({ 0.001f, 0.0f, 0.0f });
+        }
+
+        graph.Traverse([&](SceneNode*, const XMMATRIX&) { visited++; });
+        XMStoreFloat4x4(&leafWorld, node->GetWorldMatrix());
+    } // graph destruction must not recurse per level
+
+    EXPECT_EQ(visited, depth + 1);
+    EXPECT_NEAR(leafWorld._41, 200.0f, 0.5f);
+}
@@ -0,0 +1,510 @@
+#include <gtest/gtest.h>
+#include "RHI/Software/SoftwareDevice.h"
+#include "RHI/RHIBuffer.h"
+#include "Renderer/Renderer.h"
+#include "Renderer/MeshFactory.h"
+#include "Renderer/MeshletBuilder.h"
+#include "Core/ImageDiff.h"
+#include "Scene/SceneGraph.h"
+#include "Scene/SceneNode.h"
+#include "Scene/Camera.h"
+#include "Lighting/PointLight.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace DirectX;
+using namespace RRE;
+
+namespace
+{
+
+uint32 Pack(float r, float g, float b, float a = 1.0f)
+{
+    auto toByte = [](float v) { return static_cast<uint32>(v * 255.0f + 0.5f); };
+    return toByte(r) | (toByte(g) << 8) | (toByte(b) << 16) | (toByte(a) << 24);
+}
+
+uint32 PixelAt(const SoftwareDevice& device, uint32 x, uint32 y)
+{
+    const SoftwareTexture& backBuffer = device.GetBackBuffer();
+    return backBuffer.GetColorBuffer()[y * backBuffer.GetPitch() + x];
+}
+
+XMFLOAT4X4 Identity()
+{
+    XMFLOAT4X4 m;
+    XMStoreFloat4x4(&m, XMMatrixIdentity());
+    return m;
+}
+
+// Clip-space quad (identity matrices) split along its TL-BR diagonal;
+// both halves wind clockwise on screen
+struct Quad
+{
+    std::unique_ptr<IRHIBuffer> vb;
+    std::unique_ptr<IRHIBuffer> ib;
+};
+
+Quad CreateQuad(IRHIDevice& device, float x0, float y0, float x1, float y1,
+    float zFirst, float zSecond, const XMFLOAT4& color)
+{
+    XMFLOAT3 normal = { 0.0f, 0.0f, -1.0f };
+    std::vector<Vertex> vertices = {
+        { { x0, y1, zFirst }, color, normal },
+        { { x1, y1, zFirst }, color, normal },
+        { { x1, y0, zFirst }, color, normal },
+        { { x0, y1, zSecond }, color, normal },
+        { { x1, y0, zSecond }, color, normal },
+        { { x0, y0, zSecond }, color, normal },
+    };
+    std::vector<uint32> indices = { 0, 1, 2, 3, 4, 5 };
+
+    Quad quad;
+    quad.vb = device.CreateBuffer(vertices.data(),
+        static_cast<uint32>(vertices.size() * sizeof(Vertex)), sizeof(Vertex));
+    quad.ib = device.CreateBuffer(indices.data(),
+        static_cast<uint32>(indices.size() * sizeof(uint32)), sizeof(uint32));
+    return quad;
+}
+
+} // anonymous namespace
+
+TEST(SoftwareRHI, ClearFillsEveryPixel)
+{
+    // Neither dimension is a multiple of the tile size or of 4
+    SoftwareDevice device(2);
+    ASSERT_TRUE(device.Initialize(nullptr, 101, 70));
+
+    IRHIContext* context = device.GetContext();
+    context->BeginFrame();
+    context->Clear({ 1.0f, 0.0f, 0.0f, 1.0f });
+    context->EndFrame();
+
+    const SoftwareTexture& backBuffer = device.GetBackBuffer();
+    for (uint32 y = 0; y < 70; ++y)
+    {
+        for (uint32 x = 0; x < 101; ++x)
+        {
+            ASSERT_EQ(PixelAt(device, x, y), Pack(1.0f, 0.0f, 0.0f));
+            ASSERT_EQ(backBuffer.GetDepthBuffer()[y * backBuffer.GetPitch() + x], 1.0f);
+        }
+    }
+}
+
+TEST(SoftwareRHI, SharedEdgeCoversEachPixelOnce)
+{
+    SoftwareDevice device(4);
+    ASSERT_TRUE(device.Initialize(nullptr, 203, 131));
+
+    // The second half is nearer, so a pixel covered by both would count twice
+    Quad quad = CreateQuad(device, -1.0f, -1.0f, 1.0f, 1.0f, 0.6f, 0.4f, { 1.0f, 1.0f, 1.0f, 1.0f });
+
+    IRHIContext* context = device.GetContext();
+    context->BeginFrame();
+    context->Clear({ 0.0f, 0.0f, 0.0f, 1.0f });
+    context->SetUnlitMode(true, { 0.0f, 1.0f, 0.0f });
+    context->DrawPrimitives(quad.vb.get(), quad.ib.get(), Identity());
+    context->EndFrame();
+
+    const SoftwareRasterStats& stats = device.GetRasterizer().GetStats();
+    EXPECT_EQ(stats.triangles, 2u);
+    EXPECT_EQ(stats.culled, 0u);
+    EXPECT_EQ(stats.pixelsWritten, 203u * 131u);
+    EXPECT_EQ(PixelAt(device, 0, 0), Pack(0.0f, 1.0f, 0.0f));
+    EXPECT_EQ(PixelAt(device, 202, 130), Pack(0.0f, 1.0f, 0.0f));
+}
+
+TEST(SoftwareRHI, BackFacesAreCulled)
+{
+    SoftwareDevice device(1);
+    ASSERT_TRUE(device.Initialize(nullptr, 64, 64));
+
+    // Swapping x0/x1 mirrors the quad and flips its winding
+    Quad quad = CreateQuad(device, 1.0f, -1.0f, -1.0f, 1.0f, 0.5f, 0.5f, { 1.0f, 1.0f, 1.0f, 1.0f });
+
+    IRHIContext* context = device.GetContext();
+    context->BeginFrame();
+    context->Clear({ 0.0f, 0.0f, 0.0f, 1.0f });
+    context->DrawPrimitives(quad.vb.get(), quad.ib.get(), Identity());
+    context->EndFrame();
+
+    EXPECT_EQ(device.GetRasterizer().GetStats().culled, 2u);
+    EXPECT_EQ(device.GetRasterizer().GetStats().pixelsWritten, 0u);
+}
+
+TEST(SoftwareRHI, ShortIndicesMatchLongIndices)
+{
+    // The same quad through a 32-bit and a 16-bit index buffer, whole and
+    // as the range holding only the second triangle
+    uint16 shortIndices[6] = { 0, 1, 2, 3, 4, 5 };
+    std::vector<uint32> images[2][2];
+    uint64 pixels[2][2] = {};
+    for (int width = 0; width < 2; ++width)
+    {
+        for (int range = 0; range < 2; ++range)
+        {
+            SoftwareDevice device(1);
+            ASSERT_TRUE(device.Initialize(nullptr, 64, 64));
+            Quad quad = CreateQuad(device, -0.5f, -0.5f, 0.5f, 0.5f, 0.5f, 0.5f, { 1.0f, 0.5f, 0.2f, 1.0f });
+            if (width == 1)
+                quad.ib = device.CreateBuffer(shortIndices, sizeof(shortIndices), sizeof(uint16));
+            EXPECT_EQ(quad.ib->GetIndexFormat(), width == 1 ? IndexFormat::UInt16 : IndexFormat::UInt32);
+            EXPECT_EQ(quad.ib->GetIndexCount(), 6u);
+
+            IRHIContext* context = device.GetContext();
+            context->BeginFrame();
+            context->Clear({ 0.0f, 0.0f, 0.0f, 1.0f });
+            if (range == 1)
+                context->DrawPrimitivesRange(quad.vb.get(), quad.ib.get(), 3, 3, Identity());
+            else
+                context->DrawPrimitives(quad.vb.get(), quad.ib.get(), Identity());
+            context->EndFrame();
+
+            const SoftwareTexture& backBuffer = device.GetBackBuffer();
+            pixels[width][range] = device.GetRasterizer().GetStats().pixelsWritten;
+            images[width][range].assign(backBuffer.GetColorBuffer(),
+                backBuffer.GetColorBuffer() + backBuffer.GetPitch() * backBuffer.GetHeight());
+        }
+    }
+    EXPECT_EQ(pixels[0][0], 32u * 32u);
+    EXPECT_LT(pixels[0][1], pixels[0][0]);
+    EXPECT_GT(pixels[0][1], 0u);
+    for (int range = 0; range < 2; ++range)
+    {
+        EXPECT_EQ(pixels[1][range], pixels[0][range]);
+        EXPECT_TRUE(images[1][range] == images[0][range]);
+    }
+}
+
+TEST(SoftwareRHI, DepthTestKeepsNearest)
+{
+    SoftwareDevice device(2);
+    ASSERT_TRUE(device.Initialize(nullptr, 64, 64));
+    Quad nearQuad = CreateQuad(device, -0.5f, -0.5f, 0.5f, 0.5f, 0.2f, 0.2f, { 1.0f, 1.0f, 1.0f, 1.0f });
+    Quad farQuad = CreateQuad(device, -1.0f, -1.0f, 1.0f, 1.0f, 0.7f, 0.7f, { 1.0f, 1.0f, 1.0f, 1.0f });
+
+    IRHIContext* context = device.GetContext();
+    for (int order = 0; order < 2; ++order)
+    {
+        context->BeginFrame();
+        context->Clear({ 0.0f, 0.0f, 0.0f, 1.0f });
+        for (int i = 0; i < 2; ++i)
+        {
+            bool drawNear = (i == order);
+            context->SetUnlitMode(true, drawNear ? XMFLOAT3{ 1.0f, 0.0f, 0.0f } : XMFLOAT3{ 0.0f, 0.0f, 1.0f });
+            const Quad& quad = drawNear ? nearQuad : farQuad;
+            context->DrawPrimitives(quad.vb.get(), quad.ib.get(), Identity());
+        }
+        context->EndFrame();
+
+        EXPECT_EQ(PixelAt(device, 32, 32), Pack(1.0f, 0.0f, 0.0f));
+        EXPECT_EQ(PixelAt(device, 2, 2), Pack(0.0f, 0.0f, 1.0f));
+    }
+}
+
+TEST(SoftwareRHI, LightingMatchesShader)
+{
+    const uint32 width = 96;
+    const uint32 height = 64;
+    SoftwareDevice device(2);
+    ASSERT_TRUE(device.Initialize(nullptr, width, height));
+
+    // Identity matrices: world position == clip position (z = 0.5)
+    XMFLOAT4 faceColor = { 1.0f, 0.5f, 0.25f, 1.0f };
+    Quad quad = CreateQuad(device, -1.0f, -1.0f, 1.0f, 1.0f, 0.5f, 0.5f, faceColor);
+
+    XMFLOAT3 lightPos = { 0.3f, -0.2f, -1.0f };
+    XMFLOAT3 lightColor = { 1.0f, 0.9f, 0.8f };
+    XMFLOAT3 ambient = { 0.15f, 0.15f, 0.15f };
+    float Kc = 1.0f;
+    float Kl = 0.09f;
+    float Kq = 0.032f;
+
+    IRHIContext* context = device.GetContext();
+    context->BeginFrame();
+    context->Clear({ 0.0f, 0.0f, 0.0f, 1.0f });
+    context->SetLightData(lightPos, lightColor, { 0.0f, 0.0f, -5.0f }, ambient, Kc, Kl, Kq);
+    context->DrawPrimitives(quad.vb.get(), quad.ib.get(), Identity());
+    context->EndFrame();
+
+    const uint32 samples[][2] = { { 0, 0 }, { 48, 32 }, { 10, 50 }, { 95, 63 } };
+    for (const auto& sample : samples)
+    {
+        float wx = (sample[0] + 0.5f) / width * 2.0f - 1.0f;
+        float wy = 1.0f - (sample[1] + 0.5f) / height * 2.0f;
+        float lx = lightPos.x - wx;
+        float ly = lightPos.y - wy;
+        float lz = lightPos.z - 0.5f;
+        float d = std::sqrt(lx * lx + ly * ly + lz * lz);
+        float attenuation = 1.0f / (Kc + Kl * d + Kq * d * d);
+        float diffuse = std::max(-lz / d, 0.0f) * attenuation;
+
+        uint32 pixel = PixelAt(device, sample[0], sample[1]);
+        float expected[3] = {
+            (ambient.x + diffuse * lightColor.x) * faceColor.x,
+            (ambient.y + diffuse * lightColor.y) * faceColor.y,
+            (ambient.z + diffuse * lightColor.z) * faceColor.z,
+        };
+        for (int c = 0; c < 3; ++c)
+        {
+            int actual = static_cast<int>((pixel >> (8 * c)) & 0xFF);
+            EXPECT_NEAR(actual, std::min(expected[c], 1.0f) * 255.0f, 1.0f);
+        }
+    }
+}
+
+TEST(SoftwareRHI, NearPlaneClipping)
+{
+    SoftwareDevice device(2);
+    ASSERT_TRUE(device.Initialize(nullptr, 128, 128));
+
+    // Half of the quad lies behind the camera (z < 0)
+    Quad quad = CreateQuad(device, -1.0f, -1.0f, 1.0f, 1.0f, -0.5f, -0.5f, { 1.0f, 1.0f, 1.0f, 1.0f });
+    std::vector<Vertex> vertices = {
+        { { -1.0f, 1.0f, -0.5f }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, -1.0f } },
+        { { 1.0f, 1.0f, 0.5f }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, -1.0f } },
+        { { 1.0f, -1.0f, 0.5f }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, -1.0f } },
+    };
+    quad.vb->SetData(vertices.data(), static_cast<uint32>(vertices.size() * sizeof(Vertex)), sizeof(Vertex));
+    uint32 indices[] = { 0, 1, 2 };
+    quad.ib->SetData(indices, sizeof(indices), sizeof(uint32));
+
+    IRHIContext* context = device.GetContext();
+    context->BeginFrame();
+    context->Clear({ 0.0f, 0.0f, 0.0f, 1.0f });
+    context->SetUnlitMode(true, { 1.0f, 1.0f, 1.0f });
+    context->DrawPrimitives(quad.vb.get(), quad.ib.get(), Identity());
+    context->EndFrame();
+
+    const SoftwareRasterStats& stats = device.GetRasterizer().GetStats();
+    EXPECT_EQ(stats.clipped, 1u);
+    EXPECT_GT(stats.pixelsWritten, 0u);
+
+    // The right edge (z > 0) is visible, the far left corner was clipped away
+    EXPECT_EQ(PixelAt(device, 126, 1), Pack(1.0f, 1.0f, 1.0f));
+    EXPECT_EQ(PixelAt(device, 1, 1), Pack(0.0f, 0.0f, 0.0f));
+}
+
+TEST(SoftwareRHI, ThreadCountDoesNotChangeImage)
+{
+    Mesh sphere = MeshFactory::CreateSphere(24, 24);
+    Mesh cube = MeshFactory::CreateCube();
+    SceneGraph graph;
+    for (int i = 0; i < 40; ++i)
+    {
+        SceneNode* node = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+        node->GetTransform().SetPosition({ -3.0f + 0.15f * i, std::sin(i * 0.7f), 0.2f * (i % 7) });
+        node->GetTransform().SetRotation({ 0.3f * i, 0.1f * i, 0.0f });
+        node->SetMesh((i % 3) ? &sphere : &cube);
+    }
+
+    Camera camera;
+    PointLight light;
+    std::vector<uint32> images[2];
+    const uint32 threadCounts[2] = { 1, 8 };
+    for (int run = 0; run < 2; ++run)
+    {
+        SoftwareDevice device(threadCounts[run]);
+        ASSERT_TRUE(device.Initialize(nullptr, 320, 200));
+        Renderer renderer;
+        renderer.SetDevice(&device);
+
+        IRHIContext* context = device.GetContext();
+        context->BeginFrame();
+        context->Clear({ 0.1f, 0.1f, 0.1f, 1.0f });
+        renderer.RenderScene(graph, camera, &light, 320.0f / 200.0f);
+        context->EndFrame();
+
+        const SoftwareTexture& backBuffer = device.GetBackBuffer();
+        EXPECT_GT(device.GetRasterizer().GetStats().pixelsWritten, 0u);
+        images[run].assign(backBuffer.GetColorBuffer(),
+            backBuffer.GetColorBuffer() + backBuffer.GetPitch() * backBuffer.GetHeight());
+    }
+    EXPECT_TRUE(images[0] == images[1]);
+}
+
+TEST(SoftwareRHI, ClusterCullingDoesNotChangeImage)
+{
+    // Only clusters the rasterizer would cull entirely are skipped, so the
+    // surviving triangles land in the same order and the image is identical
+    Mesh sphere = MeshFactory::CreateSphere(48, 48, MeshShading::Smooth);
+    MeshletBuilder::Build(sphere);
+    SceneGraph graph;
+    for (int i = 0; i < 6; ++i)
+    {
+        SceneNode* node = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+        node->GetTransform().SetPosition({ -2.5f + 1.0f * i, 0.3f * (i % 2), 0.5f * i });
+        node->GetTransform().SetRotation({ 0.4f * i, 0.9f * i, 0.0f });
+        node->GetTransform().SetScale({ 0.5f, 0.5f + 0.1f * i, 0.5f });
+        node->SetMesh(&sphere);
+    }
+
+    Camera camera;
+    PointLight light;
+    std::vector<uint32> images[2];
+    uint64 triangles[2] = {};
+    for (int run = 0; run < 2; ++run)
+    {
+        SoftwareDevice device(4);
+        ASSERT_TRUE(device.Initialize(nullptr, 320, 200));
+        Renderer renderer;
+        renderer.SetDevice(&device);
+        renderer.SetClusterCulling(run == 0);
+
+        IRHIContext* context = device.GetContext();
+        context->BeginFrame();
+        context->Clear({ 0.1f, 0.1f, 0.1f, 1.0f });
+        renderer.RenderScene(graph, camera, &light, 320.0f / 200.0f);
+        context->EndFrame();
+
+        const SoftwareTexture& backBuffer = device.GetBackBuffer();
+        triangles[run] = device.GetRasterizer().GetStats().triangles;
+        images[run].assign(backBuffer.GetColorBuffer(),
+            backBuffer.GetColorBuffer() + backBuffer.GetPitch() * backBuffer.GetHeight());
+    }
+    EXPECT_LT(triangles[0], triangles[1] * 7 / 8);
+    EXPECT_TRUE(images[0] == images[1]);
+}
+
+TEST(SoftwareRHI, CompactVerticesMatchFullImage)
+{
+    // Decoded positions move by at most 1/65535 of the mesh bounds, so only
+    // a few edge pixels may differ and shading stays within tolerance
+    Mesh sphere = MeshFactory::CreateSphere(32, 32, MeshShading::Smooth);
+    Mesh cube = MeshFactory::CreateCube();
+    SceneGraph graph;
+    for (int i = 0; i < 4; ++i)
+    {
+        SceneNode* node = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+        node->GetTransform().SetPosition({ -1.5f + 1.0f * i, 0.2f * (i % 2), 0.4f * i });
+        node->GetTransform().SetRotation({ 0.3f * i, 0.7f * i, 0.0f });
+        node->GetTransform().SetScale({ 0.6f, 0.6f, 0.6f });
+        node->SetMesh(i % 2 ? &cube : &sphere);
+    }
+
+    Camera camera;
+    PointLight light;
+    std::vector<uint32> images[2];
+    uint32 pitch = 0;
+    for (int run = 0; run < 2; ++run)
+    {
+        SoftwareDevice device(2);
+        ASSERT_TRUE(device.Initialize(nullptr, 320, 200));
+        Renderer renderer;
+        renderer.SetDevice(&device);
+        renderer.SetVertexFormat(run == 0 ? VertexFormat::Full : VertexFormat::Compact);
+
+        IRHIContext* context = device.GetContext();
+        context->BeginFrame();
+        context->Clear({ 0.1f, 0.1f, 0.1f, 1.0f });
+        renderer.RenderScene(graph, camera, &light, 320.0f / 200.0f);
+        context->EndFrame();
+
+        const SoftwareTexture& backBuffer = device.GetBackBuffer();
+        pitch = backBuffer.GetPitch();
+        images[run].assign(backBuffer.GetColorBuffer(),
+            backBuffer.GetColorBuffer() + backBuffer.GetPitch() * backBuffer.GetHeight());
+    }
+
+    ImageDiffResult diff = ImageDiff::Compare(images[0].data(), pitch, images[1].data(), pitch,
+        320, 200, 0.1f);
+    EXPECT_LE(diff.differentPixels, 320u * 200u / 1000u);
+    EXPECT_FALSE(images[0] == std::vector<uint32>(images[0].size(), images[0][0]));
+}
+
+TEST(SoftwareRHI, RenderTargetLeavesBackBufferAlone)
+{
+    SoftwareDevice device(2);
+    ASSERT_TRUE(device.Initialize(nullptr, 64, 64));
+    auto target = device.CreateRenderTarget(37, 23);
+    ASSERT_NE(target, nullptr);
+    EXPECT_EQ(target->GetWidth(), 37u);
+
+    // Left half of clip space
+    Quad quad = CreateQuad(device, -1.0f, -1.0f, 0.0f, 1.0f, 0.5f, 0.5f, { 1.0f, 1.0f, 1.0f, 1.0f });
+
+    IRHIContext* context = device.GetContext();
+    context->BeginFrame();
+    context->Clear({ 0.0f, 0.0f, 1.0f, 1.0f });
+    context->SetRenderTarget(target.get());
+    context->Clear({ 0.0f, 0.0f, 0.0f, 1.0f });
+    context->SetUnlitMode(true, { 1.0f, 0.0f, 0.0f });
+    context->DrawPrimitives(quad.vb.get(), quad.ib.get(), Identity());
+    uint64 ticket = context->ReadPixels(target.get());
+    context->EndFrame();
+
+    std::vector<uint32> pixels(37 * 23);
+    ASSERT_EQ(context->ResolveReadback(ticket, pixels.data()), ReadbackStatus::Ready);
+    EXPECT_EQ(pixels[0], Pack(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(pixels[22 * 37 + 17], Pack(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(pixels[22 * 37 + 36], Pack(0.0f, 0.0f, 0.0f));
+    EXPECT_EQ(context->ResolveReadback(ticket, pixels.data()), ReadbackStatus::Invalid);
+
+    EXPECT_EQ(PixelAt(device, 0, 0), Pack(0.0f, 0.0f, 1.0f));
+    EXPECT_EQ(PixelAt(device, 63, 63), Pack(0.0f, 0.0f, 1.0f));
+}
+
+TEST(SoftwareRHI, ReadPixelsCapturesWorkSoFar)
+{
+    SoftwareDevice device(1);
+    ASSERT_TRUE(device.Initialize(nullptr, 16, 16));
+    auto target = device.CreateRenderTarget(16, 16);
+    ASSERT_NE(target, nullptr);
+    Quad left = CreateQuad(device, -1.0f, -1.0f, 0.0f, 1.0f, 0.5f, 0.5f, { 1.0f, 1.0f, 1.0f, 1.0f });
+    Quad right = CreateQuad(device, 0.0f, -1.0f, 1.0f, 1.0f, 0.5f, 0.5f, { 1.0f, 1.0f, 1.0f, 1.0f });
+
+    IRHIContext* context = device.GetContext();
+    context->BeginFrame();
+    context->SetRenderTarget(target.get());
+    context->Clear({ 0.0f, 0.0f, 0.0f, 1.0f });
+    context->SetUnlitMode(true, { 0.0f, 1.0f, 0.0f });
+    context->DrawPrimitives(left.vb.get(), left.ib.get(), Identity());
+    uint64 first = context->ReadPixels(target.get());
+    context->DrawPrimitives(right.vb.get(), right.ib.get(), Identity());
+    uint64 second = context->ReadPixels(target.get());
+    context->EndFrame();
+    ASSERT_NE(first, second);
+
+    std::vector<uint32> pixels(16 * 16);
+    ASSERT_EQ(context->ResolveReadback(first, pixels.data()), ReadbackStatus::Ready);
+    EXPECT_EQ(pixels[0], Pack(0.0f, 1.0f, 0.0f));
+    EXPECT_EQ(pixels[15], Pack(0.0f, 0.0f, 0.0f));
+    ASSERT_EQ(context->ResolveReadback(second, pixels.data()), ReadbackStatus::Ready);
+    EXPECT_EQ(pixels[0], Pack(0.0f, 1.0f, 0.0f));
+    EXPECT_EQ(pixels[15], Pack(0.0f, 1.0f, 0.0f));
+}
+
+TEST(SoftwareRHI, SaveFramebufferWritesPPM)
+{
+    SoftwareDevice device(1);
+    ASSERT_TRUE(device.Initialize(nullptr, 17, 9));
+    device.GetContext()->BeginFrame();
+    device.GetContext()->Clear({ 0.0f, 0.5f, 1.0f, 1.0f });
+    device.GetContext()->EndFrame();
+
+    std::string path = ::testing::TempDir() + "software_rhi.ppm";
+    ASSERT_TRUE(device.SaveFramebuffer(path.c_str()));
+
+    FILE* file = std::fopen(path.c_str(), "rb");
+    ASSERT_NE(file, nullptr);
+    char magic[3] = {};
+    unsigned int width = 0;
+    unsigned int height = 0;
+    unsigned int maxValue = 0;
+    ASSERT_EQ(std::fscanf(file, "%2s %u %u %u", magic, &width, &height, &maxValue), 4);
+    std::fgetc(file);
+    unsigned char rgb[3] = {};
+    ASSERT_EQ(std::fread(rgb, 1, 3, file), 3u);
+    std::fclose(file);
+    std::remove(path.c_str());
+
+    EXPECT_STREQ(magic, "P6");
+    EXPECT_EQ(width, 17u);
+    EXPECT_EQ(height, 9u);
+    EXPECT_EQ(rgb[0], 0);
+    EXPECT_EQ(rgb[1], 128);
+    EXPECT_EQ(rgb[2], 255);
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include "Core/ThreadPool.h"
+#include <atomic>
+#include <vector>
+
+using namespace RRE;
+
+TEST(ThreadPool, ParallelForCoversEveryIndexOnce)
+{
+    ThreadPool pool(4);
+    std::vector<int> hits(10007, 0);
+
+    pool.ParallelFor(static_cast<uint32>(hits.size()), 64, [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i)
+            hits[i]++;
+    });
+
+    for (int h : hits)
+        EXPECT_EQ(h, 1);
+}
+
+TEST(ThreadPool, ParallelForEmptyRange)
+{
+    ThreadPool pool(2);
+    bool called = false;
+    pool.ParallelFor(0, 16, [&](uint32, uint32) { called = true; });
+    EXPECT_FALSE(called);
+}
+
+TEST(ThreadPool, NestedParallelForCompletes)
+{
+    ThreadPool pool(2);
+    std::atomic<uint32> total{ 0 };
+
+    pool.ParallelFor(8, 1, [&](uint32, uint32) {
+        pool.ParallelFor(100, 10, [&](uint32 begin, uint32 end) {
+            total.fetch_add(end - begin);
+        });
+    });
+
+    EXPECT_EQ(total.load(), 800u);
+}
+
+TEST(ThreadPool, SubmittedJobsRunBeforeDestruction)
+{
+    std::atomic<int> counter{ 0 };
+    {
+        ThreadPool pool(3);
+        for (int i = 0; i < 100; ++i)
+            pool.Submit([&counter]() { counter++; });
+    }
+    EXPECT_EQ(counter.load(), 100);
+}
@@ -84,3 +84,18 @@ TEST(Transform, TRSCombined)
     EXPECT_TRUE(Math::NearEqual(pos.y, 0.0f));
     EXPECT_TRUE(Math::NearEqual(pos.z, 0.0f));
 }
+
+TEST(Transform, VersionBumpsOnlyOnChange)
+{
+    Transform t;
+    uint32 v0 = t.GetVersion();
+
+    t.SetPosition({ 0.0f, 0.0f, 0.0f });
+    EXPECT_EQ(t.GetVersion(), v0);
+
+    t.SetRotation({ 0.0f, 1.0f, 0.0f });
+    EXPECT_EQ(t.GetVersion(), v0 + 1);
+
+    t.SetScale({ 2.0f, 2.0f, 2.0f });
+    EXPECT_EQ(t.GetVersion(), v0 + 2);
+}
@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+#include "Scene/TransformHierarchy.h"
+#include "Scene/SceneGraph.h"
+#include "Scene/SceneNode.h"
+#include "Core/ThreadPool.h"
+#include "Math/MathUtil.h"
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+using namespace RRE;
+
+namespace
+{
+
+XMFLOAT3 WorldOrigin(const XMFLOAT4X4& world)
+{
+    XMFLOAT3 pos;
+    XMStoreFloat3(&pos, XMVector4Transform(XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f),
+        XMLoadFloat4x4(&world)));
+    return pos;
+}
+
+// Random tree with mixed fan-out and depth; every node gets a random TRS
+void BuildRandomScene(SceneGraph& graph, uint32 nodeCount, uint32 seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> rot(-XM_PI, XM_PI);
+    std::uniform_real_distribution<float> scl(0.5f, 1.5f);
+
+    std::vector<SceneNode*> nodes = { graph.GetRoot() };
+    nodes.reserve(nodeCount);
+    for (uint32 i = 1; i < nodeCount; ++i)
+    {
+        // Bias towards recent nodes to produce deep chains as well as wide levels
+        uint32 window = std::min<uint32>(static_cast<uint32>(nodes.size()), 64u);
+        uint32 parentIndex = (rng() % 4 == 0)
+            ? static_cast<uint32>(rng() % nodes.size())
+            : static_cast<uint32>(nodes.size() - 1 - rng() % window);
+
+        auto node = std::make_unique<SceneNode>();
+        node->GetTransform().SetPosition({ pos(rng), pos(rng), pos(rng) });
+        node->GetTransform().SetRotation({ rot(rng), rot(rng), rot(rng) });
+        node->GetTransform().SetScale({ scl(rng), scl(rng), scl(rng) });
+        nodes.push_back(nodes[parentIndex]->AddChild(std::move(node)));
+    }
+}
+
+std::vector<XMFLOAT4X4> CollectWorlds(const SceneGraph& graph)
+{
+    std::vector<XMFLOAT4X4> worlds;
+    graph.Traverse([&](SceneNode*, const XMMATRIX& world) {
+        XMFLOAT4X4 m;
+        XMStoreFloat4x4(&m, world);
+        worlds.push_back(m);
+    });
+    return worlds;
+}
+
+} // anonymous namespace
+
+TEST(TransformHierarchy, RejectsParentAfterChild)
+{
+    TransformHierarchy hierarchy;
+    EXPECT_EQ(hierarchy.AddNode(TransformHierarchy::INVALID_INDEX), 0u);
+    EXPECT_EQ(hierarchy.AddNode(5), TransformHierarchy::INVALID_INDEX);
+    EXPECT_EQ(hierarchy.GetCount(), 1u);
+}
+
+TEST(TransformHierarchy, LinearPassConcatenatesParents)
+{
+    TransformHierarchy hierarchy;
+    uint32 root = hierarchy.AddNode(TransformHierarchy::INVALID_INDEX, { 5.0f, 0.0f, 0.0f });
+    uint32 child = hierarchy.AddNode(root, { 3.0f, 0.0f, 0.0f });
+    uint32 grandchild = hierarchy.AddNode(child, { 0.0f, 1.0f, 0.0f });
+
+    EXPECT_EQ(hierarchy.UpdateWorldMatrices(), 3u);
+
+    XMFLOAT3 pos = WorldOrigin(hierarchy.GetWorldMatrix(grandchild));
+    EXPECT_TRUE(Math::NearEqualVector3(pos, { 8.0f, 1.0f, 0.0f }));
+}
+
+TEST(TransformHierarchy, OnlyDirtySubtreeIsRecomputed)
+{
+    TransformHierarchy hierarchy;
+    uint32 root = hierarchy.AddNode(TransformHierarchy::INVALID_INDEX);
+    uint32 a = hierarchy.AddNode(root);
+    hierarchy.AddNode(a);
+    uint32 b = hierarchy.AddNode(root);
+    hierarchy.AddNode(b);
+    hierarchy.UpdateWorldMatrices();
+
+    EXPECT_EQ(hierarchy.UpdateWorldMatrices(), 0u);
+
+    hierarchy.SetPosition(a, { 1.0f, 0.0f, 0.0f });
+    EXPECT_EQ(hierarchy.UpdateWorldMatrices(), 2u);
+}
+
+TEST(SceneGraph, FlatTraversalMatchesTreeTraversal)
+{
+    SceneGraph graph;
+    auto parent = std::make_unique<SceneNode>();
+    parent->GetTransform().SetRotation({ 0.0f, XM_PIDIV2, 0.0f });
+    SceneNode* parentPtr = graph.GetRoot()->AddChild(std::move(parent));
+    auto child = std::make_unique<SceneNode>();
+    child->GetTransform().SetPosition({ 1.0f, 0.0f, 0.0f });
+    child->GetTransform().SetScale({ 2.0f, 2.0f, 2.0f });
+    parentPtr->AddChild(std::move(child));
+    graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+
+    std::vector<SceneNode*> treeNodes;
+    std::vector<XMFLOAT4X4> treeWorlds;
+    graph.Traverse([&](SceneNode* node, const XMMATRIX& world) {
+        treeNodes.push_back(node);
+        XMFLOAT4X4 m;
+        XMStoreFloat4x4(&m, world);
+        treeWorlds.push_back(m);
+    });
+
+    graph.SetStorage(SceneStorage::Flat);
+    std::vector<SceneNode*> flatNodes;
+    std::vector<XMFLOAT4X4> flatWorlds;
+    graph.Traverse([&](SceneNode* node, const XMMATRIX& world) {
+        flatNodes.push_back(node);
+        XMFLOAT4X4 m;
+        XMStoreFloat4x4(&m, world);
+        flatWorlds.push_back(m);
+    });
+
+    ASSERT_EQ(flatNodes, treeNodes);
+    for (size_t i = 0; i < treeWorlds.size(); ++i)
+    {
+        EXPECT_TRUE(Math::NearEqualMatrix(flatWorlds[i], treeWorlds[i]));
+    }
+}
+
+TEST(SceneGraph, FlatTraversalPicksUpEdits)
+{
+    SceneGraph graph;
+    graph.SetStorage(SceneStorage::Flat);
+    SceneNode* a = graph.GetRoot()->AddChild(std::make_unique<SceneNode>());
+
+    int visits = 0;
+    graph.Traverse([&](SceneNode*, const XMMATRIX&) { visits++; });
+    EXPECT_EQ(visits, 2);
+
+    // Structural change triggers a rebuild
+    auto child = std::make_unique<SceneNode>();
+    child->GetTransform().SetPosition({ 0.0f, 0.0f, 1.0f });
+    SceneNode* childPtr = a->AddChild(std::move(child));
+
+    // Transform change is synced without a rebuild
+    a->GetTransform().SetPosition({ 2.0f, 0.0f, 0.0f });
+
+    XMFLOAT3 childPos = {};
+    visits = 0;
+    graph.Traverse([&](SceneNode* node, const XMMATRIX& world) {
+        visits++;
+        if (node == childPtr)
+            XMStoreFloat3(&childPos, XMVector4Transform(XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), world));
+    });
+    EXPECT_EQ(visits, 3);
+    EXPECT_TRUE(Math::NearEqualVector3(childPos, { 2.0f, 0.0f, 1.0f }));
+
+    a->GetTransform().SetPosition({ 4.0f, 0.0f, 0.0f });
+    graph.Traverse([&](SceneNode* node, const XMMATRIX& world) {
+        if (node == childPtr)
+            XMStoreFloat3(&childPos, XMVector4Transform(XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), world));
+    });
+    EXPECT_TRUE(Math::NearEqualVector3(childPos, { 4.0f, 0.0f, 1.0f }));
+}
+
+TEST(TransformHierarchy, ParallelUpdateMatchesSerialBitForBit)
+{
+    SceneGraph graph;
+    BuildRandomScene(graph, 40000, 1234);
+
+    // Serial reference: pointer-tree traversal
+    std::vector<XMFLOAT4X4> serial = CollectWorlds(graph);
+
+    ThreadPool pool(4);
+    graph.SetThreadPool(&pool);
+    graph.SetStorage(SceneStorage::Flat);
+    ASSERT_GE(serial.size(), SceneGraph::PARALLEL_UPDATE_THRESHOLD);
+
+    std::vector<XMFLOAT4X4> parallel = CollectWorlds(graph);
+    ASSERT_EQ(parallel.size(), serial.size());
+    EXPECT_EQ(std::memcmp(parallel.data(), serial.data(),
+        serial.size() * sizeof(XMFLOAT4X4)), 0);
+
+    // Incremental update after animating a handful of nodes
+    const auto& nodes = graph.GetHierarchyNodes();
+    for (size_t i = 1; i < nodes.size(); i += 997)
+    {
+        nodes[i]->GetTransform().SetRotation({ 0.0f, static_cast<float>(i) * 0.01f, 0.0f });
+    }
+    parallel = CollectWorlds(graph);
+    graph.SetStorage(SceneStorage::Tree);
+    serial = CollectWorlds(graph);
+    EXPECT_EQ(std::memcmp(parallel.data(), serial.data(),
+        serial.size() * sizeof(XMFLOAT4X4)), 0);
+}
+
+TEST(TransformHierarchy, ParallelUpdateMatchesLinearPass)
+{
+    TransformHierarchy serial;
+    TransformHierarchy parallel;
+    std::mt19937 rng(42);
+    for (uint32 i = 0; i < 5000; ++i)
+    {
+        uint32 parent = i == 0 ? TransformHierarchy::INVALID_INDEX : static_cast<uint32>(rng() % i);
+        XMFLOAT3 p = { static_cast<float>(rng() % 100) * 0.1f, 1.0f, 0.0f };
+        XMFLOAT3 r = { 0.0f, static_cast<float>(rng() % 628) * 0.01f, 0.0f };
+        serial.AddNode(parent, p, r);
+        parallel.AddNode(parent, p, r);
+    }
+
+    ThreadPool pool(3);
+    EXPECT_EQ(serial.UpdateWorldMatrices(), parallel.UpdateWorldMatricesParallel(pool, 16));
+    EXPECT_EQ(std::memcmp(serial.GetWorldMatrices().data(), parallel.GetWorldMatrices().data(),
+        serial.GetCount() * sizeof(XMFLOAT4X4)), 0);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "Renderer/VertexQuantizer.h"
+#include "Renderer/MeshFactory.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace DirectX;
+using namespace RRE;
+
+namespace
+{
+
+// Chord between unit vectors; equals the angle in radians for small angles
+// (acos is too coarse in float near 1)
+float AngleBetween(const XMFLOAT3& a, const XMFLOAT3& b)
+{
+    XMVECTOR delta = XMVectorSubtract(XMVector3Normalize(XMLoadFloat3(&a)), XMLoadFloat3(&b));
+    return XMVectorGetX(XMVector3Length(delta));
+}
+
+} // anonymous namespace
+
+TEST(VertexQuantizer, CompactVertexIs16Bytes)
+{
+    EXPECT_EQ(sizeof(CompactVertex), 16u);
+    EXPECT_EQ(sizeof(Vertex), 40u);
+}
+
+TEST(VertexQuantizer, PositionsWithinOneStep)
+{
+    Mesh sphere = MeshFactory::CreateSphere(32, 32, MeshShading::Smooth);
+    for (auto& vertex : sphere.vertices)
+    {
+        vertex.position = { vertex.position.x * 3.0f + 10.0f, vertex.position.y - 2.0f, vertex.position.z * 0.5f };
+    }
+    std::vector<CompactVertex> compact;
+    uint32 count = static_cast<uint32>(sphere.vertices.size());
+    QuantizationRange range = VertexQuantizer::Encode(sphere.vertices.data(), count, compact);
+    ASSERT_EQ(compact.size(), sphere.vertices.size());
+    EXPECT_NEAR(range.offset.x, 7.0f, 1e-4f);
+    EXPECT_NEAR(range.scale.x, 6.0f, 1e-4f);
+
+    // Round to nearest: half a step of the range per axis (plus float slack)
+    XMFLOAT3 tolerance = { range.scale.x / 65535.0f, range.scale.y / 65535.0f, range.scale.z / 65535.0f };
+    for (uint32 i = 0; i < count; ++i)
+    {
+        Vertex decoded = VertexQuantizer::Decode(compact[i], range);
+        EXPECT_NEAR(decoded.position.x, sphere.vertices[i].position.x, tolerance.x);
+        EXPECT_NEAR(decoded.position.y, sphere.vertices[i].position.y, tolerance.y);
+        EXPECT_NEAR(decoded.position.z, sphere.vertices[i].position.z, tolerance.z);
+    }
+}
+
+TEST(VertexQuantizer, FlatAxisKeepsItsValue)
+{
+    Vertex vertices[2] = {};
+    vertices[0].position = { 0.0f, 4.0f, 0.0f };
+    vertices[1].position = { 1.0f, 4.0f, 2.0f };
+    std::vector<CompactVertex> compact;
+    QuantizationRange range = VertexQuantizer::Encode(vertices, 2, compact);
+    EXPECT_EQ(range.scale.y, 0.0f);
+    EXPECT_EQ(VertexQuantizer::Decode(compact[1], range).position.y, 4.0f);
+    EXPECT_EQ(VertexQuantizer::Decode(compact[1], range).position.z, 2.0f);
+}
+
+TEST(VertexQuantizer, OctahedralNormals)
+{
+    // Axes (both hemispheres), the fold diagonals and a spread of directions
+    std::vector<XMFLOAT3> normals = {
+        { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 },
+        { 0.7071f, 0.7071f, 0 }, { -0.7071f, 0, -0.7071f },
+    };
+    for (int i = 0; i < 500; ++i)
+    {
+        float theta = 0.37f * i;
+        float z = 1.0f - 2.0f * (i + 0.5f) / 500.0f;
+        float r = std::sqrt(1.0f - z * z);
+        normals.push_back({ r * std::cos(theta), r * std::sin(theta), z });
+    }
+
+    float maxError = 0.0f;
+    for (const XMFLOAT3& normal : normals)
+    {
+        int16 encoded[2];
+        VertexQuantizer::EncodeOctahedral(normal, encoded);
+        XMFLOAT3 decoded = VertexQuantizer::DecodeOctahedral(encoded);
+        EXPECT_NEAR(decoded.x * decoded.x + decoded.y * decoded.y + decoded.z * decoded.z, 1.0f, 1e-5f);
+        maxError = std::max(maxError, AngleBetween(normal, decoded));
+    }
+    EXPECT_LT(maxError, 2e-4f);   // about 0.01 degrees
+}
+
+TEST(VertexQuantizer, PaletteColorsAreExact)
+{
+    XMFLOAT4 colors[] = {
+        { 1.0f, 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 1.0f, 1.0f },
+        { 1.0f, 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f, 0.0f }, { 51 / 255.0f, 102 / 255.0f, 1.0f, 1.0f },
+    };
+    for (const XMFLOAT4& color : colors)
+    {
+        XMFLOAT4 decoded = VertexQuantizer::UnpackColor(VertexQuantizer::PackColor(color));
+        EXPECT_FLOAT_EQ(decoded.x, color.x);
+        EXPECT_FLOAT_EQ(decoded.y, color.y);
+        EXPECT_FLOAT_EQ(decoded.z, color.z);
+        EXPECT_FLOAT_EQ(decoded.w, color.w);
+    }
+    // R8G8B8A8_UNORM byte order
+    EXPECT_EQ(VertexQuantizer::PackColor({ 1.0f, 0.0f, 0.0f, 1.0f }), 0xFF0000FFu);
+}
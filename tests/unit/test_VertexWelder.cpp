@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "Renderer/VertexWelder.h"
+#include "Renderer/MeshFactory.h"
+#include <cmath>
+#include <vector>
+
+using namespace DirectX;
+using namespace RRE;
+
+namespace
+{
+
+Vertex MakeVertex(float x, float y, float z, float nz = 1.0f)
+{
+    Vertex v;
+    v.position = { x, y, z };
+    v.color = { 1.0f, 0.0f, 0.0f, 1.0f };
+    v.normal = { 0.0f, 0.0f, nz };
+    return v;
+}
+
+float Length(const XMFLOAT3& v)
+{
+    return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+}
+
+} // anonymous namespace
+
+TEST(VertexWelder, MergesEqualVerticesInFirstOccurrenceOrder)
+{
+    // Two triangles of a quad with the shared edge duplicated
+    std::vector<Vertex> vertices = {
+        MakeVertex(0, 0, 0), MakeVertex(1, 0, 0), MakeVertex(1, 1, 0),
+        MakeVertex(0, 0, 0), MakeVertex(1, 1, 0), MakeVertex(0, 1, 0),
+    };
+    std::vector<uint32> indices = { 0, 1, 2, 3, 4, 5 };
+
+    EXPECT_EQ(VertexWelder::Weld(vertices, indices), 4u);
+    ASSERT_EQ(vertices.size(), 4u);
+    EXPECT_EQ(indices, (std::vector<uint32>{ 0, 1, 2, 0, 2, 3 }));
+    EXPECT_EQ(vertices[3].position.y, 1.0f);
+}
+
+TEST(VertexWelder, KeepsDifferentNormalsAndFoldsNegativeZero)
+{
+    std::vector<Vertex> vertices = {
+        MakeVertex(0.0f, 0, 0, 1.0f),
+        MakeVertex(0.0f, 0, 0, -1.0f),  // same position, other normal
+        MakeVertex(-0.0f, 0, 0, 1.0f),  // equal to the first
+    };
+    std::vector<uint32> indices = { 0, 1, 2 };
+
+    EXPECT_EQ(VertexWelder::Weld(vertices, indices), 2u);
+    EXPECT_EQ(indices, (std::vector<uint32>{ 0, 1, 0 }));
+}
+
+TEST(VertexWelder, SmoothSphereSharesOneVertexPerPosition)
+{
+    Mesh flat = MeshFactory::CreateSphere(16, 16);
+    Mesh smooth = MeshFactory::CreateSphere(16, 16, MeshShading::Smooth);
+
+    // 15 rings of 16 plus two poles
+    EXPECT_EQ(flat.vertices.size(), 1440u);
+    EXPECT_EQ(smooth.vertices.size(), 242u);
+    EXPECT_EQ(smooth.indices.size(), flat.indices.size());
+    // Triangles are reordered for the vertex cache; adjacency follows them
+    ASSERT_EQ(smooth.faceAdjacency.size(), flat.faceAdjacency.size());
+    for (uint32 f = 0; f < smooth.faceAdjacency.size(); ++f)
+    {
+        EXPECT_EQ(smooth.faceAdjacency[f].size(), 3u);
+    }
+
+    // Smooth normals of a unit sphere lie along the position, on the same
+    // side as the flat face normals
+    float flatSide = flat.vertices[0].normal.x * flat.vertices[0].position.x +
+        flat.vertices[0].normal.y * flat.vertices[0].position.y +
+        flat.vertices[0].normal.z * flat.vertices[0].position.z;
+    for (const Vertex& v : smooth.vertices)
+    {
+        EXPECT_NEAR(Length(v.normal), 1.0f, 1e-5f);
+        float dot = v.normal.x * v.position.x + v.normal.y * v.position.y + v.normal.z * v.position.z;
+        EXPECT_GT(std::fabs(dot), 0.99f);
+        EXPECT_EQ(dot > 0.0f, flatSide > 0.0f);
+    }
+}
+
+TEST(VertexWelder, CreasesKeepHardEdges)
+{
+    // Each cube corner keeps one vertex per side it touches
+    Mesh cube = MeshFactory::CreateCube(MeshShading::Smooth);
+    EXPECT_EQ(cube.vertices.size(), 24u);
+    for (const Vertex& v : cube.vertices)
+    {
+        float axis = std::fabs(v.normal.x) + std::fabs(v.normal.y) + std::fabs(v.normal.z);
+        EXPECT_NEAR(axis, 1.0f, 1e-5f);
+    }
+
+    // Cylinder: smooth sides, flat caps; ring positions split in two
+    Mesh cylinder = MeshFactory::CreateCylinder(16, 2.0f, MeshShading::Smooth);
+    EXPECT_EQ(cylinder.vertices.size(), 16u * 4u + 2u);
+    EXPECT_EQ(cylinder.indices.size(), 64u * 3u);
+}
+
+TEST(VertexWelder, WeldPositionsIgnoresOtherAttributes)
+{
+    // Flat cube: 24 vertices (different normals) over 8 corners
+    Mesh cube = MeshFactory::CreateCube(MeshShading::Flat);
+    std::vector<Vertex> original = cube.vertices;
+
+    std::vector<DirectX::XMFLOAT3> positions;
+    std::vector<uint32> remap;
+    EXPECT_EQ(VertexWelder::WeldPositions(cube.vertices, positions, remap), 8u);
+    ASSERT_EQ(remap.size(), original.size());
+    for (size_t i = 0; i < original.size(); ++i)
+    {
+        ASSERT_LT(remap[i], positions.size());
+        EXPECT_EQ(positions[remap[i]].x, original[i].position.x);
+        EXPECT_EQ(positions[remap[i]].y, original[i].position.y);
+        EXPECT_EQ(positions[remap[i]].z, original[i].position.z);
+    }
+    EXPECT_EQ(remap[0], 0u);
+
+    // -0 and +0 are one position
+    std::vector<Vertex> signedZero(2);
+    signedZero[0].position = { 0.0f, 1.0f, 0.0f };
+    signedZero[1].position = { -0.0f, 1.0f, -0.0f };
+    EXPECT_EQ(VertexWelder::WeldPositions(signedZero, positions, remap), 1u);
+    EXPECT_EQ(remap[1], 0u);
+}